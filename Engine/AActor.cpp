@@ -5,6 +5,9 @@
 #include "UActorComponent.h"
 #include "USceneComponent.h"
 #include "UEngineStatics.h"
+#include "UGarbageCollector.h"
+#include "UScene.h"
+#include "FProperty.h"
 
 IMPLEMENT_UCLASS(AActor, UObject)
 
@@ -17,6 +20,17 @@ AActor::AActor()
 }
 
 
+void AActor::OnComponentAdded(UActorComponent* component)
+{
+    if (!Scene)
+        return;
+
+    if (USceneComponent* sceneComp = component->Cast<USceneComponent>())
+    {
+        Scene->RegisterComponent(sceneComp);
+    }
+}
+
 void AActor::SetRootComponent(USceneComponent* InRootComponent)
 {
     RootComponent = InRootComponent;
@@ -57,25 +71,29 @@ void AActor::OnShutdown()
     }
 }
 
+void AActor::AddReferencedObjects(FReferenceCollector& collector)
+{
+    for (const auto& comp : Components)
+    {
+        collector.AddReferencedObject(comp.get());
+    }
+}
+
 json::JSON AActor::Serialize() const
 {
-    json::JSON result = UObject::Serialize();
+    // 액터 자신의 속성은 UPROPERTY로, 컴포넌트는 각자의 Serialize로 저장
+    json::JSON result = Super::Serialize();
 
     result["Type"] = "AActor";
     result["ActorClass"] = GetClass()->GetDisplayName();
 
-    // Serialize components
     int32 componentCount = 0;
     for (const auto& comp : Components)
     {
-        if (comp)
+        if (comp && !comp->IsEditorOnly())
         {
-            json::JSON compJson = comp->Serialize();
-            if (!compJson.IsNull())
-            {
-                result["Components"][std::to_string(componentCount)] = compJson;
-                ++componentCount;
-            }
+            result["Components"][std::to_string(componentCount)] = comp->Serialize();
+            ++componentCount;
         }
     }
 
@@ -84,34 +102,99 @@ json::JSON AActor::Serialize() const
 
 bool AActor::Deserialize(const json::JSON& data)
 {
-    if (!UObject::Deserialize(data))
+    bool bResult = Super::Deserialize(data);
+
+    if (!data.hasKey("Components"))
+        return bResult;
+
+    // 키가 "0", "1", ... 이므로 문자열 순서가 아닌 저장 순서로 읽음
+    const json::JSON& componentsJson = data.at("Components");
+    for (uint32 index = 0; componentsJson.hasKey(std::to_string(index)); ++index)
+    {
+        const json::JSON& compData = componentsJson.at(std::to_string(index));
+        if (!compData.hasKey("Type"))
+        {
+            bResult = false;
+            continue;
+        }
+
+        UClass* compClass = UClass::FindClassWithDisplayName(compData.at("Type").ToString());
+        UActorComponent* comp = compClass ? FindOrAddLoadedComponent(index, compClass) : nullptr;
+        if (!comp)
+        {
+            bResult = false;
+            continue;
+        }
+        bResult &= comp->Deserialize(compData);
+    }
+
+    return bResult;
+}
+
+void AActor::SerializeBinary(TArray<uint8>& outBytes) const
+{
+    Super::SerializeBinary(outBytes);
+
+    uint32 componentCount = 0;
+    for (const auto& comp : Components)
+    {
+        if (comp && !comp->IsEditorOnly())
+            ++componentCount;
+    }
+    FPropertySerializer::WriteRaw(outBytes, componentCount);
+
+    for (const auto& comp : Components)
+    {
+        if (comp && !comp->IsEditorOnly())
+        {
+            FPropertySerializer::WriteObjectRecord(comp.get(), outBytes);
+        }
+    }
+}
+
+bool AActor::DeserializeBinary(const uint8*& cursor, const uint8* end)
+{
+    bool bResult = Super::DeserializeBinary(cursor, end);
+
+    uint32 componentCount = 0;
+    if (!FPropertySerializer::ReadRaw(cursor, end, componentCount))
         return false;
 
-    // Deserialize components if they exist
-    if (data.hasKey("Components"))
+    for (uint32 index = 0; index < componentCount; ++index)
     {
-        json::JSON componentsJson = data.at("Components");
-        for (auto& compPair : componentsJson.ObjectRange())
+        UClass* compClass = nullptr;
+        const uint8* recordEnd = nullptr;
+        if (!FPropertySerializer::ReadObjectRecordHeader(cursor, end, compClass, recordEnd))
+            return false;
+
+        // 알 수 없는 클래스의 레코드는 건너뜀
+        UActorComponent* comp = compClass ? FindOrAddLoadedComponent(index, compClass) : nullptr;
+        if (comp)
         {
-            json::JSON compData = compPair.second;
-
-            if (compData.hasKey("Type"))
-            {
-                FString compType = compData.at("Type").ToString();
-                UClass* compClass = UClass::FindClassWithDisplayName(compType);
-
-                if (compClass)
-                {
-                    if (UActorComponent* comp = compClass->CreateDefaultObject()->Cast<UActorComponent>())
-                    {
-                        comp->Deserialize(compData);
-                        // Note: Components are managed by unique_ptr, this is simplified
-                        // In a full implementation, you'd need proper component management
-                    }
-                }
-            }
+            bResult &= comp->DeserializeBinary(cursor, recordEnd);
         }
+        else
+        {
+            bResult = false;
+        }
+        cursor = recordEnd;
     }
 
-    return true;
+    return bResult;
+}
+
+UActorComponent* AActor::FindOrAddLoadedComponent(uint32 index, UClass* componentClass)
+{
+    // 생성자가 만든 기본 컴포넌트는 저장된 순서와 같은 자리에 있으므로 그대로 채움
+    if (index < Components.size() && Components[index] && Components[index]->GetClass() == componentClass)
+        return Components[index].get();
+
+    UObject* object = componentClass->CreateDefaultObject();
+    UActorComponent* comp = object ? object->Cast<UActorComponent>() : nullptr;
+    if (!comp)
+    {
+        delete object;
+        return nullptr;
+    }
+    return AddComponent(TUniquePtr<UActorComponent>(comp));
 }
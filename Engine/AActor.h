@@ -3,6 +3,7 @@
 #include "UEngineStatics.h"
 #include "UActorComponent.h"
 class USceneComponent;
+class UScene;
 
 class AActor : public UObject
 {
@@ -22,6 +23,7 @@ public:
 		componentPtr->SetOwner(this);
 
 		Components.push_back(std::move(component));
+		OnComponentAdded(componentPtr);
 
 		// If it's a scene component and we don't have a root, make it root
 		if (auto sceneComp = componentPtr->template Cast<USceneComponent>())
@@ -71,16 +73,43 @@ public:
 	virtual void Update(float deltaTime);
 	virtual void OnShutdown();
 
+	/**
+	 * @brief Whether Update may run on a worker thread during UScene's parallel tick.
+	 * @note: Such actors may only touch their own components; structural changes (spawn, destroy,
+	 *        attach) go through UScene::GetCommandBuffer().
+	 */
+	virtual bool IsThreadSafeTick() const { return false; }
+
+	/** @brief Scene this actor's components are registered with (set by UScene). */
+	UScene* GetScene() const { return Scene; }
+	void SetScene(UScene* InScene) { Scene = InScene; }
+
 	// Serialization
 	virtual json::JSON Serialize() const override;
 	virtual bool Deserialize(const json::JSON& data) override;
+	void SerializeBinary(TArray<uint8>& outBytes) const override;
+	bool DeserializeBinary(const uint8*& cursor, const uint8* end) override;
 	virtual uint32 GetID() const { return ID; }
 
+	void AddReferencedObjects(FReferenceCollector& collector) override;
+	void BeginDestroy() override { OnShutdown(); }
+
 	bool markedAsDestroyed = false;
 
 private:
 	static inline uint32 ActorID;
 	TArray<TUniquePtr<UActorComponent>> Components;
 	USceneComponent* RootComponent = nullptr;
+	UScene* Scene = nullptr;
 	uint32 ID;
+
+	// UScene::actorGrid의 핸들 (루트 컴포넌트가 처음 갱신될 때 추가됨)
+	friend class UScene;
+	uint32 SceneGridHandle = UINT_MAX;
+
+	// 씬에 있는 액터에 추가된 컴포넌트를 레지스트리에 등록
+	void OnComponentAdded(UActorComponent* component);
+
+	/** @brief Component the index-th saved component loads into: the constructor's component at that slot if the class matches, else a new one. */
+	UActorComponent* FindOrAddLoadedComponent(uint32 index, UClass* componentClass);
 };
\ No newline at end of file
@@ -16,6 +16,7 @@ public:
 
     // Lifecycle methods (using existing names)
     virtual bool Initialize() override;  // TODO: Rename to InitializeComponent() later
+    bool IsThreadSafeTick() const override { return true; }  // 자기 컴포넌트만 갱신
 
     // Static mesh management
     UStaticMeshComponent* GetStaticMeshComponent() const { return StaticMeshComponent; }
@@ -73,4 +73,37 @@ VS_OUTPUT main_instanced(VS_INPUT input, VS_INST inst)
     output.Color = inst.Color;
 
 	return output;
-}
\ No newline at end of file
+}
+
+// Per-instance data for batched meshes (slot 1, see UBatchRenderer::FMeshInstance)
+struct VS_MESH_INST
+{
+    float4 World0 : INST_WORLD0;
+    float4 World1 : INST_WORLD1;
+    float4 World2 : INST_WORLD2;
+    float4 World3 : INST_WORLD3;
+    float4 Color : INST_COLOR;
+    float IsSelected : INST_SELECTED;
+};
+
+// Instanced variant of main: MVP holds only View * Projection, the world matrix comes per instance
+VS_OUTPUT main_mesh_instanced(VS_INPUT input, VS_MESH_INST inst)
+{
+    VS_OUTPUT output;
+
+    float4x4 World = float4x4(inst.World0, inst.World1, inst.World2, inst.World3);
+    float4 wpos = float4(input.Position.xyz, 1.0f);
+
+    // row: v' = v * World * VP
+    output.Position = mul(mul(wpos, World), MVP);
+    output.UV = input.UV;
+
+    // Same coloring as main (which ignores MeshColor, so inst.Color is unused here too)
+    output.Color = input.Color;
+    if (inst.IsSelected > 0.5f)
+    {
+        output.Color = output.Color + 0.25f;
+    }
+
+    return output;
+}
@@ -371,6 +371,19 @@ public:
         return GetField(it->second);
     }
 
+    /**
+     * @brief Gets a field by its name, if the layout has one.
+     * @param Name The name of the field.
+     * @return A pointer to the `FField`, or `nullptr` if no field has that name.
+     * @pre The layout must be finalized.
+     */
+    const FField* FindField(const FString& Name) const
+    {
+        assert(bIsFinalized && "Cannot find field before being finalized.");
+        auto it = FieldIndexMap.find(Name);
+        return it != FieldIndexMap.end() ? &Fields[it->second] : nullptr;
+    }
+
     /**
      * @brief Prints the layout structure to a stream in a human-readable format.
      * @param Stream The output stream (e.g., `std::cout`).
@@ -678,17 +691,15 @@ public:
         return reinterpret_cast<const void*>(Buffer.data());
     }
 
-#ifndef NDEBUG
     /**
      * @brief Gets a const reference to the buffer's layout.
-     * This method is intended for debugging purposes only.
      * @return A `const UBufferElementLayout&`.
+     * @note UShaderReflection reads field offsets from it, so it is available in release builds too.
      */
     const UBufferElementLayout& GetLayout() const
     {
         return Layout;
     }
-#endif
 
 private:
     TArray<value_type> Buffer;
@@ -15,6 +15,13 @@ void EditorApplication::Update(float deltaTime)
 {
 	// Basic update logic
 	UApplication::Update(deltaTime);
+
+	// 선택된 객체가 이번 프레임에 삭제되었다면 선택 해제 (handle 조회 O(1))
+	if (selectedSceneComponent.IsStale() || SelectedPrimitive.IsStale())
+	{
+		ResetSelectedTarget();
+	}
+
 	gizmoManager.Update(deltaTime);
 
 	// Handle input in organized sections
@@ -133,17 +140,18 @@ void EditorApplication::EndDragOperation()
 void EditorApplication::UpdateDragOperation()
 {
 	UCamera* camera = GetSceneManager().GetScene()->GetCamera();
-	if (!camera || SelectedPrimitive == nullptr) return;
+	UPrimitiveComponent* selected = SelectedPrimitive.Get();
+	if (!camera || selected == nullptr) return;
 
 	// Additional safety checks for SelectedPrimitive
-	if (!SelectedPrimitive->GetMesh())
+	if (!selected->GetMesh())
 	{
 		bAABBFlag = false;
 		return;
 	}
 
 	FVector localMin, localMax;
-	if (GetRaycastManager().MakeAABBInfo(SelectedPrimitive->GetMesh(), SelectedPrimitive->GetWorldTransform(), localMin, localMax)) {
+	if (GetRaycastManager().MakeAABBInfo(selected->GetMesh(), selected->GetWorldTransform(), localMin, localMax)) {
 
 		MinWSPos = localMin;
 		MaxWSPos = localMax;
@@ -199,35 +207,20 @@ void EditorApplication::CollectRaycastableObjects(TArray<UGizmoComponent*>& outG
 		gizmo->bIsSelected = false;
 	}
 
-	// Collect primitives from legacy objects
-	for (UObject* obj : GetSceneManager().GetScene()->GetObjects())
+	UScene* scene = GetSceneManager().GetScene();
+	for (UPrimitiveComponent* primitive : scene->GetPrimitives())
 	{
-		if (UPrimitiveComponent* primitive = obj->Cast<UPrimitiveComponent>())
-		{
-			if (primitive->GetMesh())
-			{
-				outPrimitives.push_back(primitive);
-			}
-			primitive->bIsSelected = false;
-		}
+		primitive->bIsSelected = false;
 	}
 
-	// Collect primitives from actors
-	for (AActor* actor : GetSceneManager().GetScene()->GetActors())
-	{
-		if (actor)
-		{
-			auto components = actor->GetComponents<UPrimitiveComponent>();
-			for (UPrimitiveComponent* primitive : components)
-			{
-				if (primitive && primitive->GetMesh())
-				{
-					outPrimitives.push_back(primitive);
-					primitive->bIsSelected = false;
-				}
-			}
-		}
-	}
+	// Only primitives whose bounds the mouse ray enters need the per-triangle test
+	// (attached extras such as textholders are not pickable)
+	FRay ray = GetRaycastManager().CreateRayFromScreenPosition(scene->GetCamera());
+	const size_t firstCandidate = outPrimitives.size();
+	scene->RaycastPrimitives(ray.Origin, ray.Direction, FLT_MAX, outPrimitives);
+	outPrimitives.erase(std::remove_if(outPrimitives.begin() + firstCandidate, outPrimitives.end(),
+		[](UPrimitiveComponent* primitive) { return !primitive->IsSceneRoot() || !primitive->GetMesh(); }),
+		outPrimitives.end());
 }
 
 void EditorApplication::HandleGizmoHit(UGizmoComponent* hitGizmo, const FVector& impactPoint)
@@ -305,11 +298,11 @@ void EditorApplication::HandleEmptySpaceClick()
 
 void EditorApplication::ResetSelectedTarget()
 {
-	if (selectedSceneComponent)
+	if (USceneComponent* selected = selectedSceneComponent.Get())
 	{
-		selectedSceneComponent->bIsSelected = false;
-		selectedSceneComponent = nullptr;
+		selected->bIsSelected = false;
 	}
+	selectedSceneComponent = nullptr;
 	gizmoManager.SetTarget(nullptr);
 	propertyWindow->SetTarget(nullptr);
 
@@ -337,7 +330,7 @@ void EditorApplication::RenderGUI()
 	SceneManagerWindow->Render();
 
 	ImGui::SetNextWindowPos(ImVec2(0, 560));         // Fixed position (x=20, y=20)
-	ImGui::SetNextWindowSize(ImVec2(275, 75));      // Fixed size (width=300, height=100)
+	ImGui::SetNextWindowSize(ImVec2(275, 95));      // Fixed size (width=300, height=100)
 	ImGui::Begin("Memory Stats", nullptr,
 		ImGuiWindowFlags_NoResize |
 		ImGuiWindowFlags_NoMove |
@@ -345,6 +338,7 @@ void EditorApplication::RenderGUI()
 
 	ImGui::Text("Allocated Object Count : %d", UEngineStatics::GetTotalAllocationCount());
 	ImGui::Text("Allocated Object Bytes : %d", UEngineStatics::GetTotalAllocationBytes());
+	ImGui::Text("Object Pool Reserved : %zu KB", FObjectAllocator::Get().GetReservedBytes() / 1024);
 
 	ImGui::End();
 
@@ -363,6 +357,9 @@ bool EditorApplication::OnInitialize()
 	SceneManagerWindow = MakeUnique<USceneManagerWindow>(this);
 	config = ConfigManager::GetConfig("editor");
 
+	GetGarbageCollector().SetTimeBudget(config->getFloat("GC", "TimeBudgetMs", 1.0f));
+	GetGarbageCollector().SetInterval(config->getFloat("GC", "Interval", 10.0f));
+
 	if (!gizmoManager.Initialize(&GetMeshManager()))
 	{
 		MessageBox(GetWindowHandle(), L"Failed to initialize gizmo manager", L"Engine Error", MB_OK | MB_ICONERROR);
@@ -402,22 +399,25 @@ void EditorApplication::OnSceneChange()
 	gizmoManager.SetTarget(nullptr);
 
 	// Reset selection state when scene changes
-	if (selectedSceneComponent)
+	if (USceneComponent* selected = selectedSceneComponent.Get())
 	{
-		selectedSceneComponent->bIsSelected = false;
-		selectedSceneComponent = nullptr;
+		selected->bIsSelected = false;
 	}
+	selectedSceneComponent = nullptr;
 	SelectedPrimitive = nullptr;
 	bAABBFlag = false;
+
+	// 이전 씬의 객체를 바로 회수
+	GetGarbageCollector().RequestCollection();
 }
 
 void EditorApplication::HandlePrimitiveSelect(UPrimitiveComponent* Component)
 {
 	if (!Component) return;  // Safety check
 
-	if (selectedSceneComponent)
+	if (USceneComponent* selected = selectedSceneComponent.Get())
 	{
-		selectedSceneComponent->bIsSelected = false;
+		selected->bIsSelected = false;
 	}
 	selectedSceneComponent = Component;
 	gizmoManager.SetTarget(Component);
@@ -448,45 +448,35 @@ void EditorApplication::HandlePrimitiveSelect(UPrimitiveComponent* Component)
 	}
 }
 
-void EditorApplication::OnObjectDestroyed(UObject* obj)
+void EditorApplication::AddReferencedObjects(FReferenceCollector& collector)
 {
-	if (USceneComponent* component = obj->Cast<USceneComponent>())
-	{
-		if (selectedSceneComponent == component)
-		{
-			ResetSelectedTarget();
-		}
-	}
+	// 선택된 객체는 씬에서 빠져도 선택이 풀리기 전까지 유지
+	collector.AddReferencedObject(selectedSceneComponent.Get());
+	collector.AddReferencedObject(SelectedPrimitive.Get());
+}
+
+void EditorApplication::OnObjectsDestroyed(const TArray<UObject*>& objects)
+{
+	// 선택 대상은 한 번만 조회하고, 삭제 목록을 한 번만 순회
+	UObject* selectedComponent = selectedSceneComponent.Get();
+	UObject* selectedPrimitive = SelectedPrimitive.Get();
+	if (!selectedComponent && !selectedPrimitive) return;
 
-	// Also check if the deleted object is the SelectedPrimitive for AABB display
-	if (UPrimitiveComponent* primitive = obj->Cast<UPrimitiveComponent>())
+	for (UObject* obj : objects)
 	{
-		if (SelectedPrimitive == primitive)
+		if (obj == selectedComponent || obj == selectedPrimitive)
 		{
-			SelectedPrimitive = nullptr;
-			bAABBFlag = false;
+			ResetSelectedTarget();
+			return;
 		}
 	}
+}
 
-	// Handle AActor deletion - check all its components
-	if (AActor* actor = obj->Cast<AActor>())
+void EditorApplication::OnObjectDestroyed(UObject* obj)
+{
+	// 액터의 컴포넌트는 weak handle이 stale 상태가 되어 Update에서 정리되므로 직접 비교만 수행
+	if (selectedSceneComponent.Get() == obj || SelectedPrimitive.Get() == obj)
 	{
-		auto components = actor->GetComponents<UPrimitiveComponent>();
-		for (UPrimitiveComponent* primitive : components)
-		{
-			if (primitive)
-			{
-				// Check if any of the actor's components are currently selected
-				if (selectedSceneComponent == primitive)
-				{
-					ResetSelectedTarget();
-				}
-				if (SelectedPrimitive == primitive)
-				{
-					SelectedPrimitive = nullptr;
-					bAABBFlag = false;
-				}
-			}
-		}
+		ResetSelectedTarget();
 	}
 }
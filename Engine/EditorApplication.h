@@ -6,6 +6,7 @@
 #include "UControlPanel.h"
 #include "USceneComponentPropertyWindow.h"
 #include "USceneManagerWindow.h"
+#include "TWeakObjectPtr.h"
 
 /**
  * @brief Editor application with gizmo management and object selection
@@ -16,7 +17,7 @@ private:
 	UGizmoManager gizmoManager;
 	TArray<USceneComponent*> sceneComponents;
 
-	USceneComponent* selectedSceneComponent = nullptr;
+	TWeakObjectPtr<USceneComponent> selectedSceneComponent;
 
 	UControlPanel* controlPanel = nullptr;
 	USceneComponentPropertyWindow* propertyWindow = nullptr;
@@ -28,7 +29,7 @@ private:
 	// AABB
 	bool bAABBFlag = false;
 	FVector MinWSPos, MaxWSPos; 
-	UPrimitiveComponent* SelectedPrimitive = nullptr;
+	TWeakObjectPtr<UPrimitiveComponent> SelectedPrimitive;
 
 public:
 	EditorApplication() = default;
@@ -46,6 +47,8 @@ public:
 	/** @brief: API for selecting objects through various methods(e.g., Line Casting, Heirarchy window, etc...).*/
 	void HandlePrimitiveSelect(UPrimitiveComponent* Component);
 	void OnObjectDestroyed(UObject* obj);
+	void OnObjectsDestroyed(const TArray<UObject*>& objects) override;
+	void AddReferencedObjects(FReferenceCollector& collector) override;
 
 protected:
 	void Update(float deltaTime) override;
@@ -0,0 +1,303 @@
+﻿#pragma once
+#include "Vector.h"
+#include "Vector4.h"
+#include "Matrix.h"
+
+// 컴파일 타임 SIMD 선택: /arch:AVX (-mavx) 이상이면 8개, x64 기본 SSE면 4개씩 판정
+#if defined(__AVX__)
+#include <immintrin.h>
+#define BOUNDS_USE_AVX 1
+#define BOUNDS_USE_SSE 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <xmmintrin.h>
+#define BOUNDS_USE_AVX 0
+#define BOUNDS_USE_SSE 1
+#else
+#define BOUNDS_USE_AVX 0
+#define BOUNDS_USE_SSE 0
+#endif
+
+/**
+ * @brief Axis-aligned bounding box in world (or local) space
+ * @note: A default-constructed box is empty (Min > Max) so it can be grown with AddPoint/Union.
+ */
+struct FAABB
+{
+	FVector Min{ FLT_MAX, FLT_MAX, FLT_MAX };
+	FVector Max{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+	FAABB() = default;
+	FAABB(const FVector& InMin, const FVector& InMax) : Min(InMin), Max(InMax) {}
+
+	bool IsValid() const { return Min.X <= Max.X && Min.Y <= Max.Y && Min.Z <= Max.Z; }
+
+	FVector GetCenter() const { return (Min + Max) * 0.5f; }
+	FVector GetExtent() const { return (Max - Min) * 0.5f; }
+
+	/** @brief Half the surface area; only used to compare costs, so the factor 2 is dropped. */
+	float GetPerimeter() const
+	{
+		const float DX = Max.X - Min.X, DY = Max.Y - Min.Y, DZ = Max.Z - Min.Z;
+		return DX * DY + DY * DZ + DZ * DX;
+	}
+
+	void AddPoint(const FVector& P)
+	{
+		Min = FVector(min(Min.X, P.X), min(Min.Y, P.Y), min(Min.Z, P.Z));
+		Max = FVector(max(Max.X, P.X), max(Max.Y, P.Y), max(Max.Z, P.Z));
+	}
+
+	static FAABB Union(const FAABB& A, const FAABB& B)
+	{
+		return FAABB(
+			FVector(min(A.Min.X, B.Min.X), min(A.Min.Y, B.Min.Y), min(A.Min.Z, B.Min.Z)),
+			FVector(max(A.Max.X, B.Max.X), max(A.Max.Y, B.Max.Y), max(A.Max.Z, B.Max.Z)));
+	}
+
+	FAABB ExpandBy(float Margin) const
+	{
+		const FVector M(Margin, Margin, Margin);
+		return FAABB(Min - M, Max + M);
+	}
+
+	/**
+	 * @brief Bounds of this box after an affine row-vector transform (Arvo's method).
+	 *
+	 * Each output axis is the translation plus, per input axis, the smaller/larger of the two scaled
+	 * extremes, so the result is exact for the transformed box without touching its 8 corners.
+	 * @note: M must not contain a projection (last column 0,0,0,1).
+	 */
+	FAABB TransformBy(const FMatrix& M) const
+	{
+		const float Lo[3] = { Min.X, Min.Y, Min.Z };
+		const float Hi[3] = { Max.X, Max.Y, Max.Z };
+		float OutLo[3] = { M.M[3][0], M.M[3][1], M.M[3][2] };
+		float OutHi[3] = { M.M[3][0], M.M[3][1], M.M[3][2] };
+		for (int32 i = 0; i < 3; ++i)
+		{
+			for (int32 j = 0; j < 3; ++j)
+			{
+				const float A = M.M[i][j] * Lo[i];
+				const float B = M.M[i][j] * Hi[i];
+				OutLo[j] += A < B ? A : B;
+				OutHi[j] += A < B ? B : A;
+			}
+		}
+		return FAABB(FVector(OutLo[0], OutLo[1], OutLo[2]), FVector(OutHi[0], OutHi[1], OutHi[2]));
+	}
+
+	bool Contains(const FAABB& Other) const
+	{
+		return Min.X <= Other.Min.X && Min.Y <= Other.Min.Y && Min.Z <= Other.Min.Z
+			&& Other.Max.X <= Max.X && Other.Max.Y <= Max.Y && Other.Max.Z <= Max.Z;
+	}
+
+	bool Intersects(const FAABB& Other) const
+	{
+		return Min.X <= Other.Max.X && Other.Min.X <= Max.X
+			&& Min.Y <= Other.Max.Y && Other.Min.Y <= Max.Y
+			&& Min.Z <= Other.Max.Z && Other.Min.Z <= Max.Z;
+	}
+
+	/**
+	 * @brief Slab test against a ray given as origin and reciprocal direction.
+	 * @return Entry distance in [0, MaxT] on hit (0 when the origin is inside).
+	 */
+	TOptional<float> IntersectRay(const FVector& Origin, const FVector& InvDirection, float MaxT) const
+	{
+		// 방향 성분이 0이면 InvDirection이 ±inf가 되어 슬랩 밖/안이 그대로 판정됨
+		float T0 = 0.0f, T1 = MaxT;
+		const float O[3] = { Origin.X, Origin.Y, Origin.Z };
+		const float Inv[3] = { InvDirection.X, InvDirection.Y, InvDirection.Z };
+		const float Lo[3] = { Min.X, Min.Y, Min.Z };
+		const float Hi[3] = { Max.X, Max.Y, Max.Z };
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			float TNear = (Lo[Axis] - O[Axis]) * Inv[Axis];
+			float TFar = (Hi[Axis] - O[Axis]) * Inv[Axis];
+			if (TNear > TFar) std::swap(TNear, TFar);
+			// NaN (0 * inf)은 비교가 거짓이라 해당 축을 건너뜀
+			T0 = TNear > T0 ? TNear : T0;
+			T1 = TFar < T1 ? TFar : T1;
+			if (T0 > T1) return {};
+		}
+		return T0;
+	}
+};
+
+/**
+ * @brief Up to eight boxes in SoA layout (center/extent) for the batched frustum kernel
+ * @note: Lanes past Count are still read by the kernel, so they are zeroed once on construction and
+ *        afterwards only ever hold earlier (valid) boxes.
+ */
+struct alignas(32) FAABBBatch
+{
+	static constexpr uint32 Capacity = 8;
+
+	float CenterX[Capacity], CenterY[Capacity], CenterZ[Capacity];
+	float ExtentX[Capacity], ExtentY[Capacity], ExtentZ[Capacity];
+	int32 Ids[Capacity];
+	uint32 Count = 0;
+
+	FAABBBatch()
+	{
+		for (uint32 i = 0; i < Capacity; ++i)
+		{
+			CenterX[i] = CenterY[i] = CenterZ[i] = 0.0f;
+			ExtentX[i] = ExtentY[i] = ExtentZ[i] = 0.0f;
+			Ids[i] = -1;
+		}
+	}
+
+	void Reset() { Count = 0; }
+
+	bool IsFull() const { return Count == Capacity; }
+	bool IsEmpty() const { return Count == 0; }
+
+	void Add(const FAABB& Box, int32 Id)
+	{
+		const FVector Center = Box.GetCenter();
+		const FVector Extent = Box.GetExtent();
+		CenterX[Count] = Center.X; CenterY[Count] = Center.Y; CenterZ[Count] = Center.Z;
+		ExtentX[Count] = Extent.X; ExtentY[Count] = Extent.Y; ExtentZ[Count] = Extent.Z;
+		Ids[Count] = Id;
+		++Count;
+	}
+};
+
+/**
+ * @brief Six inward-facing planes (X,Y,Z = normal, W = distance) of a view volume
+ *
+ * Extracted from a row-vector view-projection matrix with D3D clip depth [0, w], so perspective
+ * and orthographic cameras are handled the same way.
+ */
+struct FFrustum
+{
+	enum EPlane { Left, Right, Bottom, Top, Near, Far, NumPlanes };
+
+	FVector4 Planes[NumPlanes];
+
+	enum class EContainment : uint8 { Outside, Intersects, Inside };
+
+	static FFrustum FromViewProj(const FMatrix& ViewProj)
+	{
+		// clip = p * VP 이므로 j번째 열이 clip의 j번째 성분
+		auto Column = [&ViewProj](int32 j) {
+			return FVector4(ViewProj.M[0][j], ViewProj.M[1][j], ViewProj.M[2][j], ViewProj.M[3][j]);
+		};
+		auto Add = [](const FVector4& A, const FVector4& B) { return FVector4(A.X + B.X, A.Y + B.Y, A.Z + B.Z, A.W + B.W); };
+		auto Sub = [](const FVector4& A, const FVector4& B) { return FVector4(A.X - B.X, A.Y - B.Y, A.Z - B.Z, A.W - B.W); };
+
+		const FVector4 C0 = Column(0), C1 = Column(1), C2 = Column(2), C3 = Column(3);
+
+		FFrustum Result;
+		Result.Planes[Left] = Add(C3, C0);
+		Result.Planes[Right] = Sub(C3, C0);
+		Result.Planes[Bottom] = Add(C3, C1);
+		Result.Planes[Top] = Sub(C3, C1);
+		Result.Planes[Near] = C2;
+		Result.Planes[Far] = Sub(C3, C2);
+
+		for (FVector4& Plane : Result.Planes)
+		{
+			const float Length = sqrtf(Plane.X * Plane.X + Plane.Y * Plane.Y + Plane.Z * Plane.Z);
+			if (Length > 0.0f)
+			{
+				const float Inv = 1.0f / Length;
+				Plane = FVector4(Plane.X * Inv, Plane.Y * Inv, Plane.Z * Inv, Plane.W * Inv);
+			}
+		}
+		return Result;
+	}
+
+	/** @brief Conservative test: may report Intersects for boxes just outside a frustum corner. */
+	EContainment TestAABB(const FAABB& Box) const
+	{
+		const FVector Center = Box.GetCenter();
+		const FVector Extent = Box.GetExtent();
+
+		EContainment Result = EContainment::Inside;
+		for (const FVector4& Plane : Planes)
+		{
+			// 박스 중심의 부호 거리와 평면 법선 방향으로 투영한 반경 비교
+			const float Distance = Plane.X * Center.X + Plane.Y * Center.Y + Plane.Z * Center.Z + Plane.W;
+			const float Radius = fabsf(Plane.X) * Extent.X + fabsf(Plane.Y) * Extent.Y + fabsf(Plane.Z) * Extent.Z;
+			if (Distance < -Radius)
+				return EContainment::Outside;
+			if (Distance < Radius)
+				Result = EContainment::Intersects;
+		}
+		return Result;
+	}
+
+	bool IntersectsAABB(const FAABB& Box) const { return TestAABB(Box) != EContainment::Outside; }
+
+	/**
+	 * @brief Tests every box of the batch at once (8 lanes with AVX, 2x4 with SSE).
+	 * @return Bit i set if box i is not outside; bits past Batch.Count are always clear.
+	 * @note: Adds and compares in the same order as TestAABB, so both agree bit for bit, even for boxes touching a plane.
+	 */
+	uint32 TestAABBs(const FAABBBatch& Batch) const
+	{
+		const uint32 ValidMask = (1u << Batch.Count) - 1u;
+#if BOUNDS_USE_AVX
+		const __m256 SignMask = _mm256_set1_ps(-0.0f);
+		const __m256 CX = _mm256_load_ps(Batch.CenterX), CY = _mm256_load_ps(Batch.CenterY), CZ = _mm256_load_ps(Batch.CenterZ);
+		const __m256 EX = _mm256_load_ps(Batch.ExtentX), EY = _mm256_load_ps(Batch.ExtentY), EZ = _mm256_load_ps(Batch.ExtentZ);
+
+		__m256 Outside = _mm256_setzero_ps();
+		for (const FVector4& Plane : Planes)
+		{
+			const __m256 PX = _mm256_set1_ps(Plane.X), PY = _mm256_set1_ps(Plane.Y), PZ = _mm256_set1_ps(Plane.Z);
+			const __m256 Distance = _mm256_add_ps(_mm256_add_ps(
+				_mm256_add_ps(_mm256_mul_ps(PX, CX), _mm256_mul_ps(PY, CY)),
+				_mm256_mul_ps(PZ, CZ)), _mm256_set1_ps(Plane.W));
+			const __m256 Radius = _mm256_add_ps(
+				_mm256_add_ps(_mm256_mul_ps(_mm256_andnot_ps(SignMask, PX), EX), _mm256_mul_ps(_mm256_andnot_ps(SignMask, PY), EY)),
+				_mm256_mul_ps(_mm256_andnot_ps(SignMask, PZ), EZ));
+			// Distance < -Radius 이면 평면 바깥
+			Outside = _mm256_or_ps(Outside, _mm256_cmp_ps(Distance, _mm256_xor_ps(Radius, SignMask), _CMP_LT_OQ));
+		}
+		return ~static_cast<uint32>(_mm256_movemask_ps(Outside)) & ValidMask;
+#elif BOUNDS_USE_SSE
+		const __m128 SignMask = _mm_set1_ps(-0.0f);
+		uint32 OutsideBits = 0;
+		for (uint32 Lane = 0; Lane < FAABBBatch::Capacity; Lane += 4)
+		{
+			const __m128 CX = _mm_load_ps(Batch.CenterX + Lane), CY = _mm_load_ps(Batch.CenterY + Lane), CZ = _mm_load_ps(Batch.CenterZ + Lane);
+			const __m128 EX = _mm_load_ps(Batch.ExtentX + Lane), EY = _mm_load_ps(Batch.ExtentY + Lane), EZ = _mm_load_ps(Batch.ExtentZ + Lane);
+
+			__m128 Outside = _mm_setzero_ps();
+			for (const FVector4& Plane : Planes)
+			{
+				const __m128 PX = _mm_set1_ps(Plane.X), PY = _mm_set1_ps(Plane.Y), PZ = _mm_set1_ps(Plane.Z);
+				const __m128 Distance = _mm_add_ps(_mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(PX, CX), _mm_mul_ps(PY, CY)),
+					_mm_mul_ps(PZ, CZ)), _mm_set1_ps(Plane.W));
+				const __m128 Radius = _mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(_mm_andnot_ps(SignMask, PX), EX), _mm_mul_ps(_mm_andnot_ps(SignMask, PY), EY)),
+					_mm_mul_ps(_mm_andnot_ps(SignMask, PZ), EZ));
+				Outside = _mm_or_ps(Outside, _mm_cmplt_ps(Distance, _mm_xor_ps(Radius, SignMask)));
+			}
+			OutsideBits |= static_cast<uint32>(_mm_movemask_ps(Outside)) << Lane;
+		}
+		return ~OutsideBits & ValidMask;
+#else
+		// 중심/반경에서 바로 판정 (박스로 되돌리면 반올림으로 경계 결과가 달라질 수 있음)
+		uint32 Result = 0;
+		for (uint32 i = 0; i < Batch.Count; ++i)
+		{
+			bool bOutside = false;
+			for (const FVector4& Plane : Planes)
+			{
+				const float Distance = Plane.X * Batch.CenterX[i] + Plane.Y * Batch.CenterY[i] + Plane.Z * Batch.CenterZ[i] + Plane.W;
+				const float Radius = fabsf(Plane.X) * Batch.ExtentX[i] + fabsf(Plane.Y) * Batch.ExtentY[i] + fabsf(Plane.Z) * Batch.ExtentZ[i];
+				bOutside |= Distance < -Radius;
+			}
+			if (!bOutside)
+				Result |= 1u << i;
+		}
+		return Result;
+#endif
+	}
+};
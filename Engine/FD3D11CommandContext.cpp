@@ -0,0 +1,139 @@
+﻿#include "stdafx.h"
+#include "FD3D11CommandContext.h"
+
+FD3D11CommandContext::FD3D11CommandContext(ID3D11Device* InDevice, ID3D11DeviceContext* InDeviceContext)
+	: Device(InDevice)
+	, DeviceContext(InDeviceContext)
+{
+	assert(Device && DeviceContext);
+}
+
+void FD3D11CommandContext::SetInputLayout(ID3D11InputLayout* InputLayout)
+{
+	DeviceContext->IASetInputLayout(InputLayout);
+}
+
+void FD3D11CommandContext::SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY Topology)
+{
+	DeviceContext->IASetPrimitiveTopology(Topology);
+}
+
+void FD3D11CommandContext::SetVertexBuffers(uint32 StartSlot, uint32 NumBuffers, ID3D11Buffer* const* Buffers, const UINT* Strides, const UINT* Offsets)
+{
+	DeviceContext->IASetVertexBuffers(StartSlot, NumBuffers, Buffers, Strides, Offsets);
+}
+
+void FD3D11CommandContext::SetIndexBuffer(ID3D11Buffer* Buffer, DXGI_FORMAT Format, uint32 Offset)
+{
+	DeviceContext->IASetIndexBuffer(Buffer, Format, Offset);
+}
+
+void FD3D11CommandContext::SetVertexShader(ID3D11VertexShader* Shader)
+{
+	DeviceContext->VSSetShader(Shader, nullptr, 0);
+}
+
+void FD3D11CommandContext::SetPixelShader(ID3D11PixelShader* Shader)
+{
+	DeviceContext->PSSetShader(Shader, nullptr, 0);
+}
+
+void FD3D11CommandContext::SetVSConstantBuffer(uint32 Slot, ID3D11Buffer* Buffer)
+{
+	DeviceContext->VSSetConstantBuffers(Slot, 1, &Buffer);
+}
+
+void FD3D11CommandContext::SetPSConstantBuffer(uint32 Slot, ID3D11Buffer* Buffer)
+{
+	DeviceContext->PSSetConstantBuffers(Slot, 1, &Buffer);
+}
+
+void FD3D11CommandContext::SetPSShaderResource(uint32 Slot, ID3D11ShaderResourceView* ShaderResourceView)
+{
+	DeviceContext->PSSetShaderResources(Slot, 1, &ShaderResourceView);
+}
+
+void FD3D11CommandContext::SetPSSampler(uint32 Slot, ID3D11SamplerState* Sampler)
+{
+	DeviceContext->PSSetSamplers(Slot, 1, &Sampler);
+}
+
+void FD3D11CommandContext::SetRasterizerState(ID3D11RasterizerState* State)
+{
+	DeviceContext->RSSetState(State);
+}
+
+void FD3D11CommandContext::SetDepthStencilState(ID3D11DepthStencilState* State, uint32 StencilRef)
+{
+	DeviceContext->OMSetDepthStencilState(State, StencilRef);
+}
+
+void FD3D11CommandContext::GetDepthStencilState(ID3D11DepthStencilState** OutState, UINT* OutStencilRef)
+{
+	DeviceContext->OMGetDepthStencilState(OutState, OutStencilRef);
+}
+
+void FD3D11CommandContext::SetRenderTarget(ID3D11RenderTargetView* RenderTargetView, ID3D11DepthStencilView* DepthStencilView)
+{
+	DeviceContext->OMSetRenderTargets(1, &RenderTargetView, DepthStencilView);
+}
+
+void FD3D11CommandContext::SetViewport(const D3D11_VIEWPORT& Viewport)
+{
+	DeviceContext->RSSetViewports(1, &Viewport);
+}
+
+void FD3D11CommandContext::ClearRenderTarget(ID3D11RenderTargetView* RenderTargetView, const float Color[4])
+{
+	DeviceContext->ClearRenderTargetView(RenderTargetView, Color);
+}
+
+void FD3D11CommandContext::ClearDepthStencil(ID3D11DepthStencilView* DepthStencilView, uint32 ClearFlags, float Depth, uint8 Stencil)
+{
+	DeviceContext->ClearDepthStencilView(DepthStencilView, ClearFlags, Depth, Stencil);
+}
+
+ID3D11Buffer* FD3D11CommandContext::CreateBuffer(const D3D11_BUFFER_DESC& Desc, const D3D11_SUBRESOURCE_DATA* InitialData)
+{
+	ID3D11Buffer* Buffer = nullptr;
+	if (FAILED(Device->CreateBuffer(&Desc, InitialData, &Buffer)))
+		return nullptr;
+	return Buffer;
+}
+
+bool FD3D11CommandContext::WriteDynamicBuffer(ID3D11Buffer* Buffer, const void* Data, uint32 Size)
+{
+	D3D11_MAPPED_SUBRESOURCE MappedSubresource;
+	if (FAILED(DeviceContext->Map(Buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &MappedSubresource)))
+		return false;
+
+	memcpy(MappedSubresource.pData, Data, Size);
+	DeviceContext->Unmap(Buffer, 0);
+	return true;
+}
+
+void FD3D11CommandContext::UpdateBuffer(ID3D11Buffer* Buffer, const void* Data, uint32 /*Size*/)
+{
+	// 버퍼 전체 갱신이라 크기는 버퍼 desc를 따름
+	DeviceContext->UpdateSubresource(Buffer, 0, nullptr, Data, 0, 0);
+}
+
+void FD3D11CommandContext::Draw(uint32 VertexCount, uint32 StartVertexLocation)
+{
+	DeviceContext->Draw(VertexCount, StartVertexLocation);
+}
+
+void FD3D11CommandContext::DrawIndexed(uint32 IndexCount, uint32 StartIndexLocation, int32 BaseVertexLocation)
+{
+	DeviceContext->DrawIndexed(IndexCount, StartIndexLocation, BaseVertexLocation);
+}
+
+void FD3D11CommandContext::DrawInstanced(uint32 VertexCountPerInstance, uint32 InstanceCount, uint32 StartVertexLocation, uint32 StartInstanceLocation)
+{
+	DeviceContext->DrawInstanced(VertexCountPerInstance, InstanceCount, StartVertexLocation, StartInstanceLocation);
+}
+
+void FD3D11CommandContext::DrawIndexedInstanced(uint32 IndexCountPerInstance, uint32 InstanceCount, uint32 StartIndexLocation, int32 BaseVertexLocation, uint32 StartInstanceLocation)
+{
+	DeviceContext->DrawIndexedInstanced(IndexCountPerInstance, InstanceCount, StartIndexLocation, BaseVertexLocation, StartInstanceLocation);
+}
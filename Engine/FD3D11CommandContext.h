@@ -0,0 +1,49 @@
+﻿#pragma once
+#include "FRHICommandContext.h"
+
+/**
+ * @brief FRHICommandContext that submits straight to an ID3D11DeviceContext.
+ * @note: Does not own the device or the device context.
+ */
+class FD3D11CommandContext : public FRHICommandContext
+{
+public:
+	FD3D11CommandContext(ID3D11Device* InDevice, ID3D11DeviceContext* InDeviceContext);
+
+	ID3D11DeviceContext* GetDeviceContext() const { return DeviceContext; }
+
+	virtual void SetInputLayout(ID3D11InputLayout* InputLayout) override;
+	virtual void SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY Topology) override;
+	virtual void SetVertexBuffers(uint32 StartSlot, uint32 NumBuffers, ID3D11Buffer* const* Buffers, const UINT* Strides, const UINT* Offsets) override;
+	virtual void SetIndexBuffer(ID3D11Buffer* Buffer, DXGI_FORMAT Format, uint32 Offset) override;
+
+	virtual void SetVertexShader(ID3D11VertexShader* Shader) override;
+	virtual void SetPixelShader(ID3D11PixelShader* Shader) override;
+	virtual void SetVSConstantBuffer(uint32 Slot, ID3D11Buffer* Buffer) override;
+	virtual void SetPSConstantBuffer(uint32 Slot, ID3D11Buffer* Buffer) override;
+	virtual void SetPSShaderResource(uint32 Slot, ID3D11ShaderResourceView* ShaderResourceView) override;
+	virtual void SetPSSampler(uint32 Slot, ID3D11SamplerState* Sampler) override;
+
+	virtual void SetRasterizerState(ID3D11RasterizerState* State) override;
+	virtual void SetDepthStencilState(ID3D11DepthStencilState* State, uint32 StencilRef) override;
+	virtual void GetDepthStencilState(ID3D11DepthStencilState** OutState, UINT* OutStencilRef) override;
+	virtual void SetRenderTarget(ID3D11RenderTargetView* RenderTargetView, ID3D11DepthStencilView* DepthStencilView) override;
+	virtual void SetViewport(const D3D11_VIEWPORT& Viewport) override;
+
+	virtual void ClearRenderTarget(ID3D11RenderTargetView* RenderTargetView, const float Color[4]) override;
+	virtual void ClearDepthStencil(ID3D11DepthStencilView* DepthStencilView, uint32 ClearFlags, float Depth, uint8 Stencil) override;
+
+	virtual ID3D11Buffer* CreateBuffer(const D3D11_BUFFER_DESC& Desc, const D3D11_SUBRESOURCE_DATA* InitialData) override;
+
+	virtual bool WriteDynamicBuffer(ID3D11Buffer* Buffer, const void* Data, uint32 Size) override;
+	virtual void UpdateBuffer(ID3D11Buffer* Buffer, const void* Data, uint32 Size) override;
+
+	virtual void Draw(uint32 VertexCount, uint32 StartVertexLocation) override;
+	virtual void DrawIndexed(uint32 IndexCount, uint32 StartIndexLocation, int32 BaseVertexLocation) override;
+	virtual void DrawInstanced(uint32 VertexCountPerInstance, uint32 InstanceCount, uint32 StartVertexLocation, uint32 StartInstanceLocation) override;
+	virtual void DrawIndexedInstanced(uint32 IndexCountPerInstance, uint32 InstanceCount, uint32 StartIndexLocation, int32 BaseVertexLocation, uint32 StartInstanceLocation) override;
+
+private:
+	ID3D11Device* Device;
+	ID3D11DeviceContext* DeviceContext;
+};
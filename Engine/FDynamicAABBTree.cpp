@@ -0,0 +1,388 @@
+﻿#include "stdafx.h"
+#include "FDynamicAABBTree.h"
+
+namespace
+{
+	// 예측 이동량을 fat AABB에 반영할 배수 (다음 몇 프레임 동안 재삽입을 피함)
+	constexpr float DisplacementMultiplier = 2.0f;
+	// 실제 박스보다 이만큼 (Margin 배수) 더 커진 fat AABB는 다시 조여서 재삽입
+	constexpr float ShrinkMarginMultiplier = 4.0f;
+}
+
+FDynamicAABBTree::FDynamicAABBTree(float InMargin)
+	: Margin(InMargin)
+{
+}
+
+int32 FDynamicAABBTree::AllocateNode()
+{
+	if (FreeList == NullNode)
+	{
+		Nodes.emplace_back();
+		const int32 NodeId = static_cast<int32>(Nodes.size()) - 1;
+		Nodes[NodeId].Height = 0;
+		return NodeId;
+	}
+
+	const int32 NodeId = FreeList;
+	FreeList = Nodes[NodeId].Parent;
+	Nodes[NodeId] = FTreeNode();
+	Nodes[NodeId].Height = 0;
+	return NodeId;
+}
+
+void FDynamicAABBTree::FreeNode(int32 NodeId)
+{
+	FTreeNode& Node = Nodes[NodeId];
+	Node.UserData = nullptr;
+	Node.Child1 = Node.Child2 = NullNode;
+	Node.Height = -1;
+	Node.Parent = FreeList;
+	FreeList = NodeId;
+}
+
+void FDynamicAABBTree::Clear()
+{
+	Nodes.clear();
+	Root = NullNode;
+	FreeList = NullNode;
+	ProxyCount = 0;
+}
+
+int32 FDynamicAABBTree::CreateProxy(const FAABB& Bounds, UPrimitiveComponent* UserData)
+{
+	const int32 ProxyId = AllocateNode();
+	Nodes[ProxyId].Box = Bounds.ExpandBy(Margin);
+	Nodes[ProxyId].UserData = UserData;
+
+	InsertLeaf(ProxyId);
+	++ProxyCount;
+	return ProxyId;
+}
+
+void FDynamicAABBTree::DestroyProxy(int32 ProxyId)
+{
+	assert(ProxyId >= 0 && ProxyId < static_cast<int32>(Nodes.size()) && Nodes[ProxyId].IsLeaf() && Nodes[ProxyId].Height == 0);
+
+	RemoveLeaf(ProxyId);
+	FreeNode(ProxyId);
+	--ProxyCount;
+}
+
+bool FDynamicAABBTree::MoveProxy(int32 ProxyId, const FAABB& Bounds, const FVector& Displacement)
+{
+	assert(ProxyId >= 0 && ProxyId < static_cast<int32>(Nodes.size()) && Nodes[ProxyId].IsLeaf());
+
+	const FAABB& FatBox = Nodes[ProxyId].Box;
+	if (FatBox.Contains(Bounds))
+	{
+		// 여전히 안에 있어도 fat AABB가 너무 커졌으면 (예: 큰 이동 후 정지) 다시 조임
+		const FAABB HugeBox = Bounds.ExpandBy(ShrinkMarginMultiplier * Margin + Displacement.Length() * DisplacementMultiplier);
+		if (HugeBox.Contains(FatBox))
+			return false;
+	}
+
+	RemoveLeaf(ProxyId);
+
+	// 이동 방향으로만 늘려서 다음 프레임 이동도 같은 리프 안에 머물도록 함
+	FAABB NewBox = Bounds.ExpandBy(Margin);
+	const FVector Predicted = Displacement * DisplacementMultiplier;
+	(Predicted.X < 0.0f ? NewBox.Min.X : NewBox.Max.X) += Predicted.X;
+	(Predicted.Y < 0.0f ? NewBox.Min.Y : NewBox.Max.Y) += Predicted.Y;
+	(Predicted.Z < 0.0f ? NewBox.Min.Z : NewBox.Max.Z) += Predicted.Z;
+	Nodes[ProxyId].Box = NewBox;
+
+	InsertLeaf(ProxyId);
+	return true;
+}
+
+void FDynamicAABBTree::InsertLeaf(int32 Leaf)
+{
+	if (Root == NullNode)
+	{
+		Root = Leaf;
+		Nodes[Root].Parent = NullNode;
+		return;
+	}
+
+	// 1. 표면적 증가 비용이 가장 작은 형제 찾기
+	const FAABB LeafBox = Nodes[Leaf].Box;
+	int32 Index = Root;
+	while (!Nodes[Index].IsLeaf())
+	{
+		const FTreeNode& Node = Nodes[Index];
+		const int32 Child1 = Node.Child1;
+		const int32 Child2 = Node.Child2;
+
+		const float Area = Node.Box.GetPerimeter();
+		const float CombinedArea = FAABB::Union(Node.Box, LeafBox).GetPerimeter();
+
+		// 여기서 새 부모를 만들 때의 비용
+		const float Cost = 2.0f * CombinedArea;
+		// 더 내려갈 때 이 노드가 커지는 만큼은 어느 자식으로 가든 공통으로 듦
+		const float InheritanceCost = 2.0f * (CombinedArea - Area);
+
+		auto DescendCost = [&](int32 Child)
+		{
+			const FTreeNode& ChildNode = Nodes[Child];
+			const float NewArea = FAABB::Union(LeafBox, ChildNode.Box).GetPerimeter();
+			return ChildNode.IsLeaf()
+				? NewArea + InheritanceCost
+				: (NewArea - ChildNode.Box.GetPerimeter()) + InheritanceCost;
+		};
+		const float Cost1 = DescendCost(Child1);
+		const float Cost2 = DescendCost(Child2);
+
+		if (Cost < Cost1 && Cost < Cost2)
+			break;
+
+		Index = (Cost1 < Cost2) ? Child1 : Child2;
+	}
+	const int32 Sibling = Index;
+
+	// 2. 형제 자리에 새 부모를 끼워 넣음 (AllocateNode가 배열을 늘릴 수 있으므로 참조를 들고 있지 않음)
+	const int32 OldParent = Nodes[Sibling].Parent;
+	const int32 NewParent = AllocateNode();
+	Nodes[NewParent].Parent = OldParent;
+	Nodes[NewParent].Box = FAABB::Union(LeafBox, Nodes[Sibling].Box);
+	Nodes[NewParent].Height = Nodes[Sibling].Height + 1;
+	Nodes[NewParent].Child1 = Sibling;
+	Nodes[NewParent].Child2 = Leaf;
+	Nodes[Sibling].Parent = NewParent;
+	Nodes[Leaf].Parent = NewParent;
+
+	if (OldParent != NullNode)
+	{
+		FTreeNode& OldParentNode = Nodes[OldParent];
+		(OldParentNode.Child1 == Sibling ? OldParentNode.Child1 : OldParentNode.Child2) = NewParent;
+	}
+	else
+	{
+		Root = NewParent;
+	}
+
+	// 3. 루트까지 올라가며 박스/높이 갱신과 회전
+	FixUpwards(Nodes[Leaf].Parent);
+}
+
+void FDynamicAABBTree::RemoveLeaf(int32 Leaf)
+{
+	if (Leaf == Root)
+	{
+		Root = NullNode;
+		return;
+	}
+
+	const int32 Parent = Nodes[Leaf].Parent;
+	const int32 GrandParent = Nodes[Parent].Parent;
+	const int32 Sibling = (Nodes[Parent].Child1 == Leaf) ? Nodes[Parent].Child2 : Nodes[Parent].Child1;
+
+	if (GrandParent != NullNode)
+	{
+		// 부모를 없애고 형제를 조부모에 바로 연결
+		FTreeNode& GrandParentNode = Nodes[GrandParent];
+		(GrandParentNode.Child1 == Parent ? GrandParentNode.Child1 : GrandParentNode.Child2) = Sibling;
+		Nodes[Sibling].Parent = GrandParent;
+		FreeNode(Parent);
+
+		FixUpwards(GrandParent);
+	}
+	else
+	{
+		Root = Sibling;
+		Nodes[Sibling].Parent = NullNode;
+		FreeNode(Parent);
+	}
+}
+
+void FDynamicAABBTree::FixUpwards(int32 NodeId)
+{
+	while (NodeId != NullNode)
+	{
+		NodeId = Balance(NodeId);
+
+		FTreeNode& Node = Nodes[NodeId];
+		const FTreeNode& Child1 = Nodes[Node.Child1];
+		const FTreeNode& Child2 = Nodes[Node.Child2];
+		Node.Height = 1 + max(Child1.Height, Child2.Height);
+		Node.Box = FAABB::Union(Child1.Box, Child2.Box);
+
+		NodeId = Node.Parent;
+	}
+}
+
+int32 FDynamicAABBTree::Balance(int32 IndexA)
+{
+	FTreeNode* A = &Nodes[IndexA];
+	if (A->IsLeaf() || A->Height < 2)
+		return IndexA;
+
+	const int32 IndexB = A->Child1;
+	const int32 IndexC = A->Child2;
+	FTreeNode* B = &Nodes[IndexB];
+	FTreeNode* C = &Nodes[IndexC];
+
+	const int32 BalanceFactor = C->Height - B->Height;
+
+	// C를 위로 올림
+	if (BalanceFactor > 1)
+	{
+		const int32 IndexF = C->Child1;
+		const int32 IndexG = C->Child2;
+		FTreeNode* F = &Nodes[IndexF];
+		FTreeNode* G = &Nodes[IndexG];
+
+		C->Child1 = IndexA;
+		C->Parent = A->Parent;
+		A->Parent = IndexC;
+
+		if (C->Parent != NullNode)
+		{
+			FTreeNode& CParent = Nodes[C->Parent];
+			(CParent.Child1 == IndexA ? CParent.Child1 : CParent.Child2) = IndexC;
+		}
+		else
+		{
+			Root = IndexC;
+		}
+
+		// 높은 쪽 손자를 C 아래에 남기고 낮은 쪽을 A로 내림
+		if (F->Height > G->Height)
+		{
+			C->Child2 = IndexF;
+			A->Child2 = IndexG;
+			G->Parent = IndexA;
+			A->Box = FAABB::Union(B->Box, G->Box);
+			C->Box = FAABB::Union(A->Box, F->Box);
+			A->Height = 1 + max(B->Height, G->Height);
+			C->Height = 1 + max(A->Height, F->Height);
+		}
+		else
+		{
+			C->Child2 = IndexG;
+			A->Child2 = IndexF;
+			F->Parent = IndexA;
+			A->Box = FAABB::Union(B->Box, F->Box);
+			C->Box = FAABB::Union(A->Box, G->Box);
+			A->Height = 1 + max(B->Height, F->Height);
+			C->Height = 1 + max(A->Height, G->Height);
+		}
+		return IndexC;
+	}
+
+	// B를 위로 올림
+	if (BalanceFactor < -1)
+	{
+		const int32 IndexD = B->Child1;
+		const int32 IndexE = B->Child2;
+		FTreeNode* D = &Nodes[IndexD];
+		FTreeNode* E = &Nodes[IndexE];
+
+		B->Child1 = IndexA;
+		B->Parent = A->Parent;
+		A->Parent = IndexB;
+
+		if (B->Parent != NullNode)
+		{
+			FTreeNode& BParent = Nodes[B->Parent];
+			(BParent.Child1 == IndexA ? BParent.Child1 : BParent.Child2) = IndexB;
+		}
+		else
+		{
+			Root = IndexB;
+		}
+
+		if (D->Height > E->Height)
+		{
+			B->Child2 = IndexD;
+			A->Child1 = IndexE;
+			E->Parent = IndexA;
+			A->Box = FAABB::Union(C->Box, E->Box);
+			B->Box = FAABB::Union(A->Box, D->Box);
+			A->Height = 1 + max(C->Height, E->Height);
+			B->Height = 1 + max(A->Height, D->Height);
+		}
+		else
+		{
+			B->Child2 = IndexE;
+			A->Child1 = IndexD;
+			D->Parent = IndexA;
+			A->Box = FAABB::Union(C->Box, D->Box);
+			B->Box = FAABB::Union(A->Box, E->Box);
+			A->Height = 1 + max(C->Height, D->Height);
+			B->Height = 1 + max(A->Height, E->Height);
+		}
+		return IndexB;
+	}
+
+	return IndexA;
+}
+
+int32 FDynamicAABBTree::GetMaxBalance() const
+{
+	int32 MaxBalance = 0;
+	for (const FTreeNode& Node : Nodes)
+	{
+		if (Node.Height <= 1)
+			continue;
+
+		const int32 Balance = abs(Nodes[Node.Child2].Height - Nodes[Node.Child1].Height);
+		MaxBalance = max(MaxBalance, Balance);
+	}
+	return MaxBalance;
+}
+
+float FDynamicAABBTree::GetAreaRatio() const
+{
+	if (Root == NullNode)
+		return 0.0f;
+
+	const float RootArea = Nodes[Root].Box.GetPerimeter();
+	if (RootArea <= 0.0f)
+		return 0.0f;
+
+	float TotalArea = 0.0f;
+	for (const FTreeNode& Node : Nodes)
+	{
+		if (Node.Height < 0)
+			continue;
+		TotalArea += Node.Box.GetPerimeter();
+	}
+	return TotalArea / RootArea;
+}
+
+void FDynamicAABBTree::Validate() const
+{
+	if (Root != NullNode)
+	{
+		assert(Nodes[Root].Parent == NullNode);
+		ValidateNode(Root);
+	}
+
+	int32 FreeCount = 0;
+	for (int32 NodeId = FreeList; NodeId != NullNode; NodeId = Nodes[NodeId].Parent)
+	{
+		++FreeCount;
+	}
+	assert(ProxyCount == 0 || static_cast<int32>(Nodes.size()) - FreeCount == 2 * ProxyCount - 1);
+}
+
+void FDynamicAABBTree::ValidateNode(int32 NodeId) const
+{
+	const FTreeNode& Node = Nodes[NodeId];
+	if (Node.IsLeaf())
+	{
+		assert(Node.Child2 == NullNode && Node.Height == 0);
+		return;
+	}
+
+	const FTreeNode& Child1 = Nodes[Node.Child1];
+	const FTreeNode& Child2 = Nodes[Node.Child2];
+	assert(Child1.Parent == NodeId && Child2.Parent == NodeId);
+	assert(Node.Height == 1 + max(Child1.Height, Child2.Height));
+	assert(Node.Box.Contains(Child1.Box) && Node.Box.Contains(Child2.Box));
+	(void)Child1; (void)Child2;
+
+	ValidateNode(Node.Child1);
+	ValidateNode(Node.Child2);
+}
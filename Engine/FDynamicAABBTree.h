@@ -0,0 +1,287 @@
+﻿#pragma once
+#include "TArray.h"
+#include "FBounds.h"
+#include "FDynamicBitset.h"
+
+class UPrimitiveComponent;
+
+/**
+ * @brief Incremental bounding-volume hierarchy over primitive bounds
+ *
+ * Leaves store a "fat" AABB (tight bounds grown by a margin and by the predicted displacement), so
+ * a primitive that moves a little stays inside its leaf and MoveProxy is a containment check.
+ * Inserts descend by the surface-area cost of enlarging each subtree, and every insert/remove
+ * rebalances the path to the root with AVL-style rotations, keeping the height near log2(N).
+ *
+ * Proxy ids index the node pool and stay valid until DestroyProxy; freed nodes are recycled.
+ *
+ * @note: Queries are templates so the per-leaf callback inlines. They keep their traversal stack on
+ *        the call stack (heap only past 64 levels), so concurrent queries on a const tree are safe.
+ */
+class FDynamicAABBTree
+{
+public:
+	static constexpr int32 NullNode = -1;
+
+	/** @param InMargin Distance each fat AABB extends past the tight bounds. */
+	explicit FDynamicAABBTree(float InMargin = 0.1f);
+
+	FDynamicAABBTree(const FDynamicAABBTree&) = delete;
+	FDynamicAABBTree& operator=(const FDynamicAABBTree&) = delete;
+
+	int32 CreateProxy(const FAABB& Bounds, UPrimitiveComponent* UserData);
+	void DestroyProxy(int32 ProxyId);
+
+	/**
+	 * @brief Updates a proxy after its primitive moved.
+	 * @param Displacement World-space movement since the last update; the fat AABB is stretched along it.
+	 * @return true if the leaf was re-inserted, false if the old fat AABB still fits.
+	 */
+	bool MoveProxy(int32 ProxyId, const FAABB& Bounds, const FVector& Displacement);
+
+	UPrimitiveComponent* GetUserData(int32 ProxyId) const { return Nodes[ProxyId].UserData; }
+	const FAABB& GetFatAABB(int32 ProxyId) const { return Nodes[ProxyId].Box; }
+
+	void Clear();
+
+	void SetMargin(float InMargin) { Margin = InMargin; }
+	float GetMargin() const { return Margin; }
+
+	int32 GetNumProxies() const { return ProxyCount; }
+	int32 GetHeight() const { return Root == NullNode ? 0 : Nodes[Root].Height; }
+	/** @brief Largest height difference between two siblings; 0 or 1 when fully balanced. */
+	int32 GetMaxBalance() const;
+	/** @brief Sum of internal node areas over the root area; lower means tighter boxes. */
+	float GetAreaRatio() const;
+	/** @brief Checks parent links, heights and boxes with assert (debug aid). */
+	void Validate() const;
+
+	/** @brief Calls Callback(ProxyId) for every leaf whose fat AABB overlaps Box; return false to stop. */
+	template <typename TCallback>
+	void QueryAABB(const FAABB& Box, TCallback&& Callback) const
+	{
+		FNodeStack Stack;
+		Stack.Push(Root);
+		while (!Stack.IsEmpty())
+		{
+			const int32 NodeId = Stack.Pop();
+			if (NodeId == NullNode)
+				continue;
+
+			const FTreeNode& Node = Nodes[NodeId];
+			if (!Node.Box.Intersects(Box))
+				continue;
+
+			if (Node.IsLeaf())
+			{
+				if (!Callback(NodeId))
+					return;
+			}
+			else
+			{
+				Stack.Push(Node.Child1);
+				Stack.Push(Node.Child2);
+			}
+		}
+	}
+
+	/**
+	 * @brief Calls Callback(ProxyId) for every leaf whose fat AABB is not outside the frustum.
+	 * @note: Subtrees fully inside are reported without further plane tests. Leaves under partially
+	 *        visible nodes are gathered and tested eight at a time with FFrustum::TestAABBs.
+	 */
+	template <typename TCallback>
+	void QueryFrustum(const FFrustum& Frustum, TCallback&& Callback) const
+	{
+		FAABBBatch Batch;
+		auto FlushBatch = [&]()
+		{
+			for (uint32 Mask = Frustum.TestAABBs(Batch); Mask; Mask &= Mask - 1)
+			{
+				if (!Callback(Batch.Ids[FBitOps::CountTrailingZeros64(Mask)]))
+					return false;
+			}
+			Batch.Reset();
+			return true;
+		};
+
+		FNodeStack Stack;
+		Stack.Push(Root);
+		while (!Stack.IsEmpty())
+		{
+			const int32 NodeId = Stack.Pop();
+			if (NodeId == NullNode)
+				continue;
+
+			const FTreeNode& Node = Nodes[NodeId];
+			if (Node.IsLeaf())
+			{
+				Batch.Add(Node.Box, NodeId);
+				if (Batch.IsFull() && !FlushBatch())
+					return;
+				continue;
+			}
+
+			const FFrustum::EContainment Containment = Frustum.TestAABB(Node.Box);
+			if (Containment == FFrustum::EContainment::Outside)
+				continue;
+
+			if (Containment == FFrustum::EContainment::Inside)
+			{
+				if (!VisitLeaves(NodeId, Callback))
+					return;
+			}
+			else
+			{
+				Stack.Push(Node.Child1);
+				Stack.Push(Node.Child2);
+			}
+		}
+
+		if (!Batch.IsEmpty())
+		{
+			FlushBatch();
+		}
+	}
+
+	/**
+	 * @brief Walks leaves whose fat AABB the ray enters within MaxT, nearer children first.
+	 * @param Callback float(ProxyId, EntryT): return the new MaxT (e.g. the exact hit distance) to clip
+	 *        the ray, the current MaxT to continue unchanged, or 0 to stop.
+	 */
+	template <typename TCallback>
+	void RayCast(const FVector& Origin, const FVector& Direction, float MaxT, TCallback&& Callback) const
+	{
+		if (Root == NullNode)
+			return;
+
+		const FVector InvDirection(1.0f / Direction.X, 1.0f / Direction.Y, 1.0f / Direction.Z);
+
+		FNodeStack Stack;
+		Stack.Push(Root);
+		while (!Stack.IsEmpty())
+		{
+			const int32 NodeId = Stack.Pop();
+			const FTreeNode& Node = Nodes[NodeId];
+
+			const TOptional<float> EntryT = Node.Box.IntersectRay(Origin, InvDirection, MaxT);
+			if (!EntryT)
+				continue;
+
+			if (Node.IsLeaf())
+			{
+				MaxT = Callback(NodeId, *EntryT);
+				if (MaxT <= 0.0f)
+					return;
+				continue;
+			}
+
+			// 가까운 자식을 나중에 넣어 먼저 꺼내도록 해 MaxT가 빨리 줄어들게 함
+			const TOptional<float> T1 = Nodes[Node.Child1].Box.IntersectRay(Origin, InvDirection, MaxT);
+			const TOptional<float> T2 = Nodes[Node.Child2].Box.IntersectRay(Origin, InvDirection, MaxT);
+			if (T1 && T2)
+			{
+				const bool bChild1First = *T1 <= *T2;
+				Stack.Push(bChild1First ? Node.Child2 : Node.Child1);
+				Stack.Push(bChild1First ? Node.Child1 : Node.Child2);
+			}
+			else if (T1)
+			{
+				Stack.Push(Node.Child1);
+			}
+			else if (T2)
+			{
+				Stack.Push(Node.Child2);
+			}
+		}
+	}
+
+private:
+	struct FTreeNode
+	{
+		FAABB Box;
+		UPrimitiveComponent* UserData = nullptr;
+		int32 Parent = NullNode;	// 해제된 노드에서는 free list의 다음 노드
+		int32 Child1 = NullNode;
+		int32 Child2 = NullNode;
+		int32 Height = -1;			// 리프 = 0, 해제됨 = -1
+
+		bool IsLeaf() const { return Child1 == NullNode; }
+	};
+
+	/** @brief Traversal stack with 64 inline slots; spills to the heap only for degenerate trees. */
+	class FNodeStack
+	{
+	public:
+		void Push(int32 NodeId)
+		{
+			if (Count < InlineCapacity)
+			{
+				Inline[Count++] = NodeId;
+				return;
+			}
+			Overflow.push_back(NodeId);
+			++Count;
+		}
+
+		int32 Pop()
+		{
+			--Count;
+			if (Count < InlineCapacity)
+				return Inline[Count];
+
+			const int32 NodeId = Overflow.back();
+			Overflow.pop_back();
+			return NodeId;
+		}
+
+		bool IsEmpty() const { return Count == 0; }
+
+	private:
+		static constexpr int32 InlineCapacity = 64;
+		int32 Inline[InlineCapacity];
+		TArray<int32> Overflow;
+		int32 Count = 0;
+	};
+
+	int32 AllocateNode();
+	void FreeNode(int32 NodeId);
+
+	void InsertLeaf(int32 Leaf);
+	void RemoveLeaf(int32 Leaf);
+	/** @brief Rotates the taller grandchild up if the node is unbalanced; returns the subtree's new root. */
+	int32 Balance(int32 NodeId);
+	/** @brief Recomputes heights and boxes from NodeId to the root, balancing on the way. */
+	void FixUpwards(int32 NodeId);
+
+	void ValidateNode(int32 NodeId) const;
+
+	template <typename TCallback>
+	bool VisitLeaves(int32 SubtreeRoot, TCallback& Callback) const
+	{
+		FNodeStack Stack;
+		Stack.Push(SubtreeRoot);
+		while (!Stack.IsEmpty())
+		{
+			const int32 NodeId = Stack.Pop();
+			const FTreeNode& Node = Nodes[NodeId];
+			if (Node.IsLeaf())
+			{
+				if (!Callback(NodeId))
+					return false;
+			}
+			else
+			{
+				Stack.Push(Node.Child1);
+				Stack.Push(Node.Child2);
+			}
+		}
+		return true;
+	}
+
+	TArray<FTreeNode> Nodes;
+	int32 Root = NullNode;
+	int32 FreeList = NullNode;
+	int32 ProxyCount = 0;
+	float Margin;
+};
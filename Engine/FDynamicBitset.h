@@ -1,85 +1,469 @@
 ﻿#pragma once
 #include <algorithm>
+#include <cstring>
 #include "TArray.h"
 #include "UEngineStatics.h"
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// SIMD 선택: SSE2는 x86/x64 기본이라 컴파일 타임에 정하고,
+// AVX2 커널은 빌드 옵션(/arch:AVX2)과 무관하게 함께 컴파일한 뒤 실행 시 cpuid 결과로 고름
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define BITSET_USE_SSE2 1
+#define BITSET_USE_AVX2 1
+#else
+#define BITSET_USE_SSE2 0
+#define BITSET_USE_AVX2 0
+#endif
+
+// MSVC는 /arch 없이도 AVX2 내장 함수를 허용하지만 GCC/Clang은 함수 단위로 대상을 지정해야 함
+#if BITSET_USE_AVX2 && (defined(__GNUC__) || defined(__clang__))
+#define BITSET_AVX2_TARGET __attribute__((target("avx2")))
+#else
+#define BITSET_AVX2_TARGET
+#endif
+
+/**
+ * @brief Portable bit intrinsics and SIMD word-array kernels used by FDynamicBitset
+ */
+struct FBitOps
+{
+	static uint32 PopCount64(uint64 value)
+	{
+#if defined(_MSC_VER) && defined(_M_X64)
+		return static_cast<uint32>(__popcnt64(value));
+#elif defined(_MSC_VER)
+		return __popcnt(static_cast<uint32>(value)) + __popcnt(static_cast<uint32>(value >> 32));
+#else
+		return static_cast<uint32>(__builtin_popcountll(value));
+#endif
+	}
+
+	/** @note: value must be non-zero. */
+	static uint32 CountTrailingZeros64(uint64 value)
+	{
+#if defined(_MSC_VER) && defined(_M_X64)
+		unsigned long index;
+		_BitScanForward64(&index, value);
+		return static_cast<uint32>(index);
+#elif defined(_MSC_VER)
+		unsigned long index;
+		if (_BitScanForward(&index, static_cast<uint32>(value)))
+			return static_cast<uint32>(index);
+		_BitScanForward(&index, static_cast<uint32>(value >> 32));
+		return static_cast<uint32>(index) + 32;
+#else
+		return static_cast<uint32>(__builtin_ctzll(value));
+#endif
+	}
+
+	/** @brief Whether the CPU and OS support AVX2 (cpuid leaf 7 plus YMM state saving). */
+	static bool HasAVX2()
+	{
+#if BITSET_USE_AVX2 && defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7) return false;
+
+		// OSXSAVE와 AVX 비트, 그리고 OS가 문맥 전환 때 YMM 레지스터를 저장하는지 (XCR0 비트 1, 2)
+		__cpuid(info, 1);
+		const bool bOSSavesYMM = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 0x6) == 0x6;
+		if (!bOSSavesYMM) return false;
+
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+#elif BITSET_USE_AVX2
+		return __builtin_cpu_supports("avx2");
+#else
+		return false;
+#endif
+	}
+
+	/**
+	 * @brief Bulk operations take the AVX2 kernels when set; initialized from HasAVX2().
+	 * @note: Reads false (SSE2 path) during static initialization before its own initializer runs.
+	 *        Tests clear it to exercise the SSE2 path on AVX2 machines.
+	 */
+	static inline bool bUseAVX2 = HasAVX2();
+
+	enum class EOp { And, Or, AndNot, Xor };
+
+	/** @brief dst[i] = dst[i] (op) src[i] for i in [0, count) */
+	template<EOp Op>
+	static void Apply(uint64* dst, const uint64* src, size_t count)
+	{
+		size_t i = 0;
+#if BITSET_USE_AVX2
+		if (bUseAVX2)
+		{
+			i = ApplyAVX2<Op>(dst, src, count);
+		}
+#endif
+#if BITSET_USE_SSE2
+		for (; i + 2 <= count; i += 2)
+		{
+			__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+			__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), Combine128<Op>(a, b));
+		}
+#endif
+		for (; i < count; ++i)
+		{
+			dst[i] = Combine64<Op>(dst[i], src[i]);
+		}
+	}
+
+	static bool AnySet(const uint64* words, size_t count)
+	{
+		size_t i = 0;
+#if BITSET_USE_AVX2
+		if (bUseAVX2)
+		{
+			if (AnySetAVX2(words, count)) return true;
+			i = count & ~static_cast<size_t>(3);
+		}
+#endif
+#if BITSET_USE_SSE2
+		__m128i acc128 = _mm_setzero_si128();
+		for (; i + 2 <= count; i += 2)
+		{
+			acc128 = _mm_or_si128(acc128, _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i)));
+		}
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(acc128, _mm_setzero_si128())) != 0xFFFF) return true;
+#endif
+		uint64 acc = 0;
+		for (; i < count; ++i)
+		{
+			acc |= words[i];
+		}
+		return acc != 0;
+	}
+
+	static size_t CountSet(const uint64* words, size_t count)
+	{
+		// 하드웨어 popcnt가 워드당 1사이클이라 4개씩 펼쳐 의존성만 끊음
+		size_t c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			c0 += PopCount64(words[i]);
+			c1 += PopCount64(words[i + 1]);
+			c2 += PopCount64(words[i + 2]);
+			c3 += PopCount64(words[i + 3]);
+		}
+		for (; i < count; ++i)
+		{
+			c0 += PopCount64(words[i]);
+		}
+		return c0 + c1 + c2 + c3;
+	}
+
+private:
+	template<EOp Op>
+	static uint64 Combine64(uint64 a, uint64 b)
+	{
+		if constexpr (Op == EOp::And) return a & b;
+		else if constexpr (Op == EOp::Or) return a | b;
+		else if constexpr (Op == EOp::AndNot) return a & ~b;
+		else return a ^ b;
+	}
+
+#if BITSET_USE_SSE2
+	template<EOp Op>
+	static __m128i Combine128(__m128i a, __m128i b)
+	{
+		if constexpr (Op == EOp::And) return _mm_and_si128(a, b);
+		else if constexpr (Op == EOp::Or) return _mm_or_si128(a, b);
+		else if constexpr (Op == EOp::AndNot) return _mm_andnot_si128(b, a);
+		else return _mm_xor_si128(a, b);
+	}
+#endif
+
+#if BITSET_USE_AVX2
+	template<EOp Op>
+	BITSET_AVX2_TARGET static __m256i Combine256(__m256i a, __m256i b)
+	{
+		if constexpr (Op == EOp::And) return _mm256_and_si256(a, b);
+		else if constexpr (Op == EOp::Or) return _mm256_or_si256(a, b);
+		else if constexpr (Op == EOp::AndNot) return _mm256_andnot_si256(b, a);
+		else return _mm256_xor_si256(a, b);
+	}
+
+	/** @return Number of leading words processed (count rounded down to a multiple of 4). */
+	template<EOp Op>
+	BITSET_AVX2_TARGET static size_t ApplyAVX2(uint64* dst, const uint64* src, size_t count)
+	{
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+			__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), Combine256<Op>(a, b));
+		}
+		return i;
+	}
+
+	/** @brief AnySet over the leading words in multiples of 4. */
+	BITSET_AVX2_TARGET static bool AnySetAVX2(const uint64* words, size_t count)
+	{
+		__m256i acc = _mm256_setzero_si256();
+		for (size_t i = 0; i + 4 <= count; i += 4)
+		{
+			acc = _mm256_or_si256(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i)));
+		}
+		return !_mm256_testz_si256(acc, acc);
+	}
+#endif
+};
+
+/**
+ * @brief Growable bitset with inline storage for the first 128 bits
+ *
+ * Indices past the current size read as 0; Set/SetRange grow the storage on demand.
+ * Bulk operators run through FBitOps: AVX2 when the CPU has it, else SSE2 or scalar code.
+ */
 struct FDynamicBitset
 {
-	TArray<uint64> Data;
+	static constexpr size_t InlineWords = 2;
+
+	FDynamicBitset() = default;
 
 	void Set(size_t idx)
 	{
 		size_t chunk = idx / 64;
-		if (chunk >= Data.size())
+		if (chunk >= NumWords())
 		{
 			Resize(chunk + 1); // chunk 포함하도록 크기 확장
 		}
 
-		Data[chunk] |= 1ULL << (idx % 64);
+		GetData()[chunk] |= 1ULL << (idx % 64);
 	}
 
 	void Reset(size_t idx)
 	{
 		size_t chunk = idx / 64;
-		if (chunk >= Data.size())
-		{
-			Resize(chunk + 1);
-		}
+		if (chunk >= NumWords()) return; // 범위 밖은 이미 0
 
-		Data[chunk] &= ~(1ULL << (idx % 64));
+		GetData()[chunk] &= ~(1ULL << (idx % 64));
 	}
 
 	bool Test(size_t idx) const
 	{
 		size_t chunk = idx / 64;
-		if (chunk >= Data.size()) return false;
-		return (Data[chunk] & (1ULL << (idx % 64))) != 0;
+		if (chunk >= NumWords()) return false;
+		return (GetData()[chunk] & (1ULL << (idx % 64))) != 0;
 	}
 
-	void Clear() { std::fill(Data.begin(), Data.end(), 0); }
+	/** @brief Sets bits in [begin, end). */
+	void SetRange(size_t begin, size_t end)
+	{
+		if (begin >= end) return;
+		Resize((end + 63) / 64);
+		FillRange(begin, end, true);
+	}
+
+	/** @brief Clears bits in [begin, end). */
+	void ResetRange(size_t begin, size_t end)
+	{
+		end = (std::min)(end, NumWords() * 64);
+		if (begin >= end) return;
+		FillRange(begin, end, false);
+	}
+
+	void Clear()
+	{
+		if (NumWords() > 0)
+		{
+			memset(GetData(), 0, NumWords() * sizeof(uint64));
+		}
+	}
 
 	void Reserve(int n) {
-		int chunkCount = (n + 63) / 64;
-		Data.reserve(chunkCount);
+		size_t chunkCount = (static_cast<size_t>(n) + 63) / 64;
+		if (chunkCount > InlineWords)
+		{
+			HeapData.reserve(chunkCount);
+		}
 	}
 
-	size_t Count() const {
-		size_t count = 0;
-		for (auto block : Data)
-			count += __popcnt64(block); // GCC/Clang
-		return count;
+	size_t Count() const { return FBitOps::CountSet(GetData(), NumWords()); }
+
+	bool Any() const { return FBitOps::AnySet(GetData(), NumWords()); }
+
+	/** @return Index of the first set bit at or after start, or NoIndex. */
+	size_t FindNextSetBit(size_t start) const
+	{
+		size_t chunk = start / 64;
+		const size_t wordCount = NumWords();
+		if (chunk >= wordCount) return NoIndex;
+
+		const uint64* words = GetData();
+		uint64 word = words[chunk] & (~0ULL << (start % 64));
+		while (word == 0)
+		{
+			if (++chunk >= wordCount) return NoIndex;
+			word = words[chunk];
+		}
+		return chunk * 64 + FBitOps::CountTrailingZeros64(word);
 	}
 
+	/** @brief Calls func(index) for every set bit in ascending order. */
+	template<typename FuncType>
+	void ForEachSetBit(FuncType&& func) const
+	{
+		const uint64* words = GetData();
+		const size_t wordCount = NumWords();
+		for (size_t chunk = 0; chunk < wordCount; ++chunk)
+		{
+			uint64 word = words[chunk];
+			while (word != 0)
+			{
+				func(chunk * 64 + FBitOps::CountTrailingZeros64(word));
+				word &= word - 1; // 최하위 1비트 제거
+			}
+		}
+	}
 
 	FDynamicBitset& operator|=(const FDynamicBitset& other)
 	{
-		if (other.Data.size() > Data.size())
+		if (other.NumWords() > NumWords())
 		{
-			Resize(other.Data.size());
+			Resize(other.NumWords());
 		}
-		for (size_t i = 0; i < Data.size(); ++i)
-			Data[i] |= other.Data[i];
+		FBitOps::Apply<FBitOps::EOp::Or>(GetData(), other.GetData(), other.NumWords());
 		return *this;
 	}
 
 	FDynamicBitset& operator&=(const FDynamicBitset& other)
 	{
-		size_t minSize = min(Data.size(), other.Data.size());
-		for (size_t i = 0; i < minSize; ++i)
-			Data[i] &= other.Data[i];
+		size_t minSize = (std::min)(NumWords(), other.NumWords());
+		FBitOps::Apply<FBitOps::EOp::And>(GetData(), other.GetData(), minSize);
 
 		// 나머지 블록은 0으로 초기화
-		for (size_t i = minSize; i < Data.size(); ++i)
-			Data[i] = 0;
+		if (NumWords() > minSize)
+		{
+			memset(GetData() + minSize, 0, (NumWords() - minSize) * sizeof(uint64));
+		}
+
+		return *this;
+	}
+
+	FDynamicBitset& operator^=(const FDynamicBitset& other)
+	{
+		if (other.NumWords() > NumWords())
+		{
+			Resize(other.NumWords());
+		}
+		FBitOps::Apply<FBitOps::EOp::Xor>(GetData(), other.GetData(), other.NumWords());
+		return *this;
+	}
 
+	/** @brief Clears every bit that is set in other (this &= ~other). */
+	FDynamicBitset& AndNot(const FDynamicBitset& other)
+	{
+		size_t minSize = (std::min)(NumWords(), other.NumWords());
+		FBitOps::Apply<FBitOps::EOp::AndNot>(GetData(), other.GetData(), minSize);
 		return *this;
 	}
 
+	/** @brief Grows to at least size 64-bit words. New words are zero; never shrinks. */
 	void Resize(size_t size)
 	{
-		if (Data.size() < size)
+		if (size <= WordCount) return;
+
+		if (size > InlineWords)
+		{
+			if (WordCount <= InlineWords)
+			{
+				// 인라인 → 힙 이동
+				HeapData.assign(InlineData, InlineData + WordCount);
+			}
+			HeapData.resize(size, 0); // push_back 대신 resize 사용
+		}
+		WordCount = size;
+	}
+
+	size_t NumWords() const { return WordCount; }
+	size_t NumBits() const { return WordCount * 64; }
+
+	uint64* GetData() { return WordCount <= InlineWords ? InlineData : HeapData.data(); }
+	const uint64* GetData() const { return WordCount <= InlineWords ? InlineData : HeapData.data(); }
+
+	static constexpr size_t NoIndex = static_cast<size_t>(-1);
+
+private:
+	void FillRange(size_t begin, size_t end, bool value)
+	{
+		uint64* words = GetData();
+		const size_t firstChunk = begin / 64;
+		const size_t lastChunk = (end - 1) / 64;
+		const uint64 firstMask = ~0ULL << (begin % 64);
+		const uint64 lastMask = ~0ULL >> (63 - (end - 1) % 64);
+
+		if (firstChunk == lastChunk)
+		{
+			const uint64 mask = firstMask & lastMask;
+			words[firstChunk] = value ? (words[firstChunk] | mask) : (words[firstChunk] & ~mask);
+			return;
+		}
+
+		words[firstChunk] = value ? (words[firstChunk] | firstMask) : (words[firstChunk] & ~firstMask);
+		if (lastChunk > firstChunk + 1)
+		{
+			// 가운데 워드는 memset이 벡터화된 채우기로 처리
+			memset(words + firstChunk + 1, value ? 0xFF : 0x00, (lastChunk - firstChunk - 1) * sizeof(uint64));
+		}
+		words[lastChunk] = value ? (words[lastChunk] | lastMask) : (words[lastChunk] & ~lastMask);
+	}
+
+	// @note: WordCount <= InlineWords이면 InlineData, 아니면 HeapData가 유효
+	uint64 InlineData[InlineWords] = { 0, 0 };
+	TArray<uint64> HeapData;
+	size_t WordCount = 0;
+};
+
+/**
+ * @brief Iterates the set bits of an FDynamicBitset in ascending order.
+ * @note: Usage: for (FConstSetBitIterator It(bits); It; ++It) { It.GetIndex(); }
+ */
+class FConstSetBitIterator
+{
+public:
+	explicit FConstSetBitIterator(const FDynamicBitset& InBitset, size_t StartIndex = 0)
+		: Words(InBitset.GetData()), WordCount(InBitset.NumWords()), Chunk(StartIndex / 64)
+	{
+		if (Chunk < WordCount)
+		{
+			Current = Words[Chunk] & (~0ULL << (StartIndex % 64));
+		}
+		Advance();
+	}
+
+	explicit operator bool() const { return Chunk < WordCount; }
+	size_t GetIndex() const { return Chunk * 64 + FBitOps::CountTrailingZeros64(Current); }
+
+	FConstSetBitIterator& operator++()
+	{
+		Current &= Current - 1;
+		Advance();
+		return *this;
+	}
+
+private:
+	void Advance()
+	{
+		while (Current == 0)
 		{
-			Data.resize(size, 0); // push_back 대신 resize 사용
+			if (++Chunk >= WordCount) return;
+			Current = Words[Chunk];
 		}
 	}
-};
\ No newline at end of file
+
+	const uint64* Words;
+	size_t WordCount;
+	size_t Chunk;
+	uint64 Current = 0;
+};
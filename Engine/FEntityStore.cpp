@@ -0,0 +1,318 @@
+﻿#include "stdafx.h"
+#include "FEntityStore.h"
+#include "FDynamicBitset.h"
+#include <atomic>
+#include <mutex>
+#include <new>
+
+namespace
+{
+	// 고정 크기 배열이라 등록된 항목은 잠금 없이 읽을 수 있음 (등록만 직렬화)
+	FComponentTypeRegistry::FInfo TypeInfos[FComponentTypeRegistry::MaxTypes];
+	std::atomic<uint32> NumTypes{ 0 };
+
+	std::mutex& GetTypeMutex()
+	{
+		static std::mutex Mutex;
+		return Mutex;
+	}
+
+	uint32 AlignUp(uint32 Value, uint32 Alignment)
+	{
+		return (Value + Alignment - 1) & ~(Alignment - 1);
+	}
+
+	uint8* AllocateChunkMemory()
+	{
+		return static_cast<uint8*>(::operator new(FEntityStore::ChunkSize, std::align_val_t(FEntityStore::ColumnAlignment)));
+	}
+
+	void FreeChunkMemory(uint8* Data)
+	{
+		::operator delete(Data, std::align_val_t(FEntityStore::ColumnAlignment));
+	}
+}
+
+FComponentTypeId FComponentTypeRegistry::Register(uint32 Size, uint32 Alignment, const char* Name)
+{
+	std::lock_guard<std::mutex> Lock(GetTypeMutex());
+	const uint32 Id = NumTypes.load(std::memory_order_relaxed);
+	assert(Id < MaxTypes && "Too many FEntityStore component types");
+	assert(Alignment <= FEntityStore::ColumnAlignment);
+
+	TypeInfos[Id] = { Size, Alignment, Name };
+	NumTypes.store(Id + 1, std::memory_order_release);
+	return Id;
+}
+
+const FComponentTypeRegistry::FInfo& FComponentTypeRegistry::Get(FComponentTypeId Id)
+{
+	assert(Id < NumTypes.load(std::memory_order_acquire));
+	return TypeInfos[Id];
+}
+
+uint32 FComponentTypeRegistry::Num()
+{
+	return NumTypes.load(std::memory_order_acquire);
+}
+
+FEntityStore::FEntityStore()
+{
+	// 빈 마스크 아키타입은 항상 0번
+	FindOrCreateArchetype(0);
+}
+
+FEntityStore::~FEntityStore()
+{
+	for (FArchetype& Archetype : Archetypes)
+	{
+		for (FChunk& Chunk : Archetype.Chunks)
+		{
+			FreeChunkMemory(Chunk.Data);
+		}
+	}
+}
+
+uint32 FEntityStore::FindOrCreateArchetype(FComponentMask Mask)
+{
+	auto It = ArchetypeByMask.find(Mask);
+	if (It != ArchetypeByMask.end())
+		return It->second;
+
+	FArchetype Archetype;
+	Archetype.Mask = Mask;
+	for (uint32& Offset : Archetype.ColumnOffsets)
+	{
+		Offset = UINT_MAX;
+	}
+
+	uint32 BytesPerEntity = sizeof(FEntity);
+	for (FComponentMask Bits = Mask; Bits; Bits &= Bits - 1)
+	{
+		BytesPerEntity += FComponentTypeRegistry::Get(FBitOps::CountTrailingZeros64(Bits)).Size;
+	}
+
+	// 컬럼 정렬 패딩을 감안해 들어갈 때까지 용량을 줄여 가며 배치
+	Archetype.Capacity = ChunkSize / BytesPerEntity;
+	for (;;)
+	{
+		uint32 Offset = AlignUp(sizeof(FEntity) * Archetype.Capacity, ColumnAlignment);
+		for (FComponentMask Bits = Mask; Bits; Bits &= Bits - 1)
+		{
+			const FComponentTypeId Type = FBitOps::CountTrailingZeros64(Bits);
+			Archetype.ColumnOffsets[Type] = Offset;
+			Offset = AlignUp(Offset + FComponentTypeRegistry::Get(Type).Size * Archetype.Capacity, ColumnAlignment);
+		}
+		if (Offset <= ChunkSize)
+			break;
+		--Archetype.Capacity;
+	}
+	assert(Archetype.Capacity > 0 && "Archetype does not fit in a chunk");
+
+	const uint32 Index = static_cast<uint32>(Archetypes.size());
+	Archetypes.push_back(std::move(Archetype));
+	ArchetypeByMask.emplace(Mask, Index);
+	return Index;
+}
+
+FEntity FEntityStore::CreateWithMask(FComponentMask Mask)
+{
+	assert(IterationDepth == 0 && "Structural change inside an FEntityStore query");
+
+	uint32 Index;
+	if (FreeList != UINT_MAX)
+	{
+		Index = FreeList;
+		FreeList = Records[Index].Row;
+	}
+	else
+	{
+		Index = static_cast<uint32>(Records.size());
+		Records.emplace_back();
+	}
+
+	const FEntity Entity{ Index, Records[Index].Generation };
+	AllocateRow(FindOrCreateArchetype(Mask), Entity);
+	++NumAlive;
+	return Entity;
+}
+
+void FEntityStore::Destroy(FEntity Entity)
+{
+	assert(IterationDepth == 0 && "Structural change inside an FEntityStore query");
+	if (!IsAlive(Entity))
+		return;
+
+	FRecord& Record = Records[Entity.Index];
+	FreeRow(Record);
+
+	Record.Archetype = UINT_MAX;
+	++Record.Generation;
+	Record.Row = FreeList;
+	FreeList = Entity.Index;
+	--NumAlive;
+}
+
+bool FEntityStore::IsAlive(FEntity Entity) const
+{
+	return Entity.Index < Records.size()
+		&& Records[Entity.Index].Archetype != UINT_MAX
+		&& Records[Entity.Index].Generation == Entity.Generation;
+}
+
+void FEntityStore::Clear()
+{
+	assert(IterationDepth == 0 && "Structural change inside an FEntityStore query");
+
+	for (FArchetype& Archetype : Archetypes)
+	{
+		for (FChunk& Chunk : Archetype.Chunks)
+		{
+			FreeChunkMemory(Chunk.Data);
+		}
+		Archetype.Chunks.clear();
+		Archetype.NumEntities = 0;
+	}
+
+	// 세대는 유지해서 Clear 이전 핸들이 되살아나지 않게 함
+	FreeList = UINT_MAX;
+	for (uint32 Index = static_cast<uint32>(Records.size()); Index-- > 0;)
+	{
+		FRecord& Record = Records[Index];
+		if (Record.Archetype != UINT_MAX)
+		{
+			Record.Archetype = UINT_MAX;
+			++Record.Generation;
+		}
+		Record.Row = FreeList;
+		FreeList = Index;
+	}
+	NumAlive = 0;
+}
+
+FComponentMask FEntityStore::GetMask(FEntity Entity) const
+{
+	assert(IsAlive(Entity));
+	return Archetypes[Records[Entity.Index].Archetype].Mask;
+}
+
+uint32 FEntityStore::NumChunks() const
+{
+	uint32 Total = 0;
+	for (const FArchetype& Archetype : Archetypes)
+	{
+		Total += static_cast<uint32>(Archetype.Chunks.size());
+	}
+	return Total;
+}
+
+void FEntityStore::AllocateRow(uint32 ArchetypeIndex, FEntity Entity)
+{
+	FArchetype& Archetype = Archetypes[ArchetypeIndex];
+	if (Archetype.Chunks.empty() || Archetype.Chunks.back().Count == Archetype.Capacity)
+	{
+		Archetype.Chunks.push_back({ AllocateChunkMemory(), 0 });
+	}
+
+	const uint32 ChunkIndex = static_cast<uint32>(Archetype.Chunks.size() - 1);
+	FChunk& Chunk = Archetype.Chunks.back();
+	const uint32 Row = Chunk.Count++;
+	++Archetype.NumEntities;
+
+	GetEntityColumn(Archetype, Chunk)[Row] = Entity;
+	for (FComponentMask Bits = Archetype.Mask; Bits; Bits &= Bits - 1)
+	{
+		const FComponentTypeId Type = FBitOps::CountTrailingZeros64(Bits);
+		const uint32 Size = FComponentTypeRegistry::Get(Type).Size;
+		memset(Chunk.Data + Archetype.ColumnOffsets[Type] + Size * Row, 0, Size);
+	}
+
+	FRecord& Record = Records[Entity.Index];
+	Record.Archetype = ArchetypeIndex;
+	Record.Chunk = ChunkIndex;
+	Record.Row = Row;
+}
+
+void FEntityStore::FreeRow(const FRecord& Record)
+{
+	FArchetype& Archetype = Archetypes[Record.Archetype];
+	FChunk& LastChunk = Archetype.Chunks.back();
+	const uint32 LastRow = LastChunk.Count - 1;
+	FChunk& Chunk = Archetype.Chunks[Record.Chunk];
+
+	// 마지막 엔티티를 빈 자리로 옮겨 청크를 꽉 찬 상태로 유지
+	if (&Chunk != &LastChunk || Record.Row != LastRow)
+	{
+		const FEntity Moved = GetEntityColumn(Archetype, LastChunk)[LastRow];
+		GetEntityColumn(Archetype, Chunk)[Record.Row] = Moved;
+		for (FComponentMask Bits = Archetype.Mask; Bits; Bits &= Bits - 1)
+		{
+			const FComponentTypeId Type = FBitOps::CountTrailingZeros64(Bits);
+			const uint32 Size = FComponentTypeRegistry::Get(Type).Size;
+			const uint32 Offset = Archetype.ColumnOffsets[Type];
+			memcpy(Chunk.Data + Offset + Size * Record.Row, LastChunk.Data + Offset + Size * LastRow, Size);
+		}
+
+		FRecord& MovedRecord = Records[Moved.Index];
+		MovedRecord.Chunk = Record.Chunk;
+		MovedRecord.Row = Record.Row;
+	}
+
+	--Archetype.NumEntities;
+	if (--LastChunk.Count == 0)
+	{
+		FreeChunkMemory(LastChunk.Data);
+		Archetype.Chunks.pop_back();
+	}
+}
+
+void FEntityStore::ChangeMask(FEntity Entity, FComponentMask NewMask)
+{
+	assert(IterationDepth == 0 && "Structural change inside an FEntityStore query");
+	assert(IsAlive(Entity));
+
+	const FRecord OldRecord = Records[Entity.Index];
+	if (Archetypes[OldRecord.Archetype].Mask == NewMask)
+		return;
+
+	// AllocateRow가 Archetypes를 키울 수 있으므로 인덱스로만 접근
+	const uint32 NewArchetypeIndex = FindOrCreateArchetype(NewMask);
+	AllocateRow(NewArchetypeIndex, Entity);
+
+	const FArchetype& OldArchetype = Archetypes[OldRecord.Archetype];
+	const FArchetype& NewArchetype = Archetypes[NewArchetypeIndex];
+	const FRecord& NewRecord = Records[Entity.Index];
+	const uint8* Src = OldArchetype.Chunks[OldRecord.Chunk].Data;
+	uint8* Dst = NewArchetype.Chunks[NewRecord.Chunk].Data;
+
+	for (FComponentMask Bits = OldArchetype.Mask & NewMask; Bits; Bits &= Bits - 1)
+	{
+		const FComponentTypeId Type = FBitOps::CountTrailingZeros64(Bits);
+		const uint32 Size = FComponentTypeRegistry::Get(Type).Size;
+		memcpy(Dst + NewArchetype.ColumnOffsets[Type] + Size * NewRecord.Row,
+			Src + OldArchetype.ColumnOffsets[Type] + Size * OldRecord.Row, Size);
+	}
+
+	FreeRow(OldRecord);
+}
+
+void* FEntityStore::GetComponentData(FEntity Entity, FComponentTypeId Type)
+{
+	if (!IsAlive(Entity))
+		return nullptr;
+
+	const FRecord& Record = Records[Entity.Index];
+	const FArchetype& Archetype = Archetypes[Record.Archetype];
+	if (Archetype.ColumnOffsets[Type] == UINT_MAX)
+		return nullptr;
+
+	const uint32 Size = FComponentTypeRegistry::Get(Type).Size;
+	return Archetype.Chunks[Record.Chunk].Data + Archetype.ColumnOffsets[Type] + Size * Record.Row;
+}
+
+void FEntityStore::SetComponentData(FEntity Entity, FComponentTypeId Type, const void* Value)
+{
+	void* Data = GetComponentData(Entity, Type);
+	assert(Data);
+	memcpy(Data, Value, FComponentTypeRegistry::Get(Type).Size);
+}
@@ -0,0 +1,290 @@
+﻿#pragma once
+#include "TArray.h"
+#include "UJobSystem.h"
+#include <type_traits>
+#include <typeinfo>
+
+/**
+ * @brief Handle to an entity in an FEntityStore; stale handles are detected by Generation.
+ */
+struct FEntity
+{
+	uint32 Index = UINT_MAX;
+	uint32 Generation = 0;
+
+	bool IsValid() const { return Index != UINT_MAX; }
+	bool operator==(const FEntity& Other) const { return Index == Other.Index && Generation == Other.Generation; }
+	bool operator!=(const FEntity& Other) const { return !(*this == Other); }
+};
+
+using FComponentTypeId = uint32;
+using FComponentMask = uint64;
+
+/**
+ * @brief Process-wide list of component types usable in an FEntityStore (at most MaxTypes).
+ */
+struct FComponentTypeRegistry
+{
+	static constexpr uint32 MaxTypes = 64;
+
+	struct FInfo
+	{
+		uint32 Size;
+		uint32 Alignment;
+		const char* Name;
+	};
+
+	static FComponentTypeId Register(uint32 Size, uint32 Alignment, const char* Name);
+	static const FInfo& Get(FComponentTypeId Id);
+	static uint32 Num();
+};
+
+/**
+ * @brief Id of component type T, registered on first use.
+ * @note: Columns are moved with memcpy and never destructed, so T must be trivially copyable and destructible.
+ */
+template <typename T>
+FComponentTypeId GetComponentTypeId()
+{
+	// const T도 T와 같은 ID를 쓰도록 한정자를 뗀 타입에서만 등록
+	if constexpr (!std::is_same_v<T, std::remove_cv_t<T>>)
+	{
+		return GetComponentTypeId<std::remove_cv_t<T>>();
+	}
+	else
+	{
+		static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+			"FEntityStore components must be plain data");
+		static const FComponentTypeId Id = FComponentTypeRegistry::Register(sizeof(T), alignof(T), typeid(T).name());
+		return Id;
+	}
+}
+
+template <typename... Ts>
+FComponentMask MakeComponentMask()
+{
+	return (FComponentMask(0) | ... | (FComponentMask(1) << GetComponentTypeId<Ts>()));
+}
+
+/**
+ * @brief Archetype-based entity storage
+ *
+ * Entities with the same set of component types share an archetype. An archetype stores its
+ * entities in fixed 16KB chunks, each holding one tightly packed column per component type
+ * (plus the entity handles), so a query walks contiguous arrays with no per-entity indirection
+ * or virtual call. Chunks are kept full except the last one: destroying an entity (or moving it
+ * to another archetype by adding/removing a component) fills the hole with the archetype's last
+ * entity, so rows never go stale between structural changes.
+ *
+ * @note: Structural changes (Create, Destroy, Add/RemoveComponent) invalidate column pointers and
+ *        are not allowed inside a query. Component data may be written freely.
+ */
+class FEntityStore
+{
+public:
+	static constexpr uint32 ChunkSize = 16 * 1024;
+	static constexpr uint32 ColumnAlignment = 64;	// 컬럼마다 캐시 라인 시작
+
+	FEntityStore();
+	~FEntityStore();
+
+	FEntityStore(const FEntityStore&) = delete;
+	FEntityStore& operator=(const FEntityStore&) = delete;
+
+	/** @brief Creates an entity holding the given component values. */
+	template <typename... Ts>
+	FEntity Create(const Ts&... Values)
+	{
+		const FEntity Entity = CreateWithMask(MakeComponentMask<Ts...>());
+		(SetComponentData(Entity, GetComponentTypeId<Ts>(), &Values), ...);
+		return Entity;
+	}
+
+	/** @brief Creates an entity whose components (types in Mask) are zero-filled. */
+	FEntity CreateWithMask(FComponentMask Mask);
+	void Destroy(FEntity Entity);
+	bool IsAlive(FEntity Entity) const;
+	/** @brief Destroys every entity and releases all chunks (archetypes are kept). */
+	void Clear();
+
+	template <typename T>
+	void AddComponent(FEntity Entity, const T& Value = T())
+	{
+		const FComponentTypeId Type = GetComponentTypeId<T>();
+		ChangeMask(Entity, GetMask(Entity) | (FComponentMask(1) << Type));
+		SetComponentData(Entity, Type, &Value);
+	}
+
+	template <typename T>
+	void RemoveComponent(FEntity Entity)
+	{
+		ChangeMask(Entity, GetMask(Entity) & ~(FComponentMask(1) << GetComponentTypeId<T>()));
+	}
+
+	template <typename T>
+	bool HasComponent(FEntity Entity) const
+	{
+		return (GetMask(Entity) & (FComponentMask(1) << GetComponentTypeId<T>())) != 0;
+	}
+
+	/** @brief Pointer to the entity's T, or nullptr if it has none. Valid until the next structural change. */
+	template <typename T>
+	T* GetComponent(FEntity Entity)
+	{
+		return static_cast<T*>(GetComponentData(Entity, GetComponentTypeId<T>()));
+	}
+
+	FComponentMask GetMask(FEntity Entity) const;
+
+	/**
+	 * @brief Calls Fn(const FEntity* Entities, uint32 Count, Ts*... Columns) for every chunk whose
+	 *        archetype has all of Ts and none of ExcludeMask.
+	 */
+	template <typename... Ts, typename TFn>
+	void ForEachChunk(TFn&& Fn, FComponentMask ExcludeMask = 0)
+	{
+		const FComponentMask Required = MakeComponentMask<Ts...>();
+		++IterationDepth;
+		for (FArchetype& Archetype : Archetypes)
+		{
+			if (!Matches(Archetype, Required, ExcludeMask))
+				continue;
+
+			for (const FChunk& Chunk : Archetype.Chunks)
+			{
+				Fn(GetEntityColumn(Archetype, Chunk), Chunk.Count, GetColumn<Ts>(Archetype, Chunk)...);
+			}
+		}
+		--IterationDepth;
+	}
+
+	/** @brief Calls Fn(FEntity, Ts&...) for every matching entity. */
+	template <typename... Ts, typename TFn>
+	void ForEach(TFn&& Fn, FComponentMask ExcludeMask = 0)
+	{
+		ForEachChunk<Ts...>([&Fn](const FEntity* Entities, uint32 Count, Ts*... Columns) {
+			for (uint32 Row = 0; Row < Count; ++Row)
+			{
+				Fn(Entities[Row], Columns[Row]...);
+			}
+		}, ExcludeMask);
+	}
+
+	/**
+	 * @brief ForEachChunk with the chunks spread over the job system.
+	 * @note: Fn runs concurrently on different chunks; it must only write the rows it is given.
+	 */
+	template <typename... Ts, typename TFn>
+	void ParallelForEachChunk(UJobSystem& JobSystem, TFn&& Fn, FComponentMask ExcludeMask = 0)
+	{
+		const FComponentMask Required = MakeComponentMask<Ts...>();
+		ParallelChunks.clear();
+		for (uint32 ArchetypeIndex = 0; ArchetypeIndex < Archetypes.size(); ++ArchetypeIndex)
+		{
+			if (!Matches(Archetypes[ArchetypeIndex], Required, ExcludeMask))
+				continue;
+
+			for (uint32 ChunkIndex = 0; ChunkIndex < Archetypes[ArchetypeIndex].Chunks.size(); ++ChunkIndex)
+			{
+				ParallelChunks.push_back({ ArchetypeIndex, ChunkIndex });
+			}
+		}
+
+		++IterationDepth;
+		JobSystem.ParallelFor(static_cast<uint32>(ParallelChunks.size()), 1, [this, &Fn](uint32 Start, uint32 End) {
+			for (uint32 i = Start; i < End; ++i)
+			{
+				FArchetype& Archetype = Archetypes[ParallelChunks[i].Archetype];
+				const FChunk& Chunk = Archetype.Chunks[ParallelChunks[i].Chunk];
+				Fn(GetEntityColumn(Archetype, Chunk), Chunk.Count, GetColumn<Ts>(Archetype, Chunk)...);
+			}
+		});
+		--IterationDepth;
+	}
+
+	/** @brief Number of entities that have all of Ts. */
+	template <typename... Ts>
+	uint32 Count(FComponentMask ExcludeMask = 0) const
+	{
+		const FComponentMask Required = MakeComponentMask<Ts...>();
+		uint32 Total = 0;
+		for (const FArchetype& Archetype : Archetypes)
+		{
+			if (Matches(Archetype, Required, ExcludeMask))
+			{
+				Total += Archetype.NumEntities;
+			}
+		}
+		return Total;
+	}
+
+	uint32 Num() const { return NumAlive; }
+	uint32 NumArchetypes() const { return static_cast<uint32>(Archetypes.size()); }
+	uint32 NumChunks() const;
+
+private:
+	struct FChunk
+	{
+		uint8* Data = nullptr;
+		uint32 Count = 0;
+	};
+
+	struct FArchetype
+	{
+		FComponentMask Mask = 0;
+		uint32 Capacity = 0;			// 청크당 엔티티 수
+		uint32 NumEntities = 0;
+		uint32 ColumnOffsets[FComponentTypeRegistry::MaxTypes];	// 타입 ID → 청크 내 오프셋 (없으면 UINT_MAX)
+		TArray<FChunk> Chunks;			// 마지막 청크 외에는 가득 참
+	};
+
+	struct FRecord
+	{
+		uint32 Archetype = UINT_MAX;	// UINT_MAX = 해제된 슬롯
+		uint32 Chunk = 0;
+		uint32 Row = 0;
+		uint32 Generation = 0;
+	};
+
+	struct FChunkRef
+	{
+		uint32 Archetype;
+		uint32 Chunk;
+	};
+
+	static bool Matches(const FArchetype& Archetype, FComponentMask Required, FComponentMask Exclude)
+	{
+		return Archetype.NumEntities > 0 && (Archetype.Mask & Required) == Required && (Archetype.Mask & Exclude) == 0;
+	}
+
+	static FEntity* GetEntityColumn(const FArchetype&, const FChunk& Chunk)
+	{
+		return reinterpret_cast<FEntity*>(Chunk.Data);
+	}
+
+	template <typename T>
+	static T* GetColumn(const FArchetype& Archetype, const FChunk& Chunk)
+	{
+		return reinterpret_cast<T*>(Chunk.Data + Archetype.ColumnOffsets[GetComponentTypeId<T>()]);
+	}
+
+	uint32 FindOrCreateArchetype(FComponentMask Mask);
+	/** @brief Appends a zero-filled row for Entity to the archetype's last chunk (allocating one if full). */
+	void AllocateRow(uint32 ArchetypeIndex, FEntity Entity);
+	/** @brief Fills the record's row with the archetype's last entity and shrinks the archetype by one. */
+	void FreeRow(const FRecord& Record);
+	void ChangeMask(FEntity Entity, FComponentMask NewMask);
+
+	void* GetComponentData(FEntity Entity, FComponentTypeId Type);
+	void SetComponentData(FEntity Entity, FComponentTypeId Type, const void* Value);
+
+	TArray<FArchetype> Archetypes;
+	TMap<FComponentMask, uint32> ArchetypeByMask;
+
+	TArray<FRecord> Records;
+	uint32 FreeList = UINT_MAX;	// 해제된 레코드의 Row에 다음 인덱스를 저장
+	uint32 NumAlive = 0;
+
+	TArray<FChunkRef> ParallelChunks;	// ParallelForEachChunk 임시 버퍼
+	uint32 IterationDepth = 0;
+};
@@ -0,0 +1,209 @@
+﻿#include "stdafx.h"
+#include "FName.h"
+
+namespace
+{
+	/** @note: Suffixes longer than this could overflow int32 once stored as Number + 1. */
+	constexpr uint32 MaxSuffixDigits = 9;
+
+	inline char ToLowerAscii(char c)
+	{
+		return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+	}
+
+	/**
+	 * @brief Splits "Name_123" into ("Name", 124). Returns 0 when there is no valid suffix.
+	 * @note: Leading zeros ("Name_01") are kept as part of the string so they round-trip unchanged.
+	 */
+	int32 ParseNumberSuffix(const char* Str, uint32& InOutLength)
+	{
+		uint32 Digits = 0;
+		while (Digits < InOutLength && Str[InOutLength - 1 - Digits] >= '0' && Str[InOutLength - 1 - Digits] <= '9')
+		{
+			++Digits;
+		}
+
+		if (Digits == 0 || Digits > MaxSuffixDigits || Digits + 1 >= InOutLength)
+			return 0;
+
+		const uint32 UnderscorePos = InOutLength - 1 - Digits;
+		if (Str[UnderscorePos] != '_')
+			return 0;
+
+		const char* DigitStart = Str + UnderscorePos + 1;
+		if (Digits > 1 && DigitStart[0] == '0')
+			return 0;
+
+		int32 Value = 0;
+		for (uint32 i = 0; i < Digits; ++i)
+		{
+			Value = Value * 10 + (DigitStart[i] - '0');
+		}
+
+		InOutLength = UnderscorePos;
+		return Value + 1;
+	}
+}
+
+FNamePool& FNamePool::Get()
+{
+	// Function-local static: UClass registration creates UObjects (and FNames) during static initialization.
+	static FNamePool Pool;
+	return Pool;
+}
+
+FNamePool::FNamePool()
+{
+	Slots.resize(InitialSlotCount, FNameSlot{ 0, -1 });
+	SlotMask = InitialSlotCount - 1;
+
+	// Index 0 is always the empty name so default-constructed FNames never touch the table.
+	int32 ComparisonIndex;
+	Store("", 0, ComparisonIndex);
+}
+
+uint32 FNamePool::HashCaseInsensitive(const char* Str, uint32 Length)
+{
+	// FNV-1a over lower-cased bytes
+	uint32 Hash = 2166136261u;
+	for (uint32 i = 0; i < Length; ++i)
+	{
+		Hash ^= static_cast<uint8>(ToLowerAscii(Str[i]));
+		Hash *= 16777619u;
+	}
+	return Hash;
+}
+
+bool FNamePool::EqualsCaseInsensitive(const char* A, const char* B, uint32 Length)
+{
+	for (uint32 i = 0; i < Length; ++i)
+	{
+		if (ToLowerAscii(A[i]) != ToLowerAscii(B[i]))
+			return false;
+	}
+	return true;
+}
+
+const char* FNamePool::StoreBytes(const char* Str, uint32 Length)
+{
+	const uint32 Required = Length + 1;
+
+	// Oversized strings get a dedicated block so the shared blocks stay dense.
+	if (Required > BlockSize)
+	{
+		TUniquePtr<char[]> Block = MakeUnique<char[]>(Required);
+		memcpy(Block.get(), Str, Length);
+		Block[Length] = '\0';
+		const char* Result = Block.get();
+		LargeBlocks.push_back(std::move(Block));
+		return Result;
+	}
+
+	if (BlockCursor + Required > BlockSize)
+	{
+		Blocks.push_back(MakeUnique<char[]>(BlockSize));
+		BlockCursor = 0;
+	}
+
+	char* Dest = Blocks.back().get() + BlockCursor;
+	memcpy(Dest, Str, Length);
+	Dest[Length] = '\0';
+	BlockCursor += Required;
+	return Dest;
+}
+
+void FNamePool::GrowSlots()
+{
+	const uint32 NewCount = static_cast<uint32>(Slots.size()) * 2;
+	TArray<FNameSlot> NewSlots(NewCount, FNameSlot{ 0, -1 });
+	const uint32 NewMask = NewCount - 1;
+
+	for (const FNameSlot& Slot : Slots)
+	{
+		if (Slot.EntryIndex < 0) continue;
+
+		uint32 Probe = Slot.Hash & NewMask;
+		while (NewSlots[Probe].EntryIndex >= 0)
+		{
+			Probe = (Probe + 1) & NewMask;
+		}
+		NewSlots[Probe] = Slot;
+	}
+
+	Slots = std::move(NewSlots);
+	SlotMask = NewMask;
+}
+
+int32 FNamePool::Store(const char* Str, uint32 Length, int32& OutComparisonIndex)
+{
+	const uint32 Hash = HashCaseInsensitive(Str, Length);
+	int32 ComparisonIndex = -1;
+
+	uint32 Probe = Hash & SlotMask;
+	while (Slots[Probe].EntryIndex >= 0)
+	{
+		const FNameSlot& Slot = Slots[Probe];
+		if (Slot.Hash == Hash)
+		{
+			const FNameEntry& Entry = Entries[Slot.EntryIndex];
+			if (Entry.Length == Length && EqualsCaseInsensitive(Entry.Data, Str, Length))
+			{
+				// Same comparison entry; reuse the display entry only for an exact spelling match.
+				ComparisonIndex = Entry.ComparisonIndex;
+				if (memcmp(Entry.Data, Str, Length) == 0)
+				{
+					OutComparisonIndex = ComparisonIndex;
+					return Slot.EntryIndex;
+				}
+			}
+		}
+		Probe = (Probe + 1) & SlotMask;
+	}
+
+	const int32 NewIndex = static_cast<int32>(Entries.size());
+	if (ComparisonIndex < 0)
+	{
+		ComparisonIndex = NewIndex;
+	}
+
+	Entries.push_back(FNameEntry{ StoreBytes(Str, Length), Length, Hash, ComparisonIndex });
+	Slots[Probe] = FNameSlot{ Hash, NewIndex };
+
+	// Keep the load factor under 1/2 so probe sequences stay short.
+	if (Entries.size() * 2 > Slots.size())
+	{
+		GrowSlots();
+	}
+
+	OutComparisonIndex = ComparisonIndex;
+	return NewIndex;
+}
+
+void FName::Init(const char* Str, uint32 Length)
+{
+	if (Length == 0)
+	{
+		DisplayIndex = ComparisonIndex = Number = 0;
+		return;
+	}
+
+	Number = ParseNumberSuffix(Str, Length);
+	DisplayIndex = FNamePool::Get().Store(Str, Length, ComparisonIndex);
+}
+
+FString FName::GetPlainString() const
+{
+	const FNamePool& Pool = FNamePool::Get();
+	return FString(Pool.GetData(DisplayIndex), Pool.GetLength(DisplayIndex));
+}
+
+FString FName::ToString() const
+{
+	FString Result = GetPlainString();
+	if (Number != 0)
+	{
+		Result += "_";
+		Result += std::to_string(Number - 1);
+	}
+	return Result;
+}
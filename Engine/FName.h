@@ -2,32 +2,102 @@
 #include "UEngineStatics.h"
 #include "TArray.h"
 
-struct FName
+/**
+ * @brief Global name table backing FName
+ *
+ * Strings are interned once into fixed-size character blocks that never move, and are looked up
+ * through an open-addressed index keyed by a precomputed case-insensitive hash.
+ * Every distinct spelling gets its own display entry, while spellings that only differ by case
+ * share a single comparison entry.
+ */
+class FNamePool
 {
+public:
+	static FNamePool& Get();
+
+	/**
+	 * @brief Finds or adds the given string.
+	 * @return Display index of the exact spelling. The case-insensitive comparison index is written to OutComparisonIndex.
+	 */
+	int32 Store(const char* Str, uint32 Length, int32& OutComparisonIndex);
+
+	const char* GetData(int32 Index) const { return Entries[Index].Data; }
+	uint32 GetLength(int32 Index) const { return Entries[Index].Length; }
+	int32 Num() const { return static_cast<int32>(Entries.size()); }
+
+	FNamePool(const FNamePool&) = delete;
+	FNamePool& operator=(const FNamePool&) = delete;
+
 private:
-	static inline TArray<FString> data;
-	static inline int nextIndex = 0;
+	FNamePool();
+
+	struct FNameEntry
+	{
+		const char* Data;
+		uint32 Length;
+		uint32 Hash;
+		int32 ComparisonIndex;
+	};
+
+	/** @note: EntryIndex == -1 marks an empty slot. */
+	struct FNameSlot
+	{
+		uint32 Hash;
+		int32 EntryIndex;
+	};
+
+	static constexpr uint32 BlockSize = 64 * 1024;
+	static constexpr uint32 InitialSlotCount = 1024;
+
+	static uint32 HashCaseInsensitive(const char* Str, uint32 Length);
+	static bool EqualsCaseInsensitive(const char* A, const char* B, uint32 Length);
+
+	const char* StoreBytes(const char* Str, uint32 Length);
+	void GrowSlots();
+
+	TArray<TUniquePtr<char[]>> Blocks;
+	TArray<TUniquePtr<char[]>> LargeBlocks;
+	uint32 BlockCursor = BlockSize;
+
+	TArray<FNameEntry> Entries;
+	TArray<FNameSlot> Slots;
+	uint32 SlotMask = 0;
+};
+
+/**
+ * @brief Interned, case-insensitive name with an Unreal-style numeric suffix
+ *
+ * "Cube_123" is stored as the pooled string "Cube" plus Number 124, so spawning many uniquely
+ * numbered objects does not grow the name table. Number 0 means "no suffix".
+ */
+struct FName
+{
 public:
 	int32 DisplayIndex;
 	int32 ComparisonIndex;
+	int32 Number;
+
+	FName() : DisplayIndex(0), ComparisonIndex(0), Number(0) {}
+	FName(const char* pStr) { Init(pStr, pStr ? static_cast<uint32>(strlen(pStr)) : 0); }
+	FName(const FString& str) { Init(str.data(), static_cast<uint32>(str.size())); }
 
-	FName(char* pStr) : FName(FString(pStr)){}
-	FName(FString str = "") {
-		auto it = std::find(data.begin(), data.end(), str);
-		if (it != data.end())
-			ComparisonIndex = static_cast<int32>(std::distance(data.begin(), it));
-		else {
-			data.push_back(str);
-			ComparisonIndex = nextIndex++;
-		}
-		DisplayIndex = ComparisonIndex;
-	}
 	int32 Compare(const FName& other) const {
-		return ComparisonIndex - other.ComparisonIndex;
+		if (ComparisonIndex != other.ComparisonIndex)
+			return ComparisonIndex - other.ComparisonIndex;
+		return Number - other.Number;
 	}
 	bool operator==(const FName& other) const {
-		return Compare(other) == 0;
+		return ComparisonIndex == other.ComparisonIndex && Number == other.Number;
 	}
-	FString ToString() const { return data[DisplayIndex]; }
-};
+	bool operator!=(const FName& other) const {
+		return !(*this == other);
+	}
+
+	bool IsNone() const { return ComparisonIndex == 0 && Number == 0; }
 
+	FString GetPlainString() const;
+	FString ToString() const;
+
+private:
+	void Init(const char* Str, uint32 Length);
+};
@@ -0,0 +1,67 @@
+﻿#include "stdafx.h"
+#include "FObjectAllocator.h"
+
+FObjectAllocator& FObjectAllocator::Get()
+{
+	// Intentionally never destroyed: UClass instances held in static storage are freed during
+	// static destruction, which may run after a function-local static allocator would be gone.
+	static FObjectAllocator* Allocator = new FObjectAllocator();
+	return *Allocator;
+}
+
+void* FObjectAllocator::Allocate(size_t Size)
+{
+	if (Size > MaxPooledSize)
+	{
+		++LargeAllocationCount;
+		return ::operator new(Size, std::align_val_t(CacheLineSize));
+	}
+
+	const size_t Index = GetSizeClassIndex(Size);
+	if (!FreeLists[Index])
+	{
+		RefillSizeClass(Index);
+	}
+
+	FFreeBlock* Block = FreeLists[Index];
+	FreeLists[Index] = Block->Next;
+	++LiveBlockCount;
+	return Block;
+}
+
+void FObjectAllocator::Free(void* Ptr, size_t Size)
+{
+	if (!Ptr) return;
+
+	if (Size > MaxPooledSize)
+	{
+		--LargeAllocationCount;
+		::operator delete(Ptr, std::align_val_t(CacheLineSize));
+		return;
+	}
+
+	const size_t Index = GetSizeClassIndex(Size);
+	FFreeBlock* Block = static_cast<FFreeBlock*>(Ptr);
+	Block->Next = FreeLists[Index];
+	FreeLists[Index] = Block;
+	--LiveBlockCount;
+}
+
+void FObjectAllocator::RefillSizeClass(size_t Index)
+{
+	const size_t BlockSize = (Index + 1) * CacheLineSize;
+	const size_t BlockCount = SlabSize / BlockSize;
+
+	uint8* Slab = static_cast<uint8*>(::operator new(SlabSize, std::align_val_t(CacheLineSize)));
+	Slabs.push_back(Slab);
+
+	// Thread blocks in address order so consecutive allocations stay adjacent in memory.
+	FFreeBlock* Head = nullptr;
+	for (size_t i = BlockCount; i > 0; --i)
+	{
+		FFreeBlock* Block = reinterpret_cast<FFreeBlock*>(Slab + (i - 1) * BlockSize);
+		Block->Next = Head;
+		Head = Block;
+	}
+	FreeLists[Index] = Head;
+}
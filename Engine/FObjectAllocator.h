@@ -0,0 +1,56 @@
+﻿#pragma once
+#include <new>
+#include "UEngineStatics.h"
+#include "TArray.h"
+
+/**
+ * @brief Size-class pool allocator used by UObject::operator new
+ *
+ * Requests are rounded up to a multiple of the cache line size and served from per-class free lists
+ * carved out of 64KB slabs. Slabs are never returned to the heap, so spawn/destroy churn of
+ * components and actors recycles the same cache-line-aligned blocks instead of fragmenting the heap.
+ * Objects larger than MaxPooledSize fall back to aligned global new.
+ */
+class FObjectAllocator
+{
+public:
+	static constexpr size_t CacheLineSize = 64;
+	static constexpr size_t MaxPooledSize = 2048;
+	static constexpr size_t NumSizeClasses = MaxPooledSize / CacheLineSize;
+	static constexpr size_t SlabSize = 64 * 1024;
+
+	static FObjectAllocator& Get();
+
+	void* Allocate(size_t Size);
+	void Free(void* Ptr, size_t Size);
+
+	/** @brief Bytes held by slabs (pooled, whether in use or not). */
+	size_t GetReservedBytes() const { return Slabs.size() * SlabSize; }
+	/** @brief Number of pooled blocks currently handed out. */
+	size_t GetLiveBlockCount() const { return LiveBlockCount; }
+	/** @brief Number of allocations that bypassed the pool because they were too large. */
+	size_t GetLargeAllocationCount() const { return LargeAllocationCount; }
+
+	FObjectAllocator(const FObjectAllocator&) = delete;
+	FObjectAllocator& operator=(const FObjectAllocator&) = delete;
+
+private:
+	FObjectAllocator() = default;
+
+	struct FFreeBlock
+	{
+		FFreeBlock* Next;
+	};
+
+	static size_t GetSizeClassIndex(size_t Size)
+	{
+		return (Size == 0) ? 0 : (Size - 1) / CacheLineSize;
+	}
+
+	void RefillSizeClass(size_t Index);
+
+	FFreeBlock* FreeLists[NumSizeClasses] = {};
+	TArray<void*> Slabs;
+	size_t LiveBlockCount = 0;
+	size_t LargeAllocationCount = 0;
+};
@@ -0,0 +1,261 @@
+﻿#include "stdafx.h"
+#include "FProperty.h"
+#include "UObject.h"
+#include "UClass.h"
+
+namespace
+{
+	// 정수로 저장된 값("1")도 float로 읽을 수 있도록
+	bool ReadNumber(const json::JSON& Value, float& Out)
+	{
+		bool ok;
+		double f = Value.ToFloat(ok);
+		if (ok) { Out = static_cast<float>(f); return true; }
+
+		long i = Value.ToInt(ok);
+		if (ok) { Out = static_cast<float>(i); return true; }
+		return false;
+	}
+
+	bool ReadVector(const json::JSON& Value, FVector& Out)
+	{
+		if (Value.size() != 3) return false;
+		return ReadNumber(Value.at(0u), Out.X) && ReadNumber(Value.at(1u), Out.Y) && ReadNumber(Value.at(2u), Out.Z);
+	}
+}
+
+void FPropertySerializer::ToJson(const UObject* Object, json::JSON& OutJson)
+{
+	for (const FProperty& Property : Object->GetClass()->GetProperties())
+	{
+		if (!Property.HasFlag(PF_Serialize)) continue;
+
+		switch (Property.Type)
+		{
+		case EPropertyType::Bool:
+			OutJson[Property.Name] = Property.GetValue<bool>(Object);
+			break;
+		case EPropertyType::Int32:
+			OutJson[Property.Name] = Property.GetValue<int32>(Object);
+			break;
+		case EPropertyType::Float:
+			OutJson[Property.Name] = Property.GetValue<float>(Object);
+			break;
+		case EPropertyType::String:
+			OutJson[Property.Name] = Property.GetValue<FString>(Object);
+			break;
+		case EPropertyType::Vector:
+		{
+			const FVector& V = Property.GetValue<FVector>(Object);
+			OutJson[Property.Name] = json::Array(V.X, V.Y, V.Z);
+			break;
+		}
+		case EPropertyType::Quaternion:
+		{
+			const FVector Euler = Property.GetValue<FQuaternion>(Object).GetEulerXYZ();
+			OutJson[Property.Name] = json::Array(Euler.X, Euler.Y, Euler.Z);
+			break;
+		}
+		}
+	}
+}
+
+bool FPropertySerializer::FromJson(UObject* Object, const json::JSON& Data)
+{
+	bool bSuccess = true;
+	for (const FProperty& Property : Object->GetClass()->GetProperties())
+	{
+		if (!Property.HasFlag(PF_Serialize)) continue;
+
+		if (!Data.hasKey(Property.Name))
+		{
+			bSuccess = false;
+			continue;
+		}
+
+		const json::JSON& Value = Data.at(Property.Name);
+		bool ok = true;
+		switch (Property.Type)
+		{
+		case EPropertyType::Bool:
+			Property.GetValue<bool>(Object) = Value.ToBool(ok);
+			break;
+		case EPropertyType::Int32:
+			Property.GetValue<int32>(Object) = static_cast<int32>(Value.ToInt(ok));
+			break;
+		case EPropertyType::Float:
+			ok = ReadNumber(Value, Property.GetValue<float>(Object));
+			break;
+		case EPropertyType::String:
+			Property.GetValue<FString>(Object) = Value.ToString(ok);
+			break;
+		case EPropertyType::Vector:
+		{
+			FVector V;
+			ok = ReadVector(Value, V);
+			if (ok) Property.GetValue<FVector>(Object) = V;
+			break;
+		}
+		case EPropertyType::Quaternion:
+		{
+			FVector Euler;
+			ok = ReadVector(Value, Euler);
+			if (ok) Property.GetValue<FQuaternion>(Object) = FQuaternion::FromEulerXYZ(Euler.X, Euler.Y, Euler.Z);
+			break;
+		}
+		}
+		bSuccess &= ok;
+	}
+	return bSuccess;
+}
+
+void FPropertySerializer::ToBinary(const UObject* Object, TArray<uint8>& OutBytes)
+{
+	const TArray<FProperty>& Properties = Object->GetClass()->GetProperties();
+
+	uint32 Count = 0;
+	for (const FProperty& Property : Properties)
+	{
+		if (Property.HasFlag(PF_Serialize)) ++Count;
+	}
+	WriteRaw(OutBytes, Count);
+
+	// 바이트 크기는 값을 다 쓴 뒤 채움 (레이아웃이 다른 이미지를 건너뛸 수 있도록)
+	const size_t SizeOffset = OutBytes.size();
+	WriteRaw(OutBytes, static_cast<uint32>(0));
+	const size_t ValuesStart = OutBytes.size();
+
+	for (const FProperty& Property : Properties)
+	{
+		if (!Property.HasFlag(PF_Serialize)) continue;
+
+		switch (Property.Type)
+		{
+		case EPropertyType::Bool:
+			WriteRaw(OutBytes, static_cast<uint8>(Property.GetValue<bool>(Object)));
+			break;
+		case EPropertyType::Int32:
+			WriteRaw(OutBytes, Property.GetValue<int32>(Object));
+			break;
+		case EPropertyType::Float:
+			WriteRaw(OutBytes, Property.GetValue<float>(Object));
+			break;
+		case EPropertyType::String:
+			WriteString(OutBytes, Property.GetValue<FString>(Object));
+			break;
+		case EPropertyType::Vector:
+			WriteRaw(OutBytes, Property.GetValue<FVector>(Object));
+			break;
+		case EPropertyType::Quaternion:
+			WriteRaw(OutBytes, Property.GetValue<FQuaternion>(Object));
+			break;
+		}
+	}
+
+	const uint32 Size = static_cast<uint32>(OutBytes.size() - ValuesStart);
+	memcpy(OutBytes.data() + SizeOffset, &Size, sizeof(Size));
+}
+
+bool FPropertySerializer::FromBinary(UObject* Object, const uint8*& Cursor, const uint8* End)
+{
+	const TArray<FProperty>& Properties = Object->GetClass()->GetProperties();
+
+	uint32 Count = 0;
+	uint32 Size = 0;
+	if (!ReadRaw(Cursor, End, Count) || !ReadRaw(Cursor, End, Size)) return false;
+	if (static_cast<size_t>(End - Cursor) < Size) return false;
+	const uint8* ValuesEnd = Cursor + Size;
+
+	uint32 Expected = 0;
+	for (const FProperty& Property : Properties)
+	{
+		if (Property.HasFlag(PF_Serialize)) ++Expected;
+	}
+	// 레이아웃이 다르면 읽지 않고 건너뜀 (클래스 속성이 바뀐 이전 데이터)
+	if (Count != Expected)
+	{
+		Cursor = ValuesEnd;
+		return false;
+	}
+
+	for (const FProperty& Property : Properties)
+	{
+		if (!Property.HasFlag(PF_Serialize)) continue;
+
+		bool ok = true;
+		switch (Property.Type)
+		{
+		case EPropertyType::Bool:
+		{
+			uint8 Value = 0;
+			ok = ReadRaw(Cursor, ValuesEnd, Value);
+			if (ok) Property.GetValue<bool>(Object) = Value != 0;
+			break;
+		}
+		case EPropertyType::Int32:
+			ok = ReadRaw(Cursor, ValuesEnd, Property.GetValue<int32>(Object));
+			break;
+		case EPropertyType::Float:
+			ok = ReadRaw(Cursor, ValuesEnd, Property.GetValue<float>(Object));
+			break;
+		case EPropertyType::String:
+			ok = ReadString(Cursor, ValuesEnd, Property.GetValue<FString>(Object));
+			break;
+		case EPropertyType::Vector:
+			ok = ReadRaw(Cursor, ValuesEnd, Property.GetValue<FVector>(Object));
+			break;
+		case EPropertyType::Quaternion:
+			ok = ReadRaw(Cursor, ValuesEnd, Property.GetValue<FQuaternion>(Object));
+			break;
+		}
+		if (!ok)
+		{
+			Cursor = ValuesEnd;
+			return false;
+		}
+	}
+
+	const bool bConsumedAll = Cursor == ValuesEnd;
+	Cursor = ValuesEnd;
+	return bConsumedAll;
+}
+
+void FPropertySerializer::WriteObjectRecord(const UObject* Object, TArray<uint8>& OutBytes)
+{
+	WriteString(OutBytes, Object->GetClass()->GetDisplayName());
+
+	const size_t SizeOffset = OutBytes.size();
+	WriteRaw(OutBytes, static_cast<uint32>(0));
+	const size_t ImageStart = OutBytes.size();
+	Object->SerializeBinary(OutBytes);
+
+	const uint32 Size = static_cast<uint32>(OutBytes.size() - ImageStart);
+	memcpy(OutBytes.data() + SizeOffset, &Size, sizeof(Size));
+}
+
+bool FPropertySerializer::ReadObjectRecordHeader(const uint8*& Cursor, const uint8* End, UClass*& OutClass, const uint8*& OutRecordEnd)
+{
+	FString ClassName;
+	uint32 Size = 0;
+	if (!ReadString(Cursor, End, ClassName) || !ReadRaw(Cursor, End, Size)) return false;
+	if (static_cast<size_t>(End - Cursor) < Size) return false;
+
+	OutClass = UClass::FindClassWithDisplayName(ClassName);
+	OutRecordEnd = Cursor + Size;
+	return true;
+}
+
+void FPropertySerializer::WriteString(TArray<uint8>& OutBytes, const FString& Value)
+{
+	WriteRaw(OutBytes, static_cast<uint32>(Value.size()));
+	OutBytes.insert(OutBytes.end(), Value.begin(), Value.end());
+}
+
+bool FPropertySerializer::ReadString(const uint8*& Cursor, const uint8* End, FString& OutValue)
+{
+	uint32 Length = 0;
+	if (!ReadRaw(Cursor, End, Length) || static_cast<size_t>(End - Cursor) < Length) return false;
+	OutValue.assign(reinterpret_cast<const char*>(Cursor), Length);
+	Cursor += Length;
+	return true;
+}
@@ -0,0 +1,164 @@
+﻿#pragma once
+#include "UEngineStatics.h"
+#include "TArray.h"
+#include "Vector.h"
+#include "Quaternion.h"
+#include "json.hpp"
+
+class UObject;
+class UClass;
+
+enum class EPropertyType : uint8
+{
+	Bool,
+	Int32,
+	Float,
+	String,
+	Vector,
+	Quaternion,	// 저장은 오일러(라디안), 에디터 표시는 오일러(도)
+};
+
+enum EPropertyFlags : uint32
+{
+	PF_None = 0,
+	PF_Serialize = 1 << 0,	// JSON/바이너리 저장 대상
+	PF_Edit = 1 << 1,		// 프로퍼티 창에 표시
+	PF_Default = PF_Serialize | PF_Edit,
+};
+
+template<typename T> struct TPropertyTypeOf;
+template<> struct TPropertyTypeOf<bool> { static constexpr EPropertyType Value = EPropertyType::Bool; };
+template<> struct TPropertyTypeOf<int32> { static constexpr EPropertyType Value = EPropertyType::Int32; };
+template<> struct TPropertyTypeOf<float> { static constexpr EPropertyType Value = EPropertyType::Float; };
+template<> struct TPropertyTypeOf<FString> { static constexpr EPropertyType Value = EPropertyType::String; };
+template<> struct TPropertyTypeOf<FVector> { static constexpr EPropertyType Value = EPropertyType::Vector; };
+template<> struct TPropertyTypeOf<FQuaternion> { static constexpr EPropertyType Value = EPropertyType::Quaternion; };
+
+/**
+ * @brief Reflected field of a UClass
+ * @note: Accessor is instantiated per member by UPROPERTY from a pointer-to-member, so the
+ *        UObject* -> declaring class conversion goes through static_cast instead of a raw offset.
+ */
+struct FProperty
+{
+	using FAccessor = void* (*)(UObject*);
+
+	const char* Name;			// JSON 키
+	const char* DisplayName;	// 프로퍼티 창 라벨
+	EPropertyType Type;
+	FAccessor Accessor;
+	uint32 Flags;
+
+	bool HasFlag(EPropertyFlags flag) const { return (Flags & flag) != 0; }
+
+	void* GetValuePtr(UObject* Object) const
+	{
+		return Accessor(Object);
+	}
+
+	const void* GetValuePtr(const UObject* Object) const
+	{
+		return Accessor(const_cast<UObject*>(Object));
+	}
+
+	template<typename T>
+	T& GetValue(UObject* Object) const
+	{
+		assert(TPropertyTypeOf<T>::Value == Type && "Property type mismatch");
+		return *static_cast<T*>(GetValuePtr(Object));
+	}
+
+	template<typename T>
+	const T& GetValue(const UObject* Object) const
+	{
+		assert(TPropertyTypeOf<T>::Value == Type && "Property type mismatch");
+		return *static_cast<const T*>(GetValuePtr(Object));
+	}
+};
+
+template<typename TClass, typename TValue, TValue TClass::* Member>
+void* AccessProperty(UObject* Object)
+{
+	return &(static_cast<TClass*>(Object)->*Member);
+}
+
+/**
+ * @brief Serializes objects through their reflected properties
+ *
+ * Walks the flattened property list of the object's class and reads/writes each field through its
+ * accessor, so every class shares one JSON path and one binary path.
+ */
+class FPropertySerializer
+{
+public:
+	/** @brief Writes every PF_Serialize property into OutJson. Leaves OutJson untouched if there are none. */
+	static void ToJson(const UObject* Object, json::JSON& OutJson);
+
+	/** @return false if a serialized property is missing or malformed. Remaining properties are still read. */
+	static bool FromJson(UObject* Object, const json::JSON& Data);
+
+	/**
+	 * @brief Appends a compact binary image: property count, byte size, then raw values in declaration order.
+	 * @note: Strings are stored as uint32 length + bytes, quaternions as raw components.
+	 */
+	static void ToBinary(const UObject* Object, TArray<uint8>& OutBytes);
+
+	/**
+	 * @brief Reads an image written by ToBinary for the same class and advances Cursor past it.
+	 * @return false if the image is truncated or was written for a different property layout;
+	 *         a layout mismatch still skips the whole image.
+	 */
+	static bool FromBinary(UObject* Object, const uint8*& Cursor, const uint8* End);
+
+	/**
+	 * @brief Appends the object's class display name, the byte size of its SerializeBinary image and the image.
+	 * @note: Readers can skip records of unknown classes; see ReadObjectRecordHeader.
+	 */
+	static void WriteObjectRecord(const UObject* Object, TArray<uint8>& OutBytes);
+
+	/**
+	 * @brief Reads the header of a WriteObjectRecord record. Cursor is left at the image and OutRecordEnd points past it.
+	 * @param OutClass nullptr if the class is not registered (the record can still be skipped).
+	 */
+	static bool ReadObjectRecordHeader(const uint8*& Cursor, const uint8* End, UClass*& OutClass, const uint8*& OutRecordEnd);
+
+	template<typename T>
+	static void WriteRaw(TArray<uint8>& OutBytes, const T& Value)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "WriteRaw copies bytes");
+		const size_t Start = OutBytes.size();
+		OutBytes.resize(Start + sizeof(T));
+		memcpy(OutBytes.data() + Start, &Value, sizeof(T));
+	}
+
+	template<typename T>
+	static bool ReadRaw(const uint8*& Cursor, const uint8* End, T& OutValue)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "ReadRaw copies bytes");
+		if (static_cast<size_t>(End - Cursor) < sizeof(T)) return false;
+		memcpy(&OutValue, Cursor, sizeof(T));
+		Cursor += sizeof(T);
+		return true;
+	}
+
+	static void WriteString(TArray<uint8>& OutBytes, const FString& Value);
+	static bool ReadString(const uint8*& Cursor, const uint8* End, FString& OutValue);
+};
+
+/**
+ * @brief Registers a reflected property. Place at file scope after IMPLEMENT_UCLASS(ClassName, ...).
+ * @note: Member must be public, since the registration struct takes its address.
+ */
+#define UPROPERTY(ClassName, Member, Name, Flags) \
+	UPROPERTY_DISPLAYNAME(ClassName, Member, Name, Name, Flags)
+
+/** @brief UPROPERTY whose property window label differs from its serialized name. */
+#define UPROPERTY_DISPLAYNAME(ClassName, Member, Name, DisplayName, Flags) \
+struct _PropRegister_##ClassName##_##Member { \
+    _PropRegister_##ClassName##_##Member() { \
+        using FValueType = decltype(ClassName::Member); \
+        ClassName::StaticClass()->AddProperty(FProperty{ Name, DisplayName, \
+            TPropertyTypeOf<FValueType>::Value, \
+            &AccessProperty<ClassName, FValueType, &ClassName::Member>, static_cast<uint32>(Flags) }); \
+    } \
+} _PropRegisterInstance_##ClassName##_##Member;
@@ -0,0 +1,63 @@
+﻿#pragma once
+#include <d3d11.h>
+#include "UEngineStatics.h"
+
+/**
+ * @brief Command submission interface used by the renderer instead of ID3D11DeviceContext
+ *
+ * Every bind, state change, buffer write and draw issued while rendering a frame goes through
+ * this interface. FD3D11CommandContext forwards to the device context; FRecordingCommandContext
+ * captures the calls into a command stream (optionally forwarding them as well), which can be
+ * counted, replayed and compared without looking at the GPU.
+ *
+ * Resources are still D3D11 objects. Load-time resources (meshes, shaders, textures) are created on
+ * ID3D11Device; buffers the renderer creates while drawing a frame go through CreateBuffer, so a
+ * recorder without a device can still run a whole frame.
+ */
+class FRHICommandContext
+{
+public:
+	virtual ~FRHICommandContext() = default;
+
+	/** Input assembler */
+	virtual void SetInputLayout(ID3D11InputLayout* InputLayout) = 0;
+	virtual void SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY Topology) = 0;
+	virtual void SetVertexBuffers(uint32 StartSlot, uint32 NumBuffers, ID3D11Buffer* const* Buffers, const UINT* Strides, const UINT* Offsets) = 0;
+	virtual void SetIndexBuffer(ID3D11Buffer* Buffer, DXGI_FORMAT Format, uint32 Offset) = 0;
+
+	/** Shaders and their resources */
+	virtual void SetVertexShader(ID3D11VertexShader* Shader) = 0;
+	virtual void SetPixelShader(ID3D11PixelShader* Shader) = 0;
+	virtual void SetVSConstantBuffer(uint32 Slot, ID3D11Buffer* Buffer) = 0;
+	virtual void SetPSConstantBuffer(uint32 Slot, ID3D11Buffer* Buffer) = 0;
+	virtual void SetPSShaderResource(uint32 Slot, ID3D11ShaderResourceView* ShaderResourceView) = 0;
+	virtual void SetPSSampler(uint32 Slot, ID3D11SamplerState* Sampler) = 0;
+
+	/** Fixed-function state */
+	virtual void SetRasterizerState(ID3D11RasterizerState* State) = 0;
+	virtual void SetDepthStencilState(ID3D11DepthStencilState* State, uint32 StencilRef) = 0;
+	/** @note: Like OMGetDepthStencilState, the returned state is AddRef'd and must be released by the caller. */
+	virtual void GetDepthStencilState(ID3D11DepthStencilState** OutState, UINT* OutStencilRef) = 0;
+	virtual void SetRenderTarget(ID3D11RenderTargetView* RenderTargetView, ID3D11DepthStencilView* DepthStencilView) = 0;
+	virtual void SetViewport(const D3D11_VIEWPORT& Viewport) = 0;
+
+	/** Clears */
+	virtual void ClearRenderTarget(ID3D11RenderTargetView* RenderTargetView, const float Color[4]) = 0;
+	virtual void ClearDepthStencil(ID3D11DepthStencilView* DepthStencilView, uint32 ClearFlags, float Depth, uint8 Stencil) = 0;
+
+	/** Resources created while rendering */
+	/** @brief ID3D11Device::CreateBuffer; returns nullptr on failure. The caller owns the returned reference. */
+	virtual ID3D11Buffer* CreateBuffer(const D3D11_BUFFER_DESC& Desc, const D3D11_SUBRESOURCE_DATA* InitialData) = 0;
+
+	/** Buffer writes */
+	/** @brief Replaces the contents of a D3D11_USAGE_DYNAMIC buffer (Map with WRITE_DISCARD). */
+	virtual bool WriteDynamicBuffer(ID3D11Buffer* Buffer, const void* Data, uint32 Size) = 0;
+	/** @brief Replaces the contents of a D3D11_USAGE_DEFAULT buffer (UpdateSubresource). */
+	virtual void UpdateBuffer(ID3D11Buffer* Buffer, const void* Data, uint32 Size) = 0;
+
+	/** Draws */
+	virtual void Draw(uint32 VertexCount, uint32 StartVertexLocation) = 0;
+	virtual void DrawIndexed(uint32 IndexCount, uint32 StartIndexLocation, int32 BaseVertexLocation) = 0;
+	virtual void DrawInstanced(uint32 VertexCountPerInstance, uint32 InstanceCount, uint32 StartVertexLocation, uint32 StartInstanceLocation) = 0;
+	virtual void DrawIndexedInstanced(uint32 IndexCountPerInstance, uint32 InstanceCount, uint32 StartIndexLocation, int32 BaseVertexLocation, uint32 StartInstanceLocation) = 0;
+};
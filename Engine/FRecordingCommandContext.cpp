@@ -0,0 +1,533 @@
+﻿#include "stdafx.h"
+#include "FRecordingCommandContext.h"
+
+namespace
+{
+	uint32 FloatBits(float Value)
+	{
+		uint32 Bits;
+		memcpy(&Bits, &Value, sizeof(Bits));
+		return Bits;
+	}
+
+	float BitsToFloat(uint32 Bits)
+	{
+		float Value;
+		memcpy(&Value, &Bits, sizeof(Value));
+		return Value;
+	}
+
+	template <typename T>
+	T* As(IUnknown* Resource)
+	{
+		return static_cast<T*>(Resource);
+	}
+
+	/** @brief What CreateBuffer returns without a target: a live COM object with the description and no GPU memory. */
+	class FNullBuffer final : public ID3D11Buffer
+	{
+	public:
+		explicit FNullBuffer(const D3D11_BUFFER_DESC& InDesc)
+			: Desc(InDesc)
+		{
+		}
+
+		HRESULT STDMETHODCALLTYPE QueryInterface(REFIID Riid, void** OutObject)
+		{
+			if (!OutObject)
+				return E_POINTER;
+
+			if (IsEqualIID(Riid, __uuidof(IUnknown)) || IsEqualIID(Riid, __uuidof(ID3D11DeviceChild))
+				|| IsEqualIID(Riid, __uuidof(ID3D11Resource)) || IsEqualIID(Riid, __uuidof(ID3D11Buffer)))
+			{
+				*OutObject = static_cast<ID3D11Buffer*>(this);
+				AddRef();
+				return S_OK;
+			}
+			*OutObject = nullptr;
+			return E_NOINTERFACE;
+		}
+
+		ULONG STDMETHODCALLTYPE AddRef()
+		{
+			return ++RefCount;
+		}
+
+		ULONG STDMETHODCALLTYPE Release()
+		{
+			const ULONG Count = --RefCount;
+			if (Count == 0)
+			{
+				delete this;
+			}
+			return Count;
+		}
+
+		void STDMETHODCALLTYPE GetDevice(ID3D11Device** OutDevice)
+		{
+			*OutDevice = nullptr;
+		}
+
+		HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID, UINT* DataSize, void*)
+		{
+			*DataSize = 0;
+			return E_FAIL;
+		}
+
+		HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID, UINT, const void*)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID, const IUnknown*)
+		{
+			return E_NOTIMPL;
+		}
+
+		void STDMETHODCALLTYPE GetType(D3D11_RESOURCE_DIMENSION* OutDimension)
+		{
+			*OutDimension = D3D11_RESOURCE_DIMENSION_BUFFER;
+		}
+
+		void STDMETHODCALLTYPE SetEvictionPriority(UINT)
+		{
+		}
+
+		UINT STDMETHODCALLTYPE GetEvictionPriority()
+		{
+			return 0;
+		}
+
+		void STDMETHODCALLTYPE GetDesc(D3D11_BUFFER_DESC* OutDesc)
+		{
+			*OutDesc = Desc;
+		}
+
+	private:
+		~FNullBuffer() = default;
+
+		ULONG RefCount = 1;
+		D3D11_BUFFER_DESC Desc;
+	};
+}
+
+FRecordingCommandContext::FRecordingCommandContext(FRHICommandContext* InTarget)
+	: Target(InTarget)
+{
+}
+
+FRecordingCommandContext::~FRecordingCommandContext()
+{
+	Reset();
+	if (CurrentDepthStencilState)
+	{
+		CurrentDepthStencilState->Release();
+	}
+}
+
+void FRecordingCommandContext::Reset()
+{
+	for (IUnknown* Resource : RetainedResources)
+	{
+		Resource->Release();
+	}
+	RetainedResources.clear();
+	Commands.clear();
+	Payload.clear();
+	memset(Counts, 0, sizeof(Counts));
+	NumBytesWritten = 0;
+	NumBuffersCreated = 0;
+}
+
+void FRecordingCommandContext::Retain(IUnknown* Resource)
+{
+	if (Resource)
+	{
+		Resource->AddRef();
+		RetainedResources.push_back(Resource);
+	}
+}
+
+FRHICommand& FRecordingCommandContext::Record(ERHICommandType Type, IUnknown* Resource0, IUnknown* Resource1)
+{
+	Retain(Resource0);
+	Retain(Resource1);
+	++Counts[static_cast<uint32>(Type)];
+
+	FRHICommand& Command = Commands.emplace_back();
+	Command.Type = Type;
+	Command.Resources[0] = Resource0;
+	Command.Resources[1] = Resource1;
+	return Command;
+}
+
+void FRecordingCommandContext::AppendPayload(FRHICommand& Command, const void* Data, uint32 Size)
+{
+	Command.PayloadOffset = static_cast<uint32>(Payload.size());
+	Command.PayloadSize = Size;
+	const uint8* Bytes = static_cast<const uint8*>(Data);
+	Payload.insert(Payload.end(), Bytes, Bytes + Size);
+}
+
+uint32 FRecordingCommandContext::GetNumDrawCalls() const
+{
+	return GetCommandCount(ERHICommandType::Draw) + GetCommandCount(ERHICommandType::DrawIndexed)
+		+ GetCommandCount(ERHICommandType::DrawInstanced) + GetCommandCount(ERHICommandType::DrawIndexedInstanced);
+}
+
+// ==========================================================================
+// Recording
+
+void FRecordingCommandContext::SetInputLayout(ID3D11InputLayout* InputLayout)
+{
+	Record(ERHICommandType::SetInputLayout, InputLayout);
+	if (Target) Target->SetInputLayout(InputLayout);
+}
+
+void FRecordingCommandContext::SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY Topology)
+{
+	Record(ERHICommandType::SetPrimitiveTopology).Args[0] = static_cast<uint32>(Topology);
+	if (Target) Target->SetPrimitiveTopology(Topology);
+}
+
+void FRecordingCommandContext::SetVertexBuffers(uint32 StartSlot, uint32 NumBuffers, ID3D11Buffer* const* Buffers, const UINT* Strides, const UINT* Offsets)
+{
+	assert(NumBuffers <= D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT);
+
+	FVertexBufferBinding Bindings[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT];
+	for (uint32 i = 0; i < NumBuffers; ++i)
+	{
+		Bindings[i] = { Buffers[i], Strides[i], Offsets[i] };
+		Retain(Buffers[i]);
+	}
+
+	FRHICommand& Command = Record(ERHICommandType::SetVertexBuffers);
+	Command.Args[0] = StartSlot;
+	Command.Args[1] = NumBuffers;
+	AppendPayload(Command, Bindings, NumBuffers * sizeof(FVertexBufferBinding));
+
+	if (Target) Target->SetVertexBuffers(StartSlot, NumBuffers, Buffers, Strides, Offsets);
+}
+
+void FRecordingCommandContext::SetIndexBuffer(ID3D11Buffer* Buffer, DXGI_FORMAT Format, uint32 Offset)
+{
+	FRHICommand& Command = Record(ERHICommandType::SetIndexBuffer, Buffer);
+	Command.Args[0] = static_cast<uint32>(Format);
+	Command.Args[1] = Offset;
+	if (Target) Target->SetIndexBuffer(Buffer, Format, Offset);
+}
+
+void FRecordingCommandContext::SetVertexShader(ID3D11VertexShader* Shader)
+{
+	Record(ERHICommandType::SetVertexShader, Shader);
+	if (Target) Target->SetVertexShader(Shader);
+}
+
+void FRecordingCommandContext::SetPixelShader(ID3D11PixelShader* Shader)
+{
+	Record(ERHICommandType::SetPixelShader, Shader);
+	if (Target) Target->SetPixelShader(Shader);
+}
+
+void FRecordingCommandContext::SetVSConstantBuffer(uint32 Slot, ID3D11Buffer* Buffer)
+{
+	Record(ERHICommandType::SetVSConstantBuffer, Buffer).Args[0] = Slot;
+	if (Target) Target->SetVSConstantBuffer(Slot, Buffer);
+}
+
+void FRecordingCommandContext::SetPSConstantBuffer(uint32 Slot, ID3D11Buffer* Buffer)
+{
+	Record(ERHICommandType::SetPSConstantBuffer, Buffer).Args[0] = Slot;
+	if (Target) Target->SetPSConstantBuffer(Slot, Buffer);
+}
+
+void FRecordingCommandContext::SetPSShaderResource(uint32 Slot, ID3D11ShaderResourceView* ShaderResourceView)
+{
+	Record(ERHICommandType::SetPSShaderResource, ShaderResourceView).Args[0] = Slot;
+	if (Target) Target->SetPSShaderResource(Slot, ShaderResourceView);
+}
+
+void FRecordingCommandContext::SetPSSampler(uint32 Slot, ID3D11SamplerState* Sampler)
+{
+	Record(ERHICommandType::SetPSSampler, Sampler).Args[0] = Slot;
+	if (Target) Target->SetPSSampler(Slot, Sampler);
+}
+
+void FRecordingCommandContext::SetRasterizerState(ID3D11RasterizerState* State)
+{
+	Record(ERHICommandType::SetRasterizerState, State);
+	if (Target) Target->SetRasterizerState(State);
+}
+
+void FRecordingCommandContext::SetDepthStencilState(ID3D11DepthStencilState* State, uint32 StencilRef)
+{
+	Record(ERHICommandType::SetDepthStencilState, State).Args[0] = StencilRef;
+
+	if (State)
+	{
+		State->AddRef();
+	}
+	if (CurrentDepthStencilState)
+	{
+		CurrentDepthStencilState->Release();
+	}
+	CurrentDepthStencilState = State;
+	CurrentStencilRef = StencilRef;
+
+	if (Target) Target->SetDepthStencilState(State, StencilRef);
+}
+
+void FRecordingCommandContext::GetDepthStencilState(ID3D11DepthStencilState** OutState, UINT* OutStencilRef)
+{
+	// 조회는 스트림에 남기지 않음
+	if (Target)
+	{
+		Target->GetDepthStencilState(OutState, OutStencilRef);
+		return;
+	}
+
+	if (CurrentDepthStencilState)
+	{
+		CurrentDepthStencilState->AddRef();
+	}
+	*OutState = CurrentDepthStencilState;
+	*OutStencilRef = CurrentStencilRef;
+}
+
+void FRecordingCommandContext::SetRenderTarget(ID3D11RenderTargetView* RenderTargetView, ID3D11DepthStencilView* DepthStencilView)
+{
+	Record(ERHICommandType::SetRenderTarget, RenderTargetView, DepthStencilView);
+	if (Target) Target->SetRenderTarget(RenderTargetView, DepthStencilView);
+}
+
+void FRecordingCommandContext::SetViewport(const D3D11_VIEWPORT& Viewport)
+{
+	AppendPayload(Record(ERHICommandType::SetViewport), &Viewport, sizeof(Viewport));
+	if (Target) Target->SetViewport(Viewport);
+}
+
+void FRecordingCommandContext::ClearRenderTarget(ID3D11RenderTargetView* RenderTargetView, const float Color[4])
+{
+	AppendPayload(Record(ERHICommandType::ClearRenderTarget, RenderTargetView), Color, sizeof(float) * 4);
+	if (Target) Target->ClearRenderTarget(RenderTargetView, Color);
+}
+
+void FRecordingCommandContext::ClearDepthStencil(ID3D11DepthStencilView* DepthStencilView, uint32 ClearFlags, float Depth, uint8 Stencil)
+{
+	FRHICommand& Command = Record(ERHICommandType::ClearDepthStencil, DepthStencilView);
+	Command.Args[0] = ClearFlags;
+	Command.Args[1] = FloatBits(Depth);
+	Command.Args[2] = Stencil;
+	if (Target) Target->ClearDepthStencil(DepthStencilView, ClearFlags, Depth, Stencil);
+}
+
+ID3D11Buffer* FRecordingCommandContext::CreateBuffer(const D3D11_BUFFER_DESC& Desc, const D3D11_SUBRESOURCE_DATA* InitialData)
+{
+	++NumBuffersCreated;
+	return Target ? Target->CreateBuffer(Desc, InitialData) : new FNullBuffer(Desc);
+}
+
+bool FRecordingCommandContext::WriteDynamicBuffer(ID3D11Buffer* Buffer, const void* Data, uint32 Size)
+{
+	FRHICommand& Command = Record(ERHICommandType::WriteDynamicBuffer, Buffer);
+	Command.Args[0] = Size;
+	AppendPayload(Command, Data, Size);
+	NumBytesWritten += Size;
+	return Target ? Target->WriteDynamicBuffer(Buffer, Data, Size) : true;
+}
+
+void FRecordingCommandContext::UpdateBuffer(ID3D11Buffer* Buffer, const void* Data, uint32 Size)
+{
+	FRHICommand& Command = Record(ERHICommandType::UpdateBuffer, Buffer);
+	Command.Args[0] = Size;
+	AppendPayload(Command, Data, Size);
+	NumBytesWritten += Size;
+	if (Target) Target->UpdateBuffer(Buffer, Data, Size);
+}
+
+void FRecordingCommandContext::Draw(uint32 VertexCount, uint32 StartVertexLocation)
+{
+	FRHICommand& Command = Record(ERHICommandType::Draw);
+	Command.Args[0] = VertexCount;
+	Command.Args[1] = StartVertexLocation;
+	if (Target) Target->Draw(VertexCount, StartVertexLocation);
+}
+
+void FRecordingCommandContext::DrawIndexed(uint32 IndexCount, uint32 StartIndexLocation, int32 BaseVertexLocation)
+{
+	FRHICommand& Command = Record(ERHICommandType::DrawIndexed);
+	Command.Args[0] = IndexCount;
+	Command.Args[1] = StartIndexLocation;
+	Command.Args[2] = static_cast<uint32>(BaseVertexLocation);
+	if (Target) Target->DrawIndexed(IndexCount, StartIndexLocation, BaseVertexLocation);
+}
+
+void FRecordingCommandContext::DrawInstanced(uint32 VertexCountPerInstance, uint32 InstanceCount, uint32 StartVertexLocation, uint32 StartInstanceLocation)
+{
+	FRHICommand& Command = Record(ERHICommandType::DrawInstanced);
+	Command.Args[0] = VertexCountPerInstance;
+	Command.Args[1] = InstanceCount;
+	Command.Args[2] = StartVertexLocation;
+	Command.Args[3] = StartInstanceLocation;
+	if (Target) Target->DrawInstanced(VertexCountPerInstance, InstanceCount, StartVertexLocation, StartInstanceLocation);
+}
+
+void FRecordingCommandContext::DrawIndexedInstanced(uint32 IndexCountPerInstance, uint32 InstanceCount, uint32 StartIndexLocation, int32 BaseVertexLocation, uint32 StartInstanceLocation)
+{
+	FRHICommand& Command = Record(ERHICommandType::DrawIndexedInstanced);
+	Command.Args[0] = IndexCountPerInstance;
+	Command.Args[1] = InstanceCount;
+	Command.Args[2] = StartIndexLocation;
+	Command.Args[3] = static_cast<uint32>(BaseVertexLocation);
+	Command.Args[4] = StartInstanceLocation;
+	if (Target) Target->DrawIndexedInstanced(IndexCountPerInstance, InstanceCount, StartIndexLocation, BaseVertexLocation, StartInstanceLocation);
+}
+
+// ==========================================================================
+// Replay / Diff
+
+void FRecordingCommandContext::Replay(FRHICommandContext& Destination) const
+{
+	for (const FRHICommand& Command : Commands)
+	{
+		const uint32* Args = Command.Args;
+		IUnknown* const* Res = Command.Resources;
+		const uint8* Data = Payload.data() + Command.PayloadOffset;
+
+		switch (Command.Type)
+		{
+		case ERHICommandType::SetInputLayout:		Destination.SetInputLayout(As<ID3D11InputLayout>(Res[0])); break;
+		case ERHICommandType::SetPrimitiveTopology:	Destination.SetPrimitiveTopology(static_cast<D3D11_PRIMITIVE_TOPOLOGY>(Args[0])); break;
+		case ERHICommandType::SetVertexBuffers:
+		{
+			ID3D11Buffer* Buffers[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT];
+			UINT Strides[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT];
+			UINT Offsets[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT];
+			for (uint32 i = 0; i < Args[1]; ++i)
+			{
+				FVertexBufferBinding Binding;
+				memcpy(&Binding, Data + i * sizeof(FVertexBufferBinding), sizeof(Binding));
+				Buffers[i] = Binding.Buffer;
+				Strides[i] = Binding.Stride;
+				Offsets[i] = Binding.Offset;
+			}
+			Destination.SetVertexBuffers(Args[0], Args[1], Buffers, Strides, Offsets);
+			break;
+		}
+		case ERHICommandType::SetIndexBuffer:		Destination.SetIndexBuffer(As<ID3D11Buffer>(Res[0]), static_cast<DXGI_FORMAT>(Args[0]), Args[1]); break;
+		case ERHICommandType::SetVertexShader:		Destination.SetVertexShader(As<ID3D11VertexShader>(Res[0])); break;
+		case ERHICommandType::SetPixelShader:		Destination.SetPixelShader(As<ID3D11PixelShader>(Res[0])); break;
+		case ERHICommandType::SetVSConstantBuffer:	Destination.SetVSConstantBuffer(Args[0], As<ID3D11Buffer>(Res[0])); break;
+		case ERHICommandType::SetPSConstantBuffer:	Destination.SetPSConstantBuffer(Args[0], As<ID3D11Buffer>(Res[0])); break;
+		case ERHICommandType::SetPSShaderResource:	Destination.SetPSShaderResource(Args[0], As<ID3D11ShaderResourceView>(Res[0])); break;
+		case ERHICommandType::SetPSSampler:			Destination.SetPSSampler(Args[0], As<ID3D11SamplerState>(Res[0])); break;
+		case ERHICommandType::SetRasterizerState:	Destination.SetRasterizerState(As<ID3D11RasterizerState>(Res[0])); break;
+		case ERHICommandType::SetDepthStencilState:	Destination.SetDepthStencilState(As<ID3D11DepthStencilState>(Res[0]), Args[0]); break;
+		case ERHICommandType::SetRenderTarget:		Destination.SetRenderTarget(As<ID3D11RenderTargetView>(Res[0]), As<ID3D11DepthStencilView>(Res[1])); break;
+		case ERHICommandType::SetViewport:
+		{
+			D3D11_VIEWPORT Viewport;
+			memcpy(&Viewport, Data, sizeof(Viewport));
+			Destination.SetViewport(Viewport);
+			break;
+		}
+		case ERHICommandType::ClearRenderTarget:
+		{
+			float Color[4];
+			memcpy(Color, Data, sizeof(Color));
+			Destination.ClearRenderTarget(As<ID3D11RenderTargetView>(Res[0]), Color);
+			break;
+		}
+		case ERHICommandType::ClearDepthStencil:	Destination.ClearDepthStencil(As<ID3D11DepthStencilView>(Res[0]), Args[0], BitsToFloat(Args[1]), static_cast<uint8>(Args[2])); break;
+		case ERHICommandType::WriteDynamicBuffer:	Destination.WriteDynamicBuffer(As<ID3D11Buffer>(Res[0]), Data, Args[0]); break;
+		case ERHICommandType::UpdateBuffer:			Destination.UpdateBuffer(As<ID3D11Buffer>(Res[0]), Data, Args[0]); break;
+		case ERHICommandType::Draw:					Destination.Draw(Args[0], Args[1]); break;
+		case ERHICommandType::DrawIndexed:			Destination.DrawIndexed(Args[0], Args[1], static_cast<int32>(Args[2])); break;
+		case ERHICommandType::DrawInstanced:		Destination.DrawInstanced(Args[0], Args[1], Args[2], Args[3]); break;
+		case ERHICommandType::DrawIndexedInstanced:	Destination.DrawIndexedInstanced(Args[0], Args[1], Args[2], static_cast<int32>(Args[3]), Args[4]); break;
+		default:
+			assert(false && "Unknown RHI command.");
+			break;
+		}
+	}
+}
+
+TOptional<uint32> FRecordingCommandContext::FindFirstDifference(const FRecordingCommandContext& Other) const
+{
+	const uint32 NumShared = static_cast<uint32>((std::min)(Commands.size(), Other.Commands.size()));
+	for (uint32 Index = 0; Index < NumShared; ++Index)
+	{
+		const FRHICommand& A = Commands[Index];
+		const FRHICommand& B = Other.Commands[Index];
+		if (A.Type != B.Type
+			|| memcmp(A.Args, B.Args, sizeof(A.Args)) != 0
+			|| A.Resources[0] != B.Resources[0]
+			|| A.Resources[1] != B.Resources[1]
+			|| A.PayloadSize != B.PayloadSize
+			|| (A.PayloadSize > 0 && memcmp(Payload.data() + A.PayloadOffset, Other.Payload.data() + B.PayloadOffset, A.PayloadSize) != 0))
+		{
+			return Index;
+		}
+	}
+
+	if (Commands.size() != Other.Commands.size())
+		return NumShared;
+
+	return std::nullopt;
+}
+
+FString FRecordingCommandContext::DescribeCommand(uint32 Index) const
+{
+	assert(Index < Commands.size());
+	const FRHICommand& Command = Commands[Index];
+
+	std::ostringstream Stream;
+	Stream << '#' << Index << ' ' << GetCommandName(Command.Type) << '(';
+	for (uint32 i = 0; i < 5; ++i)
+	{
+		Stream << (i ? ", " : "") << Command.Args[i];
+	}
+	Stream << ')';
+	for (IUnknown* Resource : Command.Resources)
+	{
+		if (Resource)
+		{
+			Stream << ' ' << static_cast<const void*>(Resource);
+		}
+	}
+	if (Command.PayloadSize > 0)
+	{
+		Stream << " +" << Command.PayloadSize << " bytes";
+	}
+	return Stream.str();
+}
+
+const char* FRecordingCommandContext::GetCommandName(ERHICommandType Type)
+{
+	switch (Type)
+	{
+	case ERHICommandType::SetInputLayout:		return "SetInputLayout";
+	case ERHICommandType::SetPrimitiveTopology:	return "SetPrimitiveTopology";
+	case ERHICommandType::SetVertexBuffers:		return "SetVertexBuffers";
+	case ERHICommandType::SetIndexBuffer:		return "SetIndexBuffer";
+	case ERHICommandType::SetVertexShader:		return "SetVertexShader";
+	case ERHICommandType::SetPixelShader:		return "SetPixelShader";
+	case ERHICommandType::SetVSConstantBuffer:	return "SetVSConstantBuffer";
+	case ERHICommandType::SetPSConstantBuffer:	return "SetPSConstantBuffer";
+	case ERHICommandType::SetPSShaderResource:	return "SetPSShaderResource";
+	case ERHICommandType::SetPSSampler:			return "SetPSSampler";
+	case ERHICommandType::SetRasterizerState:	return "SetRasterizerState";
+	case ERHICommandType::SetDepthStencilState:	return "SetDepthStencilState";
+	case ERHICommandType::SetRenderTarget:		return "SetRenderTarget";
+	case ERHICommandType::SetViewport:			return "SetViewport";
+	case ERHICommandType::ClearRenderTarget:	return "ClearRenderTarget";
+	case ERHICommandType::ClearDepthStencil:	return "ClearDepthStencil";
+	case ERHICommandType::WriteDynamicBuffer:	return "WriteDynamicBuffer";
+	case ERHICommandType::UpdateBuffer:			return "UpdateBuffer";
+	case ERHICommandType::Draw:					return "Draw";
+	case ERHICommandType::DrawIndexed:			return "DrawIndexed";
+	case ERHICommandType::DrawInstanced:		return "DrawInstanced";
+	case ERHICommandType::DrawIndexedInstanced:	return "DrawIndexedInstanced";
+	default:									return "Unknown";
+	}
+}
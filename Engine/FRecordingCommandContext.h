@@ -0,0 +1,147 @@
+﻿#pragma once
+#include "FRHICommandContext.h"
+#include "TArray.h"
+
+enum class ERHICommandType : uint8
+{
+	SetInputLayout,
+	SetPrimitiveTopology,
+	SetVertexBuffers,
+	SetIndexBuffer,
+	SetVertexShader,
+	SetPixelShader,
+	SetVSConstantBuffer,
+	SetPSConstantBuffer,
+	SetPSShaderResource,
+	SetPSSampler,
+	SetRasterizerState,
+	SetDepthStencilState,
+	SetRenderTarget,
+	SetViewport,
+	ClearRenderTarget,
+	ClearDepthStencil,
+	WriteDynamicBuffer,
+	UpdateBuffer,
+	Draw,
+	DrawIndexed,
+	DrawInstanced,
+	DrawIndexedInstanced,
+
+	Count
+};
+
+/**
+ * @brief One recorded call. Arguments that do not fit inline (vertex buffer bindings, clear
+ *        colors, viewports, buffer contents) live in the recorder's payload array.
+ */
+struct FRHICommand
+{
+	ERHICommandType Type;
+	uint32 Args[5] = {};
+	IUnknown* Resources[2] = {};
+	uint32 PayloadOffset = 0;
+	uint32 PayloadSize = 0;
+};
+
+/**
+ * @brief FRHICommandContext that captures every call into an in-memory command stream
+ *
+ * With a target context the calls are forwarded after being recorded, so a normal frame can be
+ * captured while it renders. Without one the recorder is a null backend: nothing reaches a GPU,
+ * buffer writes always succeed, GetDepthStencilState answers from the recorded state and
+ * CreateBuffer hands out placeholder buffers that only keep their description.
+ *
+ * A recording can be replayed into any other context and compared with another recording call by
+ * call (resources by identity, buffer writes by content), e.g. to check that a renderer change does
+ * not alter what a frame submits.
+ *
+ * @note: Resources referenced by the stream are AddRef'd until Reset, so a recording can be replayed
+ *        after the renderer has released per-draw objects.
+ */
+class FRecordingCommandContext : public FRHICommandContext
+{
+public:
+	explicit FRecordingCommandContext(FRHICommandContext* InTarget = nullptr);
+	virtual ~FRecordingCommandContext();
+
+	FRecordingCommandContext(const FRecordingCommandContext&) = delete;
+	FRecordingCommandContext& operator=(const FRecordingCommandContext&) = delete;
+
+	/** @brief Drops the recorded stream and counters (the tracked depth-stencil state is kept). */
+	void Reset();
+	/** @brief Issues the recorded stream, in order, on Target. */
+	void Replay(FRHICommandContext& Target) const;
+	/** @brief Index of the first command that differs from Other's stream (a missing tail counts), or none if identical. */
+	TOptional<uint32> FindFirstDifference(const FRecordingCommandContext& Other) const;
+	/** @brief Human-readable form of one recorded command for logs and diffs. */
+	FString DescribeCommand(uint32 Index) const;
+	static const char* GetCommandName(ERHICommandType Type);
+
+	const TArray<FRHICommand>& GetCommands() const { return Commands; }
+	uint32 GetNumCommands() const { return static_cast<uint32>(Commands.size()); }
+	uint32 GetCommandCount(ERHICommandType Type) const { return Counts[static_cast<uint32>(Type)]; }
+	/** @brief Draw, DrawIndexed, DrawInstanced and DrawIndexedInstanced together. */
+	uint32 GetNumDrawCalls() const;
+	/** @brief Bytes written by WriteDynamicBuffer and UpdateBuffer. */
+	uint64 GetNumBytesWritten() const { return NumBytesWritten; }
+	/** @brief Buffers created through CreateBuffer (not part of the command stream). */
+	uint32 GetNumBuffersCreated() const { return NumBuffersCreated; }
+	FRHICommandContext* GetTarget() const { return Target; }
+
+	virtual void SetInputLayout(ID3D11InputLayout* InputLayout) override;
+	virtual void SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY Topology) override;
+	virtual void SetVertexBuffers(uint32 StartSlot, uint32 NumBuffers, ID3D11Buffer* const* Buffers, const UINT* Strides, const UINT* Offsets) override;
+	virtual void SetIndexBuffer(ID3D11Buffer* Buffer, DXGI_FORMAT Format, uint32 Offset) override;
+
+	virtual void SetVertexShader(ID3D11VertexShader* Shader) override;
+	virtual void SetPixelShader(ID3D11PixelShader* Shader) override;
+	virtual void SetVSConstantBuffer(uint32 Slot, ID3D11Buffer* Buffer) override;
+	virtual void SetPSConstantBuffer(uint32 Slot, ID3D11Buffer* Buffer) override;
+	virtual void SetPSShaderResource(uint32 Slot, ID3D11ShaderResourceView* ShaderResourceView) override;
+	virtual void SetPSSampler(uint32 Slot, ID3D11SamplerState* Sampler) override;
+
+	virtual void SetRasterizerState(ID3D11RasterizerState* State) override;
+	virtual void SetDepthStencilState(ID3D11DepthStencilState* State, uint32 StencilRef) override;
+	virtual void GetDepthStencilState(ID3D11DepthStencilState** OutState, UINT* OutStencilRef) override;
+	virtual void SetRenderTarget(ID3D11RenderTargetView* RenderTargetView, ID3D11DepthStencilView* DepthStencilView) override;
+	virtual void SetViewport(const D3D11_VIEWPORT& Viewport) override;
+
+	virtual void ClearRenderTarget(ID3D11RenderTargetView* RenderTargetView, const float Color[4]) override;
+	virtual void ClearDepthStencil(ID3D11DepthStencilView* DepthStencilView, uint32 ClearFlags, float Depth, uint8 Stencil) override;
+
+	virtual ID3D11Buffer* CreateBuffer(const D3D11_BUFFER_DESC& Desc, const D3D11_SUBRESOURCE_DATA* InitialData) override;
+
+	virtual bool WriteDynamicBuffer(ID3D11Buffer* Buffer, const void* Data, uint32 Size) override;
+	virtual void UpdateBuffer(ID3D11Buffer* Buffer, const void* Data, uint32 Size) override;
+
+	virtual void Draw(uint32 VertexCount, uint32 StartVertexLocation) override;
+	virtual void DrawIndexed(uint32 IndexCount, uint32 StartIndexLocation, int32 BaseVertexLocation) override;
+	virtual void DrawInstanced(uint32 VertexCountPerInstance, uint32 InstanceCount, uint32 StartVertexLocation, uint32 StartInstanceLocation) override;
+	virtual void DrawIndexedInstanced(uint32 IndexCountPerInstance, uint32 InstanceCount, uint32 StartIndexLocation, int32 BaseVertexLocation, uint32 StartInstanceLocation) override;
+
+private:
+	struct FVertexBufferBinding
+	{
+		ID3D11Buffer* Buffer;
+		UINT Stride;
+		UINT Offset;
+	};
+
+	FRHICommand& Record(ERHICommandType Type, IUnknown* Resource0 = nullptr, IUnknown* Resource1 = nullptr);
+	void AppendPayload(FRHICommand& Command, const void* Data, uint32 Size);
+	/** @brief Keeps Resource alive until Reset. */
+	void Retain(IUnknown* Resource);
+
+	FRHICommandContext* Target;
+
+	TArray<FRHICommand> Commands;
+	TArray<uint8> Payload;
+	TArray<IUnknown*> RetainedResources;
+	uint32 Counts[static_cast<uint32>(ERHICommandType::Count)] = {};
+	uint64 NumBytesWritten = 0;
+	uint32 NumBuffersCreated = 0;
+
+	// 타깃이 없을 때 GetDepthStencilState 응답용 (참조 유지)
+	ID3D11DepthStencilState* CurrentDepthStencilState = nullptr;
+	uint32 CurrentStencilRef = 0;
+};
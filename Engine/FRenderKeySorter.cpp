@@ -0,0 +1,143 @@
+﻿#include "stdafx.h"
+#include "FRenderKeySorter.h"
+
+void FRenderKeySorter::Reset()
+{
+	LastSubmission.clear();
+	LastSortedEntries.clear();
+}
+
+void FRenderKeySorter::SortEntriesDescending(TArray<FSortEntry>& Entries, uint32 KeyBits)
+{
+	/** Below this the histogram passes cost more than comparing. */
+	if (Entries.size() < RadixSortMinEntries)
+	{
+		std::sort(Entries.begin(), Entries.end(),
+			[](const FSortEntry& lhs, const FSortEntry& rhs) {
+			return lhs.Key > rhs.Key;
+		});
+	}
+	else
+	{
+		RadixSorter.SortDescending(Entries, KeyBits);
+	}
+}
+
+bool FRenderKeySorter::SortFromLastOrder(const TArray<FKeyedItem>& Items, uint32 KeyBits)
+{
+	const uint32 NumItems = static_cast<uint32>(Items.size());
+	const size_t MaxChanged = static_cast<size_t>(NumItems * CoherentMaxChangedFraction);
+
+	/** Look at every 16th entry first, so a frame where many keys changed does not pay for a scan it then throws away. */
+	size_t NumSampled = 0;
+	size_t NumSampledChanged = 0;
+	for (uint32 i = 0; i < NumItems; i += 16)
+	{
+		const FSortEntry& Last = LastSortedEntries[i];
+		NumSampledChanged += Items[Last.Index].first != Last.Key;
+		++NumSampled;
+	}
+	if (NumSampledChanged > NumSampled * CoherentMaxChangedFraction)
+	{
+		return false;
+	}
+
+	/** Unchanged entries keep their relative order at the front, changed ones are sorted on their own. */
+	ChangedEntries.clear();
+	uint32 NumUnchanged = 0;
+	for (const FSortEntry& Last : LastSortedEntries)
+	{
+		const uint64 Key = Items[Last.Index].first;
+		if (Key == Last.Key)
+		{
+			SortEntries[NumUnchanged++] = Last;
+		}
+		else if (ChangedEntries.size() < MaxChanged)
+		{
+			ChangedEntries.push_back({ Key, Last.Index });
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	if (!ChangedEntries.empty())
+	{
+		SortEntriesDescending(ChangedEntries, KeyBits);
+
+		// 뒤에서부터 병합하면 SortEntries 안에서 바로 합칠 수 있음
+		int64 Unchanged = static_cast<int64>(NumUnchanged) - 1;
+		int64 Changed = static_cast<int64>(ChangedEntries.size()) - 1;
+		for (int64 Out = NumItems - 1; Changed >= 0; --Out)
+		{
+			if (Unchanged >= 0 && SortEntries[Unchanged].Key < ChangedEntries[Changed].Key)
+			{
+				SortEntries[Out] = SortEntries[Unchanged--];
+			}
+			else
+			{
+				SortEntries[Out] = ChangedEntries[Changed--];
+			}
+		}
+	}
+	return true;
+}
+
+void FRenderKeySorter::SortDescending(TArray<FKeyedItem>& Items, uint32 KeyBits, ERenderSortMode Mode)
+{
+	if (Mode == ERenderSortMode::Std)
+	{
+		std::sort(Items.begin(), Items.end(),
+			[](const auto& lhs, const auto& rhs) {
+			return lhs.first > rhs.first;
+		});
+		Reset();
+		return;
+	}
+
+	const uint32 NumItems = static_cast<uint32>(Items.size());
+
+	/** The same items submitted in the same order as last frame: last frame's order is still valid for every entry whose key did not change. */
+	bool bReuseOrder = Mode == ERenderSortMode::Coherent && LastSubmission.size() == NumItems;
+	for (uint32 i = 0; bReuseOrder && i < NumItems; ++i)
+	{
+		bReuseOrder = LastSubmission[i] == Items[i].second;
+	}
+
+	SortEntries.resize(NumItems);
+	if (!bReuseOrder || !SortFromLastOrder(Items, KeyBits))
+	{
+		for (uint32 i = 0; i < NumItems; ++i)
+		{
+			SortEntries[i] = { Items[i].first, i };
+		}
+		SortEntriesDescending(SortEntries, KeyBits);
+	}
+
+	SortedItems.resize(NumItems);
+	for (uint32 i = 0; i < NumItems; ++i)
+	{
+		SortedItems[i] = Items[SortEntries[i].Index];
+	}
+
+	if (Mode == ERenderSortMode::Coherent)
+	{
+		// 같은 제출이면 LastSubmission은 이미 같음. SortEntries는 다음 프레임에 전부 다시 쓰므로 복사 대신 교환
+		if (!bReuseOrder)
+		{
+			LastSubmission.resize(NumItems);
+			for (uint32 i = 0; i < NumItems; ++i)
+			{
+				LastSubmission[i] = Items[i].second;
+			}
+		}
+		LastSortedEntries.swap(SortEntries);
+	}
+	else
+	{
+		Reset();
+	}
+
+	Items.swap(SortedItems);
+}
@@ -0,0 +1,65 @@
+﻿#pragma once
+#include "TArray.h"
+#include "TRadixSorter.h"
+#include "UEngineStatics.h"
+
+/** @brief: Selected by [Graphics] RenderSort in editor.ini. */
+enum class ERenderSortMode : uint8
+{
+	/** Comparison sort every frame. */
+	Std,
+	/** Radix sort on the render key every frame. */
+	Radix,
+	/** Keep last frame's order and only sort the entries whose key changed, if the submission did not change and few keys changed; Radix otherwise. */
+	Coherent,
+};
+
+/**
+ * @brief Orders (render key, item) pairs by descending key, once per frame
+ *
+ * The item half of each pair identifies what was submitted (UBatchRenderer passes draw packet
+ * indices). In Coherent mode the sorter remembers the submitted items and last frame's sorted
+ * order. When the next frame submits the same items in the same order, entries whose key did not
+ * change keep their old order and only the changed ones are sorted and merged back in. Once more than
+ * CoherentMaxChangedFraction of the keys changed, splitting and merging costs more than a full radix
+ * sort, so the frame is sorted from scratch instead.
+ *
+ * @note: Keeps its scratch arrays between calls; use one sorter per submission stream.
+ */
+class FRenderKeySorter
+{
+public:
+	using FKeyedItem = std::pair<uint64, uint32>;
+
+	/** @brief: Smaller arrays are sorted with std::sort even in Radix and Coherent modes. */
+	static constexpr uint32 RadixSortMinEntries = 1536;
+
+	/** @brief: Coherent mode falls back to a full sort when more than this fraction of the keys changed since last frame. */
+	static constexpr float CoherentMaxChangedFraction = 0.05f;
+
+	/** @param KeyBits Number of low key bits that can be set (RenderKeyManager::GetNumBits()). */
+	void SortDescending(TArray<FKeyedItem>& Items, uint32 KeyBits, ERenderSortMode Mode);
+
+	/** @brief: Forgets last frame's order, so the next Coherent sort starts from scratch. */
+	void Reset();
+
+private:
+	struct FSortEntry
+	{
+		uint64 Key;
+		/** @brief: Index into the submitted array. */
+		uint32 Index;
+	};
+
+	void SortEntriesDescending(TArray<FSortEntry>& Entries, uint32 KeyBits);
+	/** @brief: Fills SortEntries from last frame's order; false (SortEntries unspecified) if too many keys changed. */
+	bool SortFromLastOrder(const TArray<FKeyedItem>& Items, uint32 KeyBits);
+
+	TRadixSorter<FSortEntry> RadixSorter;
+	TArray<FSortEntry> SortEntries;
+	TArray<FSortEntry> ChangedEntries;
+	TArray<FKeyedItem> SortedItems;
+	/** @brief: Last frame's submitted items and their sorted entries, for Coherent mode. */
+	TArray<uint32> LastSubmission;
+	TArray<FSortEntry> LastSortedEntries;
+};
@@ -0,0 +1,70 @@
+﻿#pragma once
+#include "TArray.h"
+#include "UEngineStatics.h"
+#include "json.hpp"
+
+class AActor;
+class USceneComponent;
+class UClass;
+
+enum class ESceneCommand : uint8
+{
+	DestroyActor,
+	DestroyObject,
+	SpawnActor,
+	AddObject,
+	Attach,
+	Detach,
+};
+
+struct FSceneCommand
+{
+	ESceneCommand Type;
+	AActor* Actor = nullptr;
+	USceneComponent* Component = nullptr;
+	USceneComponent* Parent = nullptr;	// Attach 전용
+
+	// SpawnActor/AddObject 전용: 객체는 적용 시점에 게임 스레드에서 Class로 생성하고 Params로 Deserialize
+	// (워커에서 UObject를 만들면 GUObjectArray, 클래스 목록, 이름 풀을 잠금 없이 건드리게 됨)
+	UClass* Class = nullptr;
+	json::JSON Params;
+};
+
+/**
+ * @brief Structural scene changes recorded during a parallel tick
+ *
+ * Each job-system thread records into its own buffer (see UScene::GetCommandBuffer), so recording
+ * never locks. UScene applies the buffers in thread order at the end of the tick. New objects are
+ * recorded as class + properties and only constructed then, on the game thread.
+ */
+class FSceneCommandBuffer
+{
+public:
+	void DestroyActor(AActor* actor) { Commands.push_back({ ESceneCommand::DestroyActor, actor }); }
+	void DestroyObject(USceneComponent* component) { Commands.push_back({ ESceneCommand::DestroyObject, nullptr, component }); }
+	/**
+	 * @brief Spawns an actor of actorClass when the buffer is applied.
+	 * @param params Passed to Deserialize after construction; null keeps the class defaults.
+	 */
+	void SpawnActor(UClass* actorClass, json::JSON params = json::JSON()) { PushConstruct(ESceneCommand::SpawnActor, actorClass, std::move(params)); }
+
+	/** @brief Adds a scene object of componentClass when the buffer is applied. See SpawnActor. */
+	void AddObject(UClass* componentClass, json::JSON params = json::JSON()) { PushConstruct(ESceneCommand::AddObject, componentClass, std::move(params)); }
+	void Attach(USceneComponent* child, USceneComponent* parent) { Commands.push_back({ ESceneCommand::Attach, nullptr, child, parent }); }
+	void Detach(USceneComponent* child) { Commands.push_back({ ESceneCommand::Detach, nullptr, child }); }
+
+	const TArray<FSceneCommand>& GetCommands() const { return Commands; }
+	bool IsEmpty() const { return Commands.empty(); }
+	void Reset() { Commands.clear(); }
+
+private:
+	void PushConstruct(ESceneCommand type, UClass* objectClass, json::JSON&& params)
+	{
+		FSceneCommand& command = Commands.emplace_back();
+		command.Type = type;
+		command.Class = objectClass;
+		command.Params = std::move(params);
+	}
+
+	TArray<FSceneCommand> Commands;
+};
@@ -0,0 +1,354 @@
+﻿#include "stdafx.h"
+#include "FSceneStreamer.h"
+#include "UScene.h"
+#include "USceneComponent.h"
+#include <chrono>
+
+FSceneStreamer::FSceneStreamer(UScene* InScene, const json::JSON& Partition, const FString& BaseDirectory, const FSettings& InSettings)
+	: Scene(InScene)
+	, Settings(InSettings)
+{
+	// 손으로 쓴 파일은 정수일 수도 있음
+	bool bIsFloat = false;
+	CellSize = static_cast<float>(Partition.at("CellSize").ToFloat(bIsFloat));
+	if (!bIsFloat)
+	{
+		CellSize = static_cast<float>(Partition.at("CellSize").ToInt());
+	}
+	if (CellSize <= 0.0f)
+	{
+		CellSize = 1.0f;
+	}
+
+	RelativeDirectory = Partition.at("Directory").ToString();
+	Directory = (std::filesystem::path(BaseDirectory) / RelativeDirectory).string();
+
+	if (Partition.hasKey("Cells"))
+	{
+		for (const json::JSON& cellJson : Partition.at("Cells").ArrayRange())
+		{
+			FCell Cell;
+			Cell.X = cellJson.at(0u).ToInt();
+			Cell.Y = cellJson.at(1u).ToInt();
+			Cells.emplace(PackKey(Cell.X, Cell.Y), std::move(Cell));
+		}
+	}
+
+	LoaderThread = std::thread(&FSceneStreamer::LoaderMain, this);
+}
+
+FSceneStreamer::~FSceneStreamer()
+{
+	{
+		std::lock_guard<std::mutex> Lock(Mutex);
+		bStopping = true;
+		Requests.clear();
+	}
+	WakeCondition.notify_all();
+	LoaderThread.join();
+}
+
+FString FSceneStreamer::GetCellFileName(int32 X, int32 Y)
+{
+	return std::to_string(X) + "_" + std::to_string(Y) + ".json";
+}
+
+json::JSON FSceneStreamer::GetPartitionJson() const
+{
+	json::JSON Result;
+	Result["CellSize"] = CellSize;
+	Result["Directory"] = RelativeDirectory;
+	Result["Cells"] = json::Array();
+	for (const auto& [Key, Cell] : Cells)
+	{
+		Result["Cells"].append(json::Array(Cell.X, Cell.Y));
+	}
+	return Result;
+}
+
+void FSceneStreamer::CollectStreamedObjects(TArray<USceneComponent*>& OutObjects) const
+{
+	for (uint64 Key : ActiveCells)
+	{
+		for (const TWeakObjectPtr<USceneComponent>& Object : Cells.at(Key).Objects)
+		{
+			if (USceneComponent* Component = Object.Get())
+			{
+				OutObjects.push_back(Component);
+			}
+		}
+	}
+}
+
+float FSceneStreamer::DistanceToCell(const FCell& Cell, const FVector& ViewLocation) const
+{
+	// 셀 사각형까지의 XY 거리 (안에 있으면 0)
+	const float MinX = Cell.X * CellSize, MinY = Cell.Y * CellSize;
+	const float DX = (std::max)((std::max)(MinX - ViewLocation.X, ViewLocation.X - (MinX + CellSize)), 0.0f);
+	const float DY = (std::max)((std::max)(MinY - ViewLocation.Y, ViewLocation.Y - (MinY + CellSize)), 0.0f);
+	return sqrtf(DX * DX + DY * DY);
+}
+
+void FSceneStreamer::Activate(uint64 Key, FCell& Cell)
+{
+	if (!Cell.bActive)
+	{
+		Cell.bActive = true;
+		ActiveCells.push_back(Key);
+	}
+}
+
+void FSceneStreamer::Update(const FVector& ViewLocation)
+{
+	ReceiveLoadResults();
+
+	// 언로드 거리 밖으로 나간 셀: 로딩 중이면 취소, 생성 중/상주 중이면 삭제 시작
+	const float UnloadDistance = Settings.LoadRadius + Settings.UnloadHysteresis;
+	TArray<uint64> Cancelled;
+	for (uint64 Key : ActiveCells)
+	{
+		FCell& Cell = Cells.at(Key);
+		if (DistanceToCell(Cell, ViewLocation) <= UnloadDistance)
+			continue;
+
+		switch (Cell.State)
+		{
+		case ECellState::Loading:
+			Cell.State = ECellState::Unloaded;
+			Cancelled.push_back(Key);
+			break;
+		case ECellState::Committing:
+			Cell.PendingObjects.clear();
+			Cell.PendingObjects.shrink_to_fit();
+			Cell.State = ECellState::Unloading;
+			break;
+		case ECellState::Resident:
+			--NumResident;
+			Cell.State = ECellState::Unloading;
+			break;
+		default:
+			break;
+		}
+	}
+
+	// 아직 IO 스레드가 집어 가지 않은 요청은 큐에서 바로 제거 (이미 읽는 중이면 결과를 버림)
+	if (!Cancelled.empty())
+	{
+		std::lock_guard<std::mutex> Lock(Mutex);
+		for (uint64 Key : Cancelled)
+		{
+			auto It = std::find(Requests.begin(), Requests.end(), Key);
+			if (It != Requests.end())
+			{
+				Requests.erase(It);
+				--NumInFlight;
+			}
+		}
+	}
+
+	RequestCells(ViewLocation);
+	CommitCells();
+	UnloadCells();
+
+	// 다시 Unloaded가 된 셀은 활성 목록에서 뺌
+	ActiveCells.erase(std::remove_if(ActiveCells.begin(), ActiveCells.end(), [this](uint64 Key) {
+		FCell& Cell = Cells.at(Key);
+		if (Cell.State != ECellState::Unloaded)
+			return false;
+		Cell.bActive = false;
+		return true;
+	}), ActiveCells.end());
+}
+
+void FSceneStreamer::ReceiveLoadResults()
+{
+	TArray<FLoadResult> Received;
+	{
+		std::lock_guard<std::mutex> Lock(Mutex);
+		Received.swap(Results);
+	}
+
+	for (FLoadResult& Result : Received)
+	{
+		--NumInFlight;
+
+		// 요청 뒤에 멀어져 취소된 셀이면 버림
+		FCell& Cell = Cells.at(Result.Key);
+		if (Cell.State != ECellState::Loading)
+			continue;
+
+		Cell.PendingObjects = std::move(Result.Objects);
+		Cell.CommitCursor = 0;
+		Cell.State = ECellState::Committing;
+	}
+}
+
+void FSceneStreamer::RequestCells(const FVector& ViewLocation)
+{
+	if (NumInFlight >= Settings.MaxInFlightLoads)
+		return;
+
+	// 반경 안의 셀을 가까운 순으로 요청. 범위의 좌표 수가 셀 수보다 많으면 셀 목록을 훑음
+	RequestCandidates.clear();
+	auto Consider = [this, &ViewLocation](uint64 Key, FCell& Cell) {
+		if (Cell.State != ECellState::Unloaded)
+			return;
+		const float Distance = DistanceToCell(Cell, ViewLocation);
+		if (Distance <= Settings.LoadRadius)
+		{
+			RequestCandidates.push_back({ Distance, Key });
+		}
+	};
+
+	const int32 MinX = ToCellCoord(ViewLocation.X - Settings.LoadRadius, CellSize);
+	const int32 MaxX = ToCellCoord(ViewLocation.X + Settings.LoadRadius, CellSize);
+	const int32 MinY = ToCellCoord(ViewLocation.Y - Settings.LoadRadius, CellSize);
+	const int32 MaxY = ToCellCoord(ViewLocation.Y + Settings.LoadRadius, CellSize);
+	const uint64 RangeCount = static_cast<uint64>(MaxX - MinX + 1) * static_cast<uint64>(MaxY - MinY + 1);
+	if (RangeCount > Cells.size())
+	{
+		for (auto& [Key, Cell] : Cells)
+		{
+			Consider(Key, Cell);
+		}
+	}
+	else
+	{
+		for (int32 Y = MinY; Y <= MaxY; ++Y)
+		{
+			for (int32 X = MinX; X <= MaxX; ++X)
+			{
+				auto It = Cells.find(PackKey(X, Y));
+				if (It != Cells.end())
+				{
+					Consider(It->first, It->second);
+				}
+			}
+		}
+	}
+
+	if (RequestCandidates.empty())
+		return;
+
+	std::sort(RequestCandidates.begin(), RequestCandidates.end());
+	{
+		std::lock_guard<std::mutex> Lock(Mutex);
+		for (const auto& [Distance, Key] : RequestCandidates)
+		{
+			if (NumInFlight >= Settings.MaxInFlightLoads)
+				break;
+
+			FCell& Cell = Cells.at(Key);
+			Cell.State = ECellState::Loading;
+			Activate(Key, Cell);
+			Requests.push_back(Key);
+			++NumInFlight;
+		}
+	}
+	WakeCondition.notify_one();
+}
+
+void FSceneStreamer::CommitCells()
+{
+	using FClock = std::chrono::steady_clock;
+	const FClock::time_point Deadline = FClock::now()
+		+ std::chrono::duration_cast<FClock::duration>(std::chrono::duration<float, std::milli>(Settings.CommitBudgetMs));
+
+	// 프레임마다 최소 한 개는 생성해서 예산이 아주 작아도 진행되게 함
+	bool bCommittedAny = false;
+	for (uint64 Key : ActiveCells)
+	{
+		FCell& Cell = Cells.at(Key);
+		if (Cell.State != ECellState::Committing)
+			continue;
+
+		while (Cell.CommitCursor < Cell.PendingObjects.size())
+		{
+			if (bCommittedAny && FClock::now() >= Deadline)
+				return;
+
+			if (USceneComponent* Component = UScene::CreateObjectFromJson(Cell.PendingObjects[Cell.CommitCursor]))
+			{
+				Scene->AddObject(Component);
+				Cell.Objects.push_back(Component);
+			}
+			++Cell.CommitCursor;
+			bCommittedAny = true;
+		}
+
+		Cell.PendingObjects.clear();
+		Cell.PendingObjects.shrink_to_fit();
+		Cell.State = ECellState::Resident;
+		++NumResident;
+	}
+}
+
+void FSceneStreamer::UnloadCells()
+{
+	// 표시된 객체는 이번 프레임 UScene::FlushPendingDestroy에서 한 번에 삭제됨
+	uint32 Budget = Settings.MaxUnloadsPerFrame;
+	for (uint64 Key : ActiveCells)
+	{
+		FCell& Cell = Cells.at(Key);
+		if (Cell.State != ECellState::Unloading)
+			continue;
+
+		while (!Cell.Objects.empty())
+		{
+			if (Budget == 0)
+				return;
+
+			if (USceneComponent* Component = Cell.Objects.back().Get())
+			{
+				Component->markedAsDestroyed = true;
+				--Budget;
+			}
+			Cell.Objects.pop_back();
+		}
+
+		Cell.Objects.shrink_to_fit();
+		Cell.State = ECellState::Unloaded;
+	}
+}
+
+void FSceneStreamer::LoaderMain()
+{
+	for (;;)
+	{
+		uint64 Key;
+		{
+			std::unique_lock<std::mutex> Lock(Mutex);
+			WakeCondition.wait(Lock, [this] { return bStopping || !Requests.empty(); });
+			if (bStopping)
+				return;
+
+			Key = Requests.front();
+			Requests.pop_front();
+		}
+
+		// 파일 읽기와 JSON 파싱은 게임 스레드 밖에서
+		const int32 X = static_cast<int32>(static_cast<uint32>(Key >> 32));
+		const int32 Y = static_cast<int32>(static_cast<uint32>(Key));
+		FLoadResult Result{ Key, {} };
+
+		std::ifstream File((std::filesystem::path(Directory) / GetCellFileName(X, Y)).string());
+		if (File)
+		{
+			std::stringstream Buffer;
+			Buffer << File.rdbuf();
+			json::JSON CellData = json::JSON::Load(Buffer.str());
+			if (CellData.hasKey("Primitives"))
+			{
+				json::JSON& Primitives = CellData["Primitives"];
+				Result.Objects.reserve(Primitives.size());
+				for (auto& Primitive : Primitives.ObjectRange())
+				{
+					Result.Objects.push_back(std::move(Primitive.second));
+				}
+			}
+		}
+
+		std::lock_guard<std::mutex> Lock(Mutex);
+		Results.push_back(std::move(Result));
+	}
+}
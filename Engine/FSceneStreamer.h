@@ -0,0 +1,131 @@
+﻿#pragma once
+#include "TArray.h"
+#include "TWeakObjectPtr.h"
+#include "Vector.h"
+#include "json.hpp"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+class UScene;
+class USceneComponent;
+
+/**
+ * @brief Loads and unloads the grid cells of a partitioned scene around the viewer
+ *
+ * A partitioned scene keeps its streamed primitives out of the main file. They are split by
+ * world XY location into square cells, one JSON chunk per cell ({"Primitives": {...}} in the same
+ * format as the scene file). Reading and parsing a chunk happens on a dedicated IO thread. The game
+ * thread only turns already parsed objects into components, and stops once CommitBudgetMs is spent,
+ * so a large cell is spread over several frames instead of causing a hitch.
+ *
+ * Cells closer than LoadRadius are requested nearest first. Resident cells are released once they
+ * are farther than LoadRadius + UnloadHysteresis, so a viewer moving along a cell edge does not
+ * thrash. At most MaxInFlightLoads chunks are queued or parsed ahead of commit, which bounds the
+ * memory held outside the scene to the cells around the viewer.
+ *
+ * @note: Streamed cells are content, not editor state. Objects committed from a cell are left out of
+ *        UScene::Serialize, so edits to them are not saved.
+ */
+class FSceneStreamer
+{
+public:
+	struct FSettings
+	{
+		float LoadRadius = 100.0f;
+		float UnloadHysteresis = 20.0f;
+		float CommitBudgetMs = 2.0f;
+		uint32 MaxInFlightLoads = 8;
+		uint32 MaxUnloadsPerFrame = 256;
+	};
+
+	/**
+	 * @param Partition The scene file's "Partition" block (CellSize, Directory, Cells).
+	 * @param BaseDirectory Folder the scene file was loaded from; Directory is relative to it.
+	 */
+	FSceneStreamer(UScene* InScene, const json::JSON& Partition, const FString& BaseDirectory, const FSettings& InSettings);
+	~FSceneStreamer();
+
+	FSceneStreamer(const FSceneStreamer&) = delete;
+	FSceneStreamer& operator=(const FSceneStreamer&) = delete;
+
+	/** @brief Game thread, once per frame: requests, commits and unloads cells for the viewer at ViewLocation. */
+	void Update(const FVector& ViewLocation);
+
+	/** @brief The "Partition" block to write back into the scene file. */
+	json::JSON GetPartitionJson() const;
+	/** @brief Appends every live object that came from a cell (UScene::Serialize skips these). */
+	void CollectStreamedObjects(TArray<USceneComponent*>& OutObjects) const;
+
+	uint32 GetNumCells() const { return static_cast<uint32>(Cells.size()); }
+	uint32 GetNumResidentCells() const { return NumResident; }
+	uint32 GetNumLoadingCells() const { return NumInFlight; }
+
+	/** @brief Chunk file name of the cell at (X, Y) inside the partition directory. */
+	static FString GetCellFileName(int32 X, int32 Y);
+	static int32 ToCellCoord(float Value, float CellSize) { return static_cast<int32>(floorf(Value / CellSize)); }
+
+private:
+	enum class ECellState : uint8
+	{
+		Unloaded,
+		Loading,		// IO 스레드에 요청됨
+		Committing,		// 파싱 완료, 게임 스레드에서 나눠서 생성 중
+		Resident,
+		Unloading,		// 게임 스레드에서 나눠서 삭제 중
+	};
+
+	struct FCell
+	{
+		int32 X = 0, Y = 0;
+		ECellState State = ECellState::Unloaded;
+		TArray<json::JSON> PendingObjects;	// Committing 동안만 유지
+		uint32 CommitCursor = 0;
+		TArray<TWeakObjectPtr<USceneComponent>> Objects;
+		bool bActive = false;				// ActiveCells에 들어 있는지
+	};
+
+	struct FLoadResult
+	{
+		uint64 Key;
+		TArray<json::JSON> Objects;
+	};
+
+	static uint64 PackKey(int32 X, int32 Y)
+	{
+		return (static_cast<uint64>(static_cast<uint32>(X)) << 32) | static_cast<uint32>(Y);
+	}
+
+	float DistanceToCell(const FCell& Cell, const FVector& ViewLocation) const;
+	void Activate(uint64 Key, FCell& Cell);
+
+	void ReceiveLoadResults();
+	void RequestCells(const FVector& ViewLocation);
+	void CommitCells();
+	void UnloadCells();
+
+	/** @brief IO thread: reads and parses requested chunks until stopped. */
+	void LoaderMain();
+
+	UScene* Scene;
+	FSettings Settings;
+	float CellSize;
+	FString RelativeDirectory;
+	FString Directory;
+
+	TMap<uint64, FCell> Cells;
+	TArray<uint64> ActiveCells;		// Unloaded가 아닌 셀 (매 프레임 이것만 훑음)
+	TArray<std::pair<float, uint64>> RequestCandidates;
+	uint32 NumResident = 0;
+	uint32 NumInFlight = 0;			// 요청했지만 결과를 아직 받지 않은 청크
+
+	// IO 스레드와 공유 (Mutex로 보호)
+	std::mutex Mutex;
+	std::condition_variable WakeCondition;
+	std::deque<uint64> Requests;
+	TArray<FLoadResult> Results;
+	bool bStopping = false;
+
+	std::thread LoaderThread;
+};
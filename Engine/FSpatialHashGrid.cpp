@@ -0,0 +1,261 @@
+﻿#include "stdafx.h"
+#include "FSpatialHashGrid.h"
+
+namespace
+{
+	// 축마다 21비트 (±2^20 셀)로 묶어 64비트 키 하나로 만듦
+	constexpr int32 CoordBits = 21;
+	constexpr int32 CoordBias = 1 << (CoordBits - 1);
+	constexpr int32 CoordMin = -CoordBias;
+	constexpr int32 CoordMax = CoordBias - 1;
+	constexpr uint64 CoordMask = (1ull << CoordBits) - 1;
+
+	int32 ClampCoord(float Value)
+	{
+		const float Floored = floorf(Value);
+		if (Floored < static_cast<float>(CoordMin)) return CoordMin;
+		if (Floored > static_cast<float>(CoordMax)) return CoordMax;
+		return static_cast<int32>(Floored);
+	}
+}
+
+FSpatialHashGrid::FSpatialHashGrid(float InCellSize)
+	: CellSize(InCellSize > 0.0f ? InCellSize : 1.0f)
+	, InvCellSize(1.0f / CellSize)
+{
+}
+
+void FSpatialHashGrid::SetCellSize(float InCellSize)
+{
+	if (InCellSize <= 0.0f || InCellSize == CellSize)
+		return;
+
+	// 셀 배열에서 위치를 꺼내 두고 새 크기로 다시 분배
+	TArray<FVector> Positions(Entries.size());
+	for (uint32 Handle = 0; Handle < Entries.size(); ++Handle)
+	{
+		if (Entries[Handle].Actor)
+		{
+			Positions[Handle] = GetPosition(Handle);
+		}
+	}
+
+	CellSize = InCellSize;
+	InvCellSize = 1.0f / CellSize;
+	Cells.clear();
+
+	for (uint32 Handle = 0; Handle < Entries.size(); ++Handle)
+	{
+		if (Entries[Handle].Actor)
+		{
+			InsertIntoCell(Handle, PackKey(ToCell(Positions[Handle])), Positions[Handle]);
+		}
+	}
+}
+
+FSpatialHashGrid::FCellCoord FSpatialHashGrid::ToCell(const FVector& Position) const
+{
+	return { ClampCoord(Position.X * InvCellSize), ClampCoord(Position.Y * InvCellSize), ClampCoord(Position.Z * InvCellSize) };
+}
+
+uint64 FSpatialHashGrid::PackKey(const FCellCoord& Coord)
+{
+	return (static_cast<uint64>(Coord.X + CoordBias) & CoordMask)
+		| ((static_cast<uint64>(Coord.Y + CoordBias) & CoordMask) << CoordBits)
+		| ((static_cast<uint64>(Coord.Z + CoordBias) & CoordMask) << (2 * CoordBits));
+}
+
+FSpatialHashGrid::FCellCoord FSpatialHashGrid::UnpackKey(uint64 Key)
+{
+	return {
+		static_cast<int32>(Key & CoordMask) - CoordBias,
+		static_cast<int32>((Key >> CoordBits) & CoordMask) - CoordBias,
+		static_cast<int32>((Key >> (2 * CoordBits)) & CoordMask) - CoordBias };
+}
+
+uint32 FSpatialHashGrid::Add(AActor* Actor, const FVector& Position)
+{
+	assert(Actor && "FSpatialHashGrid entries need an actor");
+
+	uint32 Handle;
+	if (FreeList != InvalidHandle)
+	{
+		Handle = FreeList;
+		FreeList = Entries[Handle].SlotInCell;
+	}
+	else
+	{
+		Handle = static_cast<uint32>(Entries.size());
+		Entries.emplace_back();
+	}
+
+	Entries[Handle].Actor = Actor;
+	InsertIntoCell(Handle, PackKey(ToCell(Position)), Position);
+	++NumEntries;
+	return Handle;
+}
+
+void FSpatialHashGrid::Remove(uint32 Handle)
+{
+	assert(Handle < Entries.size() && Entries[Handle].Actor);
+
+	RemoveFromCell(Handle);
+	Entries[Handle].Actor = nullptr;
+	Entries[Handle].SlotInCell = FreeList;
+	FreeList = Handle;
+	--NumEntries;
+}
+
+void FSpatialHashGrid::Move(uint32 Handle, const FVector& Position)
+{
+	assert(Handle < Entries.size() && Entries[Handle].Actor);
+
+	FEntry& Entry = Entries[Handle];
+	const uint64 NewKey = PackKey(ToCell(Position));
+	if (NewKey == Entry.CellKey)
+	{
+		// 같은 셀 안의 이동은 위치만 갱신
+		Cells.find(NewKey)->second[Entry.SlotInCell].Position = Position;
+		return;
+	}
+
+	RemoveFromCell(Handle);
+	InsertIntoCell(Handle, NewKey, Position);
+}
+
+void FSpatialHashGrid::Clear()
+{
+	Entries.clear();
+	Cells.clear();
+	FreeList = InvalidHandle;
+	NumEntries = 0;
+}
+
+const FVector& FSpatialHashGrid::GetPosition(uint32 Handle) const
+{
+	const FEntry& Entry = Entries[Handle];
+	return Cells.find(Entry.CellKey)->second[Entry.SlotInCell].Position;
+}
+
+void FSpatialHashGrid::InsertIntoCell(uint32 Handle, uint64 Key, const FVector& Position)
+{
+	TArray<FCellItem>& Items = Cells[Key];
+	FEntry& Entry = Entries[Handle];
+	Entry.CellKey = Key;
+	Entry.SlotInCell = static_cast<uint32>(Items.size());
+	Items.push_back({ Position, Entry.Actor, Handle });
+}
+
+void FSpatialHashGrid::RemoveFromCell(uint32 Handle)
+{
+	const FEntry& Entry = Entries[Handle];
+	auto CellIt = Cells.find(Entry.CellKey);
+	TArray<FCellItem>& Items = CellIt->second;
+
+	// swap-pop 후 옮겨진 항목의 슬롯 갱신
+	const uint32 Slot = Entry.SlotInCell;
+	Items[Slot] = Items.back();
+	Entries[Items[Slot].Handle].SlotInCell = Slot;
+	Items.pop_back();
+
+	// 빈 셀은 지워서 셀 수가 점유된 셀 수를 넘지 않게 함
+	if (Items.empty())
+	{
+		Cells.erase(CellIt);
+	}
+}
+
+template <typename TVisitor>
+void FSpatialHashGrid::ForEachCellInBox(const FAABB& Box, TVisitor&& Visit) const
+{
+	if (Cells.empty() || !Box.IsValid())
+		return;
+
+	const FCellCoord Lo = ToCell(Box.Min);
+	const FCellCoord Hi = ToCell(Box.Max);
+	const uint64 RangeCount = static_cast<uint64>(Hi.X - Lo.X + 1) * static_cast<uint64>(Hi.Y - Lo.Y + 1) * static_cast<uint64>(Hi.Z - Lo.Z + 1);
+
+	// 범위의 셀 수가 점유된 셀보다 많으면 해시 조회 대신 점유된 셀을 훑음
+	if (RangeCount > Cells.size())
+	{
+		for (const auto& [Key, Items] : Cells)
+		{
+			const FCellCoord Coord = UnpackKey(Key);
+			if (Coord.X >= Lo.X && Coord.X <= Hi.X && Coord.Y >= Lo.Y && Coord.Y <= Hi.Y && Coord.Z >= Lo.Z && Coord.Z <= Hi.Z)
+			{
+				Visit(Items);
+			}
+		}
+		return;
+	}
+
+	for (int32 Z = Lo.Z; Z <= Hi.Z; ++Z)
+	{
+		for (int32 Y = Lo.Y; Y <= Hi.Y; ++Y)
+		{
+			for (int32 X = Lo.X; X <= Hi.X; ++X)
+			{
+				auto CellIt = Cells.find(PackKey({ X, Y, Z }));
+				if (CellIt != Cells.end())
+				{
+					Visit(CellIt->second);
+				}
+			}
+		}
+	}
+}
+
+void FSpatialHashGrid::QueryBox(const FAABB& Box, TArray<AActor*>& OutActors) const
+{
+	ForEachCellInBox(Box, [&Box, &OutActors](const TArray<FCellItem>& Items) {
+		for (const FCellItem& Item : Items)
+		{
+			const FVector& P = Item.Position;
+			if (P.X >= Box.Min.X && P.X <= Box.Max.X && P.Y >= Box.Min.Y && P.Y <= Box.Max.Y && P.Z >= Box.Min.Z && P.Z <= Box.Max.Z)
+			{
+				OutActors.push_back(Item.Actor);
+			}
+		}
+	});
+}
+
+void FSpatialHashGrid::QuerySphere(const FVector& Center, float Radius, TArray<AActor*>& OutActors) const
+{
+	const float RadiusSquared = Radius * Radius;
+	const FAABB Box(Center - FVector(Radius, Radius, Radius), Center + FVector(Radius, Radius, Radius));
+	ForEachCellInBox(Box, [&Center, RadiusSquared, &OutActors](const TArray<FCellItem>& Items) {
+		for (const FCellItem& Item : Items)
+		{
+			if ((Item.Position - Center).LengthSquared() <= RadiusSquared)
+			{
+				OutActors.push_back(Item.Actor);
+			}
+		}
+	});
+}
+
+void FSpatialHashGrid::QueryBoxes(const FAABB* Boxes, uint32 Count, TArray<AActor*>& OutActors, TArray<uint32>& OutOffsets) const
+{
+	OutActors.clear();
+	OutOffsets.clear();
+	OutOffsets.reserve(Count + 1);
+	OutOffsets.push_back(0);
+	for (uint32 i = 0; i < Count; ++i)
+	{
+		QueryBox(Boxes[i], OutActors);
+		OutOffsets.push_back(static_cast<uint32>(OutActors.size()));
+	}
+}
+
+void FSpatialHashGrid::QuerySpheres(const FVector* Centers, const float* Radii, uint32 Count, TArray<AActor*>& OutActors, TArray<uint32>& OutOffsets) const
+{
+	OutActors.clear();
+	OutOffsets.clear();
+	OutOffsets.reserve(Count + 1);
+	OutOffsets.push_back(0);
+	for (uint32 i = 0; i < Count; ++i)
+	{
+		QuerySphere(Centers[i], Radii[i], OutActors);
+		OutOffsets.push_back(static_cast<uint32>(OutActors.size()));
+	}
+}
@@ -0,0 +1,94 @@
+﻿#pragma once
+#include "TArray.h"
+#include "FBounds.h"
+
+class AActor;
+
+/**
+ * @brief Hashed uniform grid of actor locations for radius and box range queries
+ *
+ * Only occupied cells exist (keyed by packed integer cell coordinates), so memory follows the
+ * actor count rather than the world size. Each cell keeps its items' positions inline, so a query
+ * touches one contiguous array per cell and reads the actor pointer only for hits.
+ *
+ * Moving is O(1): inside the same cell it only rewrites the position, across cells it is one
+ * swap-pop and one push. Handles stay valid until Remove and are recycled afterwards.
+ *
+ * @note: Entries are points. Large actors are found by their location, not their extent.
+ */
+class FSpatialHashGrid
+{
+public:
+	static constexpr uint32 InvalidHandle = UINT_MAX;
+
+	explicit FSpatialHashGrid(float InCellSize = 10.0f);
+
+	/** @brief Changes the cell size and re-buckets every entry (handles are kept). */
+	void SetCellSize(float InCellSize);
+	float GetCellSize() const { return CellSize; }
+
+	uint32 Add(AActor* Actor, const FVector& Position);
+	void Remove(uint32 Handle);
+	void Move(uint32 Handle, const FVector& Position);
+	void Clear();
+
+	const FVector& GetPosition(uint32 Handle) const;
+	AActor* GetActor(uint32 Handle) const { return Entries[Handle].Actor; }
+
+	uint32 Num() const { return NumEntries; }
+	uint32 NumCells() const { return static_cast<uint32>(Cells.size()); }
+
+	/** @brief Appends every actor whose location is inside Box. */
+	void QueryBox(const FAABB& Box, TArray<AActor*>& OutActors) const;
+	/** @brief Appends every actor whose location is within Radius of Center. */
+	void QuerySphere(const FVector& Center, float Radius, TArray<AActor*>& OutActors) const;
+
+	/**
+	 * @brief Runs Count box queries into one caller-owned buffer.
+	 * @param OutOffsets Receives Count + 1 offsets; results of query i are OutActors[OutOffsets[i], OutOffsets[i + 1]).
+	 * @note: Both buffers are cleared first and keep their capacity, so reusing them avoids allocation.
+	 */
+	void QueryBoxes(const FAABB* Boxes, uint32 Count, TArray<AActor*>& OutActors, TArray<uint32>& OutOffsets) const;
+	/** @brief Sphere version of QueryBoxes. */
+	void QuerySpheres(const FVector* Centers, const float* Radii, uint32 Count, TArray<AActor*>& OutActors, TArray<uint32>& OutOffsets) const;
+
+private:
+	struct FCellItem
+	{
+		FVector Position;
+		AActor* Actor;
+		uint32 Handle;
+	};
+
+	struct FEntry
+	{
+		AActor* Actor = nullptr;	// nullptr = 해제된 슬롯
+		uint64 CellKey = 0;
+		uint32 SlotInCell = 0;		// 해제된 슬롯에서는 free list의 다음 핸들
+	};
+
+	struct FCellCoord
+	{
+		int32 X, Y, Z;
+	};
+
+	FCellCoord ToCell(const FVector& Position) const;
+	static uint64 PackKey(const FCellCoord& Coord);
+	static FCellCoord UnpackKey(uint64 Key);
+
+	void InsertIntoCell(uint32 Handle, uint64 Key, const FVector& Position);
+	void RemoveFromCell(uint32 Handle);
+
+	/** @brief Calls Visit(Items) for every occupied cell overlapping Box (either by lookup or by scanning). */
+	template <typename TVisitor>
+	void ForEachCellInBox(const FAABB& Box, TVisitor&& Visit) const;
+
+	float CellSize;
+	float InvCellSize;
+
+	TArray<FEntry> Entries;
+	uint32 FreeList = InvalidHandle;
+	uint32 NumEntries = 0;
+
+	TMap<uint64, TArray<FCellItem>> Cells;
+};
@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include <d3d11.h>
+#include "FRHICommandContext.h"
 
 struct FTexture
 {
@@ -10,13 +11,13 @@ struct FTexture
 	int width;
 	int height;
 
-	void Bind(ID3D11DeviceContext* DeviceContext, UINT Slot)
+	void Bind(FRHICommandContext& RHI, UINT Slot)
 	{
-		assert(DeviceContext && srv && samplerState);
+		assert(srv && samplerState);
 
-		DeviceContext->PSSetShaderResources(Slot, 1, &srv);
+		RHI.SetPSShaderResource(Slot, srv);
 
-		DeviceContext->PSSetSamplers(Slot, 1, &samplerState);
+		RHI.SetPSSampler(Slot, samplerState);
 	}
 
 	void Release()
@@ -0,0 +1,500 @@
+﻿#include "stdafx.h"
+#include "FTransformStore.h"
+#include "USceneComponent.h"
+#include "UJobSystem.h"
+#include <xmmintrin.h>
+
+namespace
+{
+	/** @brief Row-vector Local * Parent: each result row is the parent's rows weighted by one local row. */
+	void MultiplyRows(const FMatrix& Local, const FMatrix& Parent, FMatrix& Out)
+	{
+		const __m128 P0 = _mm_loadu_ps(Parent.M[0]);
+		const __m128 P1 = _mm_loadu_ps(Parent.M[1]);
+		const __m128 P2 = _mm_loadu_ps(Parent.M[2]);
+		const __m128 P3 = _mm_loadu_ps(Parent.M[3]);
+		for (int32 Row = 0; Row < 4; ++Row)
+		{
+			// FMatrix::Multiply와 같은 순서로 더해서 결과가 비트 단위로 같음
+			__m128 Sum = _mm_mul_ps(_mm_set1_ps(Local.M[Row][0]), P0);
+			Sum = _mm_add_ps(Sum, _mm_mul_ps(_mm_set1_ps(Local.M[Row][1]), P1));
+			Sum = _mm_add_ps(Sum, _mm_mul_ps(_mm_set1_ps(Local.M[Row][2]), P2));
+			Sum = _mm_add_ps(Sum, _mm_mul_ps(_mm_set1_ps(Local.M[Row][3]), P3));
+			_mm_storeu_ps(Out.M[Row], Sum);
+		}
+	}
+}
+
+FTransformStore::~FTransformStore()
+{
+	Clear();
+}
+
+void FTransformStore::Register(USceneComponent* Component)
+{
+	if (!Component || Component->TransformStore)
+		return;
+
+	const uint32 Index = Num();
+	Locations.push_back(Component->RelativeLocation);
+	Rotations.push_back(Component->RelativeQuaternion);
+	Scales.push_back(Component->RelativeScale3D);
+	Parents.push_back(NoParent);
+	SubtreeSizes.push_back(1);
+	WorldMatrices.push_back(FMatrix::IdentityMatrix());
+	Owners.push_back(Component);
+
+	Component->TransformStore = this;
+	Component->TransformIndex = Index;
+	Dirty.Set(Index);
+	Moved.Set(Index);
+
+	// 저장소에 이미 들어온 자식이 있으면 자식이 부모보다 앞에 있으므로 재구성
+	for (const USceneComponent* Child : Component->GetAttachChildren())
+	{
+		if (Child && Child->TransformStore == this)
+		{
+			bHierarchyDirty = true;
+			return;
+		}
+	}
+
+	// 루트이거나 부모의 서브트리가 지금 끝에서 끝나면 pre-order가 그대로 유지됨
+	// (UScene::RegisterComponent는 부모 다음에 자식을 깊이 우선으로 등록하므로 스폰/로딩은 대부분 여기)
+	const USceneComponent* AttachParent = Component->GetAttachParent();
+	if (!AttachParent || AttachParent->TransformStore != this)
+		return;
+
+	const uint32 ParentIndex = AttachParent->TransformIndex;
+	if (bHierarchyDirty || ParentIndex + SubtreeSizes[ParentIndex] != Index)
+	{
+		bHierarchyDirty = true;
+		return;
+	}
+
+	Parents[Index] = ParentIndex;
+	for (uint32 Ancestor = ParentIndex; Ancestor != NoParent; Ancestor = Parents[Ancestor])
+	{
+		++SubtreeSizes[Ancestor];
+	}
+}
+
+void FTransformStore::Unregister(USceneComponent* Component)
+{
+	if (!Component || Component->TransformStore != this)
+		return;
+
+	const uint32 Index = Component->TransformIndex;
+	Owners[Index] = nullptr;
+	Dirty.Reset(Index);
+	Moved.Reset(Index);
+	Component->TransformStore = nullptr;
+	Component->TransformIndex = InvalidIndex;
+	++NumHoles;
+
+	// 저장소 안에 자식이 없으면 구멍으로만 남겨 순서를 유지하고, 구멍이 절반을 넘으면 압축
+	bool bHasChildren = false;
+	for (const USceneComponent* Child : Component->GetAttachChildren())
+	{
+		bHasChildren |= Child && Child->TransformStore == this;
+	}
+	if (bHasChildren || NumHoles * 2 > Num())
+	{
+		bHierarchyDirty = true;
+	}
+}
+
+void FTransformStore::Clear()
+{
+	for (USceneComponent* Owner : Owners)
+	{
+		if (Owner)
+		{
+			Owner->TransformStore = nullptr;
+			Owner->TransformIndex = InvalidIndex;
+		}
+	}
+
+	Locations.clear();
+	Rotations.clear();
+	Scales.clear();
+	Parents.clear();
+	SubtreeSizes.clear();
+	WorldMatrices.clear();
+	Owners.clear();
+	NumHoles = 0;
+	Dirty.Clear();
+	Moved.Clear();
+	bHierarchyDirty = false;
+}
+
+void FTransformStore::SetLocal(uint32 Index, const FVector& Location, const FQuaternion& Rotation, const FVector& Scale)
+{
+	Locations[Index] = Location;
+	Rotations[Index] = Rotation;
+	Scales[Index] = Scale;
+
+	if (bDeferDirty)
+	{
+		// 공유 비트셋은 건드리지 않고 스레드별로 기록만 함
+		const uint32 ThreadIndex = UJobSystem::GetCurrentThreadIndex();
+		if (ThreadIndex < DeferredDirty.size())
+		{
+			DeferredDirty[ThreadIndex].push_back(Index);
+		}
+		else
+		{
+			std::lock_guard<std::mutex> Lock(ForeignDeferredMutex);
+			ForeignDeferredDirty.push_back(Index);
+		}
+		return;
+	}
+
+	// 서브트리가 연속 구간이므로 비트 범위 하나로 자손까지 무효화
+	// (계층이 더티면 SubtreeSizes가 낡았지만 재구성이 이 엔트리의 비트를 새 자손에게 전파함)
+	Dirty.SetRange(Index, Index + SubtreeSizes[Index]);
+	Moved.SetRange(Index, Index + SubtreeSizes[Index]);
+}
+
+void FTransformStore::BeginDeferredDirty(uint32 NumThreads)
+{
+	if (DeferredDirty.size() < NumThreads)
+	{
+		DeferredDirty.resize(NumThreads);
+	}
+	bDeferDirty = true;
+}
+
+void FTransformStore::EndDeferredDirty()
+{
+	bDeferDirty = false;
+	auto Apply = [this](TArray<uint32>& Indices)
+	{
+		for (uint32 Index : Indices)
+		{
+			Dirty.SetRange(Index, Index + SubtreeSizes[Index]);
+			Moved.SetRange(Index, Index + SubtreeSizes[Index]);
+		}
+		Indices.clear();
+	};
+	for (TArray<uint32>& Indices : DeferredDirty)
+	{
+		Apply(Indices);
+	}
+
+	std::lock_guard<std::mutex> Lock(ForeignDeferredMutex);
+	Apply(ForeignDeferredDirty);
+}
+
+const FMatrix& FTransformStore::GetWorldTransform(const USceneComponent* Component)
+{
+	if (bHierarchyDirty)
+	{
+		RebuildHierarchy();
+	}
+	return GetWorldTransformAt(Component->TransformIndex);
+}
+
+const FMatrix& FTransformStore::GetWorldTransformAt(uint32 Index)
+{
+	if (Dirty.Test(Index))
+	{
+		const uint32 Parent = Parents[Index];
+		if (Parent != NoParent && Dirty.Test(Parent))
+		{
+			GetWorldTransformAt(Parent);
+		}
+		ComputeWorld(Index);
+		Dirty.Reset(Index);
+	}
+	return WorldMatrices[Index];
+}
+
+void FTransformStore::ComputeWorld(uint32 Index)
+{
+	FMatrix Local;
+	ComputeLocals(&Index, 1, &Local);
+	const uint32 Parent = Parents[Index];
+	if (Parent != NoParent)
+	{
+		MultiplyRows(Local, WorldMatrices[Parent], WorldMatrices[Index]);
+	}
+	else
+	{
+		WorldMatrices[Index] = Local;
+	}
+}
+
+void FTransformStore::ComputeLocals(const uint32* Indices, uint32 Count, FMatrix* OutLocals) const
+{
+	// SRTRowQuaternion(S * R * T)을 풀어 쓴 것: 회전 행을 스케일배 하고 마지막 행에 위치.
+	// 레인 하나가 엔트리 하나이며, 연산 순서가 FQuaternion::ToMatrixRow와 같아서 결과도 같음
+	const __m128 One = _mm_set1_ps(1.0f);
+	const __m128 Two = _mm_set1_ps(2.0f);
+	for (uint32 Base = 0; Base < Count; Base += 4)
+	{
+		const uint32 Lanes = (std::min)(Count - Base, 4u);
+		alignas(16) float QX[4] = {}, QY[4] = {}, QZ[4] = {}, QW[4] = { 1, 1, 1, 1 };
+		alignas(16) float SX[4] = {}, SY[4] = {}, SZ[4] = {};
+		for (uint32 Lane = 0; Lane < Lanes; ++Lane)
+		{
+			const uint32 Index = Indices[Base + Lane];
+			QX[Lane] = Rotations[Index].X; QY[Lane] = Rotations[Index].Y;
+			QZ[Lane] = Rotations[Index].Z; QW[Lane] = Rotations[Index].W;
+			SX[Lane] = Scales[Index].X; SY[Lane] = Scales[Index].Y; SZ[Lane] = Scales[Index].Z;
+		}
+
+		__m128 X = _mm_load_ps(QX), Y = _mm_load_ps(QY), Z = _mm_load_ps(QZ), W = _mm_load_ps(QW);
+
+		// Normalized(): 길이가 0이면 단위 사원수
+		const __m128 Length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(X, X), _mm_mul_ps(Y, Y)), _mm_mul_ps(Z, Z)), _mm_mul_ps(W, W)));
+		const __m128 Valid = _mm_cmpgt_ps(Length, _mm_setzero_ps());
+		const __m128 Inv = _mm_div_ps(One, Length);
+		X = _mm_and_ps(Valid, _mm_mul_ps(X, Inv));
+		Y = _mm_and_ps(Valid, _mm_mul_ps(Y, Inv));
+		Z = _mm_and_ps(Valid, _mm_mul_ps(Z, Inv));
+		W = _mm_or_ps(_mm_and_ps(Valid, _mm_mul_ps(W, Inv)), _mm_andnot_ps(Valid, One));
+
+		const __m128 XX = _mm_mul_ps(X, X), YY = _mm_mul_ps(Y, Y), ZZ = _mm_mul_ps(Z, Z);
+		const __m128 XY = _mm_mul_ps(X, Y), XZ = _mm_mul_ps(X, Z), YZ = _mm_mul_ps(Y, Z);
+		const __m128 WX = _mm_mul_ps(W, X), WY = _mm_mul_ps(W, Y), WZ = _mm_mul_ps(W, Z);
+
+		const __m128 ScaleX = _mm_load_ps(SX), ScaleY = _mm_load_ps(SY), ScaleZ = _mm_load_ps(SZ);
+		alignas(16) float R[9][4];
+		_mm_store_ps(R[0], _mm_mul_ps(ScaleX, _mm_sub_ps(One, _mm_mul_ps(Two, _mm_add_ps(YY, ZZ)))));
+		_mm_store_ps(R[1], _mm_mul_ps(ScaleX, _mm_mul_ps(Two, _mm_sub_ps(XY, WZ))));
+		_mm_store_ps(R[2], _mm_mul_ps(ScaleX, _mm_mul_ps(Two, _mm_add_ps(XZ, WY))));
+		_mm_store_ps(R[3], _mm_mul_ps(ScaleY, _mm_mul_ps(Two, _mm_add_ps(XY, WZ))));
+		_mm_store_ps(R[4], _mm_mul_ps(ScaleY, _mm_sub_ps(One, _mm_mul_ps(Two, _mm_add_ps(XX, ZZ)))));
+		_mm_store_ps(R[5], _mm_mul_ps(ScaleY, _mm_mul_ps(Two, _mm_sub_ps(YZ, WX))));
+		_mm_store_ps(R[6], _mm_mul_ps(ScaleZ, _mm_mul_ps(Two, _mm_sub_ps(XZ, WY))));
+		_mm_store_ps(R[7], _mm_mul_ps(ScaleZ, _mm_mul_ps(Two, _mm_add_ps(YZ, WX))));
+		_mm_store_ps(R[8], _mm_mul_ps(ScaleZ, _mm_sub_ps(One, _mm_mul_ps(Two, _mm_add_ps(XX, YY)))));
+
+		for (uint32 Lane = 0; Lane < Lanes; ++Lane)
+		{
+			const FVector& Location = Locations[Indices[Base + Lane]];
+			FMatrix& Local = OutLocals[Base + Lane];
+			Local.M[0][0] = R[0][Lane]; Local.M[0][1] = R[1][Lane]; Local.M[0][2] = R[2][Lane]; Local.M[0][3] = 0.0f;
+			Local.M[1][0] = R[3][Lane]; Local.M[1][1] = R[4][Lane]; Local.M[1][2] = R[5][Lane]; Local.M[1][3] = 0.0f;
+			Local.M[2][0] = R[6][Lane]; Local.M[2][1] = R[7][Lane]; Local.M[2][2] = R[8][Lane]; Local.M[2][3] = 0.0f;
+			Local.M[3][0] = Location.X; Local.M[3][1] = Location.Y; Local.M[3][2] = Location.Z; Local.M[3][3] = 1.0f;
+		}
+	}
+}
+
+void FTransformStore::UpdateWorldTransforms(TArray<USceneComponent*>* OutMoved)
+{
+	if (bHierarchyDirty)
+	{
+		RebuildHierarchy();
+	}
+
+	// 로컬 행렬은 서로 독립이라 먼저 한꺼번에 계산
+	DirtyIndices.clear();
+	for (FConstSetBitIterator It(Dirty); It; ++It)
+	{
+		DirtyIndices.push_back(static_cast<uint32>(It.GetIndex()));
+	}
+	const uint32 NumDirtyIndices = static_cast<uint32>(DirtyIndices.size());
+	DirtyLocals.resize(NumDirtyIndices);
+	ComputeLocals(DirtyIndices.data(), NumDirtyIndices, DirtyLocals.data());
+
+	// pre-order라 오름차순으로 돌면 부모가 항상 먼저 갱신됨
+	for (uint32 i = 0; i < NumDirtyIndices; ++i)
+	{
+		const uint32 Index = DirtyIndices[i];
+		const uint32 Parent = Parents[Index];
+		if (Parent != NoParent)
+		{
+			MultiplyRows(DirtyLocals[i], WorldMatrices[Parent], WorldMatrices[Index]);
+		}
+		else
+		{
+			WorldMatrices[Index] = DirtyLocals[i];
+		}
+	}
+	Dirty.Clear();
+
+	if (OutMoved)
+	{
+		for (FConstSetBitIterator It(Moved); It; ++It)
+		{
+			// 조상이 움직이면 자식 구멍의 비트도 켜짐
+			if (USceneComponent* Owner = Owners[It.GetIndex()])
+			{
+				OutMoved->push_back(Owner);
+			}
+		}
+	}
+	Moved.Clear();
+}
+
+void FTransformStore::RebuildHierarchy()
+{
+	bHierarchyDirty = false;
+
+	// 1. 살아있는 슬롯만 모으고 부모를 (압축된) 인덱스로 변환
+	TArray<uint32> OldToCompact(Owners.size(), InvalidIndex);
+	TArray<uint32> CompactToOld;
+	CompactToOld.reserve(Owners.size());
+	for (uint32 i = 0; i < Num(); ++i)
+	{
+		if (Owners[i])
+		{
+			OldToCompact[i] = static_cast<uint32>(CompactToOld.size());
+			CompactToOld.push_back(i);
+		}
+	}
+
+	const uint32 Count = static_cast<uint32>(CompactToOld.size());
+	TArray<uint32> CompactParents(Count, NoParent);
+	TArray<uint32> ChildCounts(Count + 1, 0);
+	for (uint32 c = 0; c < Count; ++c)
+	{
+		// 다른 저장소(또는 저장소 밖)에 있는 부모는 루트로 취급
+		const USceneComponent* AttachParent = Owners[CompactToOld[c]]->GetAttachParent();
+		if (AttachParent && AttachParent->TransformStore == this)
+		{
+			CompactParents[c] = OldToCompact[AttachParent->TransformIndex];
+			++ChildCounts[CompactParents[c] + 1];
+		}
+	}
+
+	// 2. 자식 목록을 CSR 형태로 구성
+	for (uint32 c = 0; c < Count; ++c)
+	{
+		ChildCounts[c + 1] += ChildCounts[c];
+	}
+	TArray<uint32> ChildOffsets = ChildCounts;
+	TArray<uint32> Children(Count);
+	for (uint32 c = 0; c < Count; ++c)
+	{
+		if (CompactParents[c] != NoParent)
+		{
+			Children[ChildOffsets[CompactParents[c]]++] = c;
+		}
+	}
+
+	// 3. 루트부터 반복 DFS로 pre-order 결정
+	TArray<uint32> Order;
+	Order.reserve(Count);
+	TArray<uint8> Visited(Count, 0);
+	TArray<uint32> Stack;
+	auto Visit = [&](uint32 Root)
+	{
+		Stack.push_back(Root);
+		while (!Stack.empty())
+		{
+			const uint32 c = Stack.back();
+			Stack.pop_back();
+			if (Visited[c]) continue;
+			Visited[c] = 1;
+			Order.push_back(c);
+
+			// 역순으로 넣어야 원래 자식 순서대로 방문
+			for (uint32 k = ChildCounts[c + 1]; k > ChildCounts[c]; --k)
+			{
+				Stack.push_back(Children[k - 1]);
+			}
+		}
+	};
+	for (uint32 c = 0; c < Count; ++c)
+	{
+		if (CompactParents[c] == NoParent)
+		{
+			Visit(c);
+		}
+	}
+	// 루트에서 닿지 않는 노드 (부착 순환)는 루트로 끊어서 추가
+	for (uint32 c = 0; c < Count; ++c)
+	{
+		if (!Visited[c])
+		{
+			CompactParents[c] = NoParent;
+			Visit(c);
+		}
+	}
+
+	// 4. 새 순서로 SoA 배열 재배치
+	TArray<uint32> CompactToNew(Count);
+	for (uint32 n = 0; n < Count; ++n)
+	{
+		CompactToNew[Order[n]] = n;
+	}
+
+	TArray<FVector> NewLocations(Count);
+	TArray<FQuaternion> NewRotations(Count);
+	TArray<FVector> NewScales(Count);
+	TArray<uint32> NewParents(Count);
+	TArray<FMatrix> NewWorldMatrices(Count);
+	TArray<USceneComponent*> NewOwners(Count);
+	FDynamicBitset NewDirty;
+	FDynamicBitset NewMoved;
+	NewDirty.Reserve(Count);
+	NewMoved.Reserve(Count);
+	for (uint32 n = 0; n < Count; ++n)
+	{
+		const uint32 c = Order[n];
+		const uint32 Old = CompactToOld[c];
+		NewLocations[n] = Locations[Old];
+		NewRotations[n] = Rotations[Old];
+		NewScales[n] = Scales[Old];
+		NewParents[n] = (CompactParents[c] != NoParent) ? CompactToNew[CompactParents[c]] : NoParent;
+		NewWorldMatrices[n] = WorldMatrices[Old];
+		NewOwners[n] = Owners[Old];
+		NewOwners[n]->TransformIndex = n;
+
+		// 움직였거나 부모가 바뀐 엔트리만 이동으로 기록 (부모가 해제된 경우 포함).
+		// 나머지는 월드 행렬이 그대로 유효하므로 더티 비트도 그대로 옮김
+		const uint32 OldParent = Parents[Old];
+		const USceneComponent* NewParentOwner = (CompactParents[c] != NoParent) ? Owners[CompactToOld[CompactParents[c]]] : nullptr;
+		const bool bParentChanged = (OldParent == NoParent)
+			? NewParentOwner != nullptr
+			: (Owners[OldParent] == nullptr || Owners[OldParent] != NewParentOwner);
+		if (Moved.Test(Old) || bParentChanged)
+		{
+			NewMoved.Set(n);
+		}
+		if (Dirty.Test(Old) || bParentChanged)
+		{
+			NewDirty.Set(n);
+		}
+	}
+
+	// 자식이 항상 뒤에 있으므로 역순 누적으로 서브트리 크기 계산
+	TArray<uint32> NewSubtreeSizes(Count, 1);
+	for (uint32 n = Count; n-- > 0;)
+	{
+		if (NewParents[n] != NoParent)
+		{
+			NewSubtreeSizes[NewParents[n]] += NewSubtreeSizes[n];
+		}
+	}
+
+	// 더티와 이동은 자손에게 전파 (부모가 항상 앞이므로 순방향 한 번)
+	for (uint32 n = 0; n < Count; ++n)
+	{
+		if (NewParents[n] == NoParent)
+			continue;
+		if (NewDirty.Test(NewParents[n]))
+		{
+			NewDirty.Set(n);
+		}
+		if (NewMoved.Test(NewParents[n]))
+		{
+			NewMoved.Set(n);
+		}
+	}
+
+	Locations = std::move(NewLocations);
+	Rotations = std::move(NewRotations);
+	Scales = std::move(NewScales);
+	Parents = std::move(NewParents);
+	SubtreeSizes = std::move(NewSubtreeSizes);
+	Owners = std::move(NewOwners);
+	NumHoles = 0;
+	WorldMatrices = std::move(NewWorldMatrices);
+	Dirty = std::move(NewDirty);
+	Moved = std::move(NewMoved);
+}
@@ -0,0 +1,100 @@
+﻿#pragma once
+#include "Matrix.h"
+#include "Vector.h"
+#include "Quaternion.h"
+#include "TArray.h"
+#include "FDynamicBitset.h"
+#include <mutex>
+
+class USceneComponent;
+
+/**
+ * @brief Scene-owned structure-of-arrays storage for component transforms
+ *
+ * Entries are kept in depth-first pre-order, so every parent precedes its children and the
+ * subtree of entry i is the contiguous range [i, i + SubtreeSize[i]). Moving a component only
+ * sets a bit range; UpdateWorldTransforms then walks the dirty bits once in ascending order and
+ * recomputes each world matrix from its already up-to-date parent.
+ *
+ * @note: Components keep their reflected Relative* fields as the authoring copy and push them
+ *        here through SetLocal. Registering a root, or a child at the end of its parent's subtree,
+ *        appends in place; removing a component without children leaves a hole. Anything else
+ *        (attach/detach, out-of-order registration) only flags the hierarchy, and the pre-order
+ *        (and every component's TransformIndex) is rebuilt lazily on the next query or update.
+ *        A rebuild keeps the world matrices and dirty bits of entries whose parent did not change.
+ */
+class FTransformStore
+{
+public:
+	static constexpr uint32 InvalidIndex = UINT_MAX;
+	static constexpr uint32 NoParent = UINT_MAX;
+
+	FTransformStore() = default;
+	~FTransformStore();
+
+	FTransformStore(const FTransformStore&) = delete;
+	FTransformStore& operator=(const FTransformStore&) = delete;
+
+	/** @brief Adds the component (no-op if it already belongs to a store). */
+	void Register(USceneComponent* Component);
+	void Unregister(USceneComponent* Component);
+	/** @brief Detaches every component from the store without touching the components' data. */
+	void Clear();
+
+	void SetLocal(uint32 Index, const FVector& Location, const FQuaternion& Rotation, const FVector& Scale);
+	void MarkHierarchyDirty() { bHierarchyDirty = true; }
+
+	/**
+	 * @brief While deferring, SetLocal only records the index per job-system thread, so components
+	 *        owned by different actors can move concurrently. Threads outside the job system record
+	 *        into one locked list instead. EndDeferredDirty applies the records.
+	 * @note: Registration, attach/detach and GetWorldTransform are not allowed while deferring.
+	 */
+	void BeginDeferredDirty(uint32 NumThreads);
+	void EndDeferredDirty();
+	bool IsDeferringDirty() const { return bDeferDirty; }
+
+	/** @brief World matrix of a registered component; recomputes its dirty ancestors on demand. */
+	const FMatrix& GetWorldTransform(const USceneComponent* Component);
+
+	/**
+	 * @brief Recomputes every dirty world matrix in one linear pass.
+	 * @param OutMoved Optional; receives every component whose world transform may have changed since the
+	 *        previous update (moved, newly registered, re-parented, or below one of those).
+	 */
+	void UpdateWorldTransforms(TArray<USceneComponent*>* OutMoved = nullptr);
+
+	uint32 Num() const { return static_cast<uint32>(Owners.size()); }
+	uint32 NumDirty() const { return static_cast<uint32>(Dirty.Count()); }
+
+private:
+	void RebuildHierarchy();
+	void ComputeWorld(uint32 Index);
+	/** @brief Local matrices of Count entries, four at a time across SIMD lanes. */
+	void ComputeLocals(const uint32* Indices, uint32 Count, FMatrix* OutLocals) const;
+	const FMatrix& GetWorldTransformAt(uint32 Index);
+
+	// SoA 데이터 (인덱스 = pre-order 순서)
+	TArray<FVector> Locations;
+	TArray<FQuaternion> Rotations;
+	TArray<FVector> Scales;
+	TArray<uint32> Parents;
+	TArray<uint32> SubtreeSizes;
+	TArray<FMatrix> WorldMatrices;
+	TArray<USceneComponent*> Owners;	// nullptr = 해제된 슬롯 (다음 재구성 때 압축)
+	uint32 NumHoles = 0;
+
+	FDynamicBitset Dirty;
+	// Dirty와 달리 GetWorldTransform으로 지워지지 않고 UpdateWorldTransforms에서만 소비됨
+	FDynamicBitset Moved;
+	bool bHierarchyDirty = false;
+
+	TArray<TArray<uint32>> DeferredDirty;	// [스레드 인덱스] → 움직인 엔트리
+	std::mutex ForeignDeferredMutex;
+	TArray<uint32> ForeignDeferredDirty;	// 잡 시스템 밖의 스레드가 움직인 엔트리
+	bool bDeferDirty = false;
+
+	// UpdateWorldTransforms 스크래치
+	TArray<uint32> DirtyIndices;
+	TArray<FMatrix> DirtyLocals;
+};
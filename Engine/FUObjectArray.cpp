@@ -0,0 +1,43 @@
+﻿#include "stdafx.h"
+#include "FUObjectArray.h"
+
+uint32 FUObjectArray::AddObject(UObject* Object)
+{
+	uint32 Index;
+	if (FirstFreeIndex != FObjectHandle::InvalidIndex)
+	{
+		// 삭제된 슬롯 재사용 (O(1))
+		Index = FirstFreeIndex;
+		FirstFreeIndex = GetItem(Index)->NextFreeIndex;
+	}
+	else
+	{
+		// 새 슬롯 할당 - 청크가 부족할 때만 새 청크를 붙이고 기존 아이템은 이동하지 않음
+		if (NumItems == NumChunks * ItemsPerChunk)
+		{
+			assert(NumChunks < MaxChunks && "GUObjectArray capacity exceeded");
+			Chunks[NumChunks++] = new FUObjectItem[ItemsPerChunk];
+		}
+		Index = NumItems++;
+	}
+
+	FUObjectItem* Item = GetItem(Index);
+	Item->Object = Object;
+	Item->Flags = IOF_None;
+	Item->MarkEpoch = CurrentMarkEpoch;	// 진행 중인 GC 사이클에서 새 객체가 수거되지 않도록
+	++NumObjects;
+	return Index;
+}
+
+void FUObjectArray::RemoveObject(uint32 Index, const UObject* Object)
+{
+	FUObjectItem* Item = GetItem(Index);
+	if (!Item || Item->Object != Object)
+		return;
+
+	Item->Object = nullptr;
+	++Item->SerialNumber;  // 이전 handle 무효화
+	Item->NextFreeIndex = FirstFreeIndex;
+	FirstFreeIndex = Index;
+	--NumObjects;
+}
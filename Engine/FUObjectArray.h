@@ -0,0 +1,120 @@
+﻿#pragma once
+#include "UEngineStatics.h"
+
+class UObject;
+
+/**
+ * @brief One slot of the global object array
+ * @note: SerialNumber is bumped every time the slot is released, so handles taken for a previous
+ *        occupant never match the object that reuses the slot.
+ */
+struct FUObjectItem
+{
+	UObject* Object = nullptr;
+	uint32 SerialNumber = 1;
+	uint32 NextFreeIndex = 0;
+	uint32 Flags = 0;		// EInternalObjectFlags
+	uint32 MarkEpoch = 0;	// 마지막으로 도달 가능하다고 표시된 GC 사이클
+};
+
+enum EInternalObjectFlags : uint32
+{
+	IOF_None = 0,
+	IOF_GarbageCollectable = 1 << 0,	// 도달 불가능해지면 GC가 삭제함
+};
+
+/**
+ * @brief Index + generation pair identifying a UObject without keeping a raw pointer to it
+ */
+struct FObjectHandle
+{
+	static constexpr uint32 InvalidIndex = UINT_MAX;
+
+	uint32 Index = InvalidIndex;
+	uint32 SerialNumber = 0;
+
+	bool IsNull() const { return Index == InvalidIndex; }
+
+	bool operator==(const FObjectHandle& other) const
+	{
+		return Index == other.Index && SerialNumber == other.SerialNumber;
+	}
+	bool operator!=(const FObjectHandle& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief Chunked storage for every live UObject
+ *
+ * Items live in fixed-size chunks reached through a fixed-size chunk table, so neither the items
+ * nor the table ever move: FUObjectItem pointers stay valid while the array grows.
+ * Released slots are threaded into an intrusive free list and reused in O(1).
+ * All state is constant-initialized because UObjects are created during static initialization.
+ */
+class FUObjectArray
+{
+public:
+	static constexpr uint32 ItemsPerChunk = 16 * 1024;
+	static constexpr uint32 MaxChunks = 1024;
+
+	constexpr FUObjectArray() = default;
+
+	FUObjectArray(const FUObjectArray&) = delete;
+	FUObjectArray& operator=(const FUObjectArray&) = delete;
+
+	/** @brief Stores the object in a free or fresh slot and returns its index. */
+	uint32 AddObject(UObject* Object);
+
+	/** @brief Releases the slot if it still holds the given object. */
+	void RemoveObject(uint32 Index, const UObject* Object);
+
+	/** @brief Drops the free list so following objects get fresh, increasing indices. */
+	void ClearFreeIndices() { FirstFreeIndex = FObjectHandle::InvalidIndex; }
+
+	/** @brief Objects added from now on start out marked for the given GC cycle. */
+	void SetMarkEpoch(uint32 Epoch) { CurrentMarkEpoch = Epoch; }
+
+	/** @brief High-water mark of used slots. Slots below it may be empty. */
+	uint32 Num() const { return NumItems; }
+
+	/** @brief Number of slots currently holding an object. */
+	uint32 GetObjectCount() const { return NumObjects; }
+
+	FUObjectItem* GetItem(uint32 Index)
+	{
+		return (Index < NumItems) ? &Chunks[Index / ItemsPerChunk][Index % ItemsPerChunk] : nullptr;
+	}
+
+	const FUObjectItem* GetItem(uint32 Index) const
+	{
+		return (Index < NumItems) ? &Chunks[Index / ItemsPerChunk][Index % ItemsPerChunk] : nullptr;
+	}
+
+	UObject* GetObject(uint32 Index) const
+	{
+		const FUObjectItem* Item = GetItem(Index);
+		return Item ? Item->Object : nullptr;
+	}
+
+	UObject* operator[](uint32 Index) const { return GetObject(Index); }
+
+	FObjectHandle MakeHandle(uint32 Index) const
+	{
+		const FUObjectItem* Item = GetItem(Index);
+		return Item ? FObjectHandle{ Index, Item->SerialNumber } : FObjectHandle{};
+	}
+
+	/** @brief O(1) handle resolution. Returns nullptr for null or stale handles. */
+	UObject* Resolve(const FObjectHandle& Handle) const
+	{
+		const FUObjectItem* Item = GetItem(Handle.Index);
+		return (Item && Item->SerialNumber == Handle.SerialNumber) ? Item->Object : nullptr;
+	}
+
+private:
+	FUObjectItem* Chunks[MaxChunks] = {};
+	uint32 NumChunks = 0;
+	uint32 NumItems = 0;
+	uint32 NumObjects = 0;
+	uint32 FirstFreeIndex = FObjectHandle::InvalidIndex;
+	uint32 CurrentMarkEpoch = 0;
+};
@@ -5,6 +5,7 @@
 
 #include <d3d11.h>
 
+#include "FRHICommandContext.h"
 #include "ShaderReflection.h"
 #include "UEngineStatics.h"
 
@@ -83,6 +84,16 @@ public:
 		}
 	}
 
+	/**
+	 * @brief Shader without compiled code whose constant buffers follow the given layouts.
+	 * @note: See the headless UShaderReflection constructor; Bind sets null shader objects, so only recording RHIs can use it.
+	 */
+	UShader(ShaderID ID, EShaderType InShaderType, TArray<std::pair<FString, UBufferElementLayout>> ConstantBufferLayouts)
+		: ID(ID), ShaderType(InShaderType)
+		, ShaderReflection(MakeUnique<UShaderReflection>(InShaderType, std::move(ConstantBufferLayouts)))
+	{
+	}
+
 	/** Deleted move/copy constructor */
 	UShader(const UShader&) = delete;
 	UShader(UShader&&) = delete;
@@ -108,28 +119,40 @@ public:
 		return *ID;
 	}
 
-	void BindConstantBuffer(ID3D11DeviceContext* DeviceContext, const FString& BufferName)
+	void BindConstantBuffer(FRHICommandContext& RHI, const FString& BufferName)
 	{
-		ShaderReflection->Bind(DeviceContext, BufferName);
+		ShaderReflection->Bind(RHI, BufferName);
+	}
+
+	/** @see UShaderReflection::FindConstantBufferSlot */
+	TOptional<UShaderReflection::FConstantBufferSlot> FindConstantBufferSlot(const FString& BufferName)
+	{
+		return ShaderReflection->FindConstantBufferSlot(BufferName);
+	}
+
+	/** @see UShaderReflection::FindConstantBufferFieldOffset */
+	TOptional<uint32> FindConstantBufferFieldOffset(const FString& BufferName, const FString& FieldName) const
+	{
+		return ShaderReflection->FindConstantBufferFieldOffset(BufferName, FieldName);
 	}
 
 	template<typename... TBufferNames>
-	void BindConstantBuffers(ID3D11DeviceContext* DeviceContext, TBufferNames&&... BufferNames)
+	void BindConstantBuffers(FRHICommandContext& RHI, TBufferNames&&... BufferNames)
 	{
-		(ShaderReflection->Bind(DeviceContext, std::forward<TBufferNames>(BufferNames)), ...);
+		(ShaderReflection->Bind(RHI, std::forward<TBufferNames>(BufferNames)), ...);
 	}
 
 	template<typename... TBufferNames>
-	void Bind(ID3D11DeviceContext* DeviceContext, TBufferNames&&... BufferNames)
+	void Bind(FRHICommandContext& RHI, TBufferNames&&... BufferNames)
 	{
 		switch (ShaderType)
 		{
 		case EShaderType::VertexShader:
-			DeviceContext->IASetInputLayout(ShaderReflection->GetInputLayout());
-			DeviceContext->VSSetShader(VertexShader.Get(), nullptr, 0);
+			RHI.SetInputLayout(ShaderReflection->GetInputLayout());
+			RHI.SetVertexShader(VertexShader.Get());
 			break;
 		case EShaderType::PixelShader:
-			DeviceContext->PSSetShader(PixelShader.Get(), nullptr, 0);
+			RHI.SetPixelShader(PixelShader.Get());
 			break;
 		default:
 			assert(false && "Unsupported shader type.");
@@ -137,7 +160,7 @@ public:
 		}
 
 		/** @todo: Remove? */
-		BindConstantBuffers(DeviceContext, std::forward<TBufferNames>(BufferNames)...);
+		BindConstantBuffers(RHI, std::forward<TBufferNames>(BufferNames)...);
 	}
 
 	ID3D11InputLayout* GetInputLayout()
@@ -145,9 +168,22 @@ public:
 		return ShaderReflection->GetInputLayout();
 	}
 
+	/**
+	 * @brief Vertex shader that draws the same thing with per-instance world matrix, color and selection (slot 1).
+	 * @note: nullptr if this shader has no instanced variant; UBatchRenderer then draws one by one.
+	 */
+	UShader* GetInstancedVariant() const { return InstancedVariant; }
+	void SetInstancedVariant(UShader* Variant)
+	{
+		assert(ShaderType == EShaderType::VertexShader && (!Variant || Variant->ShaderType == EShaderType::VertexShader));
+		InstancedVariant = Variant;
+	}
+
 private:
 	TOptional<ShaderID> ID;
 
+	UShader* InstancedVariant = nullptr;
+
 	EShaderType ShaderType;
 
 	/** Composite Shader Reflection class. Unique pointer for creating it inside constructor. */
@@ -10,6 +10,7 @@
 #include <wrl/client.h>
 
 #include "DynamicBuffer.h"
+#include "FRHICommandContext.h"
 #include "UEngineStatics.h"
 
 enum class EShaderType
@@ -44,6 +45,19 @@ private:
 	};
 
 public:
+	/**
+	 * @struct FConstantBufferSlot
+	 * @brief A constant buffer resolved once, so it can be filled and bound without looking it up by name.
+	 * @note Data is the shader's CPU-side copy; every user of the shader writes into the same memory.
+	 */
+	struct FConstantBufferSlot
+	{
+		ID3D11Buffer* Buffer = nullptr;
+		char* Data = nullptr;
+		UINT Size = 0;
+		UINT BindPoint = 0;
+	};
+
 	/** @brief Default destructor. */
 	~UShaderReflection() = default;
 
@@ -57,7 +71,11 @@ public:
 			ShaderBlob->GetBufferSize(),
 			IID_PPV_ARGS(ShaderReflection.ReleaseAndGetAddressOf())
 		);
-		// TODO: Add HRESULT check for D3DReflect.
+		if (FAILED(hr))
+		{
+			UE_LOG("D3DReflect failed (0x%08X)", static_cast<uint32>(hr));
+			return;
+		}
 
 		if (InShaderType == EShaderType::VertexShader)
 		{
@@ -110,6 +128,33 @@ public:
 		UE_LOG(ss.str().c_str());
 	}
 
+	/**
+	 * @brief Builds the reflection from hand-written constant buffer layouts instead of a compiled shader.
+	 * @param ConstantBufferLayouts Buffer names and layouts; each buffer is bound at its index in the array.
+	 * @note: For headless renderers whose frames are recorded, not drawn. There are no GPU constant buffers
+	 * and no input layout, so binding passes nullptr to the RHI.
+	 */
+	UShaderReflection(EShaderType InShaderType, TArray<std::pair<FString, UBufferElementLayout>> ConstantBufferLayouts)
+		: ShaderType(InShaderType)
+	{
+		for (UINT BindPoint = 0; BindPoint < ConstantBufferLayouts.size(); ++BindPoint)
+		{
+			auto& [Name, Layout] = ConstantBufferLayouts[BindPoint];
+			Layout.Finalize();
+
+			FConstantBufferInfo ConstantBufferInfo = {};
+			ConstantBufferInfo.BindPoint = BindPoint;
+			ConstantBufferInfo.Size = static_cast<UINT>(Layout.GetStride());
+
+			ConstantBufferMap.try_emplace(Name, Microsoft::WRL::ComPtr<ID3D11Buffer>());
+			ConstantBufferInfoMap.try_emplace(Name, ConstantBufferInfo);
+			ConstantDynamicBufferMap.try_emplace(Name, std::move(Layout));
+		}
+
+		VertexBufferElementLayout.Finalize();
+		InstanceBufferElementLayout.Finalize();
+	}
+
 	/** @brief Deleted copy and move constructors to prevent unwanted object copies. */
 	UShaderReflection(const UShaderReflection&) = delete;
 	UShaderReflection(UShaderReflection&&) = delete;
@@ -119,22 +164,22 @@ public:
 	UShaderReflection& operator=(UShaderReflection&&) = delete;
 
 public:
-	void Bind(ID3D11DeviceContext* DeviceContext, const FString& Name)
+	void Bind(FRHICommandContext& RHI, const FString& Name)
 	{
 		const auto& ConstantBuffer = ConstantBufferMap[Name];
 		const auto& ConstantBufferInfo = ConstantBufferInfoMap[Name];
 		const auto& ConstantDynamicBuffer = ConstantDynamicBufferMap[Name];
 
 		/** Update Constant Buffer */
-		DeviceContext->UpdateSubresource(ConstantBuffer.Get(), 0, nullptr, ConstantDynamicBuffer.GetData(), 0, 0);
+		RHI.UpdateBuffer(ConstantBuffer.Get(), ConstantDynamicBuffer.GetData(), ConstantBufferInfo.Size);
 
 		switch (ShaderType)
 		{
 		case EShaderType::VertexShader:
-			DeviceContext->VSSetConstantBuffers(ConstantBufferInfo.BindPoint, 1, ConstantBuffer.GetAddressOf());
+			RHI.SetVSConstantBuffer(ConstantBufferInfo.BindPoint, ConstantBuffer.Get());
 			break;
 		case EShaderType::PixelShader:
-			DeviceContext->PSSetConstantBuffers(ConstantBufferInfo.BindPoint, 1, ConstantBuffer.GetAddressOf());
+			RHI.SetPSConstantBuffer(ConstantBufferInfo.BindPoint, ConstantBuffer.Get());
 			break;
 		default:
 			assert(false && "Unsupported shader type.");
@@ -171,6 +216,48 @@ public:
 		return ConstantDynamicBufferMap.at(Name);
 	}
 
+	/**
+	 * @brief Resolves a constant buffer by name.
+	 * @param Name The name of the constant buffer.
+	 * @return The resolved slot, or nothing if the shader has no constant buffer with that name.
+	 * @note The slot stays valid for the lifetime of this reflection object.
+	 */
+	TOptional<FConstantBufferSlot> FindConstantBufferSlot(const FString& Name)
+	{
+		auto BufferIt = ConstantBufferMap.find(Name);
+		if (BufferIt == ConstantBufferMap.end())
+		{
+			return {};
+		}
+
+		FConstantBufferSlot Slot;
+		Slot.Buffer = BufferIt->second.Get();
+		Slot.Data = static_cast<char*>(ConstantDynamicBufferMap.at(Name).GetData());
+		Slot.Size = ConstantBufferInfoMap.at(Name).Size;
+		Slot.BindPoint = ConstantBufferInfoMap.at(Name).BindPoint;
+		return Slot;
+	}
+
+	/**
+	 * @brief Gets the byte offset of a top-level variable inside a constant buffer.
+	 * @return The offset, or nothing if the buffer or the variable does not exist.
+	 */
+	TOptional<uint32> FindConstantBufferFieldOffset(const FString& BufferName, const FString& FieldName) const
+	{
+		auto BufferIt = ConstantDynamicBufferMap.find(BufferName);
+		if (BufferIt == ConstantDynamicBufferMap.end())
+		{
+			return {};
+		}
+
+		const UBufferElementLayout::FField* Field = BufferIt->second.GetLayout().FindField(FieldName);
+		if (!Field)
+		{
+			return {};
+		}
+		return static_cast<uint32>(Field->Offset);
+	}
+
 private:
 	/**
 	 * @brief Reflects a single constant buffer's variables and builds a `UBufferElementLayout`.
@@ -298,13 +385,17 @@ private:
 			D3D11_SIGNATURE_PARAMETER_DESC SignatureParameterDesc;
 			ShaderReflection->GetInputParameterDesc(i, &SignatureParameterDesc);
 
+			/** @note: Semantics starting with "INST_" are per-instance data read from slot 1. */
+			const bool bPerInstance = strncmp(SignatureParameterDesc.SemanticName, "INST_", 5) == 0;
+			UBufferElementLayout& Layout = bPerInstance ? InstanceBufferElementLayout : VertexBufferElementLayout;
+
 			D3D11_INPUT_ELEMENT_DESC InputElementDesc = {};
 			InputElementDesc.SemanticName = SignatureParameterDesc.SemanticName;
 			InputElementDesc.SemanticIndex = SignatureParameterDesc.SemanticIndex;
-			InputElementDesc.InputSlot = 0;
+			InputElementDesc.InputSlot = bPerInstance ? 1 : 0;
 			InputElementDesc.AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
-			InputElementDesc.InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
-			InputElementDesc.InstanceDataStepRate = 0;
+			InputElementDesc.InputSlotClass = bPerInstance ? D3D11_INPUT_PER_INSTANCE_DATA : D3D11_INPUT_PER_VERTEX_DATA;
+			InputElementDesc.InstanceDataStepRate = bPerInstance ? 1 : 0;
 
 			FString ParameterName = SignatureParameterDesc.SemanticName + std::to_string(SignatureParameterDesc.SemanticIndex);
 			if (SignatureParameterDesc.Mask == 1) /** 0b0001 One component */
@@ -313,17 +404,17 @@ private:
 				{
 					/** @note The original code has a `TODO` about supporting unsigned integer types directly. Currently, `DXGI_FORMAT_R32_UINT` is used, which is correct for unsigned integers. */
 					InputElementDesc.Format = DXGI_FORMAT_R32_UINT;
-					VertexBufferElementLayout.Append<HLSL::EType::Int>(ParameterName);
+					Layout.Append<HLSL::EType::Int>(ParameterName);
 				}
 				else if (SignatureParameterDesc.ComponentType == D3D_REGISTER_COMPONENT_SINT32)
 				{
 					InputElementDesc.Format = DXGI_FORMAT_R32_SINT;
-					VertexBufferElementLayout.Append<HLSL::EType::Int>(ParameterName);
+					Layout.Append<HLSL::EType::Int>(ParameterName);
 				}
 				else if (SignatureParameterDesc.ComponentType == D3D_REGISTER_COMPONENT_FLOAT32)
 				{
 					InputElementDesc.Format = DXGI_FORMAT_R32_FLOAT;
-					VertexBufferElementLayout.Append<HLSL::EType::Float>(ParameterName);
+					Layout.Append<HLSL::EType::Float>(ParameterName);
 				}
 				else
 				{
@@ -335,7 +426,7 @@ private:
 				if (SignatureParameterDesc.ComponentType == D3D_REGISTER_COMPONENT_FLOAT32)
 				{
 					InputElementDesc.Format = DXGI_FORMAT_R32G32_FLOAT;
-					VertexBufferElementLayout.Append<HLSL::EType::Float2>(ParameterName);
+					Layout.Append<HLSL::EType::Float2>(ParameterName);
 				}
 				else
 				{
@@ -347,7 +438,7 @@ private:
 				if (SignatureParameterDesc.ComponentType == D3D_REGISTER_COMPONENT_FLOAT32)
 				{
 					InputElementDesc.Format = DXGI_FORMAT_R32G32B32_FLOAT;
-					VertexBufferElementLayout.Append<HLSL::EType::Float3>(ParameterName);
+					Layout.Append<HLSL::EType::Float3>(ParameterName);
 				}
 				else
 				{
@@ -359,7 +450,7 @@ private:
 				if (SignatureParameterDesc.ComponentType == D3D_REGISTER_COMPONENT_FLOAT32)
 				{
 					InputElementDesc.Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
-					VertexBufferElementLayout.Append<HLSL::EType::Float4>(ParameterName);
+					Layout.Append<HLSL::EType::Float4>(ParameterName);
 				}
 				else
 				{
@@ -375,6 +466,7 @@ private:
 		}
 
 		VertexBufferElementLayout.Finalize();
+		InstanceBufferElementLayout.Finalize();
 
 		Device->CreateInputLayout(
 			InputElementDescs.data(),
@@ -392,6 +484,8 @@ private:
 
 	/** @brief Stores the layout for vertex buffer data. */
 	UBufferElementLayout VertexBufferElementLayout;
+	/** @brief Stores the layout for per-instance data (INST_ semantics), empty for non-instanced shaders. */
+	UBufferElementLayout InstanceBufferElementLayout;
 
 	Microsoft::WRL::ComPtr<ID3D11InputLayout> InputLayout;
 
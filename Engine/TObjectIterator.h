@@ -0,0 +1,60 @@
+﻿#pragma once
+#include "UClass.h"
+
+/**
+ * @brief Iterates every live object of type T and its subclasses
+ *
+ * Subclasses of T occupy a contiguous range of class tree numbers, so the iterator only visits the
+ * per-class object lists in that range. Cost is proportional to the number of matching objects,
+ * not to the total object count.
+ *
+ * @note: Objects destroyed during iteration are swap-removed from their list and may cause another
+ *        object to be skipped. Objects created during iteration are not visited.
+ *
+ * for (TObjectIterator<UGizmoComponent> It; It; ++It) { UGizmoComponent* Gizmo = *It; }
+ */
+template<typename T>
+class TObjectIterator
+{
+public:
+	TObjectIterator()
+	{
+		UObject::FlushPendingClassRegistrations();
+
+		const UClass* BaseClass = T::StaticClass();
+		ClassIndex = BaseClass->GetTreeIndex();
+		ClassEnd = BaseClass->GetTreeEndIndex() + 1;	// 트리 해석 전이면 빈 범위
+		SkipEmptyLists();
+	}
+
+	explicit operator bool() const { return ClassIndex < ClassEnd; }
+
+	T* operator*() const { return static_cast<T*>((*Objects)[ObjectIndex]); }
+	T* operator->() const { return **this; }
+
+	TObjectIterator& operator++()
+	{
+		++ObjectIndex;
+		SkipEmptyLists();
+		return *this;
+	}
+
+private:
+	void SkipEmptyLists()
+	{
+		while (ClassIndex < ClassEnd)
+		{
+			Objects = &UClass::GetClassByTreeIndex(ClassIndex)->GetObjects();
+			if (ObjectIndex < Objects->size())
+				return;
+
+			++ClassIndex;
+			ObjectIndex = 0;
+		}
+	}
+
+	const TArray<UObject*>* Objects = nullptr;
+	uint32 ClassIndex = 0;
+	uint32 ClassEnd = 0;
+	size_t ObjectIndex = 0;
+};
@@ -0,0 +1,118 @@
+﻿#pragma once
+#include <cstring>
+#include <utility>
+#include "TArray.h"
+#include "UEngineStatics.h"
+
+/**
+ * @brief Stable LSD radix sort for items that carry an unsigned integer Key member
+ *
+ * Only the low KeyBits of each key are looked at. The histograms of every digit are built in a
+ * single pass over the input, and a digit in which all keys agree is skipped, so keys that only
+ * vary in one field cost one scatter pass. Small inputs use 8-bit digits, large ones 11-bit digits
+ * (fewer passes in exchange for histograms that no longer fit in L1).
+ *
+ * @note: Scratch and histogram storage are kept between calls, so one sorter should be reused
+ *        every frame instead of being created per sort.
+ */
+template<typename TItem>
+class TRadixSorter
+{
+public:
+	/** @brief Item count from which 11-bit digits are used. */
+	static constexpr uint32 WideDigitThreshold = 8192;
+
+	void SortAscending(TArray<TItem>& Items, uint32 KeyBits)
+	{
+		Sort(Items, KeyBits, false);
+	}
+
+	/** @note: Equal keys keep their input order in both directions. */
+	void SortDescending(TArray<TItem>& Items, uint32 KeyBits)
+	{
+		Sort(Items, KeyBits, true);
+	}
+
+private:
+	void Sort(TArray<TItem>& Items, uint32 KeyBits, bool bDescending)
+	{
+		assert(KeyBits > 0 && KeyBits <= 64);
+		if (Items.size() < 2)
+		{
+			return;
+		}
+
+		if (Items.size() < WideDigitThreshold)
+		{
+			SortByDigits<8>(Items, KeyBits, bDescending);
+		}
+		else
+		{
+			SortByDigits<11>(Items, KeyBits, bDescending);
+		}
+	}
+
+	template<uint32 DigitBits>
+	void SortByDigits(TArray<TItem>& Items, uint32 KeyBits, bool bDescending)
+	{
+		constexpr uint32 Radix = 1u << DigitBits;
+		constexpr uint64 DigitMask = Radix - 1;
+
+		const uint32 Num = static_cast<uint32>(Items.size());
+		const uint32 NumDigits = (KeyBits + DigitBits - 1) / DigitBits;
+		const uint64 KeyMask = KeyBits == 64 ? ~0ull : ((1ull << KeyBits) - 1);
+		// 내림차순은 키 비트를 뒤집어 오름차순으로 정렬
+		const uint64 FlipMask = bDescending ? KeyMask : 0;
+
+		Counts.assign(static_cast<size_t>(NumDigits) * Radix, 0);
+		for (const TItem& Item : Items)
+		{
+			const uint64 Key = (static_cast<uint64>(Item.Key) & KeyMask) ^ FlipMask;
+			for (uint32 Digit = 0; Digit < NumDigits; ++Digit)
+			{
+				++Counts[Digit * Radix + ((Key >> (Digit * DigitBits)) & DigitMask)];
+			}
+		}
+
+		Scratch.resize(Num);
+		TItem* Src = Items.data();
+		TItem* Dst = Scratch.data();
+
+		const uint64 FirstKey = (static_cast<uint64>(Items[0].Key) & KeyMask) ^ FlipMask;
+		for (uint32 Digit = 0; Digit < NumDigits; ++Digit)
+		{
+			uint32* Offsets = &Counts[Digit * Radix];
+			const uint32 Shift = Digit * DigitBits;
+
+			/** Every key has the same value in this digit, nothing would move. */
+			if (Offsets[(FirstKey >> Shift) & DigitMask] == Num)
+			{
+				continue;
+			}
+
+			uint32 Sum = 0;
+			for (uint32 Bucket = 0; Bucket < Radix; ++Bucket)
+			{
+				const uint32 Count = Offsets[Bucket];
+				Offsets[Bucket] = Sum;
+				Sum += Count;
+			}
+
+			for (uint32 i = 0; i < Num; ++i)
+			{
+				const uint64 Key = (static_cast<uint64>(Src[i].Key) & KeyMask) ^ FlipMask;
+				Dst[Offsets[(Key >> Shift) & DigitMask]++] = Src[i];
+			}
+			std::swap(Src, Dst);
+		}
+
+		/** An odd number of scatter passes leaves the result in Scratch. */
+		if (Src != Items.data())
+		{
+			Items.swap(Scratch);
+		}
+	}
+
+	TArray<TItem> Scratch;
+	TArray<uint32> Counts;
+};
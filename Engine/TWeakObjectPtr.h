@@ -0,0 +1,59 @@
+﻿#pragma once
+#include "UObject.h"
+
+/**
+ * @brief Non-owning UObject reference that turns null once the object is destroyed
+ *
+ * Stores an FObjectHandle instead of a raw pointer, so checking validity is a single slot lookup
+ * and owners do not need destruction notifications to avoid dangling pointers.
+ */
+template<typename T>
+class TWeakObjectPtr
+{
+public:
+	TWeakObjectPtr() = default;
+	TWeakObjectPtr(std::nullptr_t) {}
+	TWeakObjectPtr(const T* Object) { *this = Object; }
+
+	TWeakObjectPtr& operator=(const T* Object)
+	{
+		Handle = Object ? Object->GetHandle() : FObjectHandle{};
+		return *this;
+	}
+
+	TWeakObjectPtr& operator=(std::nullptr_t)
+	{
+		Reset();
+		return *this;
+	}
+
+	/** @return The object, or nullptr if it was never set or has been destroyed. */
+	T* Get() const
+	{
+		return static_cast<T*>(UObject::GUObjectArray.Resolve(Handle));
+	}
+
+	bool IsValid() const { return Get() != nullptr; }
+
+	/** @brief True if this pointed at an object that no longer exists. */
+	bool IsStale() const { return !Handle.IsNull() && !IsValid(); }
+
+	void Reset() { Handle = FObjectHandle{}; }
+
+	const FObjectHandle& GetHandle() const { return Handle; }
+
+	T* operator->() const
+	{
+		T* Object = Get();
+		assert(Object && "Dereferencing invalid TWeakObjectPtr");
+		return Object;
+	}
+
+	explicit operator bool() const { return IsValid(); }
+
+	bool operator==(const TWeakObjectPtr& other) const { return Handle == other.Handle; }
+	bool operator!=(const TWeakObjectPtr& other) const { return Handle != other.Handle; }
+
+private:
+	FObjectHandle Handle;
+};
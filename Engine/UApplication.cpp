@@ -37,7 +37,7 @@ bool UApplication::Initialize(HINSTANCE hInstance, const std::wstring& title, in
 	if (bIsInitialized)
 		return false;
 
-	UClass::ResolveTypeBitsets();
+	UClass::ResolveTypeIntervals();
 
 	windowTitle = title;
 	windowWidth = width;
@@ -59,6 +59,8 @@ bool UApplication::Initialize(HINSTANCE hInstance, const std::wstring& title, in
 		return false;
 	}
 
+	jobSystem.Initialize();
+
 	// Initialize Renderer
 	if (!GetRenderer().Initialize(hWnd))
 	{
@@ -102,6 +104,7 @@ bool UApplication::Initialize(HINSTANCE hInstance, const std::wstring& title, in
 		MessageBox(hWnd, L"Failed to initialize scene manager", L"Engine Error", MB_OK | MB_ICONERROR);
 		return false;
 	}
+	garbageCollector.Initialize(this);
 	if (!raycastManager.Initialize(renderer.get(), &inputManager))
 	{
 		MessageBox(hWnd, L"Failed to initialize raycast manager", L"Engine Error", MB_OK | MB_ICONERROR);
@@ -167,6 +170,7 @@ void UApplication::Shutdown()
 	GetRenderer().ReleaseConstantBuffer();
 	GetRenderer().ReleaseShader();
 	GetRenderer().Release();
+	jobSystem.Shutdown();
 
 	bIsInitialized = false;
 }
@@ -177,6 +181,9 @@ void UApplication::Update(float deltaTime)
 	// Update core engine systems here if needed
 
 	sceneManager.GetScene()->Update(deltaTime);
+
+	// 프레임당 예산 안에서 도달 불가능한 객체 회수
+	garbageCollector.Tick(deltaTime);
 }
 
 void UApplication::Render()
@@ -11,6 +11,8 @@
 #include "UGizmoManager.h"
 #include "UBatchShaderManager.h"
 #include "UTextureManager.h"
+#include "UGarbageCollector.h"
+#include "UJobSystem.h"
 /**
  * @brief Main application class managing the engine's core systems and lifecycle
  */
@@ -29,6 +31,8 @@ private:
 	URaycastManager raycastManager;
 	UBatchShaderManager batchShaderManager;
 	UTextureManager textureManager;
+	UGarbageCollector garbageCollector;
+	UJobSystem jobSystem;
 
 	// Application state
 	bool bIsRunning;
@@ -59,6 +63,16 @@ public:
 	virtual void Render();
 
 	virtual void OnObjectDestroyed(UObject* obj){}
+	// GC 루트: 애플리케이션이 붙잡고 있는 객체를 보고
+	virtual void AddReferencedObjects(FReferenceCollector& collector) {}
+	// 한 프레임에 삭제된 객체들을 한 번에 전달. 기본 구현은 객체별 알림으로 위임
+	virtual void OnObjectsDestroyed(const TArray<UObject*>& objects)
+	{
+		for (UObject* obj : objects)
+		{
+			OnObjectDestroyed(obj);
+		}
+	}
 
 	// System access
 	URenderer& GetRenderer() { return *renderer; }
@@ -69,6 +83,8 @@ public:
 	UTimeManager& GetTimeManager() { return timeManager; }
 	URaycastManager& GetRaycastManager() { return raycastManager; }
 	UBatchShaderManager& GetBatchShaderManager() { return batchShaderManager; }
+	UGarbageCollector& GetGarbageCollector() { return garbageCollector; }
+	UJobSystem& GetJobSystem() { return jobSystem; }
 
 	// Window management
 	HWND GetWindowHandle() const { return hWnd; }
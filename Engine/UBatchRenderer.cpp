@@ -18,19 +18,13 @@ void UBatchRenderer::DrawPrimitiveComponent(UPrimitiveComponent* Component)
     }
 	assert(Component && "Component is not valid.");
 
-	LayerID Layer = Component->GetLayer();
-	MeshID Mesh = Component->GetMesh()->GetID();
-	ShaderID VertexShader = Component->GetVertexShader()->GetID();
-	ShaderID PixelShader = Component->GetPixelShader()->GetID();
-
-	RenderKeyType RenderKey = RenderKeyManager::CreateKey(Mesh, PixelShader, VertexShader, Layer);
-
-	PrimitiveComponentArray.emplace_back(RenderKey, Component);
+	const uint32 PacketIndex = UpdateDrawPacket(Component);
+	DrawPacketArray.emplace_back(DrawPackets[PacketIndex].Key, PacketIndex);
 }
 
 /** @note: drawOnTop does nothing with this function. */
 /** @todo: Resolve naming collision with URenderer::Draw. */
-void UBatchRenderer::DrawGizmoComponent(UGizmoComponent* Component, bool drawOnTop) 
+void UBatchRenderer::DrawGizmoComponent(UGizmoComponent* Component, bool /*drawOnTop*/) 
 {
     ConfigData* Config = ConfigManager::GetConfig("editor");
     if (!Config->getBool("Graphics", "BatchRendering"))
@@ -51,18 +45,232 @@ void UBatchRenderer::DrawTextholderComponent(UTextholderComp* Component)
     TextholderComponentArray.push_back(Component);
 }
 
+void UBatchRenderer::ReleasePrimitiveCache(UPrimitiveComponent* Component)
+{
+	assert(DrawPacketArray.empty() && "A submitted packet would be released before Draw().");
+
+	const uint32 PacketIndex = Component->DrawPacketIndex;
+	if (PacketIndex == UINT_MAX)
+	{
+		return;
+	}
+
+	assert(Component->DrawPacketOwner == this);
+	DrawPackets[PacketIndex].Primitive = nullptr;
+	FreeDrawPackets.push_back(PacketIndex);
+	Component->DrawPacketIndex = UINT_MAX;
+	Component->DrawPacketOwner = nullptr;
+	Component->MarkRenderStateDirty();
+}
+
+uint32 UBatchRenderer::UpdateDrawPacket(UPrimitiveComponent* Component)
+{
+	uint32 PacketIndex = Component->DrawPacketIndex;
+	if (PacketIndex == UINT_MAX)
+	{
+		if (FreeDrawPackets.empty())
+		{
+			PacketIndex = static_cast<uint32>(DrawPackets.size());
+			DrawPackets.emplace_back();
+		}
+		else
+		{
+			PacketIndex = FreeDrawPackets.back();
+			FreeDrawPackets.pop_back();
+		}
+		Component->DrawPacketIndex = PacketIndex;
+		Component->DrawPacketOwner = this;
+		BuildDrawPacket(DrawPackets[PacketIndex], Component);
+		return PacketIndex;
+	}
+
+	FDrawPacket& Packet = DrawPackets[PacketIndex];
+	assert(Packet.Primitive == Component);
+	if (Component->bRenderStateDirty || !Packet.bTrackedByScene || Packet.bIsSelected != Component->bIsSelected)
+	{
+		BuildDrawPacket(Packet, Component);
+	}
+	return PacketIndex;
+}
+
+void UBatchRenderer::BuildDrawPacket(FDrawPacket& Packet, UPrimitiveComponent* Component)
+{
+	UMesh* Mesh = Component->GetMesh();
+	UShader* ComponentVertexShader = Component->GetVertexShader();
+	UShader* ComponentPixelShader = Component->GetPixelShader();
+
+	Packet.Key = RenderKeyManager::CreateKey(Mesh->GetID(), ComponentPixelShader->GetID(), ComponentVertexShader->GetID(), Component->GetLayer());
+	Packet.Primitive = Component;
+
+	Packet.VertexBuffer = Mesh->VertexBuffer;
+	Packet.IndexBuffer = Mesh->IndexBuffer;
+	Packet.Stride = Mesh->Stride;
+	Packet.Topology = Mesh->PrimitiveType;
+	Packet.NumVertices = static_cast<uint32>(Mesh->NumVertices);
+	Packet.NumIndices = static_cast<uint32>(Mesh->NumIndices);
+
+	// CanBeInstanced면 상수도 MVP, 색, 선택 여부뿐이라 패킷이 직접 채움
+	const bool bDefaultConstants = Component->CanBeInstanced();
+	Packet.VertexShader = ComponentVertexShader;
+	Packet.PixelShader = ComponentPixelShader;
+	Packet.InstancedVertexShader = bDefaultConstants ? ComponentVertexShader->GetInstancedVariant() : nullptr;
+	Packet.ConstantsSlot = bDefaultConstants ? FindOrAddVertexShaderConstants(ComponentVertexShader) : FVertexShaderConstants::None;
+
+	Packet.World = Component->GetWorldTransform();
+	Packet.Color = Component->GetColor();
+	Packet.bIsSelected = Component->bIsSelected;
+	Packet.bTrackedByScene = Component->GetRegisteredScene() != nullptr;
+
+	Component->bRenderStateDirty = false;
+	++DrawPacketBuildCount;
+}
+
+uint32 UBatchRenderer::FindOrAddVertexShaderConstants(UShader* Shader)
+{
+	uint32 Index = 0;
+	for (; Index < VertexShaderConstants.size(); ++Index)
+	{
+		if (VertexShaderConstants[Index].Shader == Shader)
+		{
+			break;
+		}
+	}
+
+	if (Index == VertexShaderConstants.size())
+	{
+		FVertexShaderConstants& Constants = VertexShaderConstants.emplace_back();
+		Constants.Shader = Shader;
+
+		const TOptional<UShaderReflection::FConstantBufferSlot> Slot = Shader->FindConstantBufferSlot("ConstantBuffer");
+		const TOptional<uint32> MVPOffset = Shader->FindConstantBufferFieldOffset("ConstantBuffer", "MVP");
+		const TOptional<uint32> MeshColorOffset = Shader->FindConstantBufferFieldOffset("ConstantBuffer", "MeshColor");
+		const TOptional<uint32> IsSelectedOffset = Shader->FindConstantBufferFieldOffset("ConstantBuffer", "IsSelected");
+
+		Constants.bResolved = Slot && MVPOffset && MeshColorOffset && IsSelectedOffset;
+		if (Constants.bResolved)
+		{
+			Constants.Slot = *Slot;
+			Constants.MVPOffset = *MVPOffset;
+			Constants.MeshColorOffset = *MeshColorOffset;
+			Constants.IsSelectedOffset = *IsSelectedOffset;
+		}
+	}
+
+	return VertexShaderConstants[Index].bResolved ? Index : FVertexShaderConstants::None;
+}
+
+void UBatchRenderer::UpdatePacketConstants(const FDrawPacket& Packet)
+{
+	const FVertexShaderConstants& Constants = VertexShaderConstants[Packet.ConstantsSlot];
+	char* Data = Constants.Slot.Data;
+
+	const FMatrix MVP = Packet.World * GetViewProj();
+	const HLSL::bool32 IsSelected = Packet.bIsSelected;
+	memcpy(Data + Constants.MVPOffset, &MVP, sizeof(MVP));
+	memcpy(Data + Constants.MeshColorOffset, &Packet.Color, sizeof(Packet.Color));
+	memcpy(Data + Constants.IsSelectedOffset, &IsSelected, sizeof(IsSelected));
+
+	GetRHI().UpdateBuffer(Constants.Slot.Buffer, Data, Constants.Slot.Size);
+}
+
+bool UBatchRenderer::UploadInstanceData()
+{
+	const uint32 NumInstances = static_cast<uint32>(InstanceData.size());
+	if (NumInstances > InstanceBufferCapacity)
+	{
+		// 두 배씩 키워서 스폰이 늘어나는 동안 매 프레임 재생성하지 않게 함
+		const uint32 NewCapacity = (std::max)({ NumInstances, InstanceBufferCapacity * 2, 256u });
+
+		D3D11_BUFFER_DESC BufferDesc = {};
+		BufferDesc.ByteWidth = NewCapacity * sizeof(FMeshInstance);
+		BufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+		BufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+		BufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+		ID3D11Buffer* NewBuffer = GetRHI().CreateBuffer(BufferDesc, nullptr);
+		if (!NewBuffer)
+		{
+			LogError(E_FAIL, "CreateBuffer (InstanceBuffer)");
+			return false;
+		}
+
+		SAFE_RELEASE(InstanceBuffer);
+		InstanceBuffer = NewBuffer;
+		InstanceBufferCapacity = NewCapacity;
+	}
+
+	return GetRHI().WriteDynamicBuffer(InstanceBuffer, InstanceData.data(), NumInstances * sizeof(FMeshInstance));
+}
+
+ERenderSortMode UBatchRenderer::GetRenderSortMode()
+{
+	ConfigData* Config = ConfigManager::GetConfig("editor");
+	const FString Mode = Config->getString("Graphics", "RenderSort", "Coherent");
+	if (Mode == "Std")
+	{
+		return ERenderSortMode::Std;
+	}
+	if (Mode == "Radix")
+	{
+		return ERenderSortMode::Radix;
+	}
+	return ERenderSortMode::Coherent;
+}
+
 void UBatchRenderer::Draw()
 {
-	if (PrimitiveComponentArray.empty())
+	// 텍스트홀더는 패킷 뒤에 그리므로 텍스트홀더만 있는 프레임도 그대로 진행
+	if (DrawPacketArray.empty() && TextholderComponentArray.empty())
 	{
 		return;
 	}
 
-	/** @todo: Is std::sort enough? */
-	std::sort(PrimitiveComponentArray.begin(), PrimitiveComponentArray.end(),
-		[](const auto& lhs, const auto& rhs) {
-		return lhs.first > rhs.first;
-	});
+	PacketSorter.SortDescending(DrawPacketArray, RenderKeyManager::GetNumBits(), GetRenderSortMode());
+
+	ConfigData* Config = ConfigManager::GetConfig("editor");
+	const bool bInstancing = Config->getBool("Graphics", "Instancing", true);
+	const uint32 MinInstanceBatch = static_cast<uint32>((std::max)(Config->getInt("Graphics", "MinInstanceBatch", 2), 2));
+
+	/** Split the sorted array into runs of equal key. Runs whose packets all have an instanced shader get their instance data here. */
+	DrawRuns.clear();
+	InstanceData.clear();
+	const uint32 NumPackets = static_cast<uint32>(DrawPacketArray.size());
+	for (uint32 Begin = 0; Begin < NumPackets;)
+	{
+		const RenderKeyType Key = DrawPacketArray[Begin].first;
+		uint32 End = Begin + 1;
+		while (End < NumPackets && DrawPacketArray[End].first == Key)
+		{
+			++End;
+		}
+
+		FDrawRun Run{ Begin, End, FDrawRun::NotInstanced };
+		if (bInstancing && End - Begin >= MinInstanceBatch
+			&& std::all_of(DrawPacketArray.begin() + Begin, DrawPacketArray.begin() + End,
+				[this](const auto& Entry) { return DrawPackets[Entry.second].InstancedVertexShader != nullptr; }))
+		{
+			Run.FirstInstance = static_cast<uint32>(InstanceData.size());
+			for (uint32 i = Begin; i < End; ++i)
+			{
+				const FDrawPacket& Packet = DrawPackets[DrawPacketArray[i].second];
+				FMeshInstance& Instance = InstanceData.emplace_back();
+				memcpy(Instance.World, Packet.World.M, sizeof(Instance.World));
+				memcpy(Instance.Color, &Packet.Color, sizeof(Instance.Color));
+				Instance.IsSelected = Packet.bIsSelected ? 1.0f : 0.0f;
+			}
+		}
+		DrawRuns.push_back(Run);
+		Begin = End;
+	}
+
+	/** If the upload fails every run falls back to one draw per packet. */
+	if (!InstanceData.empty() && !UploadInstanceData())
+	{
+		for (FDrawRun& Run : DrawRuns)
+		{
+			Run.FirstInstance = FDrawRun::NotInstanced;
+		}
+	}
 
 	/** @note: Be careful not to use uninitialized values. */
 	TOptional<LayerID> LastLayer;
@@ -70,61 +278,127 @@ void UBatchRenderer::Draw()
 	TOptional<ShaderID> LastVertexShader;
 	TOptional<ShaderID> LastPixelShader;
 
-	for (const auto& [RenderKey, Component] : PrimitiveComponentArray)
+	auto BindPixelShaderAndMesh = [&](const FDrawPacket& Packet, ShaderID PixelShaderID, MeshID Mesh)
+	{
+		if (PixelShaderID != LastPixelShader)
+		{
+			Packet.PixelShader->Bind(GetRHI());
+			LastPixelShader = PixelShaderID;
+			IncrementPixelShaderSwitchCount();
+		}
+
+		if (Mesh != LastMesh)
+		{
+			const UINT Offset = 0;
+			GetRHI().SetVertexBuffers(0, 1, &Packet.VertexBuffer, &Packet.Stride, &Offset);
+			GetRHI().SetPrimitiveTopology(Packet.Topology);
+			if (Packet.IndexBuffer)
+			{
+				GetRHI().SetIndexBuffer(Packet.IndexBuffer, DXGI_FORMAT_R32_UINT, 0);
+			}
+			LastMesh = Mesh;
+			IncrementMeshSwitchCount();
+		}
+	};
+
+	for (const FDrawRun& Run : DrawRuns)
 	{
+		const RenderKeyType RenderKey = DrawPacketArray[Run.Begin].first;
 		const LayerID Layer = RenderKeyManager::Get<LayerField>(RenderKey);
 		const MeshID Mesh = RenderKeyManager::Get<MeshField>(RenderKey);
-		const ShaderID VertexShader = RenderKeyManager::Get<VertexShaderField>(RenderKey);
-		const ShaderID PixelShader = RenderKeyManager::Get<PixelShaderField>(RenderKey);
-
-		Component->UpdateConstantBuffer(*this);
+		const ShaderID VertexShaderID = RenderKeyManager::Get<VertexShaderField>(RenderKey);
+		const ShaderID PixelShaderID = RenderKeyManager::Get<PixelShaderField>(RenderKey);
 
 		/** If first element arrives, state should be initialized. */
 		if (Layer != LastLayer)
 		{
-			GetDeviceContext()->ClearDepthStencilView(DepthStencilView, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
+			GetRHI().ClearDepthStencil(DepthStencilView, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
 			LastLayer = Layer;
 			IncrementDepthStencilViewClearCount();
 		}
 
-		if (VertexShader != LastVertexShader)
+		if (Run.FirstInstance != FDrawRun::NotInstanced)
 		{
-			Component->BindVertexShader(*this);
-			LastVertexShader = VertexShader;
-			IncrementVertexShaderSwitchCount();
-		}
+			const FDrawPacket& Packet = DrawPackets[DrawPacketArray[Run.Begin].second];
+			UShader* InstancedShader = Packet.InstancedVertexShader;
 
-		if (PixelShader != LastPixelShader)
-		{
-			Component->BindPixelShader(*this);
-			LastPixelShader = PixelShader;
-			IncrementPixelShaderSwitchCount();
-		}
+			/** World matrices come from the instance buffer, so MVP only carries View * Projection. */
+			(*InstancedShader)["ConstantBuffer"]["MVP"] = GetViewProj();
+			if (InstancedShader->GetID() != LastVertexShader)
+			{
+				InstancedShader->Bind(GetRHI(), "ConstantBuffer");
+				LastVertexShader = InstancedShader->GetID();
+				IncrementVertexShaderSwitchCount();
+			}
+			else
+			{
+				InstancedShader->BindConstantBuffer(GetRHI(), "ConstantBuffer");
+			}
 
-		if (Mesh != LastMesh)
-		{
-			Component->BindMesh(*this);
-			LastMesh = Mesh;
-			IncrementMeshSwitchCount();
-		}
+			BindPixelShaderAndMesh(Packet, PixelShaderID, Mesh);
 
-		auto pMesh = Component->GetMesh();
-		if (pMesh->IsIndexBufferEnabled())
-		{
-			DrawIndexed(pMesh->NumIndices, 0, 0);
+			const UINT Stride = sizeof(FMeshInstance);
+			const UINT Offset = 0;
+			GetRHI().SetVertexBuffers(1, 1, &InstanceBuffer, &Stride, &Offset);
+
+			const uint32 NumInstances = Run.End - Run.Begin;
+			if (Packet.IndexBuffer)
+			{
+				DrawIndexedInstanced(Packet.NumIndices, NumInstances, 0, 0, Run.FirstInstance);
+			}
+			else
+			{
+				DrawInstanced(Packet.NumVertices, NumInstances, 0, Run.FirstInstance);
+			}
+			continue;
 		}
-		else
+
+		for (uint32 i = Run.Begin; i < Run.End; ++i)
 		{
-			URenderer::Draw(pMesh->NumVertices, 0);
+			const FDrawPacket& Packet = DrawPackets[DrawPacketArray[i].second];
+
+			if (VertexShaderID != LastVertexShader)
+			{
+				Packet.VertexShader->Bind(GetRHI());
+				LastVertexShader = VertexShaderID;
+				IncrementVertexShaderSwitchCount();
+
+				if (Packet.ConstantsSlot != FVertexShaderConstants::None)
+				{
+					const UShaderReflection::FConstantBufferSlot& Slot = VertexShaderConstants[Packet.ConstantsSlot].Slot;
+					GetRHI().SetVSConstantBuffer(Slot.BindPoint, Slot.Buffer);
+				}
+			}
+
+			if (Packet.ConstantsSlot != FVertexShaderConstants::None)
+			{
+				UpdatePacketConstants(Packet);
+			}
+			else
+			{
+				/** Components with their own constants (e.g. gizmos) still fill and bind the buffer themselves. */
+				Packet.Primitive->UpdateConstantBuffer(*this);
+			}
+
+			BindPixelShaderAndMesh(Packet, PixelShaderID, Mesh);
+
+			if (Packet.IndexBuffer)
+			{
+				DrawIndexed(Packet.NumIndices, 0, 0);
+			}
+			else
+			{
+				URenderer::Draw(Packet.NumVertices, 0);
+			}
 		}
 	}
 
-    GetDeviceContext()->ClearDepthStencilView(DepthStencilView, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
+    GetRHI().ClearDepthStencil(DepthStencilView, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
 
     for (auto Component : TextholderComponentArray)
     {
         URenderer::DrawTextholderComponent(Component);
     }
-	PrimitiveComponentArray.clear();
+	DrawPacketArray.clear();
     TextholderComponentArray.clear();
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "URenderer.h"
+#include "FRenderKeySorter.h"
 
 class UPrimitiveComponent;
 class UTextholderComp;
@@ -15,7 +16,10 @@ public:
 	using MeshID	= UMesh::MeshID;
 	using ShaderID	= UShader::ShaderID;
 
-	virtual ~UBatchRenderer() = default;
+	virtual ~UBatchRenderer()
+	{
+		SAFE_RELEASE(InstanceBuffer);
+	}
 
 	UBatchRenderer() = default;
 
@@ -30,9 +34,18 @@ public:
 	virtual void DrawGizmoComponent(UGizmoComponent* GizmoComponent, bool drawOnTop) override;
     virtual void DrawTextholderComponent(UTextholderComp* Component) override;
 
+	/** @note: Must not be called between submitting components and Draw(). */
+	virtual void ReleasePrimitiveCache(UPrimitiveComponent* Component) override;
+
 	/** @note: You should call Draw() before moving onto other rendering step(e.g., GUI drawing).*/
 	virtual void Draw() override;
 
+	/** @brief: Draw packets allocated so far, including the ones on the free list. */
+	uint32 GetNumDrawPackets() const { return static_cast<uint32>(DrawPackets.size()); }
+	uint32 GetNumFreeDrawPackets() const { return static_cast<uint32>(FreeDrawPackets.size()); }
+	/** @brief: How many times a packet was built or rebuilt from its component. */
+	uint64 GetDrawPacketBuildCount() const { return DrawPacketBuildCount; }
+
 private:
 	// ===============================================
 	/** @note: Caution! Do Not Read Below. */
@@ -89,6 +102,12 @@ private:
 	public:
 		static_assert(TotalBits <= (sizeof(TKey) * 8), "Total bits for Key exceeds 64 bits.");
 
+		/** @brief: Number of low bits a key can occupy; everything above is always zero. */
+		static constexpr uint32 GetNumBits()
+		{
+			return TotalBits;
+		}
+
 		[[nodiscard]] static TKey CreateKey(typename Fields::Type... Values)
 		{
 			TKey Key = 0;
@@ -130,6 +149,107 @@ private:
 		LayerField			// #1. 
 	>;
 
-	TArray<std::pair<RenderKeyType, UPrimitiveComponent*>> PrimitiveComponentArray;
+	/** @brief: Render key and DrawPackets index of every component submitted this frame. */
+	TArray<std::pair<RenderKeyType, uint32>> DrawPacketArray;
     TArray<UTextholderComp*> TextholderComponentArray;
+
+	// ===============================================
+	// Cached draw packets
+
+	/** @brief: The "ConstantBuffer" of a vertex shader, resolved once so per-draw constants are written by offset. */
+	struct FVertexShaderConstants
+	{
+		static constexpr uint32 None = UINT_MAX;
+
+		UShader* Shader;
+		/** @brief: false if the shader lacks MVP, MeshColor or IsSelected; its components then fill the buffer themselves. */
+		bool bResolved;
+		UShaderReflection::FConstantBufferSlot Slot;
+		uint32 MVPOffset;
+		uint32 MeshColorOffset;
+		uint32 IsSelectedOffset;
+	};
+
+	/**
+	 * @brief: Everything Draw() needs from a component, so the per-frame walk reads this array instead of the component.
+	 *
+	 * Built on the component's first submission and rebuilt only when it is marked render-state dirty (moved,
+	 * recolored, re-initialized) or its selection changed; a static component costs one flag check per frame.
+	 * @note: Components outside a scene are not reported when they move, so their packets are rebuilt on every submission.
+	 */
+	struct FDrawPacket
+	{
+		RenderKeyType Key;
+		/** @brief: Owner, or nullptr while the packet is on the free list. */
+		UPrimitiveComponent* Primitive;
+
+		ID3D11Buffer* VertexBuffer;
+		ID3D11Buffer* IndexBuffer;
+		UINT Stride;
+		D3D11_PRIMITIVE_TOPOLOGY Topology;
+		uint32 NumVertices;
+		uint32 NumIndices;
+
+		UShader* VertexShader;
+		UShader* PixelShader;
+		/** @brief: nullptr if the component cannot be instanced or its shader has no instanced variant. */
+		UShader* InstancedVertexShader;
+		/** @brief: Index into VertexShaderConstants, or FVertexShaderConstants::None to call the component's UpdateConstantBuffer. */
+		uint32 ConstantsSlot;
+
+		FMatrix World;
+		FVector4 Color;
+		bool bIsSelected;
+		bool bTrackedByScene;
+	};
+
+	/** @brief: Returns the index of the component's packet, building or rebuilding it first if anything it caches may have changed. */
+	uint32 UpdateDrawPacket(UPrimitiveComponent* Component);
+	void BuildDrawPacket(FDrawPacket& Packet, UPrimitiveComponent* Component);
+	uint32 FindOrAddVertexShaderConstants(UShader* Shader);
+	/** @brief: Writes the packet's MVP, color and selection into its vertex shader's constant buffer. */
+	void UpdatePacketConstants(const FDrawPacket& Packet);
+
+	TArray<FDrawPacket> DrawPackets;
+	TArray<uint32> FreeDrawPackets;
+	TArray<FVertexShaderConstants> VertexShaderConstants;
+	uint64 DrawPacketBuildCount = 0;
+
+	// ===============================================
+	// Sorting
+
+	static ERenderSortMode GetRenderSortMode();
+
+	FRenderKeySorter PacketSorter;
+
+	// ===============================================
+	// Instancing
+
+	/** @brief: Per-instance vertex data, matches VS_MESH_INST in DefaultVS.hlsl (main_mesh_instanced). */
+	struct FMeshInstance
+	{
+		float World[16];
+		float Color[4];
+		float IsSelected;
+	};
+	static_assert(sizeof(FMeshInstance) == 84, "FMeshInstance must match the tightly packed VS_MESH_INST layout.");
+
+	/** @brief: Consecutive entries of DrawPacketArray with the same render key. */
+	struct FDrawRun
+	{
+		static constexpr uint32 NotInstanced = UINT_MAX;
+
+		uint32 Begin;
+		uint32 End;
+		/** @brief: First instance in InstanceBuffer, or NotInstanced to draw the run one component at a time. */
+		uint32 FirstInstance;
+	};
+
+	/** @brief: Writes InstanceData into InstanceBuffer, growing the buffer if needed. */
+	bool UploadInstanceData();
+
+	TArray<FDrawRun> DrawRuns;
+	TArray<FMeshInstance> InstanceData;
+	ID3D11Buffer* InstanceBuffer = nullptr;
+	uint32 InstanceBufferCapacity = 0;
 };
@@ -16,6 +16,8 @@ void UBatchShaderManager::Initialize(ID3D11Device* Device)
 	/** @todo: Remove this. */
 	LoadShaderFromFile(Device, EShaderType::VertexShader, "DefaultVS.hlsl", "main", "Vertex");
 	LoadShaderFromFile(Device, EShaderType::PixelShader, "DefaultPS.hlsl", "main", "Pixel");
+	LoadShaderFromFile(Device, EShaderType::VertexShader, "DefaultVS.hlsl", "main_mesh_instanced", "Vertex_Instanced");
+	GetShaderByName("Vertex")->SetInstancedVariant(GetShaderByName("Vertex_Instanced"));
 	LoadShaderFromFile(Device, EShaderType::VertexShader, "TexTestVS.hlsl", "main", "Text_VS");
 	LoadShaderFromFile(Device, EShaderType::PixelShader, "TexTestPS.hlsl", "main", "Text_PS");
 
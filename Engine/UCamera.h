@@ -3,6 +3,7 @@
 #include "Vector.h"
 #include "Matrix.h"
 #include "Quaternion.h"
+#include "FBounds.h"
 // =====================
 // UCamera (LH, row-vector, Z-up)
 // =====================
@@ -45,6 +46,9 @@ public:
 
     bool  IsOrtho()  const { return mUseOrtho; }
 
+    // 현재 view/proj의 절두체 (직교 투영도 같은 방식으로 추출됨)
+    FFrustum GetFrustum() const { return FFrustum::FromViewProj(mView * mProj); }
+
 
     // ===== 투영 Set =====
 
@@ -19,52 +19,65 @@ UClass* UClass::RegisterToFactory(const FString& typeName, const TFunction<UObje
 	return rawPtr;
 }
 
-void UClass::ResolveTypeBitsets()
+void UClass::ResolveTypeIntervals()
 {
-	// 모든 비트셋을 실제 클래스 수에 맞게 사전 할당
-	size_t totalClasses = classList.size();
+	// 부모 연결 및 자식 목록 구성
+	TArray<TArray<UClass*>> children(classList.size());
+	TArray<UClass*> roots;
 	for (const TUniquePtr<UClass>& _class : classList)
 	{
-		_class->typeBitset.Reserve(totalClasses);
-	}
+		_class->superClass = nullptr;
+		if (!_class->superClassTypeName.empty()) {
+			auto it = nameToId.find(_class->superClassTypeName);
+			_class->superClass = (it != nameToId.end()) ? classList[it->second].get() : nullptr;
+		}
 
-	for (const TUniquePtr<UClass>& _class : classList)
-	{
-        if (!_class->superClassTypeName.empty()) {
-            auto it = nameToId.find(_class->superClassTypeName);
-            _class->superClass = (it != nameToId.end()) ? classList[it->second].get() : nullptr;
-        }
+		if (_class->superClass)
+			children[_class->superClass->typeId].push_back(_class.get());
+		else
+			roots.push_back(_class.get());
 	}
-    for (const TUniquePtr<UClass>& _class : classList)
-    {
-        if (_class->processed) continue;
-
-        _class->ResolveTypeBitset(_class.get());
-    }
-}
 
-void UClass::ResolveTypeBitset(UClass* classPtr)
-{
-    TArray<UClass*> stack;
-    stack.push_back(classPtr);
+	// 반복 DFS로 전위 번호를 매기고, 서브트리를 빠져나올 때 마지막 자손 번호를 기록
+	struct FVisit
+	{
+		UClass* Class;
+		size_t NextChild;
+	};
+	uint32 counter = 0;
+	TArray<FVisit> stack;
+	classesByTreeIndex.assign(classList.size(), nullptr);
+	for (UClass* root : roots)
+	{
+		classesByTreeIndex[counter] = root;
+		root->treeIndex = counter++;
+		root->properties = root->ownProperties;
+		stack.push_back({ root, 0 });
 
-    while (!stack.empty())
-    {
-        UClass* cur = stack.back();
+		while (!stack.empty())
+		{
+			FVisit& visit = stack.back();
+			TArray<UClass*>& childList = children[visit.Class->typeId];
+			if (visit.NextChild < childList.size())
+			{
+				UClass* child = childList[visit.NextChild++];
+				classesByTreeIndex[counter] = child;
+				child->treeIndex = counter++;
 
-        // 부모가 아직 처리되지 않았다면 먼저 스택에 push
-        while (cur->superClass && !cur->superClass->processed)
-        {
-            stack.push_back(cur->superClass);
-            cur = stack.back();
-        }
+				// 전위 순회라 부모의 속성 목록은 이미 완성되어 있음
+				child->properties = visit.Class->properties;
+				child->properties.insert(child->properties.end(), child->ownProperties.begin(), child->ownProperties.end());
 
-        // 현재 노드 처리
-        cur->typeBitset.Clear();
-        if (cur->superClass) cur->typeBitset |= cur->superClass->typeBitset;
-        cur->typeBitset.Set(cur->typeId);  // 자신의 비트 추가
-        cur->processed = true;
+				stack.push_back({ child, 0 });
+			}
+			else
+			{
+				visit.Class->treeEndIndex = counter - 1;
+				stack.pop_back();
+			}
+		}
+	}
 
-        stack.pop_back();
-    }
-}
\ No newline at end of file
+	// 타입 정보가 바뀌었으므로 캐시된 서브시스템 조회 결과도 무효화
+	UEngineStatics::InvalidateSubsystemCache();
+}
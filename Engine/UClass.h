@@ -1,9 +1,9 @@
 ﻿#pragma once
 #include "UEngineStatics.h"
-#include "FDynamicBitset.h"
 #include "json.hpp"
 #include "UObjectMacros.h"
 #include "UObject.h"
+#include "FProperty.h"
 #include <memory>
 
 /**
@@ -12,25 +12,32 @@
 class UClass : public UObject
 {
 	DECLARE_UCLASS(UClass, UObject)
+	friend class UObject;
 private:
 	static inline TArray<TUniquePtr<UClass>> classList;
+	static inline TArray<UClass*> classesByTreeIndex;
 	static inline TMap<FString, uint32> nameToId;
 	static inline TMap<FString, uint32> displayNameToId;
 	static inline uint32 registeredCount = 0;
 
 	TMap<FString, FString> metadata;
 	uint32 typeId;
-	FDynamicBitset typeBitset;
+	// 클래스 트리의 전위 순회 번호와 서브트리 마지막 자손의 번호. 자손은 항상 [treeIndex, treeEndIndex] 안에 있음
+	// 해석 전에는 빈 구간이라 IsChildOrSelfOf가 자기 자신 외에는 false
+	uint32 treeIndex = UINT_MAX;
+	uint32 treeEndIndex = 0;
 	FString className, superClassTypeName;
 	UClass* superClass;
 	TFunction<UObject*()> createFunction;
-	bool processed = false;
+	TArray<FProperty> ownProperties;	// UPROPERTY로 이 클래스가 직접 등록한 속성
+	TArray<FProperty> properties;		// 부모 속성 포함, ResolveTypeIntervals에서 구성
+	TArray<UObject*> objects;			// 정확히 이 타입인 살아있는 객체들. swap-remove로 밀집 유지
 public:
 	static UClass* RegisterToFactory(const FString& typeName, 
 		const TFunction<UObject* ()>& createFunction, const FString& superClassTypeName);
 
-	static void ResolveTypeBitsets();
-	void ResolveTypeBitset(UClass* classPtr);
+	/** @brief Links super classes and numbers the class tree. Must run after static registration. */
+	static void ResolveTypeIntervals();
 
 	static UClass* GetClass(uint32 typeId) {
 		return (typeId < classList.size()) ? classList[typeId].get() : nullptr;
@@ -59,10 +66,29 @@ public:
 		return classList;
 	}
 
-	bool IsChildOrSelfOf(UClass* baseClass) const {
-		return baseClass && typeBitset.Test(baseClass->typeId);
+	/** @brief Interval test over the numbered class tree: two compares, no memory beyond the two classes. */
+	bool IsChildOrSelfOf(const UClass* baseClass) const {
+		if (baseClass == this) return true;  // 정확한 타입 (leaf 클래스는 항상 여기서 결정됨)
+		return baseClass && baseClass->treeIndex <= treeIndex && treeIndex <= baseClass->treeEndIndex;
 	}
 
+	bool IsLeaf() const { return treeIndex == treeEndIndex; }
+
+	// 이 클래스와 모든 서브클래스는 트리 번호 [GetTreeIndex(), GetTreeEndIndex()]를 연속으로 차지
+	uint32 GetTreeIndex() const { return treeIndex; }
+	uint32 GetTreeEndIndex() const { return treeEndIndex; }
+	static UClass* GetClassByTreeIndex(uint32 index) { return classesByTreeIndex[index]; }
+
+	/** @brief Live objects whose exact type is this class. Call UObject::FlushPendingClassRegistrations() first. */
+	const TArray<UObject*>& GetObjects() const { return objects; }
+
+	UClass* GetSuperClass() const { return superClass; }
+
+	void AddProperty(const FProperty& property) { ownProperties.push_back(property); }
+
+	/** @brief Super class properties first, then this class's, in registration order. */
+	const TArray<FProperty>& GetProperties() const { return properties; }
+
 	const FString& GetUClassName() const { return className; }
 
 	const FString& GetDisplayName() const
@@ -8,6 +8,7 @@
 #include "USceneManager.h"
 #include "UScene.h"
 #include "UDefaultScene.h"
+#include "FSceneStreamer.h"
 #include "UGizmoManager.h"
 #include "URenderer.h"
 
@@ -138,12 +139,32 @@ void UControlPanel::SceneManagementSection()
 	{
 		std::filesystem::path _path("./data/");
 		std::filesystem::create_directory(_path);
-		SceneManager->SaveScene(_path.string() + FString(sceneName) + ".Scene");
+		if (bBinarySceneFile)
+			SceneManager->SaveSceneBinary(_path.string() + FString(sceneName) + ".SceneBin");
+		else
+			SceneManager->SaveScene(_path.string() + FString(sceneName) + ".Scene");
 	}
 	ImGui::SameLine();
 	if (ImGui::Button("Load scene") && strcmp(sceneName, "") != 0)
 	{
-		SceneManager->LoadScene("./data/" + FString(sceneName) + ".Scene");
+		SceneManager->LoadScene("./data/" + FString(sceneName) + (bBinarySceneFile ? ".SceneBin" : ".Scene"));
+	}
+	ImGui::SameLine();
+	ImGui::Checkbox("Binary", &bBinarySceneFile);
+	// 스트리밍 중에는 상주하지 않는 셀의 객체가 씬에 없어서 다시 나눌 수 없음
+	ImGui::BeginDisabled(SceneManager->GetScene()->GetStreamer() != nullptr);
+	if (ImGui::Button("Save partitioned") && strcmp(sceneName, "") != 0)
+	{
+		std::filesystem::path _path("./data/");
+		std::filesystem::create_directory(_path);
+		SceneManager->SavePartitionedScene(_path.string() + FString(sceneName) + ".Scene");
+	}
+	ImGui::EndDisabled();
+
+	if (FSceneStreamer* streamer = SceneManager->GetScene()->GetStreamer())
+	{
+		ImGui::Text("Streaming cells: %u resident, %u loading / %u",
+			streamer->GetNumResidentCells(), streamer->GetNumLoadingCells(), streamer->GetNumCells());
 	}
 }
 
@@ -396,6 +417,8 @@ void UControlPanel::PerformanceSection()
 	ImGui::Text("Pixel Shader Switches/Sec:");
 	ImGui::Text("Depth Stencil Clears/Sec:");
 	ImGui::Text("Mesh Switches/Sec:");
+	ImGui::Text("Visible Primitives:");
+	ImGui::Text("Culled Primitives:");
 
 	ImGui::NextColumn();
 
@@ -406,6 +429,8 @@ void UControlPanel::PerformanceSection()
 	ImGui::Text("%.2f", PixelShaderSwitchesPerSec);
 	ImGui::Text("%.2f", DepthStencilClearsPerSec);
 	ImGui::Text("%.2f", MeshSwitchesPerSec);
+	ImGui::Text("%u", SceneManager->GetScene()->GetRenderer()->GetVisiblePrimitiveCount());
+	ImGui::Text("%u", SceneManager->GetScene()->GetRenderer()->GetCulledPrimitiveCount());
 
 	PreviousTime = CurrentTime;
 	PrevDrawCallCount = DrawCallCount;
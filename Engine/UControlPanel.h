@@ -31,6 +31,7 @@ class UControlPanel : public ImGuiWindowWrapper
 
 	// Scene Management Section
 	char sceneName[256] = "Default";
+	bool bBinarySceneFile = false;	// Save/Load scene이 "<이름>.SceneBin" 바이너리 파일을 사용
 
 	// Camera Management Section
 	EViewModeIndex CurrentViewMode = EViewModeIndex::VMI_Lit;
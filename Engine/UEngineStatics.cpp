@@ -31,6 +31,7 @@ void UEngineStatics::RegisterSubsystem(UEngineSubsystem* subsystem)
     }
     
     RegisteredSubsystems.push_back(subsystem);
+    InvalidateSubsystemCache();
 }
 
 void UEngineStatics::UnregisterSubsystem(UEngineSubsystem* subsystem)
@@ -41,6 +42,7 @@ void UEngineStatics::UnregisterSubsystem(UEngineSubsystem* subsystem)
     if (it != RegisteredSubsystems.end())
     {
         RegisteredSubsystems.erase(it);
+        InvalidateSubsystemCache();
     }
 }
 
@@ -62,6 +64,17 @@ UEngineSubsystem* UEngineStatics::FindSubsystemByClass(UClass* targetClass)
     return nullptr;
 }
 
+void UEngineStatics::ForEachSubsystem(const TFunction<void(UEngineSubsystem*)>& func)
+{
+    for (UEngineSubsystem* subsystem : RegisteredSubsystems)
+    {
+        if (subsystem)
+        {
+            func(subsystem);
+        }
+    }
+}
+
 void UEngineStatics::ShutdownAllSubsystems()
 {
     // 역순으로 종료 (의존성 고려)
@@ -75,4 +88,5 @@ void UEngineStatics::ShutdownAllSubsystems()
     }
     
     RegisteredSubsystems.clear();
+    InvalidateSubsystemCache();
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 ﻿#pragma once
+#include <atomic>
 typedef unsigned char uint8;
 typedef int int32;
 typedef unsigned int uint32;
@@ -50,6 +51,36 @@ class UObject;
 class UEngineSubsystem;
 class UClass;
 
+/**
+ * @brief Per-type cached result of a subsystem lookup
+ * @note: The subsystem pointer and the registry generation it was found in are packed into one
+ *        word, so worker threads calling GetSubsystem see either the old or the new entry, never
+ *        a pointer paired with the wrong generation. The entry is valid while its generation
+ *        matches the registry generation. Generations wrap at 16 bits, which only matters for a
+ *        slot left unread across 65535 registry changes.
+ */
+struct FSubsystemCacheSlot
+{
+    static constexpr uint32 PointerBits = 48;
+    static constexpr uint32 GenerationMask = 0xFFFF;
+
+    static uint64 Pack(UEngineSubsystem* subsystem, uint32 generation)
+    {
+        // 유저 모드 포인터는 x64에서도 하위 48비트 안에 들어감
+        return (static_cast<uint64>(generation) << PointerBits) | static_cast<uint64>(reinterpret_cast<uintptr_t>(subsystem));
+    }
+
+    static uint32 GetGeneration(uint64 packed) { return static_cast<uint32>(packed >> PointerBits); }
+
+    static UEngineSubsystem* GetSubsystem(uint64 packed)
+    {
+        return reinterpret_cast<UEngineSubsystem*>(static_cast<uintptr_t>(packed & ((1ull << PointerBits) - 1)));
+    }
+
+    // 세대 0은 아직 채워지지 않은 슬롯
+    std::atomic<uint64> Packed{ 0 };
+};
+
 class UEngineStatics
 {
 public:
@@ -87,22 +118,45 @@ public:
     }
 
     // RTTI 기반 서브시스템 접근
+    // 타입별 캐시 슬롯을 사용하므로 레지스트리가 바뀌지 않았다면 비교 한 번 + 로드 한 번
+    // 병렬 틱 중 워커 스레드에서 불러도 됨 (등록/해제는 게임 스레드에서만)
     template<typename T>
     static T* GetSubsystem()
     {
         static_assert(std::is_base_of_v<UEngineSubsystem, T>, "T must inherit from UEngineSubsystem");
-        return static_cast<T*>(FindSubsystemByClass(T::StaticClass()));
+        static FSubsystemCacheSlot Slot;
+        const uint32 generation = SubsystemGeneration.load(std::memory_order_acquire);
+        uint64 packed = Slot.Packed.load(std::memory_order_relaxed);
+        if (FSubsystemCacheSlot::GetGeneration(packed) != generation)
+        {
+            // 여러 스레드가 동시에 채워도 모두 같은 값을 씀
+            packed = FSubsystemCacheSlot::Pack(FindSubsystemByClass(T::StaticClass()), generation);
+            Slot.Packed.store(packed, std::memory_order_relaxed);
+        }
+        return static_cast<T*>(FSubsystemCacheSlot::GetSubsystem(packed));
     }
 
     // 서브시스템 등록/해제
     static void RegisterSubsystem(UEngineSubsystem* subsystem);
     static void UnregisterSubsystem(UEngineSubsystem* subsystem);
     static void ShutdownAllSubsystems();
+    static void ForEachSubsystem(const TFunction<void(UEngineSubsystem*)>& func);
+
+    /** @note: Subsystems register from the base constructor, before their dynamic class is known,
+     *         so slots are refilled lazily instead of at registration time.
+     *         Also called once the class tree is numbered, since IsChildOrSelfOf fails before that. */
+    static void InvalidateSubsystemCache()
+    {
+        // 슬롯에는 16비트만 들어가고, 0은 빈 슬롯이므로 건너뜀
+        const uint32 next = (SubsystemGeneration.load(std::memory_order_relaxed) + 1) & FSubsystemCacheSlot::GenerationMask;
+        SubsystemGeneration.store(next != 0 ? next : 1, std::memory_order_release);
+    }
 
 private:
     static UEngineSubsystem* FindSubsystemByClass(UClass* targetClass);
-    
+
 private:
+    static inline std::atomic<uint32> SubsystemGeneration{ 1 };
     static uint32 NextUUID;
     static uint32 TotalAllocationBytes;
     static uint32 TotalAllocationCount;
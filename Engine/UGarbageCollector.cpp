@@ -0,0 +1,174 @@
+﻿#include "stdafx.h"
+#include <chrono>
+#include <limits>
+#include "UGarbageCollector.h"
+#include "UApplication.h"
+#include "UClass.h"
+
+IMPLEMENT_UCLASS(UGarbageCollector, UEngineSubsystem)
+
+double UGarbageCollector::NowMs()
+{
+	return std::chrono::duration<double, std::milli>(
+		std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+}
+
+bool UGarbageCollector::Initialize(UApplication* InApplication)
+{
+	application = InApplication;
+	return true;
+}
+
+void UGarbageCollector::AddRoot(UObject* Object)
+{
+	if (Object && std::find(roots.begin(), roots.end(), Object) == roots.end())
+	{
+		roots.push_back(Object);
+	}
+}
+
+void UGarbageCollector::RemoveRoot(UObject* Object)
+{
+	auto it = std::find(roots.begin(), roots.end(), Object);
+	if (it != roots.end())
+	{
+		*it = roots.back();
+		roots.pop_back();
+	}
+}
+
+void UGarbageCollector::Tick(float deltaTime)
+{
+	const double SliceStart = NowMs();
+
+	if (!bSweeping)
+	{
+		timeSinceLastCycle += deltaTime;
+		if (!bCollectionRequested && timeSinceLastCycle < IntervalSeconds)
+			return;
+
+		BeginCycle();
+	}
+
+	const bool bDone = SweepUntil(SliceStart + TimeBudgetMs);
+
+	const double SliceMs = NowMs() - SliceStart;
+	Stats.SliceMs.push_back(SliceMs);
+	Stats.MaxSliceMs = max(Stats.MaxSliceMs, SliceMs);
+	Stats.TotalMs += SliceMs;
+
+	if (bDone)
+	{
+		FinishCycle();
+	}
+}
+
+void UGarbageCollector::CollectGarbage()
+{
+	const double Start = NowMs();
+	if (!bSweeping)
+	{
+		BeginCycle();
+	}
+
+	SweepUntil(std::numeric_limits<double>::infinity());
+
+	const double SliceMs = NowMs() - Start;
+	Stats.SliceMs.push_back(SliceMs);
+	Stats.MaxSliceMs = max(Stats.MaxSliceMs, SliceMs);
+	Stats.TotalMs += SliceMs;
+	FinishCycle();
+}
+
+void UGarbageCollector::BeginCycle()
+{
+	const uint32 Cycle = Stats.Cycle + 1;
+	Stats = FGarbageCollectionStats();
+	Stats.Cycle = Cycle;
+
+	bCollectionRequested = false;
+	timeSinceLastCycle = 0.0f;
+
+	// 이번 사이클 이후 생성되는 객체는 표시된 상태로 시작
+	++markEpoch;
+	UObject::GUObjectArray.SetMarkEpoch(markEpoch);
+
+	const double MarkStart = NowMs();
+	MarkReachableObjects();
+	Stats.MarkMs = NowMs() - MarkStart;
+
+	sweepCursor = 0;
+	bSweeping = true;
+}
+
+void UGarbageCollector::MarkReachableObjects()
+{
+	FReferenceCollector Collector(markEpoch, markStack);
+
+	// 서브시스템 (USceneManager가 현재 씬을 보고함)
+	UEngineStatics::ForEachSubsystem([&Collector](UEngineSubsystem* Subsystem) {
+		Collector.AddReferencedObject(Subsystem);
+	});
+
+	Collector.AddReferencedObjects(roots);
+
+	// 에디터 선택 등 애플리케이션이 붙잡고 있는 객체
+	if (application)
+	{
+		application->AddReferencedObjects(Collector);
+	}
+
+	while (!markStack.empty())
+	{
+		UObject* Object = markStack.back();
+		markStack.pop_back();
+		Object->AddReferencedObjects(Collector);
+	}
+
+	Stats.NumMarked = Collector.GetNumMarked();
+}
+
+bool UGarbageCollector::SweepUntil(double DeadlineMs)
+{
+	FUObjectArray& ObjectArray = UObject::GUObjectArray;
+	constexpr uint32 ItemsPerTimeCheck = 256;
+
+	uint32 Checked = 0;
+	while (sweepCursor < ObjectArray.Num())
+	{
+		// 시간 확인은 일정 개수마다 한 번씩만
+		if (++Checked % ItemsPerTimeCheck == 0 && NowMs() >= DeadlineMs)
+			return false;
+
+		FUObjectItem* Item = ObjectArray.GetItem(sweepCursor++);
+		UObject* Object = Item->Object;
+		if (!Object || !(Item->Flags & IOF_GarbageCollectable) || Item->MarkEpoch == markEpoch)
+			continue;
+
+		++Stats.FreedByClass[Object->GetClass()->GetUClassName()];
+		++Stats.NumFreed;
+
+		const uint32 BytesBefore = UEngineStatics::GetTotalAllocationBytes();
+		Object->BeginDestroy();
+		delete Object;
+		Stats.BytesFreed += BytesBefore - UEngineStatics::GetTotalAllocationBytes();
+	}
+	return true;
+}
+
+void UGarbageCollector::FinishCycle()
+{
+	bSweeping = false;
+
+	if (Stats.NumFreed == 0)
+		return;
+
+	UE_LOG("[GC] Cycle %u: marked %u, freed %u objects (%u bytes) in %u slices (mark %.3f ms, max slice %.3f ms, total %.3f ms)",
+		Stats.Cycle, Stats.NumMarked, Stats.NumFreed, Stats.BytesFreed, static_cast<uint32>(Stats.SliceMs.size()),
+		Stats.MarkMs, Stats.MaxSliceMs, Stats.TotalMs);
+
+	for (const auto& Freed : Stats.FreedByClass)
+	{
+		UE_LOG("[GC]   %s x%u", Freed.first.c_str(), Freed.second);
+	}
+}
@@ -0,0 +1,120 @@
+﻿#pragma once
+#include "UEngineSubsystem.h"
+
+class UApplication;
+
+/**
+ * @brief Receives references reported from UObject::AddReferencedObjects during marking
+ */
+class FReferenceCollector
+{
+public:
+	FReferenceCollector(uint32 InEpoch, TArray<UObject*>& InMarkStack)
+		: Epoch(InEpoch), MarkStack(InMarkStack)
+	{
+	}
+
+	void AddReferencedObject(UObject* Object)
+	{
+		if (!Object) return;
+
+		FUObjectItem* Item = UObject::GUObjectArray.GetItem(Object->InternalIndex);
+		if (!Item || Item->Object != Object || Item->MarkEpoch == Epoch) return;
+
+		Item->MarkEpoch = Epoch;
+		MarkStack.push_back(Object);
+		++NumMarked;
+	}
+
+	template<typename T>
+	void AddReferencedObjects(const TArray<T*>& Objects)
+	{
+		for (T* Object : Objects)
+		{
+			AddReferencedObject(Object);
+		}
+	}
+
+	uint32 GetNumMarked() const { return NumMarked; }
+
+private:
+	uint32 Epoch;
+	TArray<UObject*>& MarkStack;
+	uint32 NumMarked = 0;
+};
+
+/**
+ * @brief Result of the last finished (or running) collection cycle
+ */
+struct FGarbageCollectionStats
+{
+	uint32 Cycle = 0;
+	uint32 NumMarked = 0;
+	uint32 NumFreed = 0;
+	uint32 BytesFreed = 0;
+	double MarkMs = 0.0;
+	double TotalMs = 0.0;
+	double MaxSliceMs = 0.0;
+	TArray<double> SliceMs;				// 사이클의 각 프레임 조각에 걸린 시간
+	TMap<FString, uint32> FreedByClass;
+};
+
+/**
+ * @brief Incremental mark-and-sweep collector for UObjects flagged IOF_GarbageCollectable
+ *
+ * Roots are the registered subsystems (the scene manager reports the current scene), objects added
+ * with AddRoot, and whatever the application reports (editor selection). Each cycle marks everything
+ * reachable in one step, then sweeps GUObjectArray over as many frames as the time budget requires.
+ *
+ * @note: Marking is not split across frames because references are plain pointers with no write
+ *        barrier; marking only visits reachable objects, while the sweep walks every slot.
+ *        Objects created after a cycle starts are treated as reachable for that cycle.
+ */
+class UGarbageCollector : public UEngineSubsystem
+{
+	DECLARE_UCLASS(UGarbageCollector, UEngineSubsystem)
+public:
+	bool Initialize(UApplication* InApplication);
+
+	/** @brief Advances the current cycle by at most one time budget, starting a new cycle when due. */
+	void Tick(float deltaTime);
+
+	/** @brief Starts a cycle on the next Tick regardless of the interval. */
+	void RequestCollection() { bCollectionRequested = true; }
+
+	/** @brief Runs a full cycle immediately, ignoring the time budget. */
+	void CollectGarbage();
+
+	void AddRoot(UObject* Object);
+	void RemoveRoot(UObject* Object);
+
+	void SetTimeBudget(float Milliseconds) { TimeBudgetMs = Milliseconds; }
+	void SetInterval(float Seconds) { IntervalSeconds = Seconds; }
+
+	bool IsCollecting() const { return bSweeping; }
+	const FGarbageCollectionStats& GetStats() const { return Stats; }
+
+private:
+	void BeginCycle();
+	void MarkReachableObjects();
+	/** @return true when the sweep reached the end of GUObjectArray. */
+	bool SweepUntil(double DeadlineMs);
+	void FinishCycle();
+
+	static double NowMs();
+
+	UApplication* application = nullptr;
+	TArray<UObject*> roots;
+	TArray<UObject*> markStack;
+
+	float TimeBudgetMs = 1.0f;
+	float IntervalSeconds = 10.0f;
+	float timeSinceLastCycle = 0.0f;
+	bool bCollectionRequested = false;
+
+	bool bSweeping = false;
+	uint32 markEpoch = 0;
+	uint32 sweepCursor = 0;
+
+	FGarbageCollectionStats Stats;
+};
@@ -28,11 +28,12 @@ bool UGizmoComponent::Initialize()
 		vertexShader = batchShaderManager->GetShaderByName(vertexShaderName);
 		pixelShader = batchShaderManager->GetShaderByName(pixelShaderName);
 	}
+	MarkRenderStateDirty();
 
 	return mesh && vertexShader && pixelShader;
 }
 
-FMatrix UGizmoComponent::GetWorldTransform() const
+FMatrix UGizmoComponent::GetRelativeTransform() const
 {
 	return FMatrix::SRTRowQuaternion(RelativeLocation, (OriginQuaternion * RelativeQuaternion).ToMatrixRow(), RelativeScale3D);
 }
@@ -57,7 +58,7 @@ void UGizmoComponent::UpdateConstantBuffer(URenderer& renderer)
 	(*vertexShader)["ConstantBuffer"]["MVP"] = MVP;
 	(*vertexShader)["ConstantBuffer"]["MeshColor"] = Color;
 	(*vertexShader)["ConstantBuffer"]["IsSelected"] = bIsSelected;
-	vertexShader->BindConstantBuffer(renderer.GetDeviceContext(), "ConstantBuffer");
+	vertexShader->BindConstantBuffer(renderer.GetRHI(), "ConstantBuffer");
 }
 
 void UGizmoComponent::BindVertexShader(URenderer& renderer)
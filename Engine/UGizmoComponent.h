@@ -25,7 +25,7 @@ public:
 
 	bool CountOnInspector() override { return true; }
 
-	FMatrix GetWorldTransform() const override;
+	FMatrix GetRelativeTransform() const override;
 
 	virtual void Update(float deltaTime) override;  // TODO: Rename to TickComponent() later
 	virtual void OnShutdown() override;  // TODO: Rename to EndPlay() later
@@ -38,6 +38,9 @@ public:
 
 	virtual void BindPixelShader(URenderer& renderer) override;
 
+	/** @note: Gizmos keep their own Color and bIsSelected, which the instanced path would not see. */
+	virtual bool CanBeInstanced() const override { return false; }
+
 	virtual void Draw(URenderer& renderer) override;
 
 	virtual LayerID GetLayer() const override { return 0; } 
@@ -47,6 +50,7 @@ public:
 	void SetOriginRotation(FVector originRotation)
 	{
 		OriginQuaternion = FQuaternion::FromEulerXYZDeg(originRotation);
+		MarkTransformDirty();
 	}
 
 	void SetColor(const FVector4& newColor) { Color = newColor; }
@@ -16,10 +16,7 @@ public:
 	
 	 virtual LayerID GetLayer() const override { return 2; } 
 
-	json::JSON Serialize() const override
-	{
-		return json::JSON();
-	}
+	bool IsEditorOnly() const override { return true; }
 
 	UGizmoGridComp();
 
@@ -12,6 +12,7 @@
 #include "UObject.h"
 #include "UScene.h"
 #include "UCamera.h"
+#include "UGarbageCollector.h"
 
 IMPLEMENT_UCLASS(UGizmoManager, UEngineSubsystem)
 UGizmoManager::UGizmoManager()
@@ -134,6 +135,14 @@ bool UGizmoManager::Initialize(UMeshManager* meshManager)
 	return true;
 }
 
+void UGizmoManager::AddReferencedObjects(FReferenceCollector& collector)
+{
+	collector.AddReferencedObject(gridPrimitive);
+	collector.AddReferencedObjects(locationGizmos);
+	collector.AddReferencedObjects(rotationGizmos);
+	collector.AddReferencedObjects(scaleGizmos);
+}
+
 void UGizmoManager::SetTarget(UPrimitiveComponent* target)
 {
 	targetObject = target;
@@ -174,7 +183,7 @@ void UGizmoManager::NextTranslation()
 
 TArray<UGizmoComponent*>& UGizmoManager::GetRaycastableGizmos()
 {
-	if (targetObject == nullptr)
+	if (!targetObject)
 	{
 		static TArray<UGizmoComponent*> emptyArray; // lives for the whole program
 		return emptyArray;
@@ -216,7 +225,8 @@ void UGizmoManager::Draw(URenderer& renderer)
 
 	// --- 파트 2: 타겟이 있을 때만 그리는 요소 ---
 
-	if (targetObject == nullptr) return;
+	UPrimitiveComponent* target = targetObject.Get();
+	if (target == nullptr) return;
 
 	// 현재 모드에 따라 올바른 기즈모를 그립니다.
 	TArray<UGizmoComponent*>* currentGizmos = nullptr;
@@ -241,7 +251,7 @@ void UGizmoManager::Draw(URenderer& renderer)
 			if (gizmoPart)
 			{
 				// Todo: 이동을 update에서 처리해야 하나??
-				gizmoPart->SetPosition(targetObject->GetPosition());
+				gizmoPart->SetPosition(target->GetPosition());
 
 				// Scale 은 항상 local
 				if (translationType != ETranslationType::Scale && isWorldSpace)
@@ -250,10 +260,10 @@ void UGizmoManager::Draw(URenderer& renderer)
 				}
 				else
 				{
-					gizmoPart->SetQuaternion(targetObject->RelativeQuaternion);
+					gizmoPart->SetQuaternion(target->RelativeQuaternion);
 				}
 
-				float gizmoScale = (targetObject->RelativeLocation - camera->GetLocation()).Length() * 0.15f;
+				float gizmoScale = (target->RelativeLocation - camera->GetLocation()).Length() * 0.15f;
 				gizmoPart->SetScale({ gizmoScale, gizmoScale, gizmoScale });
 
 
@@ -330,12 +340,15 @@ FVector UGizmoManager::FindCirclePlaneIntersection(const FRay& ray, const FPlane
 
 void UGizmoManager::BeginDrag(const FRay& mouseRay, EAxis axis, FVector impactPoint, UScene* curScene)
 {
+	UPrimitiveComponent* target = targetObject.Get();
+	if (target == nullptr) return;
+
 	isDragging = true;
 	selectedAxis = axis;
 
-	dragStartLocation = targetObject->GetPosition();
-	dragStartScale = targetObject->GetScale();
-	dragStartQuaternion = targetObject->GetQuaternion();
+	dragStartLocation = target->GetPosition();
+	dragStartScale = target->GetScale();
+	dragStartQuaternion = target->GetQuaternion();
 
 	// 이동 평면 생성
 	movementPlane.PointOnPlane = dragStartLocation;
@@ -351,7 +364,7 @@ void UGizmoManager::BeginDrag(const FRay& mouseRay, EAxis axis, FVector impactPo
 		// 로컬 스페이스 모드일 경우, 축 벡터를 오브젝트의 회전만큼 회전시킵니다.
 		if (!isWorldSpace)
 		{
-			axisDir = targetObject->GetQuaternion().RotateInverse(axisDir);
+			axisDir = target->GetQuaternion().RotateInverse(axisDir);
 		}
 		dragRotationStartPoint = mouseRay.MousePos;
 		FVector rotDir = axisDir.Cross(impactPoint - dragStartLocation);
@@ -363,7 +376,7 @@ void UGizmoManager::BeginDrag(const FRay& mouseRay, EAxis axis, FVector impactPo
 		// 로컬 스페이스 모드일 경우, 축 벡터를 오브젝트의 회전만큼 회전시킵니다.
 		if (!isWorldSpace)
 		{
-			axisDir = targetObject->GetQuaternion().RotateInverse(axisDir);
+			axisDir = target->GetQuaternion().RotateInverse(axisDir);
 		}
 
 		// 이동 축과 시선 벡터에 동시에 수직인 벡터를 찾고,
@@ -374,7 +387,7 @@ void UGizmoManager::BeginDrag(const FRay& mouseRay, EAxis axis, FVector impactPo
 	else if (translationType == ETranslationType::Scale)
 	{
 		// Scale 은 항상 로컬 스페이스 모드
-		axisDir = targetObject->GetQuaternion().RotateInverse(axisDir);
+		axisDir = target->GetQuaternion().RotateInverse(axisDir);
 
 		// 이동 축과 시선 벡터에 동시에 수직인 벡터를 찾고,
 		// 다시 외적하여 평면의 법선 벡터를 계산
@@ -395,6 +408,9 @@ void UGizmoManager::UpdateDrag(const FRay& mouseRay)
 {
 	if (!isDragging) return;
 
+	UPrimitiveComponent* target = targetObject.Get();
+	if (target == nullptr) return;
+
 	// --- 1. 마우스 레이와 이동 평면의 3D 교차점 찾기 ---
 	FVector intersectionPoint = FindCirclePlaneIntersection(mouseRay, movementPlane);
 	FVector startToIntersectionVec = intersectionPoint - dragStartLocation;
@@ -406,17 +422,17 @@ void UGizmoManager::UpdateDrag(const FRay& mouseRay)
 		// 로컬 스페이스 모드일 경우, 축 벡터를 오브젝트의 회전만큼 회전시킵니다.
 		if (!isWorldSpace)
 		{
-			axisDir = targetObject->GetQuaternion().RotateInverse(axisDir);
+			axisDir = target->GetQuaternion().RotateInverse(axisDir);
 		}
 
 		float projectedLength = startToIntersectionVec.Dot(axisDir) - projectedLengthOffset;
 		FVector newPosition = dragStartLocation + axisDir * projectedLength;
 
-		targetObject->SetPosition(newPosition);
+		target->SetPosition(newPosition);
 	}
 	else if (translationType == ETranslationType::Scale)
 	{
-		axisDir = targetObject->GetQuaternion().RotateInverse(axisDir);
+		axisDir = target->GetQuaternion().RotateInverse(axisDir);
 		float projectedLength = startToIntersectionVec.Dot(axisDir) - projectedLengthOffset;
 		FVector newScale = dragStartScale + GetAxisVector(selectedAxis) * projectedLength;
 
@@ -426,7 +442,7 @@ void UGizmoManager::UpdateDrag(const FRay& mouseRay)
 		newScale.Y = max(newScale.Y, minimumScale);
 		newScale.Z = max(newScale.Z, minimumScale);
 
-		targetObject->SetScale(newScale);
+		target->SetScale(newScale);
 	}
 	else // ETranslationType::Rotation
 	{
@@ -452,7 +468,7 @@ void UGizmoManager::UpdateDrag(const FRay& mouseRay)
 			finalQuaternion = dragStartQuaternion.RotatedLocalAxisAngle(rotationAxis, angle);
 		}
 
-		targetObject->SetQuaternion(finalQuaternion);
+		target->SetQuaternion(finalQuaternion);
 	}
 }
 
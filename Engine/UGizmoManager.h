@@ -3,6 +3,7 @@
 #include "UGizmoComponent.h"
 #include "URaycastManager.h"
 #include "UEngineSubsystem.h"
+#include "TWeakObjectPtr.h"
 
 class UMeshManager; // 전방 선언
 class URenderer;
@@ -42,7 +43,7 @@ public:
 
 	void NextTranslation();
 
-	UPrimitiveComponent* GetTarget() { return targetObject; }
+	UPrimitiveComponent* GetTarget() { return targetObject.Get(); }
 	TArray<UGizmoComponent*>& GetRaycastableGizmos();
 	void BeginDrag(const FRay& mouseRay, EAxis selectedAxis, FVector impactPoint, UScene* curScene);
 	void UpdateDrag(const FRay& mouseRay);
@@ -58,6 +59,8 @@ public:
 
 	EAxis GetSelectedAxis() { return selectedAxis; }
 
+	void AddReferencedObjects(FReferenceCollector& collector) override;
+
 private:
 	ETranslationType translationType = ETranslationType::Location;
 
@@ -72,7 +75,7 @@ private:
 
 	UCamera* camera;
 	UMeshManager* meshManager;
-	UPrimitiveComponent* targetObject = nullptr; // 현재 선택된 객체
+	TWeakObjectPtr<UPrimitiveComponent> targetObject; // 현재 선택된 객체 (삭제되면 자동으로 null)
 
 	// 드래그 계산을 위해 저장해두는 정보
 	FVector dragStartLocation;    // 드래그 시작 시 Target의 월드 위치
@@ -345,6 +345,15 @@ void UInputManager::UnregisterCallbacks(const FString& id)
     mouseCallbacks.erase(id);
 }
 
+void UInputManager::UnregisterCallbacks(const TArray<FString>& ids)
+{
+    for (const FString& id : ids)
+    {
+        keyCallbacks.erase(id);
+        mouseCallbacks.erase(id);
+    }
+}
+
 void UInputManager::UnregisterAllCallbacks()
 {
     keyCallbacks.clear();
@@ -92,6 +92,7 @@ public:
     void RegisterKeyCallback(const FString& id, KeyCallback callback);
     void RegisterMouseCallback(const FString& id, MouseCallback callback);
     void UnregisterCallbacks(const FString& id);
+    void UnregisterCallbacks(const TArray<FString>& ids);
     void UnregisterAllCallbacks();
 
 private:
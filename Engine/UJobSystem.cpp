@@ -0,0 +1,281 @@
+﻿#include "stdafx.h"
+#include "UJobSystem.h"
+#include "UClass.h"
+#include "ConfigManager.h"
+
+IMPLEMENT_UCLASS(UJobSystem, UEngineSubsystem)
+
+namespace
+{
+	// 정적 초기화는 main 이전에 메인 스레드에서 실행되므로 그 스레드를 게임 스레드로 봄
+	const std::thread::id GGameThreadId = std::this_thread::get_id();
+	thread_local uint32 GJobThreadIndex = (std::this_thread::get_id() == GGameThreadId) ? 0 : UJobSystem::ForeignThreadIndex;
+}
+
+UJobSystem::~UJobSystem()
+{
+	Shutdown();
+}
+
+bool UJobSystem::Initialize()
+{
+	return StartWorkers(ConfigManager::GetConfig("editor")->getInt("JobSystem", "Workers", -1));
+}
+
+bool UJobSystem::StartWorkers(int32 NumWorkers)
+{
+	if (!Queues.empty())
+		return true;
+
+	if (NumWorkers < 0)
+	{
+		const int32 HardwareThreads = static_cast<int32>(std::thread::hardware_concurrency());
+		NumWorkers = max(HardwareThreads - 1, 0);
+	}
+
+	bStopping = false;
+	for (int32 i = 0; i <= NumWorkers + 1; ++i)
+	{
+		Queues.push_back(MakeUnique<FWorkerQueue>());
+	}
+
+	Workers.reserve(NumWorkers);
+	for (int32 i = 0; i < NumWorkers; ++i)
+	{
+		Workers.emplace_back(&UJobSystem::WorkerMain, this, static_cast<uint32>(i + 1));
+	}
+
+	UE_LOG("JobSystem: %d worker threads", NumWorkers);
+	return true;
+}
+
+void UJobSystem::Shutdown()
+{
+	if (Queues.empty())
+		return;
+
+	{
+		std::lock_guard<std::mutex> Lock(WakeMutex);
+		bStopping = true;
+	}
+	WakeCondition.notify_all();
+
+	for (std::thread& Worker : Workers)
+	{
+		Worker.join();
+	}
+	Workers.clear();
+
+	// 남은 작업은 여기서 마저 실행해 카운터를 기다리는 쪽이 멈추지 않게 함
+	while (TryRunOne(GetCurrentThreadIndex())) {}
+	Queues.clear();
+}
+
+uint32 UJobSystem::GetCurrentThreadIndex()
+{
+	return GJobThreadIndex;
+}
+
+void UJobSystem::Run(TFunction<void()> Task, FJobCounter* Counter)
+{
+	if (Counter)
+	{
+		Counter->Count.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	FJob Job{ std::move(Task), Counter };
+	if (Workers.empty())
+	{
+		Execute(Job);
+		return;
+	}
+	Push(std::move(Job));
+}
+
+void UJobSystem::RunAfter(FJobCounter& Dependency, TFunction<void()> Task, FJobCounter* Counter)
+{
+	if (Counter)
+	{
+		Counter->Count.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	{
+		// 0이 되는 쪽도 같은 락을 잡고 Dependents를 가져가므로 놓치는 작업이 없음
+		std::lock_guard<std::mutex> Lock(Dependency.Mutex);
+		if (!Dependency.IsDone())
+		{
+			Dependency.Dependents.push_back(FJob{ std::move(Task), Counter });
+			return;
+		}
+	}
+
+	FJob Job{ std::move(Task), Counter };
+	if (Workers.empty())
+	{
+		Execute(Job);
+		return;
+	}
+	Push(std::move(Job));
+}
+
+void UJobSystem::Wait(FJobCounter& Counter)
+{
+	const uint32 ThreadIndex = GetCurrentThreadIndex();
+	while (!Counter.IsDone())
+	{
+		if (!TryRunOne(ThreadIndex))
+		{
+			// 남은 작업이 다른 스레드에서 실행 중
+			std::this_thread::yield();
+		}
+	}
+
+	// 마지막 감소를 한 스레드가 락을 놓을 때까지 기다린 뒤 반환 (호출자가 곧 Counter를 파괴할 수 있음)
+	std::lock_guard<std::mutex> Lock(Counter.Mutex);
+}
+
+void UJobSystem::ParallelFor(uint32 Num, uint32 GrainSize, const TFunction<void(uint32 Start, uint32 End)>& Body)
+{
+	if (Num == 0)
+		return;
+
+	if (GrainSize == 0)
+	{
+		GrainSize = max(Num / (GetNumThreads() * 4), 1u);
+	}
+
+	if (Workers.empty() || Num <= GrainSize)
+	{
+		Body(0, Num);
+		return;
+	}
+
+	// 첫 청크는 호출한 스레드가 직접 실행하고 나머지는 훔쳐가도록 큐에 넣음
+	FJobCounter Counter;
+	for (uint32 Start = GrainSize; Start < Num; Start += GrainSize)
+	{
+		const uint32 End = min(Start + GrainSize, Num);
+		Run([&Body, Start, End]() { Body(Start, End); }, &Counter);
+	}
+
+	Body(0, GrainSize);
+	Wait(Counter);
+}
+
+uint32 UJobSystem::GetQueueIndex(uint32 ThreadIndex) const
+{
+	// 외부 스레드끼리는 큐를 공유하지만 모든 접근이 큐 락을 거치므로 안전
+	// (Workers는 시작 중에 자라므로 워커 수 대신 미리 만든 Queues 크기로 판단)
+	const uint32 ForeignQueue = static_cast<uint32>(Queues.size()) - 1;
+	return ThreadIndex < ForeignQueue ? ThreadIndex : ForeignQueue;
+}
+
+void UJobSystem::Push(FJob&& Job)
+{
+	FWorkerQueue& Queue = *Queues[GetQueueIndex(GetCurrentThreadIndex())];
+	{
+		std::lock_guard<std::mutex> Lock(Queue.Mutex);
+		Queue.Jobs.push_back(std::move(Job));
+	}
+
+	PendingJobs.fetch_add(1, std::memory_order_release);
+	{
+		// 워커가 조건 확인과 대기 사이에 있을 때 알림을 놓치지 않도록 락을 한 번 거침
+		std::lock_guard<std::mutex> Lock(WakeMutex);
+	}
+	WakeCondition.notify_one();
+}
+
+bool UJobSystem::TryPop(uint32 ThreadIndex, FJob& OutJob)
+{
+	const uint32 QueueCount = static_cast<uint32>(Queues.size());
+
+	// 자기 큐는 뒤에서 (LIFO, 캐시에 남아있는 작업부터)
+	const uint32 OwnIndex = GetQueueIndex(ThreadIndex);
+	{
+		FWorkerQueue& Own = *Queues[OwnIndex];
+		std::lock_guard<std::mutex> Lock(Own.Mutex);
+		if (!Own.Jobs.empty())
+		{
+			OutJob = std::move(Own.Jobs.back());
+			Own.Jobs.pop_back();
+			PendingJobs.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+
+	// 다른 큐는 앞에서 훔침 (FIFO, 큰 덩어리부터)
+	for (uint32 Offset = 1; Offset < QueueCount; ++Offset)
+	{
+		FWorkerQueue& Victim = *Queues[(OwnIndex + Offset) % QueueCount];
+		std::unique_lock<std::mutex> Lock(Victim.Mutex, std::try_to_lock);
+		if (Lock.owns_lock() && !Victim.Jobs.empty())
+		{
+			OutJob = std::move(Victim.Jobs.front());
+			Victim.Jobs.pop_front();
+			PendingJobs.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool UJobSystem::TryRunOne(uint32 ThreadIndex)
+{
+	if (Queues.empty())
+		return false;
+
+	FJob Job;
+	if (!TryPop(ThreadIndex, Job))
+		return false;
+
+	Execute(Job);
+	return true;
+}
+
+void UJobSystem::Execute(FJob& Job)
+{
+	Job.Task();
+
+	FJobCounter* Counter = Job.Counter;
+	if (!Counter)
+		return;
+
+	TArray<FJob> Ready;
+	{
+		std::lock_guard<std::mutex> Lock(Counter->Mutex);
+		if (Counter->Count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			Ready.swap(Counter->Dependents);
+		}
+	}
+
+	for (FJob& Dependent : Ready)
+	{
+		if (Workers.empty())
+		{
+			Execute(Dependent);
+		}
+		else
+		{
+			Push(std::move(Dependent));
+		}
+	}
+}
+
+void UJobSystem::WorkerMain(uint32 ThreadIndex)
+{
+	GJobThreadIndex = ThreadIndex;
+
+	while (!bStopping.load(std::memory_order_acquire))
+	{
+		if (TryRunOne(ThreadIndex))
+			continue;
+
+		std::unique_lock<std::mutex> Lock(WakeMutex);
+		WakeCondition.wait(Lock, [this]() {
+			return bStopping.load(std::memory_order_acquire) || PendingJobs.load(std::memory_order_acquire) > 0;
+		});
+	}
+}
@@ -0,0 +1,119 @@
+﻿#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include "UEngineSubsystem.h"
+
+class FJobCounter;
+
+/**
+ * @brief Unit of work scheduled on UJobSystem
+ */
+struct FJob
+{
+	TFunction<void()> Task;
+	FJobCounter* Counter = nullptr;	// 끝나면 1 감소
+};
+
+/**
+ * @brief Number of outstanding jobs; jobs queued with RunAfter start once it reaches zero
+ * @note: Must outlive every job that references it (typically a local waited on with UJobSystem::Wait).
+ */
+class FJobCounter
+{
+public:
+	FJobCounter() = default;
+	FJobCounter(const FJobCounter&) = delete;
+	FJobCounter& operator=(const FJobCounter&) = delete;
+
+	bool IsDone() const { return Count.load(std::memory_order_acquire) == 0; }
+	int32 GetValue() const { return Count.load(std::memory_order_acquire); }
+
+private:
+	friend class UJobSystem;
+
+	std::atomic<int32> Count{ 0 };
+	std::mutex Mutex;
+	TArray<FJob> Dependents;
+};
+
+/**
+ * @brief Work-stealing thread pool
+ *
+ * Every thread (index 0 = the game thread, 1..N = workers) owns a deque. Jobs are pushed to and
+ * popped from the back of the submitting thread's deque and stolen from the front of the others'.
+ * Wait() and ParallelFor() run queued jobs on the calling thread until the counter drops to zero,
+ * so the game thread helps instead of blocking.
+ *
+ * Threads the pool does not own (the scene streamer's loader, for example) get ForeignThreadIndex.
+ * Their jobs go to one shared, locked queue that every thread steals from, and they have no slot
+ * in per-thread buffers sized by GetNumThreads().
+ *
+ * @note: With 0 workers every call runs inline, which keeps single-core behaviour unchanged.
+ */
+class UJobSystem : public UEngineSubsystem
+{
+	DECLARE_UCLASS(UJobSystem, UEngineSubsystem)
+public:
+	~UJobSystem() override;
+
+	/** @brief Starts the worker count from editor.ini [JobSystem] Workers (negative = hardware threads - 1). */
+	bool Initialize() override;
+
+	/**
+	 * @brief Starts the pool with an explicit worker count. Does nothing if it is already running.
+	 * @param NumWorkers Worker thread count; negative means hardware threads - 1.
+	 */
+	bool StartWorkers(int32 NumWorkers);
+	void Shutdown() override;
+
+	/** @brief Queues Task; Counter (optional) is incremented now and decremented when Task finishes. */
+	void Run(TFunction<void()> Task, FJobCounter* Counter = nullptr);
+
+	/** @brief Queues Task once Dependency reaches zero. Counter is incremented immediately. */
+	void RunAfter(FJobCounter& Dependency, TFunction<void()> Task, FJobCounter* Counter = nullptr);
+
+	/** @brief Runs queued jobs on the calling thread until Counter reaches zero. */
+	void Wait(FJobCounter& Counter);
+
+	/**
+	 * @brief Calls Body(Start, End) over [0, Num) split into chunks of GrainSize and waits for all of them.
+	 * @param GrainSize Items per job; 0 picks about four chunks per thread.
+	 */
+	void ParallelFor(uint32 Num, uint32 GrainSize, const TFunction<void(uint32 Start, uint32 End)>& Body);
+
+	uint32 GetNumWorkers() const { return static_cast<uint32>(Workers.size()); }
+	/** @brief Workers + the owning thread; the size to use for per-thread buffers. */
+	uint32 GetNumThreads() const { return GetNumWorkers() + 1; }
+
+	static constexpr uint32 ForeignThreadIndex = UINT_MAX;
+
+	/** @brief 0 on the game thread (the one that ran static initialization), 1..N on workers, ForeignThreadIndex elsewhere. */
+	static uint32 GetCurrentThreadIndex();
+	static bool IsForeignThread() { return GetCurrentThreadIndex() == ForeignThreadIndex; }
+
+private:
+	struct FWorkerQueue
+	{
+		std::mutex Mutex;
+		std::deque<FJob> Jobs;
+	};
+
+	/** @brief Index of ThreadIndex's own queue; foreign threads share the last one. */
+	uint32 GetQueueIndex(uint32 ThreadIndex) const;
+	void Push(FJob&& Job);
+	bool TryPop(uint32 ThreadIndex, FJob& OutJob);
+	bool TryRunOne(uint32 ThreadIndex);
+	void Execute(FJob& Job);
+	void WorkerMain(uint32 ThreadIndex);
+
+	TArray<TUniquePtr<FWorkerQueue>> Queues;	// [0] = 게임 스레드, [i] = i번째 워커, [마지막] = 외부 스레드 공용
+	TArray<std::thread> Workers;
+
+	std::atomic<int32> PendingJobs{ 0 };
+	std::atomic<bool> bStopping{ false };
+	std::mutex WakeMutex;
+	std::condition_variable WakeCondition;
+};
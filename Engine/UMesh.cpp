@@ -18,11 +18,31 @@ UMesh::UMesh()
 UMesh::UMesh(MeshID ID, const TArray<FVertexPosColorUV4>& vertices, D3D_PRIMITIVE_TOPOLOGY primitiveType)
 	: ID(ID), Vertices(vertices), NumVertices(vertices.size()), Stride(sizeof(FVertexPosColorUV4)), PrimitiveType(primitiveType)
 {
+	ComputeBounds();
 }
 
 UMesh::UMesh(MeshID ID, const TArray<FVertexPosColorUV4>& VertexArray, const TArray<uint32>& IndexArray, D3D_PRIMITIVE_TOPOLOGY primitiveType)
 	: ID(ID), Vertices(VertexArray), Indices(IndexArray), NumVertices(VertexArray.size()), NumIndices(IndexArray.size()), Stride(sizeof(FVertexPosColorUV4)), PrimitiveType(primitiveType)
 {
+	ComputeBounds();
+}
+
+void UMesh::ComputeBounds()
+{
+	// 정점은 생성 후 바뀌지 않으므로 한 번만 계산 (월드 바운드는 FAABB::TransformBy로 O(1))
+	LocalBounds = FAABB();
+	for (const FVertexPosColorUV4& vertex : Vertices)
+	{
+		LocalBounds.AddPoint(FVector(vertex.x, vertex.y, vertex.z));
+	}
+
+	LocalSphereCenter = LocalBounds.IsValid() ? LocalBounds.GetCenter() : FVector();
+	float radiusSquared = 0.0f;
+	for (const FVertexPosColorUV4& vertex : Vertices)
+	{
+		radiusSquared = max(radiusSquared, (FVector(vertex.x, vertex.y, vertex.z) - LocalSphereCenter).LengthSquared());
+	}
+	LocalSphereRadius = sqrtf(radiusSquared);
 }
 
 void UMesh::Init(ID3D11Device* device) {
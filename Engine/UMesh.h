@@ -4,6 +4,8 @@
 #include "FVertexPosColor.h"
 #include "UObject.h"
 #include "Vector4.h"
+#include "FBounds.h"
+#include "FRHICommandContext.h"
 
 struct FVertexPosColor4; // 전방 선언
 
@@ -37,17 +39,17 @@ public:
 		if (IndexBuffer) IndexBuffer->Release();
 	}
 
-	void Bind(ID3D11DeviceContext* DeviceContext)
+	void Bind(FRHICommandContext& RHI)
 	{
 		UINT Offset = 0;
 
-		DeviceContext->IASetVertexBuffers(0, 1, &VertexBuffer, &Stride, &Offset);
+		RHI.SetVertexBuffers(0, 1, &VertexBuffer, &Stride, &Offset);
 
-		DeviceContext->IASetPrimitiveTopology(PrimitiveType);
+		RHI.SetPrimitiveTopology(PrimitiveType);
 
 		if (IndexBuffer)
 		{
-			DeviceContext->IASetIndexBuffer(IndexBuffer, DXGI_FORMAT_R32_UINT, 0);
+			RHI.SetIndexBuffer(IndexBuffer, DXGI_FORMAT_R32_UINT, 0);
 		}
 	}
 
@@ -57,6 +59,12 @@ public:
 
 	bool IsIndexBufferEnabled() const { return IndexBuffer;  }
 
+	/** @brief Local-space bounds of Vertices, computed once at construction. */
+	const FAABB& GetLocalBounds() const { return LocalBounds; }
+	/** @brief Bounding sphere around the local AABB center (radius = farthest vertex). */
+	const FVector& GetLocalSphereCenter() const { return LocalSphereCenter; }
+	float GetLocalSphereRadius() const { return LocalSphereRadius; }
+
 	MeshID GetID() const
 	{
 		assert(ID && "ID is not initialized");
@@ -66,5 +74,11 @@ public:
 private:
 	bool isInitialized = false;
 
+	void ComputeBounds();
+
+	FAABB LocalBounds;
+	FVector LocalSphereCenter;
+	float LocalSphereRadius = 0.0f;
+
 	TOptional<MeshID> ID;
 };
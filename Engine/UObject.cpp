@@ -1,5 +1,81 @@
 ﻿#include "stdafx.h"
 #include "UObject.h"
 #include "UClass.h"
+#include "FProperty.h"
 
-IMPLEMENT_ROOT_UCLASS(UObject)
\ No newline at end of file
+IMPLEMENT_ROOT_UCLASS(UObject)
+
+TArray<UObject*>& UObject::GetPendingClassRegistrations()
+{
+    // 정적 초기화 중에도 객체가 생성되고, 정적 소멸 순서와 무관하게 유지되도록 해제하지 않음
+    static TArray<UObject*>* Pending = new TArray<UObject*>();
+    return *Pending;
+}
+
+void UObject::AddPendingClassRegistration(UObject* obj)
+{
+    TArray<UObject*>& pending = GetPendingClassRegistrations();
+    obj->RegisteredClass = nullptr;
+    obj->ClassListIndex = static_cast<uint32>(pending.size());
+    pending.push_back(obj);
+}
+
+void UObject::FlushPendingClassRegistrations()
+{
+    TArray<UObject*>& pending = GetPendingClassRegistrations();
+    for (UObject* obj : pending)
+    {
+        UClass* objectClass = obj->GetClass();
+
+        // UClass 인스턴스는 정적 소멸 시 서로의 목록을 참조하게 되므로 추적하지 않음
+        if (objectClass == UClass::StaticClass())
+        {
+            obj->ClassListIndex = UINT_MAX;
+            continue;
+        }
+
+        obj->RegisteredClass = objectClass;
+        obj->ClassListIndex = static_cast<uint32>(objectClass->objects.size());
+        objectClass->objects.push_back(obj);
+    }
+    pending.clear();
+}
+
+void UObject::RemoveFromClassList(UObject* obj)
+{
+    if (obj->ClassListIndex == UINT_MAX) return;
+
+    TArray<UObject*>& list = obj->RegisteredClass ? obj->RegisteredClass->objects : GetPendingClassRegistrations();
+    const uint32 index = obj->ClassListIndex;
+    assert(index < list.size() && list[index] == obj);
+
+    // swap-remove (O(1)): 마지막 객체를 빈 자리로 옮김
+    UObject* last = list.back();
+    list[index] = last;
+    last->ClassListIndex = index;
+    list.pop_back();
+
+    obj->RegisteredClass = nullptr;
+    obj->ClassListIndex = UINT_MAX;
+}
+
+json::JSON UObject::Serialize() const
+{
+    json::JSON result;
+    FPropertySerializer::ToJson(this, result);
+    return result;
+}
+
+bool UObject::Deserialize(const json::JSON& data)
+{
+    return FPropertySerializer::FromJson(this, data);
+}
+void UObject::SerializeBinary(TArray<uint8>& outBytes) const
+{
+    FPropertySerializer::ToBinary(this, outBytes);
+}
+
+bool UObject::DeserializeBinary(const uint8*& cursor, const uint8* end)
+{
+    return FPropertySerializer::FromBinary(this, cursor, end);
+}
@@ -5,57 +5,60 @@
 #include "ISerializable.h"
 #include "UObjectMacros.h"
 #include "FName.h"
+#include "FObjectAllocator.h"
+#include "FUObjectArray.h"
 
 typedef int int32;
 typedef unsigned int uint32;
 
+class FReferenceCollector;
+
 /**
  * @brief Base class for all engine objects with serialization and object tracking
  */
 class UObject : public ISerializable
 {
     DECLARE_ROOT_UCLASS(UObject)
-private:
-    static inline TArray<uint32> FreeIndices;
-    static inline uint32 NextFreshIndex = 0;
 public:
-    static inline TArray<UObject*> GUObjectArray;
+    // 청크 기반 저장소: 성장해도 기존 슬롯 포인터가 유지되고, 슬롯마다 세대 번호를 가짐
+    static inline FUObjectArray GUObjectArray;
     uint32 UUID;
     uint32 InternalIndex;
     FName name;
 
     static void AddTrackedObject(UObject* obj)
     {
-        // 방법 1: 빠른 추가 - 재사용 인덱스 우선 사용
-        if (!FreeIndices.empty())
-        {
-            // 삭제된 슬롯 재사용 (O(1))
-            obj->InternalIndex = FreeIndices.back();
-            FreeIndices.pop_back();
-            GUObjectArray[obj->InternalIndex] = obj;
-        }
-        else
-        {
-            // 새 슬롯 할당 (O(1) amortized)
-            obj->InternalIndex = NextFreshIndex++;
-            GUObjectArray.push_back(obj);
-        }
+        // 재사용 인덱스 우선 사용 (O(1))
+        obj->InternalIndex = GUObjectArray.AddObject(obj);
+        AddPendingClassRegistration(obj);
     }
 
     static void RemoveTrackedObject(UObject* obj)
     {
-        // 방법 1: 빠른 삭제 - nullptr 마킹 + 인덱스 재사용 큐에 추가
-        if (obj->InternalIndex < GUObjectArray.size() && GUObjectArray[obj->InternalIndex] == obj)
-        {
-            GUObjectArray[obj->InternalIndex] = nullptr;  // O(1)
-            FreeIndices.push_back(obj->InternalIndex);    // O(1)
-        }
+        // nullptr 마킹 + 세대 증가 + free list 추가 (O(1))
+        GUObjectArray.RemoveObject(obj->InternalIndex, obj);
+        RemoveFromClassList(obj);
+    }
+
+    /**
+     * @brief Moves objects constructed since the last call into their UClass object lists.
+     * @note: Registration is deferred because GetClass() still reports UObject inside the UObject constructor.
+     *        TObjectIterator calls this before walking the lists.
+     */
+    static void FlushPendingClassRegistrations();
+
+    /** @brief Generation-checked handle for this object. See TWeakObjectPtr. */
+    FObjectHandle GetHandle() const
+    {
+        return GUObjectArray.MakeHandle(InternalIndex);
     }
 
     UObject()
     {
+        // 기본 이름은 최초 한 번만 name pool에 등록
+        static const FName DefaultObjectName("New Object");
         UUID = UINT_MAX;
-        name = FName("New Object");
+        name = DefaultObjectName;
         AddTrackedObject(this);
     }
 
@@ -64,6 +67,34 @@ public:
         RemoveTrackedObject(this);
     }
 
+private:
+    // 클래스별 객체 목록에서의 위치. RegisteredClass가 nullptr이면 등록 대기 목록에서의 위치
+    UClass* RegisteredClass = nullptr;
+    uint32 ClassListIndex = UINT_MAX;
+
+    static TArray<UObject*>& GetPendingClassRegistrations();
+    static void AddPendingClassRegistration(UObject* obj);
+    static void RemoveFromClassList(UObject* obj);
+
+public:
+    /** @brief Lets the garbage collector delete this object once nothing reachable references it. */
+    void SetGarbageCollectable(bool bCollectable)
+    {
+        FUObjectItem* item = GUObjectArray.GetItem(InternalIndex);
+        item->Flags = bCollectable ? (item->Flags | IOF_GarbageCollectable) : (item->Flags & ~IOF_GarbageCollectable);
+    }
+
+    bool IsGarbageCollectable() const
+    {
+        return (GUObjectArray.GetItem(InternalIndex)->Flags & IOF_GarbageCollectable) != 0;
+    }
+
+    /** @brief Reports every UObject this object keeps alive. See UGarbageCollector. */
+    virtual void AddReferencedObjects(FReferenceCollector& collector) {}
+
+    /** @brief Called by the garbage collector right before deleting an unreachable object. */
+    virtual void BeginDestroy() {}
+
     virtual bool CountOnInspector() {
         return false;
     }
@@ -82,17 +113,18 @@ public:
     const T* Cast() const {
         return IsA<T>() ? static_cast<const T*>(this) : nullptr;
     }
-    // Override new/delete for tracking
+    // Override new/delete for tracking and pooled allocation
     void* operator new(size_t size)
     {
         UEngineStatics::AddAllocation(size);
-        return ::operator new(size);
+        return FObjectAllocator::Get().Allocate(size);
     }
 
+    // virtual 소멸자 덕분에 size는 항상 실제 파생 클래스 크기
     void operator delete(void* ptr, size_t size)
     {
         UEngineStatics::RemoveAllocation(size);
-        ::operator delete(ptr);
+        FObjectAllocator::Get().Free(ptr, size);
     }
 
     // 배치 new/delete도 오버라이드 (필요한 경우)
@@ -106,15 +138,17 @@ public:
         // placement delete는 아무것도 안함
     }
 
-    json::JSON Serialize() const override
-    {
-        return json::JSON();
-    }
+    // 기본 구현은 UPROPERTY로 등록된 속성을 사용 (FPropertySerializer)
+    json::JSON Serialize() const override;
+    bool Deserialize(const json::JSON& data) override;
 
-    bool Deserialize(const json::JSON& data) override
-    {
-        return true;
-    }
+    /** @brief Binary counterpart of Serialize; the default writes the UPROPERTY image (FPropertySerializer::ToBinary). */
+    virtual void SerializeBinary(TArray<uint8>& outBytes) const;
+    /** @brief Reads what SerializeBinary wrote and advances cursor past it. */
+    virtual bool DeserializeBinary(const uint8*& cursor, const uint8* end);
+
+    /** @brief Editor-only objects are left out of scene files. */
+    virtual bool IsEditorOnly() const { return false; }
 
     void SetUUID(uint32 uuid)
     {
@@ -123,6 +157,6 @@ public:
 
     static void ClearFreeIndices()
     {
-        FreeIndices.clear();
+        GUObjectArray.ClearFreeIndices();
     }
 };
\ No newline at end of file
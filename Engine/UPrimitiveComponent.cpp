@@ -17,6 +17,22 @@ IMPLEMENT_UCLASS(UPrimitiveComponent, USceneComponent)
 
 uint32 UPrimitiveComponent::PrimitiveID = 0;
 
+UPrimitiveComponent::~UPrimitiveComponent()
+{
+	// ~USceneComponent에서는 이미 Cast<UPrimitiveComponent>가 실패해서 BVH 리프, 엔티티, 드로우 패킷이
+	// 해제되지 않으므로 아직 프리미티브인 동안 씬에서 뺌
+	if (UScene* scene = GetRegisteredScene())
+	{
+		scene->UnregisterComponent(this, false);
+	}
+
+	// 씬에 등록되지 않은 채 그려진 프리미티브(기즈모)나 렌더러 없는 씬의 프리미티브도 패킷을 돌려줌
+	if (DrawPacketOwner)
+	{
+		DrawPacketOwner->ReleasePrimitiveCache(this);
+	}
+}
+
 bool UPrimitiveComponent::Initialize()
 {
 	if (!USceneComponent::Initialize()) return false;
@@ -44,6 +60,7 @@ bool UPrimitiveComponent::Initialize()
 	}
 
 	texture = textureManager->RetrieveTexture(GetClass()->GetMeta("TextInfo"));
+	MarkRenderStateDirty();
 
 	// Auto-create and attach textholder component
 	if (bAutoCreateTextholder)
@@ -79,23 +96,32 @@ void UPrimitiveComponent::OnShutdown()
 	Super::OnShutdown();
 }
 
+bool UPrimitiveComponent::GetWorldBounds(FAABB& outBounds) const
+{
+	if (!mesh || !mesh->GetLocalBounds().IsValid())
+		return false;
+
+	outBounds = mesh->GetLocalBounds().TransformBy(GetWorldTransform());
+	return true;
+}
+
 void UPrimitiveComponent::UpdateConstantBuffer(URenderer& renderer)
 {
 	FMatrix MVP = GetWorldTransform() * renderer.GetViewProj();
 	(*vertexShader)["ConstantBuffer"]["MVP"] = MVP;
 	(*vertexShader)["ConstantBuffer"]["MeshColor"] = Color;
 	(*vertexShader)["ConstantBuffer"]["IsSelected"] = bIsSelected;
-	vertexShader->BindConstantBuffer(renderer.GetDeviceContext(), "ConstantBuffer");
+	vertexShader->BindConstantBuffer(renderer.GetRHI(), "ConstantBuffer");
 }
 
 void UPrimitiveComponent::BindVertexShader(URenderer& renderer)
 {
-	vertexShader->Bind(renderer.GetDeviceContext(), "ConstantBuffer");
+	vertexShader->Bind(renderer.GetRHI(), "ConstantBuffer");
 }
 
 void UPrimitiveComponent::BindPixelShader(URenderer& renderer)
 {
-	pixelShader->Bind(renderer.GetDeviceContext());
+	pixelShader->Bind(renderer.GetRHI());
 }
 
 void UPrimitiveComponent::BindShader(URenderer& renderer)
@@ -106,14 +132,14 @@ void UPrimitiveComponent::BindShader(URenderer& renderer)
 
 void UPrimitiveComponent::BindMesh(URenderer& renderer)
 {
-	mesh->Bind(renderer.GetDeviceContext());
+	mesh->Bind(renderer.GetRHI());
 }
 
 void UPrimitiveComponent::BindTexture(URenderer& renderer)
 {
 	/** @todo: Hard-coded slot number. */
 	// texture를 보내주는ㄱ ㅔ맞을ㅇ듯Bind 
-	texture->Bind(renderer.GetDeviceContext(), 0);
+	texture->Bind(renderer.GetRHI(), 0);
 }
 
 void UPrimitiveComponent::Draw(URenderer& renderer)
@@ -129,12 +155,5 @@ void UPrimitiveComponent::Draw(URenderer& renderer)
         renderer.DrawPrimitiveComponent(this);
     }
 
-	// Draw attached child components
-	for (USceneComponent* child : AttachChildren)
-	{
-		if (UPrimitiveComponent* childPrimitive = child->Cast<UPrimitiveComponent>())
-		{
-			childPrimitive->Draw(renderer);
-		}
-	}
+	// 부착된 자식은 씬 레지스트리에서 따로 그려지므로 여기서 재귀하지 않음
 }
@@ -9,6 +9,8 @@
 #include "ConfigManager.h"
 #include "Constant.h"
 #include "FTextInfo.h"
+#include "FDynamicAABBTree.h"
+#include "FEntityStore.h"
 
 class UMeshManager; // 전방 선언
 class UTextureManager;
@@ -63,9 +65,25 @@ public:
 
 	virtual void Draw(URenderer& renderer);
 
+	/**
+	 * @brief World-space bounds used by the scene's spatial index.
+	 * @return false if the component has nothing to bound (no mesh); it is then left out of the index.
+	 */
+	virtual bool GetWorldBounds(FAABB& outBounds) const;
+
+	/** @brief Leaf of this component in UScene's primitive tree, or FDynamicAABBTree::NullNode. */
+	int32 GetSceneProxyId() const { return SceneProxyId; }
+
 	virtual LayerID GetLayer() const { return 2;  }
 
-	virtual ~UPrimitiveComponent() {}
+	/**
+	 * @brief Whether UBatchRenderer may draw this with its shader's instanced variant and write its constants itself.
+	 * @note: UBatchRenderer then reads only GetWorldTransform(), Color and bIsSelected (cached in its draw
+	 *        packet), so override this to return false if UpdateConstantBuffer writes anything else.
+	 */
+	virtual bool CanBeInstanced() const { return true; }
+
+	virtual ~UPrimitiveComponent();
 
 	bool CountOnInspector() override { return true; }
 
@@ -75,9 +93,16 @@ public:
 
 	UShader* GetPixelShader() { return pixelShader;  }
 
-	void SetColor(const FVector4& newColor) { Color = newColor; }
+	void SetColor(const FVector4& newColor) { Color = newColor; MarkRenderStateDirty(); }
 	FVector4 GetColor() const { return Color; }
 
+	/**
+	 * @brief Tells the renderer to rebuild what it cached for this component (mesh, shaders, world matrix, color).
+	 * @note: UScene calls this for every primitive whose world transform changed; bIsSelected is checked on every draw.
+	 */
+	void MarkRenderStateDirty() { bRenderStateDirty = true; }
+	bool IsRenderStateDirty() const { return bRenderStateDirty; }
+
 public:
 	virtual uint32 GetID() const { return ID;  }
     virtual EEngineShowFlags GetShowFlag() const { return EEngineShowFlags::SF_Primitives; }
@@ -89,4 +114,16 @@ protected:
 private:
 	static uint32 PrimitiveID;
 	uint32 ID;
+
+	// UScene의 BVH 리프 (UScene::RefreshPrimitiveBounds가 관리)
+	friend class UScene;
+	int32 SceneProxyId = FDynamicAABBTree::NullNode;
+	FVector SceneBoundsCenter;	// 마지막 갱신 때의 중심, 다음 이동량 예측에 사용
+	FEntity SceneEntity;		// UScene::entityStore의 미러 엔티티 (바운드가 있을 때만)
+
+	// UBatchRenderer의 캐시된 드로우 패킷 (UBatchRenderer가 관리)
+	friend class UBatchRenderer;
+	uint32 DrawPacketIndex = UINT_MAX;
+	URenderer* DrawPacketOwner = nullptr;	// 패킷을 가진 렌더러. 씬에 없는 기즈모도 소멸 시 여기로 반환
+	bool bRenderStateDirty = true;
 };
@@ -267,33 +267,11 @@ FRay URaycastManager::CreateRayFromScreenPosition(UCamera* camera)
 
 bool URaycastManager::MakeAABBInfo(UMesh* mesh, FMatrix M, FVector& outMin, FVector& outMax)
 {
-	if (mesh->Vertices.size() == 0) return false;
+	if (!mesh->GetLocalBounds().IsValid()) return false;
 
-	float maxPos[3] = { INT_MIN, INT_MIN, INT_MIN };
-	float minPos[3] = { INT_MAX, INT_MAX,INT_MAX };
-
-	auto UpdateMinMax = [&](const FVector4& p)
-	{
-			minPos[0] = (p.X < minPos[0]) ? p.X : minPos[0];
-			minPos[1] = (p.Y < minPos[1]) ? p.Y : minPos[1];
-			minPos[2] = (p.Z < minPos[2]) ? p.Z : minPos[2]; 
-
-			// max 갱신: 더 크면 교체
-			maxPos[0] = (p.X > maxPos[0]) ? p.X : maxPos[0];
-			maxPos[1] = (p.Y > maxPos[1]) ? p.Y : maxPos[1];
-			maxPos[2] = (p.Z > maxPos[2]) ? p.Z : maxPos[2]; 
-	};
-
-	for (auto v : mesh->Vertices)
-	{
-		UpdateMinMax( FMatrix::MultiplyVectorRow( { v.x, v.y, v.z, 1.0f}, M ));
-	}
-
-	outMin.X = minPos[0];
-	outMin.Y = minPos[1];
-	outMin.Z = minPos[2];
-
-	outMax.X = maxPos[0];
-	outMax.Y = maxPos[1];
-	outMax.Z = maxPos[2];
+	// 정점을 전부 변환하지 않고 메시의 로컬 AABB를 Arvo 방식으로 변환 (O(1))
+	const FAABB worldBounds = mesh->GetLocalBounds().TransformBy(M);
+	outMin = worldBounds.Min;
+	outMax = worldBounds.Max;
+	return true;
 }
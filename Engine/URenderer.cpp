@@ -29,10 +29,15 @@ URenderer::URenderer()
 	ConfigData* config = ConfigManager::GetConfig("editor");
 
 	if (config)
+	{
 		bIsShaderReflectionEnabled = config->getBool("Graphics", "ShaderReflection");
-
+		bRecordCommands = config->getBool("Graphics", "RecordCommands", false);
+	}
 	else
+	{
 		bIsShaderReflectionEnabled = false;
+		bRecordCommands = false;
+	}
 
 	ZeroMemory(&Viewport, sizeof(Viewport));
 }
@@ -59,6 +64,15 @@ bool URenderer::Initialize(HWND InhWnd)
 		return false;
 	}
 
+	// 프레임 제출은 모두 RHI를 거침 (녹화 옵션이면 녹화기가 D3D 컨텍스트를 감쌈)
+	D3D11Context = MakeUnique<FD3D11CommandContext>(Device, DeviceContext);
+	RHI = D3D11Context.get();
+	if (bRecordCommands)
+	{
+		CommandRecorder = MakeUnique<FRecordingCommandContext>(D3D11Context.get());
+		RHI = CommandRecorder.get();
+	}
+
 	// Create render target view
 	if (!CreateRenderTargetView())
 	{
@@ -93,6 +107,25 @@ bool URenderer::Initialize(HWND InhWnd)
 	return true;
 }
 
+bool URenderer::InitializeHeadless(int32 Width, int32 Height)
+{
+	if (bIsInitialized)
+		return true;
+
+	// 디바이스 없이 타깃 없는 녹화기를 RHI로 둠 (프레임 명령은 GetCommandRecorder로 확인)
+	CommandRecorder = MakeUnique<FRecordingCommandContext>();
+	RHI = CommandRecorder.get();
+
+	if (!SetupViewport(Width, Height))
+	{
+		LogError(E_FAIL, "SetupViewport");
+		return false;
+	}
+
+	bIsInitialized = true;
+	return true;
+}
+
 /*
 bool URenderer::CreateShader()
 {
@@ -456,6 +489,11 @@ void URenderer::Release()
 	SAFE_RELEASE(DepthStencilView);
 	SAFE_RELEASE(RenderTargetView);
 	SAFE_RELEASE(SwapChain);
+
+	// 녹화기가 잡고 있는 리소스 참조를 디바이스보다 먼저 놓음
+	RHI = nullptr;
+	CommandRecorder.reset();
+	D3D11Context.reset();
 	SAFE_RELEASE(DeviceContext);
 	SAFE_RELEASE(Device);
 
@@ -698,11 +736,11 @@ void URenderer::EnsureAabbLineVB(UINT bytes)
 	bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
 	bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
 
-	HRESULT hr = Device->CreateBuffer(&bd, nullptr, &aabbLineVB);
+	aabbLineVB = GetRHI().CreateBuffer(bd, nullptr);
 
-	if (FAILED(hr))
+	if (!aabbLineVB)
 	{
-		LogError(hr, "AABB BUFFER ERROR");
+		LogError(E_FAIL, "AABB BUFFER ERROR");
 		return;
 	}
 }
@@ -718,31 +756,34 @@ void URenderer::DrawAABBLines(const FVector& mn, const FVector& mx)
 	UINT bytes = (UINT)(verts.size() * sizeof(FVertexPosColorUV4));
 	EnsureAabbLineVB(bytes);
 
-	D3D11_MAPPED_SUBRESOURCE mapped{};
-	DeviceContext->Map(aabbLineVB, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
-	memcpy(mapped.pData, verts.data(), bytes);
-	DeviceContext->Unmap(aabbLineVB, 0);
+	GetRHI().WriteDynamicBuffer(aabbLineVB, verts.data(), bytes);
 
 	UINT stride = sizeof(FVertexPosColorUV4), offset = 0;
-	DeviceContext->IASetVertexBuffers(0, 1, &aabbLineVB, &stride, &offset);
-	DeviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_LINELIST);
+	GetRHI().SetVertexBuffers(0, 1, &aabbLineVB, &stride, &offset);
+	GetRHI().SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_LINELIST);
 	 
 	FMatrix identity = FMatrix::Identity;
 	FVector4 color(1, 1, 0, 1); // 노란색, 필요하면 파라미터로
 	SetModel(identity, color, true);
-	DeviceContext->Draw((UINT)verts.size(), 0);
+	GetRHI().Draw((UINT)verts.size(), 0);
 }
 
 void URenderer::Prepare()
 {
-	if (!DeviceContext)
+	if (!RHI)
 		return;
 
+	// 녹화는 프레임 단위 (다음 Prepare 전까지 직전 프레임 명령을 볼 수 있음)
+	if (CommandRecorder)
+	{
+		CommandRecorder->Reset();
+	}
+
 	// Set render target and depth stencil view
-	DeviceContext->OMSetRenderTargets(1, &RenderTargetView, DepthStencilView);
+	RHI->SetRenderTarget(RenderTargetView, DepthStencilView);
 
 	// Set viewport
-	DeviceContext->RSSetViewports(1, &CurrentViewport);
+	RHI->SetViewport(CurrentViewport);
 
 	// Clear render target and depth stencil
 	Clear();
@@ -750,7 +791,7 @@ void URenderer::Prepare()
 
 void URenderer::PrepareShader()
 {
-	if (!DeviceContext)
+	if (!RHI)
 	{
 		return;
 	}
@@ -761,14 +802,14 @@ void URenderer::PrepareShader()
 	}
 
 	// Set shaders
-	DeviceContext->VSSetShader(VertexShader, nullptr, 0);
-	DeviceContext->PSSetShader(PixelShader, nullptr, 0);
+	RHI->SetVertexShader(VertexShader);
+	RHI->SetPixelShader(PixelShader);
 
 	// Set input layout
-	DeviceContext->IASetInputLayout(InputLayout);
+	RHI->SetInputLayout(InputLayout);
 
 	// Set primitive topology (default to triangle list)
-	DeviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	RHI->SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
 	// Set rasterizer state (와인딩 순서 적용)
 	//if (RasterizerState)
@@ -779,7 +820,7 @@ void URenderer::PrepareShader()
 	// Set constant buffer
 	if (ConstantBuffer)
 	{
-		DeviceContext->VSSetConstantBuffers(0, 1, &ConstantBuffer);
+		RHI->SetVSConstantBuffer(0, ConstantBuffer);
 	}
 }
 
@@ -793,36 +834,54 @@ void URenderer::SwapBuffer()
 
 void URenderer::Clear(float Red, float Green, float Blue, float Alpha)
 {
-	if (!DeviceContext)
+	if (!RHI)
 		return;
 
 	float clearColor[4] = { Red, Green, Blue, Alpha };
 
 	if (RenderTargetView)
 	{
-		DeviceContext->ClearRenderTargetView(RenderTargetView, clearColor);
+		RHI->ClearRenderTarget(RenderTargetView, clearColor);
 	}
 
 	if (DepthStencilView)
 	{
-		DeviceContext->ClearDepthStencilView(DepthStencilView, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
+		RHI->ClearDepthStencil(DepthStencilView, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
 	}
 }
 
 void URenderer::DrawIndexed(UINT IndexCount, UINT StartIndexLocation, INT BaseVertexLocation)
 {
-	if (DeviceContext)
+	if (RHI)
 	{
-		DeviceContext->DrawIndexed(IndexCount, StartIndexLocation, BaseVertexLocation);
+		RHI->DrawIndexed(IndexCount, StartIndexLocation, BaseVertexLocation);
 		IncrementDrawCallCount();
 	}
 }
 
 void URenderer::Draw(UINT VertexCount, UINT StartVertexLocation)
 {
-	if (DeviceContext)
+	if (RHI)
 	{
-		DeviceContext->Draw(VertexCount, StartVertexLocation);
+		RHI->Draw(VertexCount, StartVertexLocation);
+		IncrementDrawCallCount();
+	}
+}
+
+void URenderer::DrawIndexedInstanced(UINT IndexCountPerInstance, UINT InstanceCount, UINT StartIndexLocation, INT BaseVertexLocation, UINT StartInstanceLocation)
+{
+	if (RHI)
+	{
+		RHI->DrawIndexedInstanced(IndexCountPerInstance, InstanceCount, StartIndexLocation, BaseVertexLocation, StartInstanceLocation);
+		IncrementDrawCallCount();
+	}
+}
+
+void URenderer::DrawInstanced(UINT VertexCountPerInstance, UINT InstanceCount, UINT StartVertexLocation, UINT StartInstanceLocation)
+{
+	if (RHI)
+	{
+		RHI->DrawInstanced(VertexCountPerInstance, InstanceCount, StartVertexLocation, StartInstanceLocation);
 		IncrementDrawCallCount();
 	}
 }
@@ -834,8 +893,8 @@ void URenderer::Draw(UINT VertexCount, UINT StartVertexLocation)
 
 	UINT offset = 0;
 
-	DeviceContext->IASetVertexBuffers(0, 1, &Mesh->VertexBuffer, &Mesh->Stride, &offset);
-	DeviceContext->IASetPrimitiveTopology(Mesh->PrimitiveType);
+	GetRHI().SetVertexBuffers(0, 1, &Mesh->VertexBuffer, &Mesh->Stride, &offset);
+	GetRHI().SetPrimitiveTopology(Mesh->PrimitiveType);
 
 	Draw(Mesh->NumVertices, 0);
 }
@@ -847,8 +906,8 @@ void URenderer::Draw(UINT VertexCount, UINT StartVertexLocation)
 
 	UINT offset = 0;
 
-	DeviceContext->IASetVertexBuffers(0, 1, &Mesh->VertexBuffer, &Mesh->Stride, &offset);
-	DeviceContext->IASetPrimitiveTopology(D3D10_PRIMITIVE_TOPOLOGY_LINELIST);
+	GetRHI().SetVertexBuffers(0, 1, &Mesh->VertexBuffer, &Mesh->Stride, &offset);
+	GetRHI().SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_LINELIST);
 
 	Draw(Mesh->NumVertices, 0);
 }
@@ -856,7 +915,7 @@ void URenderer::Draw(UINT VertexCount, UINT StartVertexLocation)
 void URenderer::DrawPrimitiveComponent(UPrimitiveComponent* component)
 {
 	auto Mesh = component->GetMesh();
-	Mesh->Bind(DeviceContext);
+	Mesh->Bind(GetRHI());
 	IncrementMeshSwitchCount();
 
 	component->UpdateConstantBuffer(*this);
@@ -878,7 +937,7 @@ void URenderer::DrawPrimitiveComponent(UPrimitiveComponent* component)
 void URenderer::DrawGizmoComponent(UGizmoComponent* component, bool drawOnTop)
 {
 	auto Mesh = component->GetMesh();
-	Mesh->Bind(DeviceContext);
+	Mesh->Bind(GetRHI());
 	IncrementMeshSwitchCount();
 
 	component->UpdateConstantBuffer(*this);
@@ -915,22 +974,22 @@ void URenderer::DrawGizmoComponent(UGizmoComponent* component, bool drawOnTop)
 	// Backup current depth-stencil state
 	ID3D11DepthStencilState* pOldState = nullptr;
 	UINT stencilRef = 0;
-	DeviceContext->OMGetDepthStencilState(&pOldState, &stencilRef);
+	GetRHI().GetDepthStencilState(&pOldState, &stencilRef);
 
 	// Set new depth state
-	DeviceContext->OMSetDepthStencilState(pDSState, 0);
+	GetRHI().SetDepthStencilState(pDSState, 0);
 
 	if (Mesh->IsIndexBufferEnabled())
 	{
-		DeviceContext->DrawIndexed(Mesh->NumIndices, 0, 0);
+		GetRHI().DrawIndexed(Mesh->NumIndices, 0, 0);
 	}
 	else
 	{
-		DeviceContext->Draw(Mesh->NumVertices, 0);
+		GetRHI().Draw(Mesh->NumVertices, 0);
 	}
 
 	// Restore previous depth state
-	DeviceContext->OMSetDepthStencilState(pOldState, stencilRef);
+	GetRHI().SetDepthStencilState(pOldState, stencilRef);
 
 	// Release local COM objects
 	SAFE_RELEASE(pOldState);
@@ -956,13 +1015,9 @@ void URenderer::DrawTextholderComponent(UTextholderComp* Component)
     IncrementVertexShaderSwitchCount();
     IncrementPixelShaderSwitchCount();
 	
-	DeviceContext->IASetInputLayout(InputLayoutTextInst); 
+	GetRHI().SetInputLayout(InputLayoutTextInst); 
 
-	D3D11_MAPPED_SUBRESOURCE m{}; 
-	DeviceContext->Map(textInstanceVB, 0, D3D11_MAP_WRITE_DISCARD, 0, &m);
-	memcpy(m.pData, instances.data(), instances.size() * sizeof(FTextInstance));
-	memcpy(m.pData, instances.data(), instances.size() * sizeof(FTextInstance));
-	DeviceContext->Unmap(textInstanceVB, 0);
+	GetRHI().WriteDynamicBuffer(textInstanceVB, instances.data(), (uint32)(instances.size() * sizeof(FTextInstance)));
 
 	// 이전 상태 백업하고
 	// vertexshader inputlayout을 intaced draw 용으로 교체
@@ -970,11 +1025,11 @@ void URenderer::DrawTextholderComponent(UTextholderComp* Component)
 	UINT strides[2] = { text->Stride, (UINT)sizeof(FTextInstance) };
 	UINT offsets[2] = { 0, 0 };
 
-	DeviceContext->IASetVertexBuffers(0, 2, bufs, strides, offsets);
-	DeviceContext->IASetPrimitiveTopology(text->PrimitiveType);
+	GetRHI().SetVertexBuffers(0, 2, bufs, strides, offsets);
+	GetRHI().SetPrimitiveTopology(text->PrimitiveType);
 	IncrementMeshSwitchCount();
 
-	DeviceContext->DrawInstanced(text->NumVertices, (UINT)instances.size(), 0, 0);
+	GetRHI().DrawInstanced(text->NumVertices, (UINT)instances.size(), 0, 0);
 }
 
 [[deprecated]] void URenderer::DrawMeshOnTop(UMesh* Mesh)
@@ -999,19 +1054,19 @@ void URenderer::DrawTextholderComponent(UTextholderComp* Component)
 	// Backup current depth-stencil state
 	ID3D11DepthStencilState* pOldState = nullptr;
 	UINT StencilRef = 0;
-	DeviceContext->OMGetDepthStencilState(&pOldState, &StencilRef);
+	GetRHI().GetDepthStencilState(&pOldState, &StencilRef);
 
 	// Set new state (no depth test)
-	DeviceContext->OMSetDepthStencilState(pDepthStencilState, 0);
+	GetRHI().SetDepthStencilState(pDepthStencilState, 0);
 
 	// Draw mesh
 	UINT Offset = 0;
-	DeviceContext->IASetVertexBuffers(0, 1, &Mesh->VertexBuffer, &Mesh->Stride, &Offset);
-	DeviceContext->IASetPrimitiveTopology(Mesh->PrimitiveType);
+	GetRHI().SetVertexBuffers(0, 1, &Mesh->VertexBuffer, &Mesh->Stride, &Offset);
+	GetRHI().SetPrimitiveTopology(Mesh->PrimitiveType);
 	Draw(Mesh->NumVertices, 0);
 
 	// Restore previous depth state
-	DeviceContext->OMSetDepthStencilState(pOldState, StencilRef);
+	GetRHI().SetDepthStencilState(pOldState, StencilRef);
 
 	// Release local COM objects
 	SAFE_RELEASE(pOldState);
@@ -1021,33 +1076,33 @@ void URenderer::DrawTextholderComponent(UTextholderComp* Component)
 
 void URenderer::SetVertexBuffer(ID3D11Buffer* Buffer, UINT Stride, UINT Offset)
 {
-	if (DeviceContext && Buffer)
+	if (RHI && Buffer)
 	{
-		DeviceContext->IASetVertexBuffers(0, 1, &Buffer, &Stride, &Offset);
+		RHI->SetVertexBuffers(0, 1, &Buffer, &Stride, &Offset);
 	}
 }
 
 void URenderer::SetIndexBuffer(ID3D11Buffer* Buffer, DXGI_FORMAT Format)
 {
-	if (DeviceContext && Buffer)
+	if (RHI && Buffer)
 	{
-		DeviceContext->IASetIndexBuffer(Buffer, Format, 0);
+		RHI->SetIndexBuffer(Buffer, Format, 0);
 	}
 }
 
 void URenderer::SetConstantBuffer(ID3D11Buffer* Buffer, UINT Slot)
 {
-	if (DeviceContext && Buffer)
+	if (RHI && Buffer)
 	{
-		DeviceContext->VSSetConstantBuffers(Slot, 1, &Buffer);
+		RHI->SetVSConstantBuffer(Slot, Buffer);
 	}
 }
 
 void URenderer::SetTexture(ID3D11ShaderResourceView* ShaderResourceView, UINT Slot)
 {
-	if (DeviceContext && ShaderResourceView)
+	if (RHI && ShaderResourceView)
 	{
-		DeviceContext->PSSetShaderResources(Slot, 1, &ShaderResourceView);
+		RHI->SetPSShaderResource(Slot, ShaderResourceView);
 	}
 }
 
@@ -1070,7 +1125,7 @@ void URenderer::SetRasterizerMode(EViewModeIndex vmi)
 	if (!rss)
 		return;
 
-	DeviceContext->RSSetState(rss);
+	GetRHI().SetRasterizerState(rss);
 }
 
 void URenderer::SetViewProj(const FMatrix& View, const FMatrix& Projection)
@@ -1086,18 +1141,12 @@ bool URenderer::UpdateConstantBuffer(const void* Data, size_t Size)
 	if (!ConstantBuffer || !Data)
 		return false;
 
-	D3D11_MAPPED_SUBRESOURCE MappedSubresource;
-	HRESULT hResult = DeviceContext->Map(ConstantBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &MappedSubresource);
-
-	if (FAILED(hResult))
+	if (!GetRHI().WriteDynamicBuffer(ConstantBuffer, Data, static_cast<uint32>(Size)))
 	{
-		LogError(hResult, "Map ConstantBuffer");
+		LogError(E_FAIL, "Map ConstantBuffer");
 		return false;
 	}
 
-	memcpy(MappedSubresource.pData, Data, Size);
-	DeviceContext->Unmap(ConstantBuffer, 0);
-
 	return true;
 }
 
@@ -1315,8 +1364,8 @@ void URenderer::SetModel(const FMatrix& M, const FVector4& color, bool bIsSelect
 		//(*currentVertexShader)["ConstantBuffer"]["IsSelected"] = bIsSelected;
 	
 		/** @brief: For now, binding should be done here. */
-		currentVertexShader->Bind(GetDeviceContext(), "ConstantBuffer");
-		currentPixelShader->Bind(GetDeviceContext());
+		currentVertexShader->Bind(GetRHI(), "ConstantBuffer");
+		currentPixelShader->Bind(GetRHI());
 	}
 }
 
@@ -7,6 +7,8 @@
 #include "UTextholderComp.h"
 #include "UEngineSubsystem.h"
 #include "Constant.h"
+#include "FD3D11CommandContext.h"
+#include "FRecordingCommandContext.h"
 
 class UPrimitiveComponent;
 
@@ -35,6 +37,12 @@ public:
 public:
 	/** Initialization and cleanup */
 	bool Initialize(HWND hWnd);
+	/**
+	 * @brief Initializes without a window or device: frames go to a FRecordingCommandContext with no target
+	 *        (GetCommandRecorder), so a whole frame can be submitted and inspected in tests.
+	 * @note: Only resources created through the RHI exist; CreateShader, CreateConstantBuffer and the like need Initialize.
+	 */
+	bool InitializeHeadless(int32 Width, int32 Height);
 	bool CreateShader();
 	bool CreateShader_SR();
 	bool CreateRasterizerState();
@@ -59,6 +67,14 @@ public:
 	// Getters
 	ID3D11Device* GetDevice() const { return Device; }
 	ID3D11DeviceContext* GetDeviceContext() const { return DeviceContext; }
+	/** @brief Context every frame submission goes through (the D3D11 context, or the recorder wrapping it). */
+	FRHICommandContext& GetRHI() const
+	{
+		assert(RHI && "Renderer is not initialized");
+		return *RHI;
+	}
+	/** @brief Recorder capturing the commands submitted since the last Prepare(), if [Graphics] RecordCommands is on or the renderer is headless. */
+	FRecordingCommandContext* GetCommandRecorder() const { return CommandRecorder.get(); }
 	IDXGISwapChain* GetSwapChain() const { return SwapChain; }
 	bool IsInitialized() const { return bIsInitialized; }
 
@@ -75,6 +91,11 @@ protected:
 	ID3D11RasterizerState* RasterizerStateSolid;
 	ID3D11RasterizerState* RasterizerStateWireFrame;
 
+	/** Command submission */
+	TUniquePtr<FD3D11CommandContext> D3D11Context;
+	TUniquePtr<FRecordingCommandContext> CommandRecorder;
+	FRHICommandContext* RHI = nullptr;
+
 	/** Shader Objects */
 	ID3D11VertexShader* VertexShader;
 	ID3D11PixelShader* PixelShader;
@@ -115,6 +136,9 @@ public:
 	void DrawIndexed(UINT IndexCount, UINT StartIndexLocation = 0, INT BaseVertexLocation = 0);
 	/** @note: Use Draw() or DrawMesh() to track number of draw calls */
 	void Draw(UINT VertexCount, UINT StartVertexLocation = 0);
+	/** @note: An instanced draw counts as one draw call. */
+	void DrawIndexedInstanced(UINT IndexCountPerInstance, UINT InstanceCount, UINT StartIndexLocation = 0, INT BaseVertexLocation = 0, UINT StartInstanceLocation = 0);
+	void DrawInstanced(UINT VertexCountPerInstance, UINT InstanceCount, UINT StartVertexLocation = 0, UINT StartInstanceLocation = 0);
 	void DrawMesh(UMesh* Mesh);
 
 	/** @note: Does nothing in URenderer.h. Just introduced for derived classes. */
@@ -130,6 +154,9 @@ public:
 	virtual void DrawGizmoComponent(UGizmoComponent* component, bool drawOnTop = false);
 	virtual void DrawTextholderComponent(UTextholderComp* Component);
 
+	/** @brief Drops anything cached for the component (it is leaving the scene or being deleted). */
+	virtual void ReleasePrimitiveCache(UPrimitiveComponent* component) {}
+
 	/** @note: These helper functions use Draw() or DrawMesh() Internally. */
 	void DrawLine(UMesh* Mesh);
 	void DrawMeshOnTop(UMesh* Mesh);
@@ -229,6 +256,15 @@ public:
 		return DepthStencilViewClearCount;
 	}
 
+	/** @brief Per-frame culling result reported by the scene (not cumulative like the counters above). */
+	void SetCullingStats(uint32 Visible, uint32 Culled)
+	{
+		VisiblePrimitiveCount = Visible;
+		CulledPrimitiveCount = Culled;
+	}
+	uint32 GetVisiblePrimitiveCount() const { return VisiblePrimitiveCount; }
+	uint32 GetCulledPrimitiveCount() const { return CulledPrimitiveCount; }
+
 protected:
 	void IncrementDrawCallCount() { ++DrawCallCount; }
 	void IncrementMeshSwitchCount() { ++MeshSwitchCount; }
@@ -236,7 +272,7 @@ protected:
 	void IncrementPixelShaderSwitchCount() { ++PixelShaderSwitchCount; }
 	void IncrementDepthStencilViewClearCount() { ++DepthStencilViewClearCount; }
 
-private:
+protected:
 	/** Error handling */
 	void LogError(HRESULT hResult, const char* Function);
 	bool CheckResult(HRESULT hResult, const char* Function);
@@ -253,6 +289,7 @@ private:
 
 private:
 	bool bIsShaderReflectionEnabled;
+	bool bRecordCommands;
 
 	uint64 DrawCallCount;
 	/** @brief: The number of VBO binding. */
@@ -263,4 +300,7 @@ private:
 	uint64 PixelShaderSwitchCount;
 	/** @brief: The number of Depth Stencil View clearing for layers. */
 	uint64 DepthStencilViewClearCount;
+	/** @brief: Primitives submitted / rejected by frustum culling in the last frame. */
+	uint32 VisiblePrimitiveCount = 0;
+	uint32 CulledPrimitiveCount = 0;
 };
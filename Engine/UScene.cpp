@@ -7,25 +7,37 @@
 #include "UObject.h"
 #include "USceneComponent.h"
 #include "UPrimitiveComponent.h"
-#include "UGizmoGridComp.h"
 #include "URaycastManager.h"
 #include "UCamera.h"
 #include "Constant.h"
+#include "UGarbageCollector.h"
+#include "UJobSystem.h"
+#include "ConfigManager.h"
+#include "FSceneStreamer.h"
+#include "FProperty.h"
 
 IMPLEMENT_UCLASS(UScene, UObject)
+UPROPERTY(UScene, version, "Version", PF_Serialize)
+
 UScene::UScene()
 {
 	version = 1;
 	primitiveCount = 0;
+	commandBuffers.resize(1);
 }
 
 UScene::~UScene()
 {
 	OnShutdown();
+	// 프리미티브의 드로우 패킷은 각 ~UPrimitiveComponent가 반환함
 	for (UObject* object : objects)
 	{
 		delete object;
 	}
+	for (AActor* actor : actors)
+	{
+		delete actor;
+	}
 	delete camera;
 }
 
@@ -39,6 +51,11 @@ bool UScene::Initialize(UApplication* app, URenderer* r, UMeshManager* mm, UInpu
 	backBufferWidth = 0.0f;
 	backBufferHeight = 0.0f;
 
+	bParallelTick = ConfigManager::GetConfig("editor")->getBool("Scene", "ParallelTick", false);
+	primitiveTree.SetMargin(ConfigManager::GetConfig("editor")->getFloat("Scene", "BoundsMargin", 0.1f));
+	bFrustumCulling = ConfigManager::GetConfig("editor")->getBool("Scene", "FrustumCulling", true);
+	actorGrid.SetCellSize(ConfigManager::GetConfig("editor")->getFloat("Scene", "GridCellSize", 10.0f));
+
 	// 모든 Primitive 컴포넌트 초기화
 	for (UObject* obj : objects)
 	{
@@ -63,6 +80,36 @@ UScene* UScene::Create(json::JSON data)
 	return scene;
 }
 
+USceneComponent* UScene::CreateObjectFromJson(const json::JSON& data)
+{
+	if (!data.hasKey("Type"))
+		return nullptr;
+
+	UClass* _class = UClass::FindClassWithDisplayName(data.at("Type").ToString());
+	if (_class == nullptr)
+		return nullptr;
+
+	USceneComponent* component = _class->CreateDefaultObject()->Cast<USceneComponent>();
+	if (component == nullptr)
+		return nullptr;
+
+	component->Deserialize(data);
+	return component;
+}
+
+void UScene::EnableStreaming(const json::JSON& partition, const FString& baseDirectory)
+{
+	ConfigData* config = ConfigManager::GetConfig("editor");
+	FSceneStreamer::FSettings settings;
+	settings.LoadRadius = config->getFloat("Streaming", "LoadRadius", settings.LoadRadius);
+	settings.UnloadHysteresis = config->getFloat("Streaming", "UnloadHysteresis", settings.UnloadHysteresis);
+	settings.CommitBudgetMs = config->getFloat("Streaming", "CommitBudgetMs", settings.CommitBudgetMs);
+	settings.MaxInFlightLoads = static_cast<uint32>((std::max)(1, config->getInt("Streaming", "MaxInFlightLoads", static_cast<int32>(settings.MaxInFlightLoads))));
+	settings.MaxUnloadsPerFrame = static_cast<uint32>((std::max)(1, config->getInt("Streaming", "MaxUnloadsPerFrame", static_cast<int32>(settings.MaxUnloadsPerFrame))));
+
+	streamer = MakeUnique<FSceneStreamer>(this, partition, baseDirectory, settings);
+}
+
 void UScene::AddObject(USceneComponent* obj)
 {
 	// 런타임에서만 사용 - Scene이 Initialize된 후에 호출할 것
@@ -75,6 +122,8 @@ void UScene::AddObject(USceneComponent* obj)
 	}
 
 	objects.push_back(obj);
+	obj->SetGarbageCollectable(true);
+	RegisterComponent(obj);
 
 	// 일단 표준 RTTI 사용
 	if (UPrimitiveComponent* primitive = obj->Cast<UPrimitiveComponent>())
@@ -92,54 +141,92 @@ void UScene::RemoveObject(USceneComponent* obj)
 	if (itr == objects.end()) return;
 
 	objects.erase(itr);
+	UnregisterComponent(obj);
 	--primitiveCount;
 }
 
+void UScene::AddReferencedObjects(FReferenceCollector& collector)
+{
+	collector.AddReferencedObjects(objects);
+	collector.AddReferencedObjects(actors);
+}
+
 json::JSON UScene::Serialize() const
 {
-	json::JSON result;
-	// UScene 특성에 맞는 JSON 구성
-	result["Version"] = version;
+	// Version은 UPROPERTY, 나머지는 UScene 특성에 맞게 구성
+	json::JSON result = Super::Serialize();
 	result["NextUUID"] = std::to_string(UEngineStatics::GetNextUUID());
 
+	// 스트리밍 셀에서 온 객체는 셀 파일에 있으므로 제외하고 Partition 블록을 그대로 씀
+	TSet<const UObject*> streamedObjects;
+	if (streamer)
+	{
+		TArray<USceneComponent*> streamed;
+		streamer->CollectStreamedObjects(streamed);
+		streamedObjects.insert(streamed.begin(), streamed.end());
+		result["Partition"] = streamer->GetPartitionJson();
+	}
+
 	// Serialize legacy objects (components)
-	int32 validCount = 0;
 	for (UObject* object : objects)
 	{
-		if (object == nullptr) continue;
-		json::JSON _json = object->Serialize();
-		if (!_json.IsNull())
-		{
-			result["Primitives"][std::to_string(object->UUID)] = _json;
-			++validCount;
-		}
+		if (object == nullptr || object->IsEditorOnly() || streamedObjects.count(object)) continue;
+		result["Primitives"][std::to_string(object->UUID)] = object->Serialize();
 	}
 
 	// Serialize actors
-	int32 validActorCount = 0;
 	for (AActor* actor : actors)
 	{
-		if (actor == nullptr) continue;
-		json::JSON actorJson = actor->Serialize();
-		if (!actorJson.IsNull())
-		{
-			result["Actors"][std::to_string(actor->UUID)] = actorJson;
-			++validActorCount;
-		}
+		if (actor == nullptr || actor->IsEditorOnly()) continue;
+		result["Actors"][std::to_string(actor->UUID)] = actor->Serialize();
 	}
 
 	return result;
 }
 
-bool UScene::Deserialize(const json::JSON& data)
+void UScene::ClearForLoad()
 {
-	version = data.at("Version").ToInt();
-	//nextUUID = data.at("NextUUID").ToInt();
+	// 새 내용으로 바뀌므로 이전 파티션의 스트리밍은 중단 (분할된 씬이면 USceneManager가 다시 켬)
+	streamer.reset();
 
+	for (USceneComponent* object : objects)
+	{
+		UnregisterComponent(object);
+	}
+	for (AActor* actor : actors)
+	{
+		UnregisterActorComponents(actor);
+	}
 	objects.clear();
 	actors.clear();
+	transformStore.Clear();
+	primitiveCount = 0;
+}
+
+void UScene::AddLoadedObject(USceneComponent* component, uint32 uuid)
+{
+	component->SetUUID(uuid);
 
-	if (!data.hasKey("Primitives")) return false;
+	objects.push_back(component);
+	component->SetGarbageCollectable(true);
+	RegisterComponent(component);
+	if (component->CountOnInspector())
+		++primitiveCount;
+}
+
+void UScene::AddLoadedActor(AActor* actor, uint32 uuid)
+{
+	actor->SetUUID(uuid);
+	actors.push_back(actor);
+	actor->SetGarbageCollectable(true);
+	RegisterActorComponents(actor);
+}
+
+bool UScene::Deserialize(const json::JSON& data)
+{
+	ClearForLoad();
+
+	if (!Super::Deserialize(data) || !data.hasKey("Primitives")) return false;
 	json::JSON primitivesJson = data.at("Primitives");
 
 	UEngineStatics::SetUUIDGeneration(false);
@@ -147,18 +234,11 @@ bool UScene::Deserialize(const json::JSON& data)
 	for (auto& primitiveJson : primitivesJson.ObjectRange())
 	{
 		uint32 uuid = stoi(primitiveJson.first);
-		json::JSON _data = primitiveJson.second;
+		USceneComponent* component = CreateObjectFromJson(primitiveJson.second);
+		if (component == nullptr)
+			continue;
 
-		UClass* _class = UClass::FindClassWithDisplayName(_data.at("Type").ToString());
-		USceneComponent* component = nullptr;
-			if(_class != nullptr) component = _class->CreateDefaultObject()->Cast<USceneComponent>();
-
-		component->Deserialize(_data);
-		component->SetUUID(uuid);
-
-		objects.push_back(component);
-		if (component->CountOnInspector())
-			++primitiveCount;
+		AddLoadedObject(component, uuid);
 	}
 
 	// Deserialize actors if they exist
@@ -180,21 +260,13 @@ bool UScene::Deserialize(const json::JSON& data)
 					if (AActor* actor = actorClass->CreateDefaultObject()->Cast<AActor>())
 					{
 						actor->Deserialize(actorData);
-						actor->SetUUID(uuid);
-						actors.push_back(actor);
+						AddLoadedActor(actor, uuid);
 					}
 				}
 			}
 		}
 	}
 
-	USceneComponent* gizmoGrid = new UGizmoGridComp(
-		{ 0.3f, 0.3f, 0.3f },
-		{ 0.0f, 0.0f, 0.0f },
-		{ 0.2f, 0.2f, 0.2f }
-	);
-	//objects.push_back(gizmoGrid);
-
 	FString uuidStr = data.at("NextUUID").ToString();
 
 	UEngineStatics::SetNextUUID((uint32)stoi(uuidStr));
@@ -203,6 +275,95 @@ bool UScene::Deserialize(const json::JSON& data)
 	return true;
 }
 
+void UScene::SerializeBinary(TArray<uint8>& outBytes) const
+{
+	FPropertySerializer::WriteRaw(outBytes, BinarySceneMagic);
+	Super::SerializeBinary(outBytes);
+	FPropertySerializer::WriteRaw(outBytes, UEngineStatics::GetNextUUID());
+
+	// 개수는 다 쓴 뒤 채움 (에디터 전용 객체는 빠짐)
+	auto writeObjects = [&outBytes](const auto& list)
+	{
+		const size_t countOffset = outBytes.size();
+		FPropertySerializer::WriteRaw(outBytes, static_cast<uint32>(0));
+
+		uint32 count = 0;
+		for (const UObject* object : list)
+		{
+			if (object == nullptr || object->IsEditorOnly()) continue;
+			FPropertySerializer::WriteRaw(outBytes, object->UUID);
+			FPropertySerializer::WriteObjectRecord(object, outBytes);
+			++count;
+		}
+		memcpy(outBytes.data() + countOffset, &count, sizeof(count));
+	};
+	writeObjects(objects);
+	writeObjects(actors);
+}
+
+bool UScene::DeserializeBinary(const uint8*& cursor, const uint8* end)
+{
+	ClearForLoad();
+
+	uint32 magic = 0;
+	if (!FPropertySerializer::ReadRaw(cursor, end, magic) || magic != BinarySceneMagic) return false;
+
+	bool bResult = Super::DeserializeBinary(cursor, end);
+	uint32 nextUUID = 0;
+	if (!FPropertySerializer::ReadRaw(cursor, end, nextUUID)) return false;
+
+	UEngineStatics::SetUUIDGeneration(false);
+	UObject::ClearFreeIndices();
+
+	// 레코드마다 (UUID, 클래스 이름, 크기, 이미지). 알 수 없는 클래스는 크기만큼 건너뜀
+	auto readObjects = [&cursor, end, &bResult](const TFunction<void(UObject*, uint32)>& addLoaded)
+	{
+		uint32 count = 0;
+		if (!FPropertySerializer::ReadRaw(cursor, end, count)) return false;
+
+		for (uint32 i = 0; i < count; ++i)
+		{
+			uint32 uuid = 0;
+			UClass* objectClass = nullptr;
+			const uint8* recordEnd = nullptr;
+			if (!FPropertySerializer::ReadRaw(cursor, end, uuid) ||
+				!FPropertySerializer::ReadObjectRecordHeader(cursor, end, objectClass, recordEnd))
+				return false;
+
+			if (UObject* object = objectClass ? objectClass->CreateDefaultObject() : nullptr)
+			{
+				bResult &= object->DeserializeBinary(cursor, recordEnd);
+				addLoaded(object, uuid);
+			}
+			else
+			{
+				bResult = false;
+			}
+			cursor = recordEnd;
+		}
+		return true;
+	};
+
+	const bool bComplete =
+		readObjects([this](UObject* object, uint32 uuid) {
+			if (USceneComponent* component = object->Cast<USceneComponent>())
+				AddLoadedObject(component, uuid);
+			else
+				delete object;
+		}) &&
+		readObjects([this](UObject* object, uint32 uuid) {
+			if (AActor* actor = object->Cast<AActor>())
+				AddLoadedActor(actor, uuid);
+			else
+				delete object;
+		});
+
+	UEngineStatics::SetNextUUID(nextUUID);
+	UEngineStatics::SetUUIDGeneration(true);
+
+	return bComplete && bResult;
+}
+
 void  UScene::SetVisibilityOfEachPrimitive(EEngineShowFlags InPrimitiveToHide, bool isOn)
 {
     objectVisibility[InPrimitiveToHide] = isOn;
@@ -226,28 +387,40 @@ void UScene::Render()
 
 	renderer->SetViewProj(camera->GetView(), camera->GetProj());
 
-	// Render legacy objects (components)
-	for (UObject* obj : objects)
+	// 그리기 전에 이동한 프리미티브를 반영해 렌더러 캐시가 이번 프레임 트랜스폼을 보게 함
+	UpdateSpatialIndex();
+
+	visiblePrimitives.clear();
+	CollectDrawPrimitives(camera->GetFrustum(), visiblePrimitives);
+	for (UPrimitiveComponent* primitive : visiblePrimitives)
 	{
-		if (UPrimitiveComponent* primitive = obj->Cast<UPrimitiveComponent>())
-		{
-			primitive->Draw(*renderer);
-		}
+		primitive->Draw(*renderer);
 	}
 
-	// Render actors
-	for (AActor* actor : actors)
+	const uint32 visibleCount = static_cast<uint32>(visiblePrimitives.size());
+	renderer->SetCullingStats(visibleCount, static_cast<uint32>(primitives.size()) - visibleCount);
+}
+
+void UScene::CollectDrawPrimitives(const FFrustum& frustum, TArray<UPrimitiveComponent*>& outPrimitives)
+{
+	if (!bFrustumCulling)
 	{
-		if (actor)
+		// 등록된 프리미티브를 평탄하게 순회 (부착된 자식도 레지스트리에 있으므로 재귀 없음)
+		outPrimitives.insert(outPrimitives.end(), primitives.begin(), primitives.end());
+		return;
+	}
+
+	// BVH로 절두체 밖 서브트리를 통째로 버리고 남은 리프만 SIMD로 판정
+	QueryPrimitives(frustum, outPrimitives);
+
+	// 바운드가 없어 트리에 없는 프리미티브는 항상 그림 (보통 0개라 순회하지 않음)
+	if (static_cast<int32>(primitives.size()) > primitiveTree.GetNumProxies())
+	{
+		for (UPrimitiveComponent* primitive : primitives)
 		{
-			// Draw only root-level primitive components (children will be drawn by their parents)
-			auto components = actor->GetComponents<UPrimitiveComponent>();
-			for (UPrimitiveComponent* primitive : components)
+			if (primitive->GetSceneProxyId() == FDynamicAABBTree::NullNode)
 			{
-				if (primitive && !primitive->GetAttachParent())  // Only draw if no parent (root-level)
-				{
-					primitive->Draw(*renderer);  // This will also draw attached children
-				}
+				outPrimitives.push_back(primitive);
 			}
 		}
 	}
@@ -262,8 +435,11 @@ void UScene::Update(float deltaTime)
 		camera->SetAspect((float)backBufferWidth / (float)backBufferHeight);
 	}
 
-	TArray<USceneComponent*> deleteTarget;
-	TArray<AActor*> deleteActorTarget;
+	// 셀 생성/삭제 표시는 아래 객체 순회보다 먼저 (언로드된 객체가 이번 프레임에 정리되도록)
+	if (streamer)
+	{
+		streamer->Update(camera->GetLocation());
+	}
 
 	// Update legacy components
 	for (UObject* obj : objects)
@@ -273,42 +449,229 @@ void UScene::Update(float deltaTime)
 			sceneComponent->Update(deltaTime);
 
 			if (sceneComponent->markedAsDestroyed)
-				deleteTarget.push_back(sceneComponent);
+				pendingDestroyObjects.push_back(sceneComponent);
 		}
 	}
 
 	// Update actors
+	UJobSystem* jobSystem = application ? &application->GetJobSystem() : nullptr;
+	if (bParallelTick && jobSystem && jobSystem->GetNumWorkers() > 0)
+	{
+		TickActorsParallel(deltaTime, *jobSystem);
+	}
+	else
+	{
+		for (AActor* actor : actors)
+		{
+			if (actor)
+			{
+				actor->Update(deltaTime);
+
+				if (actor->markedAsDestroyed)
+					pendingDestroyActors.push_back(actor);
+			}
+		}
+	}
+
+	// 틱 중에 기록된 구조 변경을 한 지점에서 반영
+	ApplyCommandBuffers();
+
+	// 이번 프레임에 움직인 트랜스폼을 한 번의 선형 패스로 갱신하고 BVH에 반영
+	UpdateSpatialIndex();
+
+	FlushPendingDestroy();
+}
+
+void UScene::TickActorsParallel(float deltaTime, UJobSystem& jobSystem)
+{
+	parallelTickActors.clear();
+	serialTickActors.clear();
 	for (AActor* actor : actors)
 	{
 		if (actor)
 		{
-			actor->Update(deltaTime);
+			(actor->IsThreadSafeTick() ? parallelTickActors : serialTickActors).push_back(actor);
+		}
+	}
+
+	if (commandBuffers.size() < jobSystem.GetNumThreads())
+	{
+		commandBuffers.resize(jobSystem.GetNumThreads());
+	}
+
+	// 병렬 구간: 트랜스폼 더티 표시는 스레드별로 모았다가 끝난 뒤 반영
+	transformStore.BeginDeferredDirty(jobSystem.GetNumThreads());
+	jobSystem.ParallelFor(static_cast<uint32>(parallelTickActors.size()), ParallelTickGrainSize,
+		[this, deltaTime](uint32 start, uint32 end)
+		{
+			FSceneCommandBuffer& commands = GetCommandBuffer();
+			for (uint32 i = start; i < end; ++i)
+			{
+				AActor* actor = parallelTickActors[i];
+				actor->Update(deltaTime);
+
+				if (actor->markedAsDestroyed)
+					commands.DestroyActor(actor);
+			}
+		});
+	transformStore.EndDeferredDirty();
+
+	// 게임 스레드 구간: 스레드 안전하지 않은 액터
+	for (AActor* actor : serialTickActors)
+	{
+		actor->Update(deltaTime);
+
+		if (actor->markedAsDestroyed)
+			pendingDestroyActors.push_back(actor);
+	}
+}
 
-			if (actor->markedAsDestroyed)
-				deleteActorTarget.push_back(actor);
+FSceneCommandBuffer& UScene::GetCommandBuffer()
+{
+	// 병렬 틱 밖의 워커 작업이나 잡 시스템 밖의 스레드는 버퍼가 없으므로 릴리스에서도 거부:
+	// 기록은 스레드별 임시 버퍼로 버리고 다음 적용 때 게임 스레드에서 로그를 남김
+	const uint32 threadIndex = UJobSystem::GetCurrentThreadIndex();
+	if (threadIndex >= commandBuffers.size())
+	{
+		assert(false && "GetCommandBuffer called from a thread without a command buffer");
+		rejectedCommandBufferRequests.fetch_add(1, std::memory_order_relaxed);
+		thread_local FSceneCommandBuffer rejectedBuffer;
+		rejectedBuffer.Reset();
+		return rejectedBuffer;
+	}
+	return commandBuffers[threadIndex];
+}
+
+void UScene::ApplyCommandBuffers()
+{
+	if (const uint32 rejected = rejectedCommandBufferRequests.exchange(0, std::memory_order_relaxed))
+	{
+		UE_LOG("Scene: dropped commands from %u command buffer requests made outside the job system's threads", rejected);
+	}
+
+	// 스레드 순서대로 적용해 결과가 실행 순서와 무관하게 결정적
+	for (FSceneCommandBuffer& buffer : commandBuffers)
+	{
+		for (const FSceneCommand& command : buffer.GetCommands())
+		{
+			switch (command.Type)
+			{
+			case ESceneCommand::DestroyActor:
+				command.Actor->markedAsDestroyed = true;
+				pendingDestroyActors.push_back(command.Actor);
+				break;
+			case ESceneCommand::DestroyObject:
+				command.Component->markedAsDestroyed = true;
+				pendingDestroyObjects.push_back(command.Component);
+				break;
+			case ESceneCommand::SpawnActor:
+			{
+				UObject* object = command.Class ? command.Class->CreateDefaultObject() : nullptr;
+				if (AActor* actor = object ? object->Cast<AActor>() : nullptr)
+				{
+					if (!command.Params.IsNull())
+						actor->Deserialize(command.Params);
+					AddActor(actor);
+				}
+				else
+				{
+					delete object;
+				}
+				break;
+			}
+			case ESceneCommand::AddObject:
+			{
+				UObject* object = command.Class ? command.Class->CreateDefaultObject() : nullptr;
+				if (USceneComponent* component = object ? object->Cast<USceneComponent>() : nullptr)
+				{
+					if (!command.Params.IsNull())
+						component->Deserialize(command.Params);
+					AddObject(component);
+				}
+				else
+				{
+					delete object;
+				}
+				break;
+			}
+			case ESceneCommand::Attach:
+				command.Component->AttachToComponent(command.Parent);
+				break;
+			case ESceneCommand::Detach:
+				command.Component->DetachFromComponent();
+				break;
+			}
 		}
+		buffer.Reset();
 	}
+}
+
+void UScene::FlushPendingDestroy()
+{
+	if (pendingDestroyObjects.empty() && pendingDestroyActors.empty())
+		return;
+
+	// 플래그와 명령 버퍼 양쪽으로 들어온 중복 제거 (두 번 삭제 방지)
+	std::sort(pendingDestroyObjects.begin(), pendingDestroyObjects.end());
+	pendingDestroyObjects.erase(std::unique(pendingDestroyObjects.begin(), pendingDestroyObjects.end()), pendingDestroyObjects.end());
+	std::sort(pendingDestroyActors.begin(), pendingDestroyActors.end());
+	pendingDestroyActors.erase(std::unique(pendingDestroyActors.begin(), pendingDestroyActors.end()), pendingDestroyActors.end());
+
+	// 목록에서 한 번의 패스로 제거 (객체마다 find/erase 하면 O(n^2))
+	objects.erase(std::remove_if(objects.begin(), objects.end(),
+		[](USceneComponent* component) { return component && component->markedAsDestroyed; }), objects.end());
+	actors.erase(std::remove_if(actors.begin(), actors.end(),
+		[](AActor* actor) { return actor && actor->markedAsDestroyed; }), actors.end());
+
+	primitiveCount -= static_cast<int32>(pendingDestroyObjects.size() + pendingDestroyActors.size());
+
+	TArray<FString> callbackIds;
+	TArray<UObject*> destroyedObjects;
+	callbackIds.reserve(pendingDestroyObjects.size());
+	destroyedObjects.reserve(pendingDestroyObjects.size() + pendingDestroyActors.size());
 
-	// Delete legacy components
-	for (USceneComponent* component : deleteTarget)
+	for (USceneComponent* component : pendingDestroyObjects)
 	{
 		component->OnShutdown();
-		USceneManager* sceneManager = UEngineStatics::GetSubsystem<USceneManager>();
-		UInputManager* inputManager = UEngineStatics::GetSubsystem<UInputManager>();
+		callbackIds.push_back(std::to_string(component->InternalIndex));
+		destroyedObjects.push_back(component);
+	}
 
-		sceneManager->GetScene()->RemoveObject(component);
-		inputManager->UnregisterCallbacks(std::to_string(component->InternalIndex));
-		GUObjectArray.erase(std::find(GUObjectArray.begin(), GUObjectArray.end(), component));
-		application->OnObjectDestroyed(component);
-		delete(component);
+	for (AActor* actor : pendingDestroyActors)
+	{
+		actor->OnShutdown();
+		destroyedObjects.push_back(actor);
+
+		for (UActorComponent* component : actor->GetComponents<UActorComponent>())
+		{
+			if (component)
+				destroyedObjects.push_back(component);
+		}
 	}
 
-	// Delete actors
-	for (AActor* actor : deleteActorTarget)
+	// 입력 콜백 해제와 삭제 알림은 프레임당 한 번씩만
+	if (UInputManager* input = UEngineStatics::GetSubsystem<UInputManager>())
+	{
+		input->UnregisterCallbacks(callbackIds);
+	}
+	if (application)
 	{
-		RemoveActor(actor);
+		application->OnObjectsDestroyed(destroyedObjects);
 	}
 
+	// 소멸자에서 GUObjectArray 슬롯이 O(1)로 반환됨
+	for (USceneComponent* component : pendingDestroyObjects)
+	{
+		delete component;
+	}
+	for (AActor* actor : pendingDestroyActors)
+	{
+		UnregisterActorComponents(actor);
+		delete actor;
+	}
+
+	pendingDestroyObjects.clear();
+	pendingDestroyActors.clear();
 }
 
 bool UScene::OnInitialize()
@@ -323,11 +686,113 @@ void UScene::AddActor(AActor* actor)
 		return;
 
 	actors.push_back(actor);
+	actor->SetGarbageCollectable(true);
 	actor->Initialize();
+	RegisterActorComponents(actor);
 
     ++primitiveCount;
 }
 
+void UScene::RegisterActorComponents(AActor* actor)
+{
+	actor->SetScene(this);
+	for (USceneComponent* component : actor->GetComponents<USceneComponent>())
+	{
+		RegisterComponent(component);
+	}
+}
+
+void UScene::UnregisterActorComponents(AActor* actor)
+{
+	if (actor->SceneGridHandle != FSpatialHashGrid::InvalidHandle)
+	{
+		actorGrid.Remove(actor->SceneGridHandle);
+		actor->SceneGridHandle = FSpatialHashGrid::InvalidHandle;
+	}
+	actor->SetScene(nullptr);
+	for (USceneComponent* component : actor->GetComponents<USceneComponent>())
+	{
+		UnregisterComponent(component);
+	}
+}
+
+void UScene::RegisterComponent(USceneComponent* component, bool bSceneRoot)
+{
+	if (!component)
+		return;
+
+	if (bSceneRoot)
+	{
+		component->bSceneRoot = true;
+	}
+	if (component->RegisteredScene)
+		return;
+
+	component->RegisteredScene = this;
+	transformStore.Register(component);
+
+	if (UPrimitiveComponent* primitive = component->Cast<UPrimitiveComponent>())
+	{
+		component->ScenePrimitiveIndex = static_cast<uint32>(primitives.size());
+		primitives.push_back(primitive);
+		primitive->MarkRenderStateDirty();
+	}
+
+	// Initialize 중에 만들어진 텍스트홀더처럼 이미 붙어 있는 자식도 함께 등록
+	for (USceneComponent* child : component->GetAttachChildren())
+	{
+		RegisterComponent(child, false);
+	}
+}
+
+void UScene::UnregisterComponent(USceneComponent* component, bool bIncludeChildren)
+{
+	if (!component || component->RegisteredScene != this)
+		return;
+
+	const uint32 index = component->ScenePrimitiveIndex;
+	if (index != UINT_MAX)
+	{
+		// swap-pop: 마지막 원소를 빈 자리로 옮기고 인덱스 갱신
+		USceneComponent* moved = primitives.back();
+		primitives[index] = primitives.back();
+		moved->ScenePrimitiveIndex = index;
+		primitives.pop_back();
+		component->ScenePrimitiveIndex = UINT_MAX;
+	}
+
+	if (UPrimitiveComponent* primitive = component->Cast<UPrimitiveComponent>())
+	{
+		if (primitive->SceneProxyId != FDynamicAABBTree::NullNode)
+		{
+			primitiveTree.DestroyProxy(primitive->SceneProxyId);
+			primitive->SceneProxyId = FDynamicAABBTree::NullNode;
+		}
+		entityStore.Destroy(primitive->SceneEntity);
+		primitive->SceneEntity = FEntity();
+
+		if (renderer)
+		{
+			renderer->ReleasePrimitiveCache(primitive);
+		}
+	}
+
+	component->RegisteredScene = nullptr;
+	component->bSceneRoot = false;
+	transformStore.Unregister(component);
+
+	if (bIncludeChildren)
+	{
+		for (USceneComponent* child : component->GetAttachChildren())
+		{
+			if (child && !child->bSceneRoot)
+			{
+				UnregisterComponent(child, true);
+			}
+		}
+	}
+}
+
 void UScene::RemoveActor(AActor* actor)
 {
 	if (!actor)
@@ -356,7 +821,139 @@ void UScene::RemoveActor(AActor* actor)
 		}
 
         --primitiveCount;
+		UnregisterActorComponents(actor);
 		delete actor;
 	}
 }
 
+void UScene::UpdateSpatialIndex()
+{
+	// 새로 등록된 컴포넌트도 이동으로 보고되므로 바운드 계산은 전부 여기서 지연 처리
+	movedComponents.clear();
+	transformStore.UpdateWorldTransforms(&movedComponents);
+
+	for (USceneComponent* component : movedComponents)
+	{
+		if (UPrimitiveComponent* primitive = component->Cast<UPrimitiveComponent>())
+		{
+			RefreshPrimitiveBounds(primitive);
+			primitive->MarkRenderStateDirty();
+		}
+
+		// 루트가 움직인 액터만 그리드 갱신. 첫 갱신 때 추가해서 스폰 시 별도 처리가 필요 없음
+		AActor* owner = component->GetOwner();
+		if (owner && owner->GetScene() == this && owner->GetRootComponent() == component)
+		{
+			if (owner->SceneGridHandle == FSpatialHashGrid::InvalidHandle)
+			{
+				owner->SceneGridHandle = actorGrid.Add(owner, component->GetWorldLocation());
+			}
+			else
+			{
+				actorGrid.Move(owner->SceneGridHandle, component->GetWorldLocation());
+			}
+		}
+	}
+}
+
+void UScene::RefreshPrimitiveBounds(UPrimitiveComponent* primitive)
+{
+	FAABB bounds;
+	if (!primitive->GetWorldBounds(bounds))
+	{
+		if (primitive->SceneProxyId != FDynamicAABBTree::NullNode)
+		{
+			primitiveTree.DestroyProxy(primitive->SceneProxyId);
+			primitive->SceneProxyId = FDynamicAABBTree::NullNode;
+		}
+		entityStore.Destroy(primitive->SceneEntity);
+		primitive->SceneEntity = FEntity();
+		return;
+	}
+
+	if (!entityStore.IsAlive(primitive->SceneEntity))
+	{
+		primitive->SceneEntity = entityStore.Create(
+			FPrimitiveRef{ primitive, primitive->GetMesh() }, FWorldMatrix{ primitive->GetWorldTransform() }, FWorldBounds{ bounds });
+	}
+	else
+	{
+		entityStore.GetComponent<FPrimitiveRef>(primitive->SceneEntity)->Mesh = primitive->GetMesh();
+		entityStore.GetComponent<FWorldMatrix>(primitive->SceneEntity)->Matrix = primitive->GetWorldTransform();
+		entityStore.GetComponent<FWorldBounds>(primitive->SceneEntity)->Bounds = bounds;
+	}
+
+	const FVector center = bounds.GetCenter();
+	if (primitive->SceneProxyId == FDynamicAABBTree::NullNode)
+	{
+		primitive->SceneProxyId = primitiveTree.CreateProxy(bounds, primitive);
+	}
+	else
+	{
+		primitiveTree.MoveProxy(primitive->SceneProxyId, bounds, center - primitive->SceneBoundsCenter);
+	}
+	primitive->SceneBoundsCenter = center;
+}
+
+void UScene::QueryPrimitives(const FAABB& box, TArray<UPrimitiveComponent*>& outPrimitives)
+{
+	UpdateSpatialIndex();
+	primitiveTree.QueryAABB(box, [this, &outPrimitives](int32 proxyId) {
+		outPrimitives.push_back(primitiveTree.GetUserData(proxyId));
+		return true;
+	});
+}
+
+void UScene::QueryPrimitives(const FFrustum& frustum, TArray<UPrimitiveComponent*>& outPrimitives)
+{
+	UpdateSpatialIndex();
+	primitiveTree.QueryFrustum(frustum, [this, &outPrimitives](int32 proxyId) {
+		outPrimitives.push_back(primitiveTree.GetUserData(proxyId));
+		return true;
+	});
+}
+
+void UScene::QueryPrimitivesLinear(const FFrustum& frustum, TArray<UPrimitiveComponent*>& outPrimitives)
+{
+	UpdateSpatialIndex();
+
+	// 청크의 바운드 컬럼을 8개씩 SoA로 옮겨 한 번에 판정 (Ids = 청크 내 행)
+	FAABBBatch batch;
+	entityStore.ForEachChunk<const FPrimitiveRef, const FWorldBounds>(
+		[&frustum, &batch, &outPrimitives](const FEntity*, uint32 count, const FPrimitiveRef* refs, const FWorldBounds* bounds) {
+			for (uint32 row = 0; row < count; row += FAABBBatch::Capacity)
+			{
+				batch.Reset();
+				const uint32 end = (std::min)(row + FAABBBatch::Capacity, count);
+				for (uint32 i = row; i < end; ++i)
+				{
+					batch.Add(bounds[i].Bounds, static_cast<int32>(i));
+				}
+				for (uint32 mask = frustum.TestAABBs(batch); mask; mask &= mask - 1)
+				{
+					outPrimitives.push_back(refs[batch.Ids[FBitOps::CountTrailingZeros64(mask)]].Primitive);
+				}
+			}
+		});
+}
+
+void UScene::RaycastPrimitives(const FVector& origin, const FVector& direction, float maxDistance, TArray<UPrimitiveComponent*>& outPrimitives)
+{
+	UpdateSpatialIndex();
+	primitiveTree.RayCast(origin, direction, maxDistance, [this, &outPrimitives, maxDistance](int32 proxyId, float) {
+		outPrimitives.push_back(primitiveTree.GetUserData(proxyId));
+		return maxDistance;
+	});
+}
+
+void UScene::QueryActors(const FAABB& box, TArray<AActor*>& outActors)
+{
+	UpdateSpatialIndex();
+	actorGrid.QueryBox(box, outActors);
+}
+
+void UScene::QueryActors(const FVector& center, float radius, TArray<AActor*>& outActors)
+{
+	UpdateSpatialIndex();
+	actorGrid.QuerySphere(center, radius, outActors);
+}
@@ -7,10 +7,36 @@
 #include "json.hpp"
 #include "UGizmoManager.h"
 #include "Constant.h"
+#include "FTransformStore.h"
+#include "FSceneCommandBuffer.h"
+#include "FDynamicAABBTree.h"
+#include "FSpatialHashGrid.h"
+#include "FEntityStore.h"
+#include <atomic>
 
 class UCamera;
 class URaycastManager;
 class AActor;
+class UJobSystem;
+class UPrimitiveComponent;
+class FSceneStreamer;
+
+// UScene::entityStore에 미러링되는 프리미티브 데이터 (대량 순회용 컬럼)
+struct FPrimitiveRef
+{
+	UPrimitiveComponent* Primitive;
+	UMesh* Mesh;
+};
+
+struct FWorldMatrix
+{
+	FMatrix Matrix;
+};
+
+struct FWorldBounds
+{
+	FAABB Bounds;
+};
 
 /**
  * @brief Container for all scene objects with rendering and update functionality
@@ -23,27 +49,86 @@ private:
 
 protected:
 	int32 backBufferWidth, backBufferHeight;
-	int32 version;
 	int32 primitiveCount;
 	bool isInitialized;
 
 	TArray<USceneComponent*> objects;  // TODO: Deprecated, use actors instead
 	TArray<AActor*> actors;  // New actor-based management
 
+	// 이번 프레임에 삭제 표시된 객체들. Update 마지막에 한 번에 정리됨
+	TArray<USceneComponent*> pendingDestroyObjects;
+	TArray<AActor*> pendingDestroyActors;
+
+	// 씬에 있는 컴포넌트들의 트랜스폼 (SoA, 부모가 자식보다 앞)
+	FTransformStore transformStore;
+
+	// 씬에 등록된 모든 프리미티브 (부착된 텍스트홀더 포함). 순서 없음, 제거는 swap-pop
+	TArray<UPrimitiveComponent*> primitives;
+
+	// 프리미티브 월드 바운드의 BVH. 트랜스폼이 바뀐 프리미티브만 UpdateSpatialIndex에서 갱신
+	FDynamicAABBTree primitiveTree;
+	TArray<USceneComponent*> movedComponents;	// UpdateSpatialIndex 임시 버퍼
+
+	// 액터 위치(루트 컴포넌트)의 해시 그리드. 범위 질의용, 루트가 움직인 액터만 갱신
+	FSpatialHashGrid actorGrid;
+
+	// 바운드가 있는 프리미티브의 청크 SoA 미러 (FPrimitiveRef, FWorldMatrix, FWorldBounds)
+	// primitiveTree와 같은 시점(RefreshPrimitiveBounds)에 갱신됨
+	FEntityStore entityStore;
+
+	// 분할된 씬이면 카메라 주변 셀을 불러오고 내림 (아니면 nullptr)
+	TUniquePtr<FSceneStreamer> streamer;
+
+	// 절두체 컬링: 이번 프레임에 그릴 프리미티브 (프레임마다 재사용)
+	bool bFrustumCulling = true;
+	TArray<UPrimitiveComponent*> visiblePrimitives;
+
+	// 병렬 틱: 스레드별 명령 버퍼와 프레임마다 다시 나누는 액터 목록
+	bool bParallelTick = false;
+	TArray<FSceneCommandBuffer> commandBuffers;
+	std::atomic<uint32> rejectedCommandBufferRequests{ 0 };	// 버퍼가 없는 스레드의 GetCommandBuffer 호출 수
+	TArray<AActor*> parallelTickActors;
+	TArray<AActor*> serialTickActors;
+	static constexpr uint32 ParallelTickGrainSize = 64;
+
 	// Reference from outside
 	UApplication* application;
-	URenderer* renderer;
+	URenderer* renderer = nullptr;
 	UMeshManager* meshManager;
 	UInputManager* inputManager;
 	//URaycastManager* RaycastManager;
 	//UGizmoManager* GizmoManager;
 
 	//UScene owns camera
-	UCamera* camera;
+	UCamera* camera = nullptr;
 
 	virtual void RenderGUI() {}
 	virtual void OnShutdown() {}
+
+	/** @brief Removes, notifies and deletes every queued object in a single pass over the scene. */
+	void FlushPendingDestroy();
+
+	/** @brief Inserts, refits or removes the primitive's leaf in primitiveTree from its current world bounds. */
+	void RefreshPrimitiveBounds(UPrimitiveComponent* primitive);
+
+	void RegisterActorComponents(AActor* actor);
+	void UnregisterActorComponents(AActor* actor);
+
+	/** @brief Ticks thread-safe actors on the job system, then the rest on the game thread. */
+	void TickActorsParallel(float deltaTime, UJobSystem& jobSystem);
+	void ApplyCommandBuffers();
+
+	// Deserialize/DeserializeBinary 공통: 이전 내용을 비우고, 읽은 객체를 UUID와 함께 등록
+	void ClearForLoad();
+	void AddLoadedObject(USceneComponent* component, uint32 uuid);
+	void AddLoadedActor(AActor* actor, uint32 uuid);
 public:
+	// UPROPERTY "Version". USceneManager가 저장할 때마다 올림
+	int32 version;
+
+	/** @brief First four bytes ("USCN") of a scene saved with SerializeBinary; USceneManager::LoadScene picks the format from them. */
+	static constexpr uint32 BinarySceneMagic = 0x4E435355;
+
 	UScene();
 	virtual ~UScene();
 	virtual bool Initialize(UApplication* app, URenderer* r, UMeshManager* mm, UInputManager* im = nullptr);
@@ -57,6 +142,15 @@ public:
 	int32 GetObjectCount() { return primitiveCount; }
 
 	static UScene* Create(json::JSON data);
+	/** @brief Builds a scene object from its serialized form ("Type" + properties); nullptr for unknown types. */
+	static USceneComponent* CreateObjectFromJson(const json::JSON& data);
+
+	/**
+	 * @brief Starts streaming the cells described by a scene file's "Partition" block around the camera.
+	 * @param baseDirectory Folder of the scene file; the partition's Directory is relative to it.
+	 */
+	void EnableStreaming(const json::JSON& partition, const FString& baseDirectory);
+	FSceneStreamer* GetStreamer() const { return streamer.get(); }
 
 	void AddObject(USceneComponent* obj);  // TODO: Deprecated
 	void RemoveObject(USceneComponent* obj);  // TODO: Deprecated
@@ -69,13 +163,82 @@ public:
 
 	json::JSON Serialize() const override;
 
+	void AddReferencedObjects(FReferenceCollector& collector) override;
+
 	bool Deserialize(const json::JSON& data) override;
 
+	/**
+	 * @brief Writes the same content as Serialize as a binary image: BinarySceneMagic, the UPROPERTY image,
+	 *        NextUUID, then (UUID, object record) pairs for the objects and the actors.
+	 * @note: Has no Partition block, so streamed objects would be written like any other; USceneManager
+	 *        refuses binary saves while streaming.
+	 */
+	void SerializeBinary(TArray<uint8>& outBytes) const override;
+	bool DeserializeBinary(const uint8*& cursor, const uint8* end) override;
+
 	const TArray<USceneComponent*>& GetObjects() const { return objects; }  // TODO: Deprecated
 	const TArray<AActor*>& GetActors() const { return actors; }  // New method
 
 	UCamera* GetCamera() { return camera; }
 	URenderer* GetRenderer() { return renderer; }
+	FTransformStore& GetTransformStore() { return transformStore; }
+
+	/**
+	 * @brief Adds the component and everything attached under it to the primitive registry and transformStore.
+	 * @param bSceneRoot true when added directly (objects, actor components), false when it follows an attach.
+	 */
+	void RegisterComponent(USceneComponent* component, bool bSceneRoot = true);
+	/** @brief Removes the component (and, optionally, its attached non-root descendants) from the scene. */
+	void UnregisterComponent(USceneComponent* component, bool bIncludeChildren = true);
+	/**
+	 * @brief Every primitive currently in the scene, maintained incrementally; iterate without allocating.
+	 * @note: Order is unspecified. Unregistering swap-pops, so it depends on the removal history, not on
+	 *        registration order. Do not use it for anything user-visible: the outliner lists actors and
+	 *        objects, and UBatchRenderer orders draws by render key (equal keys keep this order).
+	 */
+	const TArray<UPrimitiveComponent*>& GetPrimitives() const { return primitives; }
+
+	/**
+	 * @brief Flushes pending transform changes and refits their leaves in the primitive tree.
+	 * @note: Runs once per Update; the queries below call it too so they see edits made since then.
+	 */
+	void UpdateSpatialIndex();
+	const FDynamicAABBTree& GetPrimitiveTree() const { return primitiveTree; }
+	const FSpatialHashGrid& GetActorGrid() const { return actorGrid; }
+	/** @brief Chunked mirror of primitive data for systems that iterate every primitive; see FPrimitiveRef. */
+	FEntityStore& GetEntityStore() { return entityStore; }
+
+	/** @brief Appends primitives whose (fat) bounds overlap box. Primitives without bounds are never returned. */
+	void QueryPrimitives(const FAABB& box, TArray<UPrimitiveComponent*>& outPrimitives);
+	/** @brief Appends primitives whose (fat) bounds are not outside frustum. */
+	void QueryPrimitives(const FFrustum& frustum, TArray<UPrimitiveComponent*>& outPrimitives);
+	/**
+	 * @brief Same test as QueryPrimitives(frustum) against the exact bounds, by streaming every chunk of entityStore.
+	 * @note: O(n) but branch-free and sequential; preferable when most of the scene is on screen.
+	 */
+	void QueryPrimitivesLinear(const FFrustum& frustum, TArray<UPrimitiveComponent*>& outPrimitives);
+	/**
+	 * @brief Appends what Render draws: primitives not outside frustum plus those without bounds, or the
+	 *        whole registry with culling off. Every primitive appears at most once.
+	 */
+	void CollectDrawPrimitives(const FFrustum& frustum, TArray<UPrimitiveComponent*>& outPrimitives);
+	/** @brief Appends primitives whose (fat) bounds the ray enters within maxDistance, roughly nearest first. */
+	void RaycastPrimitives(const FVector& origin, const FVector& direction, float maxDistance, TArray<UPrimitiveComponent*>& outPrimitives);
+
+	/** @brief Appends actors whose root component location is inside box. */
+	void QueryActors(const FAABB& box, TArray<AActor*>& outActors);
+	/** @brief Appends actors whose root component location is within radius of center. */
+	void QueryActors(const FVector& center, float radius, TArray<AActor*>& outActors);
+
+	/**
+	 * @brief Command buffer of the calling thread; applied at the end of Update.
+	 * @note: Threads without a buffer (outside the job system) are rejected: an assert in debug; in release the records are dropped and logged.
+	 */
+	FSceneCommandBuffer& GetCommandBuffer();
+	void SetFrustumCulling(bool bEnable) { bFrustumCulling = bEnable; }
+	bool IsFrustumCulling() const { return bFrustumCulling; }
+	void SetParallelTick(bool bEnable) { bParallelTick = bEnable; }
+	bool IsParallelTick() const { return bParallelTick; }
 	UInputManager* GetInputManager() { return inputManager; }
 
 	int32 GetBackBufferWidth() { return backBufferWidth; };
@@ -6,18 +6,94 @@
 #include "UInputManager.h"
 #include "UScene.h"
 #include "AActor.h"
+#include "UGarbageCollector.h"
+#include "FTransformStore.h"
 
 IMPLEMENT_UCLASS(USceneComponent, UActorComponent)
-FMatrix USceneComponent::GetWorldTransform() const
+UPROPERTY_DISPLAYNAME(USceneComponent, RelativeLocation, "Location", "Translation", PF_Default)
+UPROPERTY(USceneComponent, RelativeQuaternion, "Rotation", PF_Default)
+UPROPERTY(USceneComponent, RelativeScale3D, "Scale", PF_Default)
+
+USceneComponent::~USceneComponent()
 {
-    FMatrix relativeTransform = GetRelativeTransform();
+    if (RegisteredScene)
+    {
+        // 자식은 각자의 소멸자에서 해제됨
+        RegisteredScene->UnregisterComponent(this, false);
+    }
+    if (TransformStore)
+    {
+        TransformStore->Unregister(this);
+    }
+}
 
-    if (AttachParent)
+const FMatrix& USceneComponent::GetWorldTransform() const
+{
+    if (TransformStore)
     {
-        return relativeTransform * AttachParent->GetWorldTransform();
+        // 부모까지 같은 저장소에 있으면 저장소 값을 그대로 사용
+        if (!TransformStore->IsDeferringDirty() && (!AttachParent || AttachParent->TransformStore == TransformStore))
+        {
+            return TransformStore->GetWorldTransform(this);
+        }
+
+        // 병렬 틱 중에는 형제가 다른 스레드에서 같은 부모를 조회할 수 있으므로 부모 캐시에 쓰지 않고
+        // 부모 체인을 값으로 따라 올라가며 계산 (자기 캐시는 소유 액터를 틱하는 스레드만 씀)
+        if (TransformStore->IsDeferringDirty())
+        {
+            FMatrix World = GetRelativeTransform();
+            for (const USceneComponent* Parent = AttachParent; Parent; Parent = Parent->AttachParent)
+            {
+                World = World * Parent->GetRelativeTransform();
+            }
+            CachedWorldTransform = World;
+            return CachedWorldTransform;
+        }
+
+        // 부모가 저장소 밖이면 자기 캐시에 새로 계산
+        // (저장소 컴포넌트의 더티 플래그는 항상 true로 두고 쓰지 않음)
+        CachedWorldTransform = AttachParent
+            ? GetRelativeTransform() * AttachParent->GetWorldTransform()
+            : GetRelativeTransform();
+        return CachedWorldTransform;
+    }
+
+    // 저장소에 있는 부모의 이동은 플래그로 전파되지 않으므로 그 경우엔 매번 다시 계산
+    if (bWorldTransformDirty || (AttachParent && AttachParent->TransformStore))
+    {
+        // 부모가 깨끗하면 부모 캐시를 그대로 사용하므로 조회는 더티인 조상 수만큼만 비용이 듦
+        CachedWorldTransform = AttachParent
+            ? GetRelativeTransform() * AttachParent->GetWorldTransform()
+            : GetRelativeTransform();
+        bWorldTransformDirty = false;
     }
 
-    return relativeTransform;
+    return CachedWorldTransform;
+}
+
+void USceneComponent::MarkTransformDirty()
+{
+    if (TransformStore)
+    {
+        TransformStore->SetLocal(TransformIndex, RelativeLocation, RelativeQuaternion, RelativeScale3D);
+    }
+    PropagateTransformDirty();
+}
+
+void USceneComponent::PropagateTransformDirty()
+{
+    // 이미 더티면 자손도 모두 더티이므로 전파 생략
+    if (bWorldTransformDirty)
+        return;
+
+    bWorldTransformDirty = true;
+    for (USceneComponent* child : AttachChildren)
+    {
+        if (child)
+        {
+            child->PropagateTransformDirty();
+        }
+    }
 }
 
 FMatrix USceneComponent::GetRelativeTransform() const
@@ -36,6 +112,16 @@ void USceneComponent::AttachToComponent(USceneComponent* Parent)
     // Set new parent
     AttachParent = Parent;
     Parent->AttachChildren.push_back(this);
+    if (TransformStore)
+    {
+        TransformStore->MarkHierarchyDirty();
+    }
+    // 씬에 있는 부모에 붙으면 서브트리도 씬에 등록
+    if (Parent->RegisteredScene && !RegisteredScene)
+    {
+        Parent->RegisteredScene->RegisterComponent(this, false);
+    }
+    MarkTransformDirty();
 }
 
 void USceneComponent::AttachChild(USceneComponent* Child)
@@ -62,6 +148,16 @@ void USceneComponent::DetachFromComponent()
             }
         }
         AttachParent = nullptr;
+        if (TransformStore)
+        {
+            TransformStore->MarkHierarchyDirty();
+        }
+        // 부착으로 따라 들어온 컴포넌트는 떨어지면 씬에서도 빠짐
+        if (RegisteredScene && !bSceneRoot)
+        {
+            RegisteredScene->UnregisterComponent(this);
+        }
+        MarkTransformDirty();
     }
 }
 
@@ -273,36 +369,30 @@ void USceneComponent::HandleInput(int32 keyCode)
     }
 }
 
-json::JSON USceneComponent::Serialize() const
+void USceneComponent::AddReferencedObjects(FReferenceCollector& collector)
 {
-    FVector tmpRot = RelativeQuaternion.GetEulerXYZ();
-    json::JSON result;
-    result["Location"] = json::Array(RelativeLocation.X, RelativeLocation.Y, RelativeLocation.Z);
-    result["Rotation"] = json::Array( tmpRot.X, tmpRot.Y, tmpRot.Z);
-    result["Scale"] = json::Array(RelativeScale3D.X, RelativeScale3D.Y, RelativeScale3D.Z);
-    result["Type"] = GetClass()->GetDisplayName();
-    return result;
+    collector.AddReferencedObjects(AttachChildren);
 }
 
-// -------------------------
-// Deserialize
-// -------------------------
 bool USceneComponent::Deserialize(const json::JSON& data)
 {
-    if (!data.hasKey("Location") || !data.hasKey("Rotation") || !data.hasKey("Scale"))
-        return false;
-
-    auto loc = data.at("Location");
-    if (loc.size() != 3) return false;
-    RelativeLocation = FVector(loc[0].ToFloat(), loc[1].ToFloat(), loc[2].ToFloat());
-
-    auto rot = data.at("Rotation");
-    if (rot.size() != 3) return false;
-    RelativeQuaternion = FQuaternion::FromEulerXYZ(rot[0].ToFloat(), rot[1].ToFloat(), rot[2].ToFloat());
+    // FromJson은 Relative* 필드를 직접 채우므로 캐시 무효화 필요
+    const bool bResult = Super::Deserialize(data);
+    MarkTransformDirty();
+    return bResult;
+}
 
-    auto scale = data.at("Scale");
-    if (scale.size() != 3) return false;
-    RelativeScale3D = FVector(scale[0].ToFloat(), scale[1].ToFloat(), scale[2].ToFloat());
+bool USceneComponent::DeserializeBinary(const uint8*& cursor, const uint8* end)
+{
+    const bool bResult = Super::DeserializeBinary(cursor, end);
+    MarkTransformDirty();
+    return bResult;
+}
 
-    return true;
+json::JSON USceneComponent::Serialize() const
+{
+    // Location/Rotation/Scale는 UPROPERTY 메타데이터로 저장
+    json::JSON result = Super::Serialize();
+    result["Type"] = GetClass()->GetDisplayName();
+    return result;
 }
\ No newline at end of file
@@ -5,6 +5,9 @@
 #include "Quaternion.h"
 #include "TArray.h"
 
+class FTransformStore;
+class UScene;
+
 /**
  * @brief Base component for objects with transform in 3D space
  */
@@ -22,6 +25,24 @@ protected:
 	USceneComponent* AttachParent = nullptr;
 	TArray<USceneComponent*> AttachChildren;
 
+private:
+	// 월드 행렬 캐시. 더티 노드의 자손은 항상 더티 (MarkTransformDirty가 보장)
+	mutable FMatrix CachedWorldTransform;
+	mutable bool bWorldTransformDirty = true;
+
+	// 씬에 등록되면 월드 행렬은 씬의 SoA 저장소에서 관리 (FTransformStore가 인덱스를 갱신)
+	friend class FTransformStore;
+	FTransformStore* TransformStore = nullptr;
+	uint32 TransformIndex = UINT_MAX;
+
+	void PropagateTransformDirty();
+
+	// 씬 등록 정보 (UScene::RegisterComponent가 관리)
+	friend class UScene;
+	UScene* RegisteredScene = nullptr;
+	uint32 ScenePrimitiveIndex = UINT_MAX;
+	bool bSceneRoot = false;	// 씬에 직접 추가됨 (부착으로 따라 들어온 것이 아님)
+
 public:
 	USceneComponent(FVector pos = { 0,0,0 }, FVector rot = { 0,0,0 }, FVector scl = { 1,1,1 })
 		: UActorComponent(), RelativeLocation(pos), //RelativeRotation(rot),
@@ -29,10 +50,27 @@ public:
 	{
 		UUID = UEngineStatics::GenUUID();
 	}
+	virtual ~USceneComponent();
 
-	virtual FMatrix GetWorldTransform() const;
+	/**
+	 * @brief Cached world matrix; recomputed only after this component or an ancestor moved.
+	 * @note: During the parallel tick this walks the parent chain by value and only writes this component's own cache.
+	 */
+	const FMatrix& GetWorldTransform() const;
 	virtual FMatrix GetRelativeTransform() const;
 
+	/**
+	 * @brief Invalidates the cached world matrix of this component and all of its descendants.
+	 * @note: Call after writing Relative* directly (e.g. through FProperty).
+	 */
+	void MarkTransformDirty();
+	bool IsTransformDirty() const { return bWorldTransformDirty; }
+	FTransformStore* GetTransformStore() const { return TransformStore; }
+
+	UScene* GetRegisteredScene() const { return RegisteredScene; }
+	/** @brief True for objects and actor components added to the scene directly, false for attached extras (e.g. textholders). */
+	bool IsSceneRoot() const { return bSceneRoot; }
+
 	// Attachment functions
 	void AttachToComponent(USceneComponent* Parent);
 	void AttachChild(USceneComponent* Child);
@@ -69,9 +107,9 @@ public:
 	// virtual void EndPlay();
 
 	// 위치와 스케일 설정 함수들
-	void SetPosition(const FVector& pos) { RelativeLocation = pos; }
-	void SetScale(const FVector& scl) { RelativeScale3D = scl; }
-	void SetRotation(const FVector& rot) { RelativeQuaternion = FQuaternion::FromEulerXYZDeg(rot); }
+	void SetPosition(const FVector& pos) { RelativeLocation = pos; MarkTransformDirty(); }
+	void SetScale(const FVector& scl) { RelativeScale3D = scl; MarkTransformDirty(); }
+	void SetRotation(const FVector& rot) { RelativeQuaternion = FQuaternion::FromEulerXYZDeg(rot); MarkTransformDirty(); }
 	void AddQuaternion(const FVector& axis, const float deg, const bool isWorldAxis = false)
 	{
 		if (isWorldAxis)
@@ -82,14 +120,16 @@ public:
 		{
 			RelativeQuaternion.RotateLocalAxisAngle(axis, deg);
 		}
+		MarkTransformDirty();
 	}
-	void SetQuaternion(const FQuaternion quat) { RelativeQuaternion = quat; }
+	void SetQuaternion(const FQuaternion quat) { RelativeQuaternion = quat; MarkTransformDirty(); }
 	void ResetQuaternion()
 	{
 		RelativeQuaternion.X = 0;
 		RelativeQuaternion.Y = 0;
 		RelativeQuaternion.Z = 0;
 		RelativeQuaternion.W = 1;
+		MarkTransformDirty();
 	}
 	FVector GetPosition() const
 	{
@@ -110,4 +150,8 @@ public:
 
 	json::JSON Serialize() const override;
 	bool Deserialize(const json::JSON& data) override;
+	bool DeserializeBinary(const uint8*& cursor, const uint8* end) override;
+
+	void AddReferencedObjects(FReferenceCollector& collector) override;
+	void BeginDestroy() override { OnShutdown(); }
 };
\ No newline at end of file
@@ -1,5 +1,7 @@
 ﻿#include "stdafx.h"
 #include "USceneComponentPropertyWindow.h"
+#include "UClass.h"
+#include "FProperty.h"
 
 
 // 활성화(선택) 상태면 버튼색을 Active 계열로 바꿔서 '눌린 버튼'처럼 보이게 하는 헬퍼
@@ -18,66 +20,117 @@ static bool ModeButton(const char* label, bool active, const ImVec2& size = ImVe
 	return pressed;
 }
 
-void USceneComponentPropertyWindow::RenderContent()
+// 3칸짜리 float 행. 편집이 끝났으면 bOutCommitted = true
+static bool InputFloat3Row(float values[3], bool& bOutCommitted)
 {
-	if (!Target) return;
+	bool changed = false;
+	for (int32 i = 0; i < 3; i++)
+	{
+		ImGui::TableSetColumnIndex(i);
+		ImGui::SetNextItemWidth(-1);
+		ImGui::PushID(i);
+		changed |= ImGui::InputFloat("##v", &values[i], 0.0f, 0.0f, "%.3f");
+		bOutCommitted |= ImGui::IsItemDeactivatedAfterEdit();
+		ImGui::PopID();
+	}
+	return changed;
+}
 
-	FVector& location = Target->RelativeLocation;
-	FVector rotation = Target->GetRotation();
-	FVector& scale = Target->RelativeScale3D;
+// UPROPERTY 메타데이터만으로 한 행을 그림
+// @return 값이 바뀌었으면 true
+static bool RenderPropertyRow(USceneComponent* target, const FProperty& property)
+{
+	bool changed = false;
+	ImGui::TableNextRow();
+	ImGui::PushID(property.Name);
 
-	float locationInput[3] = { location.X, location.Y, location.Z };
-	float rotationInput[3] = { rotation.X, rotation.Y, rotation.Z };
-	float scaleInput[3] = { scale.X,    scale.Y,    scale.Z };
-	bool rotCommited = false;
-	// 나머지는 테이블로
-	if (ImGui::BeginTable("EditablePropertyTable", 4, ImGuiTableFlags_None))
+	bool committed = false;
+	switch (property.Type)
+	{
+	case EPropertyType::Bool:
+		ImGui::TableSetColumnIndex(0);
+		changed = ImGui::Checkbox("##v", &property.GetValue<bool>(target));
+		break;
+	case EPropertyType::Int32:
+		ImGui::TableSetColumnIndex(0);
+		ImGui::SetNextItemWidth(-1);
+		changed = ImGui::InputInt("##v", &property.GetValue<int32>(target), 0, 0);
+		break;
+	case EPropertyType::Float:
+		ImGui::TableSetColumnIndex(0);
+		ImGui::SetNextItemWidth(-1);
+		changed = ImGui::InputFloat("##v", &property.GetValue<float>(target), 0.0f, 0.0f, "%.3f");
+		break;
+	case EPropertyType::String:
 	{
-		ImGui::TableNextRow();
-		for (int32 i = 0; i < 3; i++)
+		FString& value = property.GetValue<FString>(target);
+		char buffer[256];
+		snprintf(buffer, sizeof(buffer), "%s", value.c_str());
+		ImGui::TableSetColumnIndex(0);
+		ImGui::SetNextItemWidth(-1);
+		if (ImGui::InputText("##v", buffer, sizeof(buffer)))
 		{
-			ImGui::TableSetColumnIndex(i);
-			ImGui::SetNextItemWidth(-1);
-			ImGui::InputFloat(("##tra" + std::to_string(i)).c_str(),
-				&locationInput[i], 0.0f, 0.0f, "%.3f");
+			value = buffer;
+			changed = true;
 		}
-		ImGui::TableSetColumnIndex(3);
-		ImGui::Text("Translation");
+		break;
+	}
+	case EPropertyType::Vector:
+	{
+		FVector& value = property.GetValue<FVector>(target);
+		float input[3] = { value.X, value.Y, value.Z };
+		if (InputFloat3Row(input, committed))
+		{
+			value = FVector(input[0], input[1], input[2]);
+			changed = true;
+		}
+		break;
+	}
+	case EPropertyType::Quaternion:
+	{
+		// 오일러 각은 편집이 끝났을 때만 적용 (입력 중 쿼터니언 왕복 변환으로 값이 튀는 것 방지)
+		FQuaternion& value = property.GetValue<FQuaternion>(target);
+		FVector euler = value.GetEulerXYZDeg();
+		float input[3] = { euler.X, euler.Y, euler.Z };
+		InputFloat3Row(input, committed);
+		if (committed)
+		{
+			value = FQuaternion::FromEulerXYZDeg(input[0], input[1], input[2]);
+			changed = true;
+		}
+		break;
+	}
+	}
+
+	ImGui::TableSetColumnIndex(3);
+	ImGui::Text("%s", property.DisplayName);
+	ImGui::PopID();
+	return changed;
+}
+
+void USceneComponentPropertyWindow::RenderContent()
+{
+	USceneComponent* target = Target.Get();
+	if (!target) return;
 
-		ImGui::TableNextRow();
-		for (int32 i = 0; i < 3; i++)
+	// 나머지는 테이블로
+	if (ImGui::BeginTable("EditablePropertyTable", 4, ImGuiTableFlags_None))
+	{
+		bool changed = false;
+		for (const FProperty& property : target->GetClass()->GetProperties())
 		{
-			ImGui::TableSetColumnIndex(i);
-			ImGui::SetNextItemWidth(-1);
-			ImGui::InputFloat(("##rot" + std::to_string(i)).c_str(),
-				&rotationInput[i], 0.0f, 0.0f, "%.3f");
-			if (ImGui::IsItemDeactivatedAfterEdit())
+			if (property.HasFlag(PF_Edit))
 			{
-				rotCommited = true;
+				changed |= RenderPropertyRow(target, property);
 			}
 		}
-		ImGui::TableSetColumnIndex(3);
-		ImGui::Text("Rotation");
 
-		ImGui::TableNextRow();
-		for (int32 i = 0; i < 3; i++)
+		// 메타데이터 편집은 Relative*를 직접 쓰므로 월드 행렬 캐시 무효화
+		if (changed)
 		{
-			ImGui::TableSetColumnIndex(i);
-			ImGui::SetNextItemWidth(-1);
-			ImGui::InputFloat(("##scl" + std::to_string(i)).c_str(),
-				&scaleInput[i], 0.0f, 0.0f, "%.3f");
+			target->MarkTransformDirty();
 		}
-		ImGui::TableSetColumnIndex(3);
-		ImGui::Text("Scale");
 
 		ImGui::EndTable();
 	}
-
-	if (rotCommited)
-	{
-		Target->SetRotation({ rotationInput[0], rotationInput[1], rotationInput[2] });
-	}
-	location = FVector(locationInput[0], locationInput[1], locationInput[2]);
-	rotation = FVector(rotationInput[0], rotationInput[1], rotationInput[2]);
-	scale = FVector(scaleInput[0], scaleInput[1], scaleInput[2]);
 }
@@ -2,11 +2,12 @@
 #include "ImGuiWindowWrapper.h"
 #include "USceneManager.h"
 #include "USceneComponent.h"
+#include "TWeakObjectPtr.h"
 
 class USceneComponentPropertyWindow : public ImGuiWindowWrapper
 {
 private:
-	USceneComponent* Target = nullptr;
+	TWeakObjectPtr<USceneComponent> Target;
 
 public:
 	USceneComponentPropertyWindow() : ImGuiWindowWrapper("Property Window", ImVec2(0, 450), ImVec2(275, 110))
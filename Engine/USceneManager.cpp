@@ -2,6 +2,10 @@
 #include "USceneManager.h"
 #include "UScene.h"
 #include "UApplication.h"
+#include "UGarbageCollector.h"
+#include "FSceneStreamer.h"
+#include "ConfigManager.h"
+#include "FProperty.h"
 
 
 IMPLEMENT_UCLASS(USceneManager, UEngineSubsystem)
@@ -46,6 +50,11 @@ void USceneManager::SetScene(UScene* scene)
 	application->OnSceneChange();
 }
 
+void USceneManager::AddReferencedObjects(FReferenceCollector& collector)
+{
+	collector.AddReferencedObject(currentScene);
+}
+
 void USceneManager::RequestExit()
 {
 	if (application) {
@@ -54,39 +63,83 @@ void USceneManager::RequestExit()
 }
 
 
+namespace
+{
+	bool ReadFileBytes(const FString& path, TArray<uint8>& outBytes)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file)
+			return false;
+		outBytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		return true;
+	}
+
+	bool IsBinaryScene(const TArray<uint8>& bytes)
+	{
+		uint32 magic = 0;
+		const uint8* cursor = bytes.data();
+		return FPropertySerializer::ReadRaw(cursor, bytes.data() + bytes.size(), magic) && magic == UScene::BinarySceneMagic;
+	}
+}
+
 void USceneManager::LoadScene(const FString& path)
 {
-	std::ifstream file(path);
-	if (!file)
+	TArray<uint8> bytes;
+	if (!ReadFileBytes(path, bytes))
 	{
 		// Log error: failed to open file
 		return;
+	}
 
+	// 바이너리 씬은 매직 넘버로 구분 (JSON은 '{'로 시작)
+	if (IsBinaryScene(bytes))
+	{
+		UScene* scene = new UScene();
+		const uint8* cursor = bytes.data();
+		if (!scene->DeserializeBinary(cursor, bytes.data() + bytes.size()))
+		{
+			UE_LOG("[Scene] %s: some objects could not be read", path.c_str());
+		}
+		SetScene(scene);
+		return;
 	}
-	std::stringstream buffer;
-	buffer << file.rdbuf();
 
-	json::JSON sceneData = json::JSON::Load(buffer.str());
+	json::JSON sceneData = json::JSON::Load(FString(bytes.begin(), bytes.end()));
 	SetScene(UScene::Create(sceneData));
+
+	// 분할된 씬: 셀은 카메라 위치에 따라 백그라운드에서 불러옴
+	if (sceneData.hasKey("Partition"))
+	{
+		currentScene->EnableStreaming(sceneData["Partition"], std::filesystem::path(path).parent_path().string());
+	}
 }
 
-void USceneManager::SaveScene(const FString& path)
+void USceneManager::BumpVersionFromSavedScene(const FString& path)
 {
-	std::filesystem::path fsPath(path);
+	TArray<uint8> bytes;
+	if (!std::filesystem::exists(path) || !ReadFileBytes(path, bytes))
+		return;
 
-	if (std::filesystem::exists(fsPath))
+	// 이전 파일의 Version + 1 (형식은 이전 파일 기준)
+	if (IsBinaryScene(bytes))
 	{
-		std::ifstream file(path);
-		if (file)
+		UScene saved;
+		const uint8* cursor = bytes.data() + sizeof(UScene::BinarySceneMagic);
+		if (FPropertySerializer::FromBinary(&saved, cursor, bytes.data() + bytes.size()))
 		{
-			std::stringstream buffer;
-			buffer << file.rdbuf();
-			json::JSON sceneData = json::JSON::Load(buffer.str());
-
-			currentScene->SetVersion(sceneData["Version"].ToInt() + 1);
+			currentScene->SetVersion(saved.version + 1);
 		}
+		return;
 	}
 
+	json::JSON sceneData = json::JSON::Load(FString(bytes.begin(), bytes.end()));
+	currentScene->SetVersion(sceneData["Version"].ToInt() + 1);
+}
+
+void USceneManager::SaveScene(const FString& path)
+{
+	BumpVersionFromSavedScene(path);
+
 	json::JSON sceneData = currentScene->Serialize();
 
 	std::ofstream file(path);
@@ -100,3 +153,141 @@ void USceneManager::SaveScene(const FString& path)
 	file << sceneData.dump();
 }
 
+bool USceneManager::SaveSceneBinary(const FString& path)
+{
+	// 바이너리 형식에는 Partition 블록이 없어서 스트리밍된 객체를 셀과 구분해 둘 수 없음
+	if (currentScene->GetStreamer())
+	{
+		UE_LOG("[Scene] Cannot save a streaming scene as binary; save it as JSON instead");
+		return false;
+	}
+
+	BumpVersionFromSavedScene(path);
+
+	TArray<uint8> bytes;
+	currentScene->SerializeBinary(bytes);
+
+	std::ofstream file(path, std::ios::binary);
+	if (!file)
+	{
+		// Log error: failed to open file
+		return false;
+	}
+	file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+	return true;
+}
+
+
+bool USceneManager::SavePartitionedScene(const FString& path)
+{
+	// 스트리밍 중인 씬은 상주 셀의 객체만 갖고 있고, 그 객체들도 Serialize에서 빠짐
+	if (currentScene->GetStreamer())
+	{
+		UE_LOG("[Streaming] Cannot save a partitioned scene while it is streaming; load the unpartitioned scene and save it again");
+		return false;
+	}
+
+	const float cellSize = ConfigManager::GetConfig("editor")->getFloat("Streaming", "CellSize", 50.0f);
+	return SavePartitionedScene(*currentScene, path, cellSize);
+}
+
+bool USceneManager::SavePartitionedScene(const UScene& scene, const FString& path, float cellSize)
+{
+	const std::filesystem::path fsPath(path);
+	const FString cellDirectoryName = fsPath.stem().string() + ".cells";
+	const std::filesystem::path cellDirectory = fsPath.parent_path() / cellDirectoryName;
+	std::filesystem::create_directories(cellDirectory);
+
+	json::JSON sceneData = scene.Serialize();
+
+	// 프리미티브를 위치(XY)에 따라 셀로 나눔. 레거시 객체는 루트라 Location이 곧 월드 위치
+	TMap<FString, json::JSON> cellDatas;	// 셀 파일 이름 → {"Primitives": ...}
+	TArray<std::pair<int32, int32>> cellCoords;
+	if (sceneData.hasKey("Primitives"))
+	{
+		for (auto& primitive : sceneData["Primitives"].ObjectRange())
+		{
+			const json::JSON& location = primitive.second.at("Location");
+			const int32 x = FSceneStreamer::ToCellCoord(static_cast<float>(location.at(0u).ToFloat()), cellSize);
+			const int32 y = FSceneStreamer::ToCellCoord(static_cast<float>(location.at(1u).ToFloat()), cellSize);
+			const FString cellFileName = FSceneStreamer::GetCellFileName(x, y);
+
+			auto it = cellDatas.find(cellFileName);
+			if (it == cellDatas.end())
+			{
+				it = cellDatas.emplace(cellFileName, json::JSON()).first;
+				cellCoords.push_back({ x, y });
+			}
+			it->second["Primitives"][primitive.first] = primitive.second;
+		}
+	}
+
+	// 메인 파일의 Primitives는 비워 둠 (UScene::Deserialize가 키를 요구함)
+	json::JSON mainData;
+	for (auto& entry : sceneData.ObjectRange())
+	{
+		if (entry.first != "Primitives")
+		{
+			mainData[entry.first] = entry.second;
+		}
+	}
+	mainData["Primitives"] = json::Object();
+
+	json::JSON partition;
+	partition["CellSize"] = cellSize;
+	partition["Directory"] = cellDirectoryName;
+	partition["Cells"] = json::Array();
+	for (const auto& [x, y] : cellCoords)
+	{
+		const FString cellFileName = FSceneStreamer::GetCellFileName(x, y);
+		std::ofstream cellFile(cellDirectory / cellFileName);
+		if (!cellFile)
+		{
+			// Log error: failed to open file
+			return false;
+		}
+		cellFile << cellDatas[cellFileName].dump();
+		partition["Cells"].append(json::Array(x, y));
+	}
+	mainData["Partition"] = partition;
+
+	// 메인 파일은 임시 파일에 다 쓴 뒤 교체. 중간에 실패해도 이전 메인 파일과 그 셀 목록이 남음
+	const std::filesystem::path tempPath = fsPath.string() + ".tmp";
+	{
+		std::ofstream file(tempPath);
+		if (!file)
+		{
+			// Log error: failed to open file
+			return false;
+		}
+		file << mainData.dump();
+		if (!file.flush())
+		{
+			file.close();
+			std::error_code error;
+			std::filesystem::remove(tempPath, error);
+			return false;
+		}
+	}
+
+	std::error_code renameError;
+	std::filesystem::rename(tempPath, fsPath, renameError);
+	if (renameError)
+	{
+		UE_LOG("[Scene] %s: could not replace the scene file (%s)", path.c_str(), renameError.message().c_str());
+		std::error_code error;
+		std::filesystem::remove(tempPath, error);
+		return false;
+	}
+
+	// 새 메인 파일이 자리 잡은 뒤에야 이전 저장에서 남은 셀 중 이번에 쓰지 않은 것을 지움
+	for (const auto& entry : std::filesystem::directory_iterator(cellDirectory))
+	{
+		if (entry.is_regular_file() && entry.path().extension() == ".json" && cellDatas.find(entry.path().filename().string()) == cellDatas.end())
+		{
+			std::error_code error;
+			std::filesystem::remove(entry.path(), error);
+		}
+	}
+	return true;
+}
@@ -13,6 +13,9 @@ class USceneManager : public UEngineSubsystem
 private:
     UApplication* application;
     UScene* currentScene = nullptr;
+
+    // 같은 경로에 저장된 이전 씬(JSON 또는 바이너리)의 Version + 1로 맞춤
+    void BumpVersionFromSavedScene(const FString& path);
 public:
     ~USceneManager() override;
     bool Initialize(UApplication* _application);
@@ -21,7 +24,29 @@ public:
     void SetScene(UScene* scene);
 
     void RequestExit();
+    /** @brief Loads a JSON scene, or a binary one written by SaveSceneBinary (told apart by UScene::BinarySceneMagic). */
     void LoadScene(const FString& path = "");
     void SaveScene(const FString& path = "");
+    /**
+     * @brief Saves the scene through UScene::SerializeBinary; LoadScene reads it back.
+     * @return false (and nothing is written) while the scene is streaming, since the binary form has no Partition block.
+     */
+    bool SaveSceneBinary(const FString& path);
+    /**
+     * @brief Saves the scene as a partitioned world: primitives go to per-cell chunk files in "<name>.cells"
+     *        next to path, the main file keeps everything else plus the "Partition" block.
+     *        Cell files left over from an earlier save to the same path are deleted.
+     * @return false (and nothing is written) while the scene is streaming: objects of cells that are not
+     *         resident are not in the scene, so re-partitioning it would drop them.
+     */
+    bool SavePartitionedScene(const FString& path);
+    /**
+     * @brief Partitions scene into path with the given cell size; what SavePartitionedScene does once the checks pass.
+     * @note: Cell files are written first, then the main file through "<path>.tmp" and a rename, and stale cells
+     *        are deleted last, so a save that fails part way leaves the previous main file and its cells loadable.
+     */
+    static bool SavePartitionedScene(const UScene& scene, const FString& path, float cellSize);
+
+    void AddReferencedObjects(FReferenceCollector& collector) override;
 };
 
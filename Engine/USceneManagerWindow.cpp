@@ -3,6 +3,7 @@
 #include "EditorApplication.h"
 #include "USceneManagerWindow.h"
 #include "AActor.h"
+#include "UPrimitiveComponent.h"
 
 void USceneManagerWindow::RenderContent()
 {
@@ -47,10 +48,11 @@ void USceneManagerWindow::RenderContent()
 	}
 
 	// Display legacy objects (components not owned by actors)
+	// 씬의 객체 목록은 추가 순서를 유지하므로 프레임마다 같은 순서로 그려짐
 	bool hasLegacyObjects = false;
-	for (const auto& Object : Scene->GetObjects())
+	for (USceneComponent* object : Scene->GetObjects())
 	{
-		auto Component = Object->Cast<UPrimitiveComponent>();
+		UPrimitiveComponent* Component = object ? object->Cast<UPrimitiveComponent>() : nullptr;
 		if (!Component || !Component->IsManageable())
 		{
 			continue;
@@ -73,4 +75,4 @@ void USceneManagerWindow::RenderContent()
 			}
 		}
 	}
-}
+}
\ No newline at end of file
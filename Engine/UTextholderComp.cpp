@@ -61,11 +61,32 @@ void UTextholderComp::SetText(const FString& textContent)
 
 // ====================================================== //
 
+bool UTextholderComp::GetWorldBounds(FAABB& outBounds) const
+{
+	if (!mesh || !mesh->GetLocalBounds().IsValid())
+		return false;
+
+	// UpdateConstantBuffer와 같은 기준점 (부모 위 1 유닛, 부모의 회전/스케일 무시)
+	USceneComponent* parent = parentTransform.Get();
+	const FVector anchor = parent ?
+		parent->GetWorldLocation() + FVector(0.0f, 0.0f, 1.0f) :
+		GetWorldLocation();
+
+	// 글자 쿼드 하나를 감싸는 원점 기준 반경 + 중앙 정렬된 글자열 너비의 절반
+	const float glyphRadius = mesh->GetLocalSphereCenter().Length() + mesh->GetLocalSphereRadius();
+	const float halfWidth = TextInfo.orderOfChar.size() * TextInfo.cellWidth * 0.01f * 0.5f;
+	const float radius = glyphRadius + halfWidth;
+
+	outBounds = FAABB(anchor - FVector(radius, radius, radius), anchor + FVector(radius, radius, radius));
+	return true;
+}
+
 void UTextholderComp::UpdateConstantBuffer(URenderer& renderer)
 {
 	// Calculate independent transform without parent's rotation/scale influence
-	FVector worldPosition = parentTransform ?
-		parentTransform->GetWorldLocation() + FVector(0.0f, 0.0f, 1.0f) :
+	USceneComponent* parent = parentTransform.Get();
+	FVector worldPosition = parent ?
+		parent->GetWorldLocation() + FVector(0.0f, 0.0f, 1.0f) :
 		GetWorldLocation();
 
 	// Create independent transform matrix with billboard rotation and fixed scale
@@ -78,13 +99,13 @@ void UTextholderComp::UpdateConstantBuffer(URenderer& renderer)
 	FMatrix MVP = independentTransform * renderer.GetViewProj();
 	(*vertexShader)["ConstantBuffer"]["MVP"] = MVP;
 	(*vertexShader)["ConstantBuffer"]["MeshColor"] = Color;
-	vertexShader->BindConstantBuffer(renderer.GetDeviceContext(), "ConstantBuffer");
+	vertexShader->BindConstantBuffer(renderer.GetRHI(), "ConstantBuffer");
 }
 
 void UTextholderComp::BindVertexShader(URenderer& renderer)
 {
 	//renderer.GetDeviceContext()->IASetInputLayout(vertexShader->GetInputLayout());
-	vertexShader->Bind(renderer.GetDeviceContext(), "ConstantBuffer");
+	vertexShader->Bind(renderer.GetRHI(), "ConstantBuffer");
 }
 
 void UTextholderComp::BindPixelShader(URenderer& renderer)
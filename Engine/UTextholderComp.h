@@ -2,6 +2,7 @@
 #include "stdafx.h"
 #include "UObjectMacros.h"
 #include "UPrimitiveComponent.h"
+#include "TWeakObjectPtr.h"
 
 struct FTextInstance
 {
@@ -49,9 +50,14 @@ public:
 
 	virtual void BindPixelShader(URenderer& renderer) override;
 
+	virtual bool CanBeInstanced() const override { return false; }
+
 	virtual void Update(float deltaTime) override;
 	virtual void Draw(URenderer& renderer) override;
 
+	/** @brief Cube around the billboard anchor that holds the text at any camera orientation. */
+	virtual bool GetWorldBounds(FAABB& outBounds) const override;
+
 	virtual LayerID GetLayer() const { return 0;  }
 
 	// todo : 추후 textholder도 gizmo 필요하면 추가 구현
@@ -62,7 +68,7 @@ private:
 	// Hold those two subsystem due to caching
 	UTextureManager* cachedTextureManager;
 	UInputManager* cachedInputManager;
-	USceneComponent* parentTransform;
+	TWeakObjectPtr<USceneComponent> parentTransform;
 	//  TODO : pointer로 들고 있기
 	FTextInfo TextInfo;
 
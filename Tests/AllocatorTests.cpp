@@ -0,0 +1,109 @@
+﻿#include "stdafx.h"
+#include "TestFramework.h"
+#include "FObjectAllocator.h"
+#include <random>
+
+ENGINE_TEST(FObjectAllocator_ReturnsCacheLineAlignedBlocks)
+{
+	FObjectAllocator& Allocator = FObjectAllocator::Get();
+	const size_t LiveBefore = Allocator.GetLiveBlockCount();
+
+	TArray<std::pair<void*, size_t>> Blocks;
+	for (size_t Size : { 1, 63, 64, 65, 200, 512, 2048 })
+	{
+		void* Block = Allocator.Allocate(Size);
+		CHECK(reinterpret_cast<uintptr_t>(Block) % FObjectAllocator::CacheLineSize == 0);
+		memset(Block, 0xCD, Size);
+		Blocks.emplace_back(Block, Size);
+	}
+	CHECK(Allocator.GetLiveBlockCount() == LiveBefore + Blocks.size());
+
+	for (const auto& [Block, Size] : Blocks)
+	{
+		Allocator.Free(Block, Size);
+	}
+	CHECK(Allocator.GetLiveBlockCount() == LiveBefore);
+}
+
+ENGINE_TEST(FObjectAllocator_ReusesFreedBlockOfSameSizeClass)
+{
+	FObjectAllocator& Allocator = FObjectAllocator::Get();
+
+	void* First = Allocator.Allocate(300);
+	Allocator.Free(First, 300);
+	// 300과 320은 같은 크기 클래스(5줄)이므로 방금 반환된 블록이 다시 나옴
+	void* Second = Allocator.Allocate(320);
+	CHECK(First == Second);
+	Allocator.Free(Second, 320);
+}
+
+ENGINE_TEST(FObjectAllocator_LargeObjectsBypassPool)
+{
+	FObjectAllocator& Allocator = FObjectAllocator::Get();
+	const size_t LargeBefore = Allocator.GetLargeAllocationCount();
+	const size_t LiveBefore = Allocator.GetLiveBlockCount();
+
+	void* Block = Allocator.Allocate(FObjectAllocator::MaxPooledSize + 1);
+	CHECK(reinterpret_cast<uintptr_t>(Block) % FObjectAllocator::CacheLineSize == 0);
+	CHECK(Allocator.GetLargeAllocationCount() == LargeBefore + 1);
+	CHECK(Allocator.GetLiveBlockCount() == LiveBefore);
+	Allocator.Free(Block, FObjectAllocator::MaxPooledSize + 1);
+}
+
+namespace
+{
+	/**
+	 * @brief Keeps NumLive objects of component-like sizes alive and replaces a random one NumOps times.
+	 * @return Sum of block addresses, so the optimizer has to keep every allocation.
+	 */
+	template<typename TAllocate, typename TFree>
+	uint64 RunChurn(uint32 NumLive, uint32 NumOps, TAllocate&& Allocate, TFree&& Free)
+	{
+		// 컴포넌트, 텍스트홀더, 액터 크기대를 흉내냄
+		static constexpr size_t Sizes[] = { 176, 240, 368, 512, 720, 904 };
+
+		std::mt19937 Random(7);
+		TArray<std::pair<void*, size_t>> Live(NumLive);
+		uint64 Sum = 0;
+		for (auto& Entry : Live)
+		{
+			Entry.second = Sizes[Random() % std::size(Sizes)];
+			Entry.first = Allocate(Entry.second);
+		}
+		for (uint32 i = 0; i < NumOps; ++i)
+		{
+			auto& Entry = Live[Random() % NumLive];
+			Free(Entry.first, Entry.second);
+			Entry.second = Sizes[Random() % std::size(Sizes)];
+			Entry.first = Allocate(Entry.second);
+			Sum += reinterpret_cast<uintptr_t>(Entry.first);
+		}
+		for (auto& Entry : Live)
+		{
+			Free(Entry.first, Entry.second);
+		}
+		return Sum;
+	}
+}
+
+ENGINE_BENCHMARK(FObjectAllocator_SpawnDestroyChurn)
+{
+	constexpr uint32 NumOps = 2000000;
+	for (uint32 NumLive : { 1000u, 100000u })
+	{
+		const FString Suffix = " (" + std::to_string(NumLive) + " live, 2M ops)";
+
+		ReportTime(("pooled FObjectAllocator" + Suffix).c_str(), MeasureMs(3, [NumLive] {
+			FObjectAllocator& Allocator = FObjectAllocator::Get();
+			KeepResult(RunChurn(NumLive, NumOps,
+				[&Allocator](size_t Size) { return Allocator.Allocate(Size); },
+				[&Allocator](void* Ptr, size_t Size) { Allocator.Free(Ptr, Size); }));
+		}));
+
+		ReportTime(("global operator new" + Suffix).c_str(), MeasureMs(3, [NumLive] {
+			KeepResult(RunChurn(NumLive, NumOps,
+				[](size_t Size) { return ::operator new(Size); },
+				[](void* Ptr, size_t) { ::operator delete(Ptr); }));
+		}));
+	}
+}
@@ -0,0 +1,276 @@
+﻿#include "stdafx.h"
+#include "TestFramework.h"
+#include "UBatchRenderer.h"
+#include "UPrimitiveComponent.h"
+#include "FRecordingCommandContext.h"
+#include "ConfigManager.h"
+#include "SceneTestUtils.h"
+
+namespace
+{
+	/** @brief Sets editor.ini [Graphics] values for one test and puts the old ones back afterwards. */
+	class FScopedGraphicsConfig
+	{
+	public:
+		FScopedGraphicsConfig(const FString& Key, const FString& Value)
+		{
+			Set(Key, Value);
+		}
+
+		~FScopedGraphicsConfig()
+		{
+			for (auto It = Saved.rbegin(); It != Saved.rend(); ++It)
+			{
+				ConfigManager::GetConfig("editor")->setString("Graphics", It->first, It->second);
+			}
+		}
+
+		void Set(const FString& Key, const FString& Value)
+		{
+			ConfigData* Config = ConfigManager::GetConfig("editor");
+			Saved.emplace_back(Key, Config->getString("Graphics", Key));
+			Config->setString("Graphics", Key, Value);
+		}
+
+	private:
+		TArray<std::pair<FString, FString>> Saved;
+	};
+
+	/** @brief "ConstantBuffer" as DefaultVS.hlsl declares it; the instanced variant only keeps MVP (= View * Projection). */
+	TArray<std::pair<FString, UBufferElementLayout>> MakeMeshConstants(bool bInstanced)
+	{
+		UBufferElementLayout Layout;
+		Layout.Append<HLSL::EType::Matrix>("MVP");
+		if (!bInstanced)
+		{
+			Layout.Append<HLSL::EType::Float4>("MeshColor");
+			Layout.Append<HLSL::EType::Bool>("IsSelected");
+		}
+
+		TArray<std::pair<FString, UBufferElementLayout>> ConstantBuffers;
+		ConstantBuffers.emplace_back("ConstantBuffer", std::move(Layout));
+		return ConstantBuffers;
+	}
+
+	/** @brief Meshes and shaders like the ones UMeshManager and URenderer load, with placeholder buffers from a headless RHI. */
+	struct FHeadlessAssets
+	{
+		explicit FHeadlessAssets(URenderer& Renderer)
+			: IndexedMesh(0, TArray<FVertexPosColorUV4>(8), TArray<uint32>(36))
+			, Mesh(1, TArray<FVertexPosColorUV4>(6))
+			, VertexShader(1, EShaderType::VertexShader, MakeMeshConstants(false))
+			, InstancedVertexShader(2, EShaderType::VertexShader, MakeMeshConstants(true))
+			, PixelShader(1, EShaderType::PixelShader, {})
+		{
+			for (UMesh* Each : { &IndexedMesh, &Mesh })
+			{
+				D3D11_BUFFER_DESC Desc = {};
+				Desc.ByteWidth = static_cast<UINT>(sizeof(FVertexPosColorUV4) * Each->NumVertices);
+				Desc.Usage = D3D11_USAGE_IMMUTABLE;
+				Desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+				Each->VertexBuffer = Renderer.GetRHI().CreateBuffer(Desc, nullptr);
+			}
+
+			D3D11_BUFFER_DESC IndexDesc = {};
+			IndexDesc.ByteWidth = static_cast<UINT>(sizeof(uint32) * IndexedMesh.NumIndices);
+			IndexDesc.Usage = D3D11_USAGE_IMMUTABLE;
+			IndexDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
+			IndexedMesh.IndexBuffer = Renderer.GetRHI().CreateBuffer(IndexDesc, nullptr);
+
+			VertexShader.SetInstancedVariant(&InstancedVertexShader);
+		}
+
+		UMesh IndexedMesh;
+		UMesh Mesh;
+		UShader VertexShader;
+		UShader InstancedVertexShader;
+		UShader PixelShader;
+	};
+
+	/** @brief Primitive drawing the given mesh with the given shaders, without the mesh manager. */
+	class UTestMeshPrimitive : public UPrimitiveComponent
+	{
+	public:
+		UTestMeshPrimitive(UMesh* InMesh, FHeadlessAssets& Assets, const FVector& Location = FVector(0, 0, 0))
+			: UPrimitiveComponent(Location)
+		{
+			mesh = InMesh;
+			vertexShader = &Assets.VertexShader;
+			pixelShader = &Assets.PixelShader;
+		}
+	};
+}
+
+ENGINE_TEST(UBatchRenderer_HeadlessFrameDrawsAndSwitchesState)
+{
+	FScopedGraphicsConfig Config("BatchRendering", "true");
+	Config.Set("Instancing", "true");
+	Config.Set("MinInstanceBatch", "2");
+
+	UBatchRenderer Renderer;
+	CHECK(Renderer.InitializeHeadless(800, 600));
+	FRecordingCommandContext* Recorder = Renderer.GetCommandRecorder();
+	CHECK(Recorder != nullptr);
+	CHECK(Recorder->GetTarget() == nullptr);
+
+	FHeadlessAssets Assets(Renderer);
+	TArray<TUniquePtr<UTestMeshPrimitive>> Components;
+	for (int32 i = 0; i < 3; ++i)
+	{
+		Components.push_back(MakeUnique<UTestMeshPrimitive>(&Assets.IndexedMesh, Assets, FVector(static_cast<float>(i), 0, 0)));
+	}
+	Components.push_back(MakeUnique<UTestMeshPrimitive>(&Assets.Mesh, Assets));
+
+	auto DrawFrame = [&]
+	{
+		Renderer.Prepare();
+		Renderer.SetViewProj(FMatrix::Identity, FMatrix::Identity);
+		for (const auto& Component : Components)
+		{
+			Renderer.DrawPrimitiveComponent(Component.get());
+		}
+		Renderer.Draw();
+	};
+
+	// 메시 ID가 큰 쪽부터 그림: 단독 메시는 하나씩, 같은 키 셋은 인스턴스 한 번
+	const uint64 DrawCallsBefore = Renderer.GetDrawCallCount();
+	const uint64 MeshSwitchesBefore = Renderer.GetMeshSwitchCount();
+	const uint64 VertexShaderSwitchesBefore = Renderer.GetVertexShaderSwitchCount();
+	const uint64 PixelShaderSwitchesBefore = Renderer.GetPixelShaderSwitchCount();
+	const uint64 ClearsBefore = Renderer.GetDepthStencilViewClearCount();
+	DrawFrame();
+
+	CHECK(Recorder->GetNumDrawCalls() == 2);
+	CHECK(Recorder->GetCommandCount(ERHICommandType::Draw) == 1);
+	CHECK(Recorder->GetCommandCount(ERHICommandType::DrawIndexedInstanced) == 1);
+	CHECK(Recorder->GetCommandCount(ERHICommandType::SetVertexShader) == 2);
+	CHECK(Recorder->GetCommandCount(ERHICommandType::SetPixelShader) == 1);
+	// 메시 두 번 + 인스턴스 버퍼(슬롯 1) 한 번
+	CHECK(Recorder->GetCommandCount(ERHICommandType::SetVertexBuffers) == 3);
+	CHECK(Recorder->GetCommandCount(ERHICommandType::SetIndexBuffer) == 1);
+	// 레이어 시작 한 번 + 텍스트홀더 전 한 번
+	CHECK(Recorder->GetCommandCount(ERHICommandType::ClearDepthStencil) == 2);
+	CHECK(Recorder->GetCommandCount(ERHICommandType::WriteDynamicBuffer) == 1);
+	CHECK(Recorder->GetNumBuffersCreated() == 1);
+
+	CHECK(Renderer.GetDrawCallCount() - DrawCallsBefore == 2);
+	CHECK(Renderer.GetMeshSwitchCount() - MeshSwitchesBefore == 2);
+	CHECK(Renderer.GetVertexShaderSwitchCount() - VertexShaderSwitchesBefore == 2);
+	CHECK(Renderer.GetPixelShaderSwitchCount() - PixelShaderSwitchesBefore == 1);
+	CHECK(Renderer.GetDepthStencilViewClearCount() - ClearsBefore == 1);
+
+	// 같은 프레임을 다시 그리면 명령은 같고 인스턴스 버퍼는 재사용됨
+	DrawFrame();
+	CHECK(Recorder->GetNumDrawCalls() == 2);
+	CHECK(Recorder->GetCommandCount(ERHICommandType::SetVertexShader) == 2);
+	CHECK(Recorder->GetNumBuffersCreated() == 0);
+
+	// 인스턴싱을 끄면 프리미티브마다 한 번씩 그리고 셰이더는 한 번만 바뀜
+	Config.Set("Instancing", "false");
+	DrawFrame();
+	CHECK(Recorder->GetNumDrawCalls() == 4);
+	CHECK(Recorder->GetCommandCount(ERHICommandType::DrawIndexed) == 3);
+	CHECK(Recorder->GetCommandCount(ERHICommandType::Draw) == 1);
+	CHECK(Recorder->GetCommandCount(ERHICommandType::SetVertexShader) == 1);
+	CHECK(Recorder->GetCommandCount(ERHICommandType::SetPixelShader) == 1);
+	CHECK(Recorder->GetCommandCount(ERHICommandType::SetVertexBuffers) == 2);
+	CHECK(Recorder->GetCommandCount(ERHICommandType::UpdateBuffer) == 4);
+	CHECK(Recorder->GetCommandCount(ERHICommandType::WriteDynamicBuffer) == 0);
+}
+
+ENGINE_TEST(UBatchRenderer_DrawPacketCacheRebuildsOnlyWhenNeeded)
+{
+	FScopedGraphicsConfig Config("BatchRendering", "true");
+
+	UBatchRenderer Renderer;
+	CHECK(Renderer.InitializeHeadless(800, 600));
+	FHeadlessAssets Assets(Renderer);
+	UTestScene Scene;
+
+	// 씬에 등록된 프리미티브는 씬이 움직임을 알려주므로 패킷을 재사용할 수 있음
+	TArray<UTestMeshPrimitive*> Tracked;
+	for (int32 i = 0; i < 3; ++i)
+	{
+		Tracked.push_back(new UTestMeshPrimitive(&Assets.IndexedMesh, Assets, FVector(static_cast<float>(i), 0, 0)));
+		Scene.AddTestObject(Tracked.back());
+	}
+	UTestMeshPrimitive* Untracked = new UTestMeshPrimitive(&Assets.Mesh, Assets);
+
+	auto DrawFrame = [&](std::initializer_list<UPrimitiveComponent*> Extra = {})
+	{
+		Renderer.Prepare();
+		Renderer.SetViewProj(FMatrix::Identity, FMatrix::Identity);
+		for (UTestMeshPrimitive* Component : Tracked)
+		{
+			Renderer.DrawPrimitiveComponent(Component);
+		}
+		for (UPrimitiveComponent* Component : Extra)
+		{
+			Renderer.DrawPrimitiveComponent(Component);
+		}
+		Renderer.Draw();
+	};
+
+	DrawFrame();
+	CHECK(Renderer.GetDrawPacketBuildCount() == 3);
+	CHECK(Renderer.GetNumDrawPackets() == 3);
+	CHECK(Renderer.GetNumFreeDrawPackets() == 0);
+	for (UTestMeshPrimitive* Component : Tracked)
+	{
+		CHECK(!Component->IsRenderStateDirty());
+	}
+
+	// 바뀐 것이 없으면 다시 만들지 않음
+	DrawFrame();
+	CHECK(Renderer.GetDrawPacketBuildCount() == 3);
+
+	// 더티 표시된 것만 다시 만듦
+	Tracked[1]->SetColor(FVector4(1, 0, 0, 1));
+	CHECK(Tracked[1]->IsRenderStateDirty());
+	DrawFrame();
+	CHECK(Renderer.GetDrawPacketBuildCount() == 4);
+	CHECK(!Tracked[1]->IsRenderStateDirty());
+
+	// 선택이 바뀌면 더티 표시 없이도 다시 만들고, 그다음 프레임은 재사용
+	Tracked[2]->bIsSelected = true;
+	DrawFrame();
+	CHECK(Renderer.GetDrawPacketBuildCount() == 5);
+	DrawFrame();
+	CHECK(Renderer.GetDrawPacketBuildCount() == 5);
+	Tracked[2]->bIsSelected = false;
+	DrawFrame();
+	CHECK(Renderer.GetDrawPacketBuildCount() == 6);
+
+	// 씬 밖의 프리미티브는 움직여도 알 수 없으므로 제출할 때마다 다시 만듦
+	DrawFrame({ Untracked });
+	DrawFrame({ Untracked });
+	CHECK(Renderer.GetDrawPacketBuildCount() == 8);
+	CHECK(Renderer.GetNumDrawPackets() == 4);
+
+	// 반환한 패킷은 free list로 가고, 다시 제출하면 같은 자리를 받아 새로 만듦
+	Renderer.ReleasePrimitiveCache(Tracked[0]);
+	CHECK(Renderer.GetNumFreeDrawPackets() == 1);
+	CHECK(Tracked[0]->IsRenderStateDirty());
+	Renderer.ReleasePrimitiveCache(Tracked[0]);
+	CHECK(Renderer.GetNumFreeDrawPackets() == 1);
+	DrawFrame();
+	CHECK(Renderer.GetDrawPacketBuildCount() == 9);
+	CHECK(Renderer.GetNumDrawPackets() == 4);
+	CHECK(Renderer.GetNumFreeDrawPackets() == 0);
+
+	// 씬에 없는 프리미티브도 소멸하면 패킷을 가진 렌더러(DrawPacketOwner)에 돌려주고, 새 프리미티브가 그 자리를 씀
+	delete Untracked;
+	CHECK(Renderer.GetNumFreeDrawPackets() == 1);
+	UTestMeshPrimitive* Replacement = new UTestMeshPrimitive(&Assets.Mesh, Assets);
+	DrawFrame({ Replacement });
+	CHECK(Renderer.GetNumDrawPackets() == 4);
+	CHECK(Renderer.GetNumFreeDrawPackets() == 0);
+	CHECK(Renderer.GetCommandRecorder()->GetNumDrawCalls() == 2);
+	delete Replacement;
+
+	// 씬의 프리미티브도 소멸할 때 반환함
+	Scene.ForgetObject(Tracked[2]);
+	delete Tracked[2];
+	Tracked.pop_back();
+	CHECK(Renderer.GetNumFreeDrawPackets() == 2);
+}
@@ -0,0 +1,187 @@
+﻿#include "stdafx.h"
+#include "TestFramework.h"
+#include "FDynamicBitset.h"
+#include <random>
+
+ENGINE_TEST(FDynamicBitset_RangesCountsAndIteration)
+{
+	// 인라인(128비트) 안에서 시작해 힙으로 넘어가는 경우까지
+	FDynamicBitset Bits;
+	Bits.Set(3);
+	Bits.Set(127);
+	CHECK(Bits.NumWords() == FDynamicBitset::InlineWords);
+	Bits.SetRange(100, 1000);
+	CHECK(Bits.Test(3) && Bits.Test(100) && Bits.Test(999) && !Bits.Test(1000) && !Bits.Test(99));
+	CHECK(Bits.Count() == 901);
+
+	Bits.ResetRange(200, 263);
+	CHECK(!Bits.Test(200) && !Bits.Test(262) && Bits.Test(263) && Bits.Test(199));
+	CHECK(Bits.Count() == 901 - 63);
+
+	TArray<size_t> Visited;
+	Bits.ForEachSetBit([&Visited](size_t Index) { Visited.push_back(Index); });
+	CHECK(Visited.size() == Bits.Count());
+	CHECK(std::is_sorted(Visited.begin(), Visited.end()));
+
+	size_t Index = 0;
+	for (FConstSetBitIterator It(Bits); It; ++It, ++Index)
+	{
+		CHECK(It.GetIndex() == Visited[Index]);
+	}
+	CHECK(Index == Visited.size());
+	CHECK(Bits.FindNextSetBit(4) == 100);
+	CHECK(Bits.FindNextSetBit(1000) == FDynamicBitset::NoIndex);
+}
+
+ENGINE_TEST(FDynamicBitset_BulkOperatorsMatchPerBitReference)
+{
+	// AVX2를 지원하는 CPU에서는 AVX2와 SSE2 경로를 모두 확인
+	const bool bUseAVX2 = FBitOps::bUseAVX2;
+	for (bool bAVX2 : { false, FBitOps::HasAVX2() })
+	{
+		FBitOps::bUseAVX2 = bAVX2;
+
+		// 벡터 경로의 꼬리 처리를 보려고 워드 수가 4/2의 배수가 아닌 크기를 사용
+		constexpr size_t NumBits = 64 * 37 + 5;
+		std::mt19937 Random(11);
+		FDynamicBitset A, B;
+		TArray<bool> RefA(NumBits), RefB(NumBits);
+		for (size_t i = 0; i < NumBits; ++i)
+		{
+			if (Random() % 3 == 0) { A.Set(i); RefA[i] = true; }
+			if (Random() % 2 == 0) { B.Set(i); RefB[i] = true; }
+		}
+
+		FDynamicBitset And = A, Or = A, Xor = A, AndNot = A;
+		And &= B;
+		Or |= B;
+		Xor ^= B;
+		AndNot.AndNot(B);
+		for (size_t i = 0; i < NumBits; ++i)
+		{
+			CHECK(And.Test(i) == (RefA[i] && RefB[i]));
+			CHECK(Or.Test(i) == (RefA[i] || RefB[i]));
+			CHECK(Xor.Test(i) == (RefA[i] != RefB[i]));
+			CHECK(AndNot.Test(i) == (RefA[i] && !RefB[i]));
+		}
+		size_t ExpectedAndCount = 0;
+		for (size_t i = 0; i < NumBits; ++i)
+		{
+			ExpectedAndCount += (RefA[i] && RefB[i]) ? 1 : 0;
+		}
+		CHECK(And.Count() == ExpectedAndCount);
+
+		// Any: 4워드 묶음 안의 비트, 2워드 꼬리의 비트, 마지막 한 워드의 비트
+		for (size_t Bit : { size_t(64 * 5 + 7), size_t(64 * 33 + 1), NumBits - 1 })
+		{
+			FDynamicBitset One;
+			One.Resize(NumBits / 64 + 1);
+			CHECK(!One.Any());
+			One.Set(Bit);
+			CHECK(One.Any());
+		}
+	}
+	FBitOps::bUseAVX2 = bUseAVX2;
+}
+
+namespace
+{
+	constexpr size_t NumPrimitives = 131072;
+
+	FDynamicBitset MakeRandomMask(uint32 Seed, uint32 OneIn)
+	{
+		std::mt19937 Random(Seed);
+		FDynamicBitset Bits;
+		Bits.Resize(NumPrimitives / 64);
+		for (size_t i = 0; i < NumPrimitives; ++i)
+		{
+			if (Random() % OneIn == 0) Bits.Set(i);
+		}
+		return Bits;
+	}
+}
+
+ENGINE_BENCHMARK(FDynamicBitset_VisibilityMask128k)
+{
+	// 128k 프리미티브 마스크를 프레임마다 다루는 상황: 1000번 반복
+	constexpr int32 NumPasses = 1000;
+	const FDynamicBitset Visible = MakeRandomMask(1, 2);
+	const FDynamicBitset Dirty = MakeRandomMask(2, 100);
+
+	ReportTime("&= scalar word loop (old), 128k bits x1000", MeasureMs(3, [&] {
+		FDynamicBitset Result = Visible;
+		for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+		{
+			uint64* Words = Result.GetData();
+			const uint64* Other = Dirty.GetData();
+			for (size_t i = 0; i < Result.NumWords(); ++i)
+				Words[i] &= Other[i];
+		}
+		KeepResult(Result.GetData()[0]);
+	}));
+	ReportTime("&= FBitOps, 128k bits x1000", MeasureMs(3, [&] {
+		FDynamicBitset Result = Visible;
+		for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+			Result &= Dirty;
+		KeepResult(Result.GetData()[0]);
+	}));
+	const bool bUseAVX2 = FBitOps::bUseAVX2;
+	FBitOps::bUseAVX2 = false;
+	ReportTime("&= FBitOps SSE2 only, 128k bits x1000", MeasureMs(3, [&] {
+		FDynamicBitset Result = Visible;
+		for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+			Result &= Dirty;
+		KeepResult(Result.GetData()[0]);
+	}));
+	FBitOps::bUseAVX2 = bUseAVX2;
+	ReportTime("Count(), 128k bits x1000", MeasureMs(3, [&] {
+		uint64 Sum = 0;
+		for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+			Sum += Visible.Count();
+		KeepResult(Sum);
+	}));
+
+	for (const auto& [Label, Mask] : { std::make_pair("50%", &Visible), std::make_pair("1%", &Dirty) })
+	{
+		ReportTime((FString("Test() every bit, ") + Label + " set x1000").c_str(), MeasureMs(3, [Mask = Mask] {
+			uint64 Sum = 0;
+			for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+			{
+				for (size_t i = 0; i < NumPrimitives; ++i)
+					if (Mask->Test(i)) Sum += i;
+			}
+			KeepResult(Sum);
+		}));
+		ReportTime((FString("ForEachSetBit, ") + Label + " set x1000").c_str(), MeasureMs(3, [Mask = Mask] {
+			uint64 Sum = 0;
+			for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+				Mask->ForEachSetBit([&Sum](size_t Index) { Sum += Index; });
+			KeepResult(Sum);
+		}));
+	}
+
+	ReportTime("Set() per bit over 100k range x1000", MeasureMs(3, [] {
+		FDynamicBitset Bits;
+		uint64 Sum = 0;
+		for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+		{
+			for (size_t i = 1000; i < 101000; ++i)
+				Bits.Set(i);
+			Sum += Bits.GetData()[16 + Pass % 1500];
+			Bits.Clear();
+		}
+		KeepResult(Sum);
+	}));
+	ReportTime("SetRange over 100k range x1000", MeasureMs(3, [] {
+		FDynamicBitset Bits;
+		uint64 Sum = 0;
+		for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+		{
+			Bits.SetRange(1000, 101000);
+			// 매 반복 값을 읽어서 채우기가 Clear에 가려 제거되지 않게 함
+			Sum += Bits.GetData()[16 + Pass % 1500];
+			Bits.Clear();
+		}
+		KeepResult(Sum);
+	}));
+}
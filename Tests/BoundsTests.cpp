@@ -0,0 +1,253 @@
+﻿#include "stdafx.h"
+#include "TestFramework.h"
+#include "FBounds.h"
+#include "Quaternion.h"
+#include <cmath>
+#include <random>
+
+namespace
+{
+	/** @brief Orthographic view-projection whose planes are x = ±128, y = ±64, z = 0 and z = 256 (powers of two, so extraction is exact). */
+	FMatrix MakeExactOrthoViewProj()
+	{
+		return FMatrix::Scale(1.0f / 128.0f, 1.0f / 64.0f, 1.0f / 256.0f);
+	}
+
+	FMatrix MakePerspectiveViewProj()
+	{
+		const FMatrix View = FMatrix::LookAtLHRow(FVector(-5, 2, 3), FVector(10, 0, 0), FVector(0, 0, 1));
+		const FMatrix Proj = FMatrix::PerspectiveFovLHRow(60.0f * DegreeToRadian, 16.0f / 9.0f, 0.5f, 200.0f);
+		return View * Proj;
+	}
+
+	float PlaneDistance(const FVector4& Plane, const FVector& Point)
+	{
+		return Plane.X * Point.X + Plane.Y * Point.Y + Plane.Z * Point.Z + Plane.W;
+	}
+
+	FAABB MakeBox(const FVector& Center, const FVector& Extent)
+	{
+		return FAABB(Center - Extent, Center + Extent);
+	}
+
+	/**
+	 * @brief Random boxes around the frustum, plus boxes whose support point or center sits on a plane
+	 *        (points projected onto the plane, with and without extent).
+	 */
+	TArray<FAABB> MakeTestBoxes(const FFrustum& Frustum, std::mt19937& Random, int32 NumRandom)
+	{
+		std::uniform_real_distribution<float> Position(-250.0f, 250.0f);
+		std::uniform_real_distribution<float> Size(0.0f, 20.0f);
+		TArray<FAABB> Boxes;
+		for (int32 i = 0; i < NumRandom; ++i)
+		{
+			Boxes.push_back(MakeBox(FVector(Position(Random), Position(Random), Position(Random)), FVector(Size(Random), Size(Random), Size(Random))));
+		}
+
+		for (const FVector4& Plane : Frustum.Planes)
+		{
+			for (int32 i = 0; i < NumRandom / 8; ++i)
+			{
+				const FVector Point(Position(Random), Position(Random), Position(Random));
+				const float Distance = PlaneDistance(Plane, Point);
+				const FVector OnPlane(Point.X - Distance * Plane.X, Point.Y - Distance * Plane.Y, Point.Z - Distance * Plane.Z);
+				const FVector Extent(Size(Random), Size(Random), Size(Random));
+				const float Radius = fabsf(Plane.X) * Extent.X + fabsf(Plane.Y) * Extent.Y + fabsf(Plane.Z) * Extent.Z;
+
+				// 점, 중심이 평면 위, 바깥쪽 면이 평면에 닿음, 안쪽 면이 평면에 닿음
+				Boxes.push_back(MakeBox(OnPlane, FVector(0, 0, 0)));
+				Boxes.push_back(MakeBox(OnPlane, Extent));
+				Boxes.push_back(MakeBox(FVector(OnPlane.X - Radius * Plane.X, OnPlane.Y - Radius * Plane.Y, OnPlane.Z - Radius * Plane.Z), Extent));
+				Boxes.push_back(MakeBox(FVector(OnPlane.X + Radius * Plane.X, OnPlane.Y + Radius * Plane.Y, OnPlane.Z + Radius * Plane.Z), Extent));
+			}
+		}
+		return Boxes;
+	}
+
+	/** @brief Feeds Boxes through TestAABBs in batches of 1..8 and counts lanes that disagree with TestAABB. */
+	int32 CountBatchMismatches(const FFrustum& Frustum, const TArray<FAABB>& Boxes, std::mt19937& Random)
+	{
+		int32 Mismatches = 0;
+		FAABBBatch Batch;
+		size_t Next = 0;
+		while (Next < Boxes.size())
+		{
+			Batch.Reset();
+			const uint32 BatchSize = 1 + Random() % FAABBBatch::Capacity;
+			for (uint32 i = 0; i < BatchSize && Next < Boxes.size(); ++i, ++Next)
+			{
+				Batch.Add(Boxes[Next], static_cast<int32>(Next));
+			}
+
+			const uint32 Bits = Frustum.TestAABBs(Batch);
+			for (uint32 Lane = 0; Lane < FAABBBatch::Capacity; ++Lane)
+			{
+				const bool bExpected = Lane < Batch.Count && Frustum.TestAABB(Boxes[Batch.Ids[Lane]]) != FFrustum::EContainment::Outside;
+				Mismatches += ((Bits >> Lane) & 1u) != static_cast<uint32>(bExpected);
+			}
+		}
+		return Mismatches;
+	}
+}
+
+ENGINE_TEST(FFrustum_FromViewProjExtractsPlanes)
+{
+	// 직교 투영: 평면이 정확히 나와야 함
+	const FFrustum Ortho = FFrustum::FromViewProj(MakeExactOrthoViewProj());
+	auto Equals = [](const FVector4& A, const FVector4& B) { return A.X == B.X && A.Y == B.Y && A.Z == B.Z && A.W == B.W; };
+	CHECK(Equals(Ortho.Planes[FFrustum::Left], FVector4(1, 0, 0, 128)));
+	CHECK(Equals(Ortho.Planes[FFrustum::Right], FVector4(-1, 0, 0, 128)));
+	CHECK(Equals(Ortho.Planes[FFrustum::Bottom], FVector4(0, 1, 0, 64)));
+	CHECK(Equals(Ortho.Planes[FFrustum::Top], FVector4(0, -1, 0, 64)));
+	CHECK(Equals(Ortho.Planes[FFrustum::Near], FVector4(0, 0, 1, 0)));
+	CHECK(Equals(Ortho.Planes[FFrustum::Far], FVector4(0, 0, -1, 256)));
+
+	// 원근 투영: 법선은 단위 길이, 평면 안쪽 판정이 클립 공간 판정과 같아야 함
+	const FMatrix ViewProj = MakePerspectiveViewProj();
+	const FFrustum Perspective = FFrustum::FromViewProj(ViewProj);
+	for (const FVector4& Plane : Perspective.Planes)
+	{
+		CHECK(fabsf(sqrtf(Plane.X * Plane.X + Plane.Y * Plane.Y + Plane.Z * Plane.Z) - 1.0f) < 1e-5f);
+	}
+
+	std::mt19937 Random(17);
+	std::uniform_real_distribution<float> Position(-250.0f, 250.0f);
+	int32 NumInside = 0;
+	int32 NumChecked = 0;
+	for (int32 i = 0; i < 20000; ++i)
+	{
+		const FVector Point(Position(Random), Position(Random), Position(Random));
+		const FVector4 Clip = FMatrix::MultiplyVectorRow(FVector4(Point.X, Point.Y, Point.Z, 1.0f), ViewProj);
+		const bool bInsideClip = -Clip.W <= Clip.X && Clip.X <= Clip.W && -Clip.W <= Clip.Y && Clip.Y <= Clip.W && 0.0f <= Clip.Z && Clip.Z <= Clip.W;
+
+		float MinDistance = FLT_MAX;
+		for (const FVector4& Plane : Perspective.Planes)
+		{
+			MinDistance = (std::min)(MinDistance, PlaneDistance(Plane, Point));
+		}
+		// 평면에 아주 가까운 점은 반올림에 따라 갈릴 수 있으므로 제외
+		if (fabsf(MinDistance) < 1e-2f)
+			continue;
+		++NumChecked;
+		NumInside += bInsideClip;
+		CHECK(bInsideClip == (MinDistance > 0.0f));
+	}
+	CHECK(NumChecked > 19000);
+	CHECK(NumInside > 100);
+
+	// NDC 모서리 8개는 각각 자기 평면 3개 위에 있음
+	const FMatrix InvViewProj = FMatrix::Inverse(ViewProj);
+	for (int32 Corner = 0; Corner < 8; ++Corner)
+	{
+		const float X = (Corner & 1) ? 1.0f : -1.0f;
+		const float Y = (Corner & 2) ? 1.0f : -1.0f;
+		const float Z = (Corner & 4) ? 1.0f : 0.0f;
+		const FVector4 World = FMatrix::MultiplyVectorRow(FVector4(X, Y, Z, 1.0f), InvViewProj);
+		const FVector Point(World.X / World.W, World.Y / World.W, World.Z / World.W);
+
+		const FVector4& SidePlane = Perspective.Planes[X < 0 ? FFrustum::Left : FFrustum::Right];
+		const FVector4& UpPlane = Perspective.Planes[Y < 0 ? FFrustum::Bottom : FFrustum::Top];
+		const FVector4& DepthPlane = Perspective.Planes[Z == 0.0f ? FFrustum::Near : FFrustum::Far];
+		// 먼 모서리는 200 단위 밖이므로 허용 오차도 거리에 비례
+		const float Tolerance = Z == 0.0f ? 1e-3f : 5e-2f;
+		CHECK(fabsf(PlaneDistance(SidePlane, Point)) < Tolerance);
+		CHECK(fabsf(PlaneDistance(UpPlane, Point)) < Tolerance);
+		CHECK(fabsf(PlaneDistance(DepthPlane, Point)) < Tolerance);
+	}
+}
+
+ENGINE_TEST(FFrustum_TestAABBsMatchesScalar)
+{
+	std::mt19937 Random(23);
+	for (const FMatrix& ViewProj : { MakeExactOrthoViewProj(), MakePerspectiveViewProj() })
+	{
+		const FFrustum Frustum = FFrustum::FromViewProj(ViewProj);
+		const TArray<FAABB> Boxes = MakeTestBoxes(Frustum, Random, 4000);
+		CHECK(CountBatchMismatches(Frustum, Boxes, Random) == 0);
+	}
+
+	// 직교 절두체의 왼쪽 평면 x = -128: 닿기만 해도 보이고, 조금만 떨어져도 바깥
+	const FFrustum Ortho = FFrustum::FromViewProj(MakeExactOrthoViewProj());
+	const float JustOutside = -128.0f - 1.0f / 1024.0f;
+	const FAABB Touching(FVector(-132, -4, 10), FVector(-128, 4, 20));
+	const FAABB Separated(FVector(-132, -4, 10), FVector(JustOutside, 4, 20));
+	const FAABB PointOnPlane(FVector(-128, 0, 10), FVector(-128, 0, 10));
+	const FAABB PointOutside(FVector(JustOutside, 0, 10), FVector(JustOutside, 0, 10));
+	const FAABB OnNearPlane(FVector(-1, -1, -2), FVector(1, 1, 0));
+	const FAABB OnFarCorner(FVector(128, 64, 256), FVector(130, 66, 260));
+
+	CHECK(Ortho.TestAABB(Touching) == FFrustum::EContainment::Intersects);
+	CHECK(Ortho.TestAABB(Separated) == FFrustum::EContainment::Outside);
+	CHECK(Ortho.TestAABB(PointOnPlane) != FFrustum::EContainment::Outside);
+	CHECK(Ortho.TestAABB(PointOutside) == FFrustum::EContainment::Outside);
+	CHECK(Ortho.TestAABB(OnNearPlane) == FFrustum::EContainment::Intersects);
+	CHECK(Ortho.TestAABB(OnFarCorner) == FFrustum::EContainment::Intersects);
+	CHECK(Ortho.TestAABB(FAABB(FVector(-1, -1, 1), FVector(1, 1, 2))) == FFrustum::EContainment::Inside);
+
+	FAABBBatch Batch;
+	Batch.Add(Touching, 0);
+	Batch.Add(Separated, 1);
+	Batch.Add(PointOnPlane, 2);
+	Batch.Add(PointOutside, 3);
+	Batch.Add(OnNearPlane, 4);
+	Batch.Add(OnFarCorner, 5);
+	CHECK(Ortho.TestAABBs(Batch) == 0b110101u);
+
+	// 남은 레인에 이전 박스가 있어도 Count 밖의 비트는 항상 0
+	Batch.Reset();
+	Batch.Add(Touching, 0);
+	CHECK(Ortho.TestAABBs(Batch) == 1u);
+}
+
+ENGINE_TEST(FAABB_TransformByMatchesTransformedCorners)
+{
+	std::mt19937 Random(31);
+	std::uniform_real_distribution<float> Position(-50.0f, 50.0f);
+	std::uniform_real_distribution<float> Angle(-180.0f, 180.0f);
+	std::uniform_real_distribution<float> Magnitude(0.1f, 4.0f);
+
+	auto NearlyEqual = [](float A, float B) { return fabsf(A - B) <= 1e-4f * (std::max)(1.0f, fabsf(A)); };
+	auto CornerBounds = [](const FAABB& Box, const FMatrix& M) {
+		FAABB Result;
+		for (int32 Corner = 0; Corner < 8; ++Corner)
+		{
+			const FVector4 P((Corner & 1) ? Box.Max.X : Box.Min.X, (Corner & 2) ? Box.Max.Y : Box.Min.Y, (Corner & 4) ? Box.Max.Z : Box.Min.Z, 1.0f);
+			const FVector4 Q = FMatrix::MultiplyVectorRow(P, M);
+			Result.AddPoint(FVector(Q.X, Q.Y, Q.Z));
+		}
+		return Result;
+	};
+
+	for (int32 i = 0; i < 2000; ++i)
+	{
+		// 회전만, 크기만 (음수 포함), 이동만, 셋 다
+		const FVector Translation(Position(Random), Position(Random), Position(Random));
+		const FVector Rotation(Angle(Random), Angle(Random), Angle(Random));
+		const FVector Scale(Magnitude(Random) * (Random() % 2 ? -1.0f : 1.0f), Magnitude(Random) * (Random() % 2 ? -1.0f : 1.0f), Magnitude(Random));
+		const FVector Zero(0, 0, 0), One(1, 1, 1);
+		FMatrix M;
+		switch (i % 4)
+		{
+		case 0: M = FMatrix::SRTRowEuler(Zero, Rotation, One); break;
+		case 1: M = FMatrix::SRTRowEuler(Zero, Zero, Scale); break;
+		case 2: M = FMatrix::SRTRowEuler(Translation, Zero, One); break;
+		default: M = FMatrix::SRTRowQuaternion(Translation, FQuaternion::FromEulerXYZDeg(Rotation).ToMatrixRow(), Scale); break;
+		}
+
+		const FVector Min(Position(Random), Position(Random), Position(Random));
+		const FVector Size = (i % 16 == 0) ? FVector(0, 0, 0) : FVector(Magnitude(Random), Magnitude(Random), Magnitude(Random));
+		const FAABB Box(Min, Min + Size);
+
+		const FAABB Arvo = Box.TransformBy(M);
+		const FAABB Expected = CornerBounds(Box, M);
+		CHECK(Arvo.IsValid());
+		CHECK(NearlyEqual(Arvo.Min.X, Expected.Min.X) && NearlyEqual(Arvo.Min.Y, Expected.Min.Y) && NearlyEqual(Arvo.Min.Z, Expected.Min.Z));
+		CHECK(NearlyEqual(Arvo.Max.X, Expected.Max.X) && NearlyEqual(Arvo.Max.Y, Expected.Max.Y) && NearlyEqual(Arvo.Max.Z, Expected.Max.Z));
+	}
+
+	// 음수 크기로 뒤집히면 최소/최대가 서로 바뀌어야 함
+	const FAABB Mirrored = FAABB(FVector(1, 2, 3), FVector(4, 5, 6)).TransformBy(FMatrix::Scale(-1.0f, 2.0f, -0.5f));
+	CHECK(Mirrored.Min.X == -4.0f && Mirrored.Max.X == -1.0f);
+	CHECK(Mirrored.Min.Y == 4.0f && Mirrored.Max.Y == 10.0f);
+	CHECK(Mirrored.Min.Z == -3.0f && Mirrored.Max.Z == -1.5f);
+}
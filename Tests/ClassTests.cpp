@@ -0,0 +1,100 @@
+﻿#include "stdafx.h"
+#include "TestFramework.h"
+#include "UClass.h"
+#include "UCubeComp.h"
+#include "USphereComp.h"
+#include "UPlaneComp.h"
+#include "FDynamicBitset.h"
+#include <random>
+
+ENGINE_TEST(UClass_IntervalsMatchSuperClassChain)
+{
+	// 모든 클래스 쌍에 대해 구간 검사와 부모 체인 탐색이 같은 답을 내야 함
+	for (const TUniquePtr<UClass>& Class : UClass::GetClassList())
+	{
+		for (const TUniquePtr<UClass>& Base : UClass::GetClassList())
+		{
+			bool bExpected = false;
+			for (const UClass* It = Class.get(); It; It = It->GetSuperClass())
+			{
+				bExpected |= It == Base.get();
+			}
+			CHECK(Class->IsChildOrSelfOf(Base.get()) == bExpected);
+		}
+	}
+
+	UCubeComp Cube;
+	CHECK(Cube.IsA<UPrimitiveComponent>());
+	CHECK(Cube.IsA<USceneComponent>());
+	CHECK(Cube.Cast<USphereComp>() == nullptr);
+	CHECK(UCubeComp::StaticClass()->IsLeaf());
+	CHECK(!UPrimitiveComponent::StaticClass()->IsLeaf());
+}
+
+ENGINE_BENCHMARK(UClass_CastPrimitiveOverSceneObjects)
+{
+	// UScene::Render/Update의 Cast<UPrimitiveComponent> 루프와 같은 모양: 섞인 컴포넌트 목록을 훑음
+	constexpr int32 NumObjects = 10000;
+	std::mt19937 Random(3);
+	TArray<USceneComponent*> Objects;
+	for (int32 i = 0; i < NumObjects; ++i)
+	{
+		switch (Random() % 4)
+		{
+		case 0: Objects.push_back(new USceneComponent()); break;
+		case 1: Objects.push_back(new UCubeComp()); break;
+		case 2: Objects.push_back(new USphereComp()); break;
+		default: Objects.push_back(new UPlaneComp()); break;
+		}
+	}
+
+	// 이전 방식: 클래스마다 전체 클래스 수 크기의 힙 비트셋 (조상 비트가 켜짐)
+	const TArray<TUniquePtr<UClass>>& Classes = UClass::GetClassList();
+	TArray<TUniquePtr<FDynamicBitset>> AncestorBits(Classes.size());
+	for (const TUniquePtr<UClass>& Class : Classes)
+	{
+		auto Bits = MakeUnique<FDynamicBitset>();
+		Bits->Resize(Classes.size());
+		for (const UClass* It = Class.get(); It; It = It->GetSuperClass())
+		{
+			Bits->Set(It->GetTreeIndex());
+		}
+		AncestorBits[Class->GetTreeIndex()] = std::move(Bits);
+	}
+
+	constexpr int32 NumPasses = 1000;
+	ReportTime("bitset IsA (old), 10k objects x 1000", MeasureMs(3, [&Objects, &AncestorBits] {
+		uint64 Count = 0;
+		for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+		{
+			for (USceneComponent* Object : Objects)
+			{
+				// 이전 IsA처럼 매번 StaticClass()를 거침
+				if (AncestorBits[Object->GetClass()->GetTreeIndex()]->Test(UPrimitiveComponent::StaticClass()->GetTreeIndex()))
+					++Count;
+			}
+		}
+		KeepResult(Count);
+	}));
+	ReportTime("interval Cast, 10k objects x 1000", MeasureMs(3, [&Objects] {
+		uint64 Count = 0;
+		for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+		{
+			for (USceneComponent* Object : Objects)
+			{
+				if (Object->Cast<UPrimitiveComponent>())
+					++Count;
+			}
+		}
+		KeepResult(Count);
+	}));
+
+	// 속도는 객체 포인터 추적이 지배하므로 이전 방식의 차이는 주로 클래스 수의 제곱에 비례하던 메모리
+	printf("    %d classes: bitsets %zu bytes (old), intervals %zu bytes\n", static_cast<int32>(Classes.size()),
+		Classes.size() * (sizeof(FDynamicBitset) + (Classes.size() + 63) / 64 * sizeof(uint64)), Classes.size() * 2 * sizeof(uint32));
+
+	for (USceneComponent* Object : Objects)
+	{
+		delete Object;
+	}
+}
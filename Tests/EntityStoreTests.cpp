@@ -0,0 +1,226 @@
+﻿#include "stdafx.h"
+#include "TestFramework.h"
+#include "FEntityStore.h"
+#include "UJobSystem.h"
+#include <thread>
+
+namespace
+{
+	struct FTestPosition
+	{
+		float X, Y, Z;
+	};
+
+	struct FTestVelocity
+	{
+		float X, Y, Z;
+	};
+
+	struct FTestTag
+	{
+		uint32 Value;
+	};
+
+	/** @brief Creates position/velocity entities until the archetype spills into a second chunk; returns the first chunk's capacity. */
+	uint32 FillPastFirstChunk(FEntityStore& Store, TArray<FEntity>& OutEntities)
+	{
+		while (Store.NumChunks() < 2)
+		{
+			const float Value = static_cast<float>(OutEntities.size());
+			OutEntities.push_back(Store.Create(FTestPosition{ Value, 0, 0 }, FTestVelocity{ 0, Value, 0 }));
+		}
+		return static_cast<uint32>(OutEntities.size()) - 1;
+	}
+
+	bool HoldsOwnValues(FEntityStore& Store, FEntity Entity, float Value)
+	{
+		const FTestPosition* Position = Store.GetComponent<FTestPosition>(Entity);
+		const FTestVelocity* Velocity = Store.GetComponent<FTestVelocity>(Entity);
+		return Position && Velocity && Position->X == Value && Velocity->Y == Value;
+	}
+}
+
+ENGINE_TEST(FEntityStore_DestroySwapMovesLastRowIntoHole)
+{
+	FEntityStore Store;
+	TArray<FEntity> Entities;
+	const uint32 Capacity = FillPastFirstChunk(Store, Entities);
+	CHECK(Capacity > 1);
+	CHECK(Store.Num() == Capacity + 1);
+
+	// 두 번째 청크의 유일한 엔티티가 첫 행으로 옮겨지고 빈 청크는 해제됨
+	const FEntity Last = Entities.back();
+	Store.Destroy(Entities[0]);
+	CHECK(!Store.IsAlive(Entities[0]));
+	CHECK(Store.NumChunks() == 1);
+	CHECK(Store.Num() == Capacity);
+	CHECK(HoldsOwnValues(Store, Last, static_cast<float>(Capacity)));
+
+	uint32 NumVisitedChunks = 0;
+	Store.ForEachChunk<FTestPosition>([&](const FEntity* Rows, uint32 Count, FTestPosition* Positions) {
+		++NumVisitedChunks;
+		CHECK(Count == Capacity);
+		CHECK(Rows[0] == Last);
+		CHECK(Positions[0].X == static_cast<float>(Capacity));
+	});
+	CHECK(NumVisitedChunks == 1);
+
+	// 청크 중간을 지워도 나머지 엔티티는 자기 값을 그대로 가짐
+	Store.Destroy(Entities[Capacity / 2]);
+	for (uint32 i = 1; i < Entities.size(); ++i)
+	{
+		if (i != Capacity / 2)
+		{
+			CHECK(HoldsOwnValues(Store, Entities[i], static_cast<float>(i)));
+		}
+	}
+
+	uint32 NumRows = 0;
+	Store.ForEach<FTestPosition, FTestVelocity>([&](FEntity Entity, FTestPosition& Position, FTestVelocity& Velocity) {
+		++NumRows;
+		CHECK(Store.IsAlive(Entity));
+		CHECK(Position.X == Velocity.Y);
+	});
+	CHECK(NumRows == Capacity - 1);
+}
+
+ENGINE_TEST(FEntityStore_AddRemoveComponentMigratesArchetype)
+{
+	FEntityStore Store;
+	const FEntity Moving = Store.Create(FTestPosition{ 1, 2, 3 });
+	const FEntity Staying = Store.Create(FTestPosition{ 4, 5, 6 });
+	CHECK(Store.NumArchetypes() == 2);
+
+	Store.AddComponent(Moving, FTestVelocity{ 7, 8, 9 });
+	CHECK(Store.NumArchetypes() == 3);
+	CHECK(Store.HasComponent<FTestVelocity>(Moving));
+	CHECK((Store.GetMask(Moving) == MakeComponentMask<FTestPosition, FTestVelocity>()));
+	CHECK(Store.GetComponent<FTestPosition>(Moving)->Z == 3);
+	CHECK(Store.GetComponent<FTestVelocity>(Moving)->X == 7);
+	CHECK(Store.Count<FTestPosition>() == 2);
+	CHECK((Store.Count<FTestPosition, FTestVelocity>() == 1));
+	CHECK(Store.Count<FTestPosition>(MakeComponentMask<FTestVelocity>()) == 1);
+
+	// 옮겨 간 자리를 채운 엔티티도 자기 값을 유지
+	CHECK(!Store.HasComponent<FTestVelocity>(Staying));
+	CHECK(Store.GetComponent<FTestPosition>(Staying)->X == 4);
+
+	Store.RemoveComponent<FTestPosition>(Moving);
+	CHECK(!Store.HasComponent<FTestPosition>(Moving));
+	CHECK(Store.GetComponent<FTestPosition>(Moving) == nullptr);
+	CHECK(Store.GetComponent<FTestVelocity>(Moving)->Y == 8);
+	CHECK(Store.Count<FTestPosition>() == 1);
+	CHECK(Store.Count<FTestVelocity>() == 1);
+
+	// 이미 있는 아키타입으로 돌아가면 새로 만들지 않고, 새 컬럼은 0으로 시작
+	Store.AddComponent<FTestPosition>(Moving);
+	CHECK(Store.NumArchetypes() == 4);
+	CHECK(Store.GetComponent<FTestPosition>(Moving)->X == 0);
+	CHECK(Store.GetComponent<FTestVelocity>(Moving)->Z == 9);
+	CHECK(Store.Num() == 2);
+}
+
+ENGINE_TEST(FEntityStore_StaleHandleNotAliveAfterSlotReuse)
+{
+	FEntityStore Store;
+	const FEntity Old = Store.Create(FTestTag{ 1 });
+	Store.Destroy(Old);
+	CHECK(!Store.IsAlive(Old));
+	CHECK(Store.GetComponent<FTestTag>(Old) == nullptr);
+
+	// 해제된 슬롯을 재사용해도 세대가 달라 예전 핸들은 새 엔티티를 가리키지 않음
+	const FEntity Reused = Store.Create(FTestTag{ 2 });
+	CHECK(Reused.Index == Old.Index);
+	CHECK(Reused.Generation != Old.Generation);
+	CHECK(Reused != Old);
+	CHECK(!Store.IsAlive(Old));
+	CHECK(Store.GetComponent<FTestTag>(Old) == nullptr);
+
+	Store.Destroy(Old);
+	CHECK(Store.IsAlive(Reused));
+	CHECK(Store.GetComponent<FTestTag>(Reused)->Value == 2);
+	CHECK(Store.Num() == 1);
+	CHECK(!Store.IsAlive(FEntity()));
+}
+
+ENGINE_TEST(FEntityStore_ClearDropsEntitiesAndKeepsArchetypes)
+{
+	FEntityStore Store;
+	TArray<FEntity> Entities;
+	FillPastFirstChunk(Store, Entities);
+	const FEntity Tagged = Store.Create(FTestTag{ 3 });
+	const uint32 NumArchetypes = Store.NumArchetypes();
+
+	Store.Clear();
+	CHECK(Store.Num() == 0);
+	CHECK(Store.NumChunks() == 0);
+	CHECK(Store.NumArchetypes() == NumArchetypes);
+	CHECK(Store.Count<FTestPosition>() == 0);
+	CHECK(!Store.IsAlive(Tagged));
+	for (const FEntity& Entity : Entities)
+	{
+		CHECK(!Store.IsAlive(Entity));
+	}
+
+	uint32 NumVisitedChunks = 0;
+	Store.ForEachChunk<FTestPosition>([&](const FEntity*, uint32, FTestPosition*) { ++NumVisitedChunks; });
+	CHECK(NumVisitedChunks == 0);
+
+	// Clear 이전 핸들은 같은 슬롯이 재사용돼도 살아나지 않음
+	const FEntity Fresh = Store.Create(FTestTag{ 4 });
+	CHECK(Fresh.Index == Entities[0].Index);
+	CHECK(!Store.IsAlive(Entities[0]));
+	CHECK(Store.GetComponent<FTestTag>(Fresh)->Value == 4);
+	CHECK(Store.NumArchetypes() == NumArchetypes);
+	CHECK(Store.Num() == 1);
+}
+
+ENGINE_BENCHMARK(FEntityStore_Iterate1MEntities)
+{
+	constexpr uint32 NumEntities = 1000000;
+	constexpr int32 Repeats = 20;
+
+	FEntityStore Store;
+	for (uint32 i = 0; i < NumEntities; ++i)
+	{
+		const float Value = static_cast<float>(i % 1000);
+		Store.Create(FTestPosition{ Value, 0, 0 }, FTestVelocity{ 1, Value, 0 });
+	}
+	printf("    %-48s %10u\n", "chunks", Store.NumChunks());
+
+	ReportTime("ForEach, position += velocity", MeasureMs(Repeats, [&] {
+		Store.ForEach<FTestPosition, const FTestVelocity>([](FEntity, FTestPosition& Position, const FTestVelocity& Velocity) {
+			Position.X += Velocity.X;
+			Position.Y += Velocity.Y;
+			Position.Z += Velocity.Z;
+		});
+	}));
+
+	ReportTime("ForEachChunk, position += velocity", MeasureMs(Repeats, [&] {
+		Store.ForEachChunk<FTestPosition, const FTestVelocity>([](const FEntity*, uint32 Count, FTestPosition* Positions, const FTestVelocity* Velocities) {
+			for (uint32 Row = 0; Row < Count; ++Row)
+			{
+				Positions[Row].X += Velocities[Row].X;
+				Positions[Row].Y += Velocities[Row].Y;
+				Positions[Row].Z += Velocities[Row].Z;
+			}
+		});
+	}));
+
+	UJobSystem JobSystem;
+	JobSystem.StartWorkers((std::max)(1u, std::thread::hardware_concurrency()) - 1);
+	ReportTime("ParallelForEachChunk, position += velocity", MeasureMs(Repeats, [&] {
+		Store.ParallelForEachChunk<FTestPosition, const FTestVelocity>(JobSystem, [](const FEntity*, uint32 Count, FTestPosition* Positions, const FTestVelocity* Velocities) {
+			for (uint32 Row = 0; Row < Count; ++Row)
+			{
+				Positions[Row].X += Velocities[Row].X;
+				Positions[Row].Y += Velocities[Row].Y;
+				Positions[Row].Z += Velocities[Row].Z;
+			}
+		});
+	}));
+
+	double Sum = 0;
+	Store.ForEach<const FTestPosition>([&Sum](FEntity, const FTestPosition& Position) { Sum += Position.X; });
+	KeepResult(static_cast<uint64>(Sum));
+}
@@ -0,0 +1,189 @@
+﻿#include "stdafx.h"
+#include "TestFramework.h"
+#include "UGarbageCollector.h"
+#include "TWeakObjectPtr.h"
+
+namespace
+{
+	/** @brief Collectable object whose outgoing references are set by the test. */
+	class UTestNode : public UObject
+	{
+	public:
+		UTestNode()
+		{
+			SetGarbageCollectable(true);
+		}
+
+		void AddReferencedObjects(FReferenceCollector& collector) override
+		{
+			collector.AddReferencedObjects(References);
+		}
+
+		TArray<UObject*> References;
+	};
+
+	/** @brief Collector with no application; the first full cycle clears garbage left by earlier tests. */
+	struct FTestCollector
+	{
+		UGarbageCollector GC;
+
+		FTestCollector()
+		{
+			GC.Initialize(nullptr);
+			GC.CollectGarbage();
+		}
+	};
+}
+
+ENGINE_TEST(UGarbageCollector_CollectsUnreachableKeepsRootedAndReferenced)
+{
+	FTestCollector Collector;
+	UGarbageCollector& GC = Collector.GC;
+
+	UTestNode* Root = new UTestNode();
+	UTestNode* Referenced = new UTestNode();
+	UTestNode* Unreachable = new UTestNode();
+	UTestNode* ReferencedByUnreachable = new UTestNode();
+	UTestNode* NotCollectable = new UTestNode();
+	NotCollectable->SetGarbageCollectable(false);
+	Root->References.push_back(Referenced);
+	Unreachable->References.push_back(ReferencedByUnreachable);
+
+	TWeakObjectPtr<UTestNode> WeakRoot(Root), WeakReferenced(Referenced), WeakUnreachable(Unreachable),
+		WeakReferencedByUnreachable(ReferencedByUnreachable), WeakNotCollectable(NotCollectable);
+
+	GC.AddRoot(Root);
+	GC.CollectGarbage();
+	CHECK(WeakRoot.IsValid());
+	CHECK(WeakReferenced.IsValid());
+	CHECK(WeakNotCollectable.IsValid());
+	CHECK(!WeakUnreachable.IsValid());
+	CHECK(!WeakReferencedByUnreachable.IsValid());
+	CHECK(GC.GetStats().NumFreed == 2);
+	CHECK(GC.GetStats().NumMarked >= 2);
+	CHECK(!GC.IsCollecting());
+
+	// 루트에서 빼면 루트와 그것이 붙잡던 객체가 함께 수거됨
+	GC.RemoveRoot(Root);
+	GC.CollectGarbage();
+	CHECK(!WeakRoot.IsValid());
+	CHECK(!WeakReferenced.IsValid());
+	CHECK(WeakNotCollectable.IsValid());
+	CHECK(GC.GetStats().NumFreed == 2);
+
+	delete NotCollectable;
+}
+
+ENGINE_TEST(UGarbageCollector_CollectsUnreachableCycles)
+{
+	FTestCollector Collector;
+	UGarbageCollector& GC = Collector.GC;
+
+	// A <-> B 순환과 자기 참조 C: 참조 카운트로는 수거되지 않는 모양
+	UTestNode* A = new UTestNode();
+	UTestNode* B = new UTestNode();
+	UTestNode* C = new UTestNode();
+	A->References.push_back(B);
+	B->References.push_back(A);
+	C->References.push_back(C);
+
+	// 루트에서 닿는 순환은 살아남아야 함
+	UTestNode* Root = new UTestNode();
+	UTestNode* RootedA = new UTestNode();
+	UTestNode* RootedB = new UTestNode();
+	Root->References.push_back(RootedA);
+	RootedA->References.push_back(RootedB);
+	RootedB->References.push_back(RootedA);
+	GC.AddRoot(Root);
+
+	TWeakObjectPtr<UTestNode> WeakA(A), WeakB(B), WeakC(C), WeakRootedA(RootedA), WeakRootedB(RootedB);
+	GC.CollectGarbage();
+	CHECK(!WeakA.IsValid());
+	CHECK(!WeakB.IsValid());
+	CHECK(!WeakC.IsValid());
+	CHECK(WeakRootedA.IsValid());
+	CHECK(WeakRootedB.IsValid());
+	CHECK(GC.GetStats().NumFreed == 3);
+
+	GC.RemoveRoot(Root);
+	GC.CollectGarbage();
+	CHECK(!WeakRootedA.IsValid());
+	CHECK(!WeakRootedB.IsValid());
+	CHECK(GC.GetStats().NumFreed == 3);
+}
+
+ENGINE_TEST(UGarbageCollector_IncrementalSweepSpansFrames)
+{
+	FTestCollector Collector;
+	UGarbageCollector& GC = Collector.GC;
+
+	constexpr uint32 NumGarbage = 20000;
+	TArray<TWeakObjectPtr<UTestNode>> Garbage;
+	for (uint32 i = 0; i < NumGarbage; ++i)
+	{
+		Garbage.push_back(new UTestNode());
+	}
+
+	// 예산 0이면 한 조각은 시간 확인 간격(256개)만큼만 훑고 다음 프레임으로 넘김
+	GC.SetTimeBudget(0.0f);
+	GC.SetInterval(1000.0f);
+	GC.Tick(0.016f);
+	CHECK(!GC.IsCollecting());
+	CHECK(Garbage[0].IsValid());
+
+	GC.RequestCollection();
+	GC.Tick(0.016f);
+	CHECK(GC.IsCollecting());
+	CHECK(GC.GetStats().SliceMs.size() == 1);
+
+	// 사이클 도중 생긴 객체는 이번 사이클에서는 표시된 것으로 취급
+	TWeakObjectPtr<UTestNode> CreatedMidCycle(new UTestNode());
+
+	uint32 NumTicks = 1;
+	while (GC.IsCollecting() && NumTicks < 100000)
+	{
+		GC.Tick(0.016f);
+		++NumTicks;
+	}
+	CHECK(!GC.IsCollecting());
+	CHECK(NumTicks > 1);
+	CHECK(GC.GetStats().SliceMs.size() == NumTicks);
+	CHECK(GC.GetStats().NumFreed == NumGarbage);
+	for (const TWeakObjectPtr<UTestNode>& Weak : Garbage)
+	{
+		CHECK(!Weak.IsValid());
+	}
+	CHECK(CreatedMidCycle.IsValid());
+
+	// 간격이 지나면 요청 없이도 다음 사이클이 시작됨
+	GC.SetTimeBudget(1000.0f);
+	GC.Tick(1000.0f);
+	CHECK(!GC.IsCollecting());
+	CHECK(GC.GetStats().NumFreed == 1);
+	CHECK(!CreatedMidCycle.IsValid());
+}
+
+ENGINE_BENCHMARK(UGarbageCollector_SweepSlices)
+{
+	// 1ms 예산으로 10만 개를 수거할 때 조각 수와 가장 긴 조각
+	FTestCollector Collector;
+	UGarbageCollector& GC = Collector.GC;
+
+	for (uint32 i = 0; i < 100000; ++i)
+	{
+		new UTestNode();
+	}
+	GC.SetTimeBudget(1.0f);
+	GC.RequestCollection();
+	do
+	{
+		GC.Tick(0.016f);
+	} while (GC.IsCollecting());
+
+	const FGarbageCollectionStats& Stats = GC.GetStats();
+	ReportTime("mark", Stats.MarkMs);
+	ReportTime("max slice (1 ms budget)", Stats.MaxSliceMs);
+	ReportTime("total", Stats.TotalMs);
+	printf("    %-48s %10u\n", "  slices", static_cast<uint32>(Stats.SliceMs.size()));
+	printf("    %-48s %10u\n", "  freed", Stats.NumFreed);
+}
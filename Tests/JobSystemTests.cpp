@@ -0,0 +1,163 @@
+﻿#include "stdafx.h"
+#include "TestFramework.h"
+#include "UJobSystem.h"
+#include <cmath>
+
+ENGINE_TEST(UJobSystem_ParallelForCoversEveryIndexOnce)
+{
+	for (int32 NumWorkers : { 0, 1, 3 })
+	{
+		UJobSystem JobSystem;
+		JobSystem.StartWorkers(NumWorkers);
+		CHECK(JobSystem.GetNumWorkers() == static_cast<uint32>(NumWorkers));
+
+		// 청크 크기로 나누어떨어지지 않는 개수, 자동 청크(0) 둘 다
+		TArray<int32> Hits(100003, 0);
+		for (uint32 GrainSize : { 1000u, 0u })
+		{
+			JobSystem.ParallelFor(static_cast<uint32>(Hits.size()), GrainSize, [&Hits](uint32 Start, uint32 End) {
+				for (uint32 i = Start; i < End; ++i)
+					++Hits[i];
+			});
+		}
+		CHECK(std::all_of(Hits.begin(), Hits.end(), [](int32 Count) { return Count == 2; }));
+
+		// 중첩 ParallelFor도 끝까지 진행되어야 함
+		std::atomic<int32> Sum{ 0 };
+		JobSystem.ParallelFor(64, 1, [&JobSystem, &Sum](uint32 Start, uint32 End) {
+			JobSystem.ParallelFor(1000, 10, [&Sum, Outer = End - Start](uint32 InnerStart, uint32 InnerEnd) {
+				Sum += static_cast<int32>((InnerEnd - InnerStart) * Outer);
+			});
+		});
+		CHECK(Sum.load() == 64000);
+	}
+}
+
+ENGINE_TEST(UJobSystem_RunAfterWaitsForDependency)
+{
+	for (int32 NumWorkers : { 0, 3 })
+	{
+		UJobSystem JobSystem;
+		JobSystem.StartWorkers(NumWorkers);
+
+		std::atomic<int32> Stage{ 0 };
+		std::atomic<int32> EarlyStarts{ 0 };
+		FJobCounter First, Second;
+		for (int32 i = 0; i < 100; ++i)
+		{
+			JobSystem.Run([&Stage] { Stage.fetch_add(1); }, &First);
+		}
+		for (int32 i = 0; i < 50; ++i)
+		{
+			JobSystem.RunAfter(First, [&Stage, &EarlyStarts] {
+				if (Stage.load() < 100) EarlyStarts.fetch_add(1);
+				Stage.fetch_add(1000);
+			}, &Second);
+		}
+		JobSystem.Wait(Second);
+
+		CHECK(First.IsDone() && Second.IsDone());
+		CHECK(EarlyStarts.load() == 0);
+		CHECK(Stage.load() == 100 + 50 * 1000);
+	}
+}
+
+ENGINE_TEST(UJobSystem_WaitRunsQueuedJobsOnCallingThread)
+{
+	// 유일한 워커를 막아 두면 Wait를 부른 스레드가 직접 작업을 처리해야 끝남
+	UJobSystem JobSystem;
+	JobSystem.StartWorkers(1);
+
+	std::atomic<bool> bBlockerStarted{ false };
+	std::atomic<bool> bRelease{ false };
+	FJobCounter Blocker;
+	JobSystem.Run([&] {
+		bBlockerStarted = true;
+		while (!bRelease) std::this_thread::yield();
+	}, &Blocker);
+	while (!bBlockerStarted) std::this_thread::yield();
+
+	uint32 RanOnThread = UINT_MAX;
+	FJobCounter Job;
+	JobSystem.Run([&RanOnThread] { RanOnThread = UJobSystem::GetCurrentThreadIndex(); }, &Job);
+	JobSystem.Wait(Job);
+	CHECK(RanOnThread == 0);
+
+	bRelease = true;
+	JobSystem.Wait(Blocker);
+	CHECK(Blocker.IsDone());
+}
+
+ENGINE_TEST(UJobSystem_ForeignThreadsUseSharedQueue)
+{
+	CHECK(UJobSystem::GetCurrentThreadIndex() == 0);
+	CHECK(!UJobSystem::IsForeignThread());
+
+	UJobSystem JobSystem;
+	JobSystem.StartWorkers(2);
+
+	// 스트리머 로더처럼 잡 시스템이 만들지 않은 스레드가 게임 스레드의 ParallelFor와 동시에 작업을 넣음
+	constexpr int32 NumForeignJobs = 2000;
+	std::atomic<int32> ForeignRuns{ 0 };
+	uint32 ForeignIndex = 0;
+	std::thread Foreign([&] {
+		ForeignIndex = UJobSystem::GetCurrentThreadIndex();
+		FJobCounter Counter;
+		for (int32 i = 0; i < NumForeignJobs; ++i)
+		{
+			JobSystem.Run([&ForeignRuns] { ForeignRuns.fetch_add(1); }, &Counter);
+		}
+		JobSystem.Wait(Counter);
+	});
+
+	TArray<int32> Hits(100000, 0);
+	for (int32 Repeat = 0; Repeat < 20; ++Repeat)
+	{
+		JobSystem.ParallelFor(static_cast<uint32>(Hits.size()), 100, [&Hits](uint32 Start, uint32 End) {
+			for (uint32 i = Start; i < End; ++i)
+				++Hits[i];
+		});
+	}
+	Foreign.join();
+
+	CHECK(ForeignIndex == UJobSystem::ForeignThreadIndex);
+	CHECK(ForeignRuns.load() == NumForeignJobs);
+	CHECK(std::all_of(Hits.begin(), Hits.end(), [](int32 Count) { return Count == 20; }));
+}
+
+ENGINE_BENCHMARK(UJobSystem_ParallelForScaling)
+{
+	// 항목당 계산이 충분히 큰 ParallelFor를 워커 0..N개로 실행 (0 = 호출 스레드만)
+	constexpr uint32 NumItems = 1 << 20;
+	const int32 HardwareThreads = static_cast<int32>(std::thread::hardware_concurrency());
+	const int32 MaxWorkers = (std::max)(HardwareThreads - 1, 1);
+	printf("    hardware threads: %d\n", HardwareThreads);
+
+	TArray<float> Values(NumItems);
+	double SingleThreadMs = 0.0;
+	for (int32 NumWorkers = 0; NumWorkers <= MaxWorkers; ++NumWorkers)
+	{
+		UJobSystem JobSystem;
+		JobSystem.StartWorkers(NumWorkers);
+		std::fill(Values.begin(), Values.end(), 1.0f);
+
+		const double Ms = MeasureMs(3, [&JobSystem, &Values] {
+			JobSystem.ParallelFor(NumItems, 0, [&Values](uint32 Start, uint32 End) {
+				for (uint32 i = Start; i < End; ++i)
+				{
+					float Value = Values[i];
+					for (int32 k = 0; k < 16; ++k)
+						Value = std::sqrt(Value * 1.0001f + 1.0f);
+					Values[i] = Value;
+				}
+			});
+		});
+		KeepResult(static_cast<uint64>(Values[NumItems / 2]));
+
+		if (NumWorkers == 0)
+			SingleThreadMs = Ms;
+		const FString Label = std::to_string(NumWorkers) + " worker(s), 1M items";
+		ReportTime(Label.c_str(), Ms);
+		printf("    %-48s %10.2fx\n", "  speedup vs calling thread only", SingleThreadMs / Ms);
+	}
+}
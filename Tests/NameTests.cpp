@@ -0,0 +1,122 @@
+﻿#include "stdafx.h"
+#include "TestFramework.h"
+#include "FName.h"
+
+ENGINE_TEST(FName_ComparesCaseInsensitively)
+{
+	const FName Lower("cube");
+	const FName Upper("CUBE");
+	CHECK(Lower == Upper);
+	CHECK(Lower.GetPlainString() == "cube");
+	CHECK(Upper.GetPlainString() == "CUBE");
+	CHECK(FName("Cube") != FName("Sphere"));
+	CHECK(FName().IsNone());
+	CHECK(FName("").IsNone());
+}
+
+ENGINE_TEST(FName_SplitsNumberSuffix)
+{
+	const FName Numbered("Cube_123");
+	CHECK(Numbered.Number == 124);
+	CHECK(Numbered.GetPlainString() == "Cube");
+	CHECK(Numbered.ToString() == "Cube_123");
+	CHECK(Numbered.ComparisonIndex == FName("Cube").ComparisonIndex);
+	CHECK(Numbered != FName("Cube_124"));
+
+	// 앞자리 0이나 밑줄 없는 숫자는 문자열의 일부로 남아 그대로 왕복됨
+	CHECK(FName("Cube_0123").Number == 0);
+	CHECK(FName("Cube_0123").ToString() == "Cube_0123");
+	CHECK(FName("Cube123").Number == 0);
+	CHECK(FName("_5").Number == 0);
+}
+
+ENGINE_TEST(FName_NumberedNamesDoNotGrowPool)
+{
+	FName("Pooled");
+	const int32 Before = FNamePool::Get().Num();
+	for (int32 i = 0; i < 10000; ++i)
+	{
+		FName Name(FString("Pooled_") + std::to_string(i));
+		CHECK(Name.Number == i + 1);
+	}
+	CHECK(FNamePool::Get().Num() == Before);
+}
+
+namespace
+{
+	/** @brief The table FName used before the pool: a linear, case-sensitive scan over every distinct string. */
+	struct FLinearNameTable
+	{
+		TArray<FString> Names;
+
+		int32 Find(const FString& Str)
+		{
+			auto It = std::find(Names.begin(), Names.end(), Str);
+			if (It != Names.end())
+				return static_cast<int32>(It - Names.begin());
+			Names.push_back(Str);
+			return static_cast<int32>(Names.size()) - 1;
+		}
+	};
+
+	constexpr int32 NumNames = 1000000;
+}
+
+ENGINE_BENCHMARK(FName_Construct1M)
+{
+	// 미리 만든 문자열로 FString 생성 비용을 측정에서 뺌
+	TArray<FString> Numbered(NumNames), Distinct(NumNames);
+	for (int32 i = 0; i < NumNames; ++i)
+	{
+		Numbered[i] = "Cube_" + std::to_string(i);
+		Distinct[i] = "Distinct" + std::to_string(i);
+	}
+
+	ReportTime("1M x FName(\"New Object\")", MeasureMs(3, [] {
+		uint64 Sum = 0;
+		for (int32 i = 0; i < NumNames; ++i)
+			Sum += FName("New Object").ComparisonIndex;
+		KeepResult(Sum);
+	}));
+
+	ReportTime("1M numbered names (Cube_0..Cube_999999)", MeasureMs(3, [&Numbered] {
+		uint64 Sum = 0;
+		for (const FString& Str : Numbered)
+			Sum += FName(Str).Number;
+		KeepResult(Sum);
+	}));
+
+	// 처음 한 번은 1M개 항목을 추가하고, 이후 반복은 전부 조회
+	ReportTime("1M distinct names, first insert", MeasureMs(1, [&Distinct] {
+		uint64 Sum = 0;
+		for (const FString& Str : Distinct)
+			Sum += FName(Str).DisplayIndex;
+		KeepResult(Sum);
+	}));
+	ReportTime("1M distinct names, lookup", MeasureMs(3, [&Distinct] {
+		uint64 Sum = 0;
+		for (const FString& Str : Distinct)
+			Sum += FName(Str).DisplayIndex;
+		KeepResult(Sum);
+	}));
+
+	// 이전 선형 테이블은 고유 이름 수에 대해 이차 비용이라 1만 개에서만 비교
+	ReportTime("10k distinct names, linear table (old)", MeasureMs(1, [&Numbered] {
+		FLinearNameTable Table;
+		uint64 Sum = 0;
+		for (int32 i = 0; i < 10000; ++i)
+			Sum += Table.Find(Numbered[i]);
+		KeepResult(Sum);
+	}));
+	TArray<FString> Fresh(10000);
+	for (int32 i = 0; i < 10000; ++i)
+	{
+		Fresh[i] = "Fresh" + std::to_string(i);
+	}
+	ReportTime("10k distinct names, FName", MeasureMs(1, [&Fresh] {
+		uint64 Sum = 0;
+		for (const FString& Str : Fresh)
+			Sum += FName(Str).DisplayIndex;
+		KeepResult(Sum);
+	}));
+}
@@ -0,0 +1,90 @@
+﻿#include "stdafx.h"
+#include "TestFramework.h"
+#include "TWeakObjectPtr.h"
+#include "USceneComponent.h"
+
+namespace
+{
+	// FUObjectArray는 객체를 역참조하지 않으므로 번호를 가짜 포인터로 넣음
+	UObject* ToFakeObject(uint32 Index)
+	{
+		return reinterpret_cast<UObject*>(static_cast<uintptr_t>(Index + 1) * 16);
+	}
+}
+
+ENGINE_TEST(TWeakObjectPtr_NullAfterDestroyAndSlotReuse)
+{
+	USceneComponent* Object = new USceneComponent();
+	TWeakObjectPtr<USceneComponent> Weak(Object);
+	CHECK(Weak.Get() == Object);
+	CHECK(!Weak.IsStale());
+
+	const uint32 Index = Object->InternalIndex;
+	delete Object;
+	CHECK(Weak.Get() == nullptr);
+	CHECK(!Weak);
+	CHECK(Weak.IsStale());
+
+	// free list가 방금 반환된 슬롯을 먼저 돌려주므로 새 객체가 같은 인덱스를 받음
+	USceneComponent* Reused = new USceneComponent();
+	CHECK(Reused->InternalIndex == Index);
+	CHECK(Weak.Get() == nullptr);
+	CHECK(Weak.IsStale());
+
+	TWeakObjectPtr<USceneComponent> ReusedWeak(Reused);
+	CHECK(ReusedWeak.Get() == Reused);
+	CHECK(ReusedWeak != Weak);
+
+	delete Reused;
+	CHECK(ReusedWeak.Get() == nullptr);
+
+	Weak.Reset();
+	CHECK(!Weak.IsStale());
+}
+
+ENGINE_TEST(FUObjectArray_GrowsAcrossChunkBoundary)
+{
+	constexpr uint32 ChunkSize = FUObjectArray::ItemsPerChunk;
+	FUObjectArray Array;
+
+	// 첫 청크 끝까지 채우고 첫 아이템 주소를 기억
+	for (uint32 i = 0; i < ChunkSize; ++i)
+	{
+		CHECK(Array.AddObject(ToFakeObject(i)) == i);
+	}
+	const FUObjectItem* FirstItem = Array.GetItem(0);
+	const FUObjectItem* LastInChunk = Array.GetItem(ChunkSize - 1);
+	const FObjectHandle LastHandle = Array.MakeHandle(ChunkSize - 1);
+
+	// 경계를 넘어 두 번째 청크를 붙여도 기존 아이템은 이동하지 않음
+	for (uint32 i = ChunkSize; i < ChunkSize + 3; ++i)
+	{
+		CHECK(Array.AddObject(ToFakeObject(i)) == i);
+	}
+	CHECK(Array.Num() == ChunkSize + 3);
+	CHECK(Array.GetObjectCount() == ChunkSize + 3);
+	CHECK(Array.GetItem(0) == FirstItem);
+	CHECK(Array.GetItem(ChunkSize - 1) == LastInChunk);
+	CHECK(Array.Resolve(LastHandle) == ToFakeObject(ChunkSize - 1));
+	CHECK(Array[ChunkSize] == ToFakeObject(ChunkSize));
+	CHECK(Array.GetItem(ChunkSize + 3) == nullptr);
+
+	// 경계 양쪽의 슬롯을 반환하고 재사용해도 예전 핸들은 되살아나지 않음
+	const FObjectHandle FirstInChunk = Array.MakeHandle(ChunkSize);
+	Array.RemoveObject(ChunkSize - 1, ToFakeObject(ChunkSize - 1));
+	Array.RemoveObject(ChunkSize, ToFakeObject(ChunkSize));
+	CHECK(Array.GetObjectCount() == ChunkSize + 1);
+	CHECK(Array.Resolve(LastHandle) == nullptr);
+	CHECK(Array.Resolve(FirstInChunk) == nullptr);
+
+	CHECK(Array.AddObject(ToFakeObject(100)) == ChunkSize);
+	CHECK(Array.AddObject(ToFakeObject(101)) == ChunkSize - 1);
+	CHECK(Array.Num() == ChunkSize + 3);
+	CHECK(Array.Resolve(LastHandle) == nullptr);
+	CHECK(Array.Resolve(FirstInChunk) == nullptr);
+	CHECK(Array.Resolve(Array.MakeHandle(ChunkSize - 1)) == ToFakeObject(101));
+
+	// 다른 객체를 넘긴 RemoveObject는 슬롯을 건드리지 않음
+	Array.RemoveObject(ChunkSize, ToFakeObject(ChunkSize));
+	CHECK(Array[ChunkSize] == ToFakeObject(100));
+}
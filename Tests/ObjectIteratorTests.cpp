@@ -0,0 +1,92 @@
+﻿#include "stdafx.h"
+#include "TestFramework.h"
+#include "TObjectIterator.h"
+#include "UCubeComp.h"
+#include "USphereComp.h"
+#include "UGizmoArrowComp.h"
+
+namespace
+{
+	template<typename T>
+	int32 CountWithIterator()
+	{
+		int32 Count = 0;
+		for (TObjectIterator<T> It; It; ++It)
+		{
+			++Count;
+		}
+		return Count;
+	}
+}
+
+ENGINE_TEST(TObjectIterator_VisitsSubclassesAndSkipsDeleted)
+{
+	const int32 PrimitivesBefore = CountWithIterator<UPrimitiveComponent>();
+	const int32 CubesBefore = CountWithIterator<UCubeComp>();
+
+	TArray<USceneComponent*> Objects;
+	for (int32 i = 0; i < 10; ++i)
+	{
+		Objects.push_back(new UCubeComp());
+		Objects.push_back(new USphereComp());
+		Objects.push_back(new USceneComponent());
+	}
+	CHECK(CountWithIterator<UPrimitiveComponent>() == PrimitivesBefore + 20);
+	CHECK(CountWithIterator<UCubeComp>() == CubesBefore + 10);
+
+	// 중간 객체를 지워도 swap-remove로 목록이 밀집 유지되어야 함
+	delete Objects[0];
+	delete Objects[4];
+	Objects.erase(Objects.begin() + 4);
+	Objects.erase(Objects.begin());
+	CHECK(CountWithIterator<UPrimitiveComponent>() == PrimitivesBefore + 18);
+	CHECK(CountWithIterator<UCubeComp>() == CubesBefore + 9);
+	for (TObjectIterator<UCubeComp> It; It; ++It)
+	{
+		CHECK(It->IsA<UCubeComp>());
+	}
+
+	for (USceneComponent* Object : Objects)
+	{
+		delete Object;
+	}
+	CHECK(CountWithIterator<UPrimitiveComponent>() == PrimitivesBefore);
+}
+
+ENGINE_BENCHMARK(TObjectIterator_1kGizmosAmong100kObjects)
+{
+	TArray<USceneComponent*> Objects;
+	for (int32 i = 0; i < 100000; ++i)
+	{
+		Objects.push_back(i % 100 == 0 ? static_cast<USceneComponent*>(new UGizmoArrowComp()) : new UCubeComp());
+	}
+	UObject::FlushPendingClassRegistrations();
+
+	constexpr int32 NumPasses = 100;
+	ReportTime("scan + Cast over 100k objects x100 (old)", MeasureMs(3, [&Objects] {
+		uint64 Sum = 0;
+		for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+		{
+			for (USceneComponent* Object : Objects)
+			{
+				if (UGizmoComponent* Gizmo = Object->Cast<UGizmoComponent>())
+					Sum += Gizmo->UUID;
+			}
+		}
+		KeepResult(Sum);
+	}));
+	ReportTime("TObjectIterator<UGizmoComponent> x100", MeasureMs(3, [] {
+		uint64 Sum = 0;
+		for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+		{
+			for (TObjectIterator<UGizmoComponent> It; It; ++It)
+				Sum += It->UUID;
+		}
+		KeepResult(Sum);
+	}));
+
+	for (USceneComponent* Object : Objects)
+	{
+		delete Object;
+	}
+}
@@ -0,0 +1,177 @@
+﻿#include "stdafx.h"
+#include "TestFramework.h"
+#include "UClass.h"
+#include "UCubeComp.h"
+#include "FProperty.h"
+#include "USphereComp.h"
+#include "AStaticMeshActor.h"
+#include "SceneTestUtils.h"
+
+namespace
+{
+	bool NearlyEqual(const FVector& A, const FVector& B)
+	{
+		return fabsf(A.X - B.X) < 1e-3f && fabsf(A.Y - B.Y) < 1e-3f && fabsf(A.Z - B.Z) < 1e-3f;
+	}
+
+	/** @brief Two cubes, a sphere and a static mesh actor, with distinct UUIDs and transforms. */
+	void FillScene(UTestScene& Scene)
+	{
+		Scene.SetVersion(7);
+		for (uint32 i = 0; i < 3; ++i)
+		{
+			const FVector Location(static_cast<float>(i), 2.0f * i, -3.0f * i);
+			USceneComponent* Object = (i == 2) ? static_cast<USceneComponent*>(new USphereComp(Location, { 0, 0, 45 }))
+				: new UCubeComp(Location, { 10.0f * i, 0, 0 }, { 1, 2, 3 });
+			Object->SetUUID(100 + i);
+			Scene.AddTestObject(Object);
+		}
+
+		AStaticMeshActor* Actor = new AStaticMeshActor();
+		Actor->SetTransform({ 5, 6, 7 }, { 0, 30, 0 }, { 2, 2, 2 });
+		Actor->SetUUID(200);
+		Scene.AddTestActor(Actor);
+	}
+
+	/** @brief Same objects (by UUID and class), transforms, actors and actor components as FillScene made. */
+	bool MatchesFilledScene(UTestScene& Scene)
+	{
+		if (Scene.version != 7 || Scene.GetObjects().size() != 3 || Scene.GetActors().size() != 1)
+			return false;
+
+		for (uint32 i = 0; i < 3; ++i)
+		{
+			USceneComponent* Object = nullptr;
+			for (USceneComponent* Candidate : Scene.GetObjects())
+			{
+				if (Candidate->UUID == 100 + i)
+					Object = Candidate;
+			}
+			const bool bExpectSphere = i == 2;
+			if (!Object || Object->IsA<USphereComp>() != bExpectSphere || Object->IsA<UCubeComp>() == bExpectSphere)
+				return false;
+			if (!NearlyEqual(Object->GetPosition(), FVector(static_cast<float>(i), 2.0f * i, -3.0f * i)))
+				return false;
+			// 로드 후 월드 트랜스폼도 새 상대 트랜스폼을 따라야 함
+			if (!NearlyEqual(Object->GetWorldLocation(), Object->GetPosition()))
+				return false;
+		}
+
+		AActor* Actor = Scene.GetActors()[0];
+		// 생성자가 만든 컴포넌트에 읽어 들여야 하고, 새로 붙이면 안 됨
+		TArray<UActorComponent*> Components = Actor->GetComponents<UActorComponent>();
+		AStaticMeshActor* MeshActor = Actor->Cast<AStaticMeshActor>();
+		return Actor->UUID == 200 && MeshActor && Components.size() == 1 &&
+			NearlyEqual(MeshActor->GetStaticMeshComponent()->GetPosition(), FVector(5, 6, 7)) &&
+			NearlyEqual(MeshActor->GetStaticMeshComponent()->GetScale(), FVector(2, 2, 2)) &&
+			NearlyEqual(MeshActor->GetStaticMeshComponent()->GetRotation(), FVector(0, 30, 0));
+	}
+}
+
+ENGINE_TEST(UPROPERTY_RoundTripsSceneComponentThroughJson)
+{
+	UCubeComp Source({ 1, 2, 3 }, { 10, 20, 30 }, { 2, 2, 2 });
+	json::JSON Data = Source.Serialize();
+	CHECK(Data.hasKey("Location"));
+	CHECK(Data.hasKey("Rotation"));
+	CHECK(Data.hasKey("Scale"));
+
+	UCubeComp Target;
+	CHECK(Target.Deserialize(Data));
+	CHECK(Target.RelativeLocation.X == 1 && Target.RelativeLocation.Y == 2 && Target.RelativeLocation.Z == 3);
+	CHECK(Target.RelativeScale3D.X == 2 && Target.RelativeScale3D.Y == 2 && Target.RelativeScale3D.Z == 2);
+	const FVector Euler = Target.RelativeQuaternion.GetEulerXYZDeg();
+	CHECK(fabsf(Euler.X - 10) < 1e-3f && fabsf(Euler.Y - 20) < 1e-3f && fabsf(Euler.Z - 30) < 1e-3f);
+}
+
+ENGINE_TEST(UPROPERTY_AccessorsResolveThroughDerivedClasses)
+{
+	// 부모 클래스 속성이 먼저 오고, 파생 객체를 통해서도 같은 멤버를 가리켜야 함
+	const TArray<FProperty>& Properties = UCubeComp::StaticClass()->GetProperties();
+	CHECK(Properties.size() >= 3);
+	CHECK(strcmp(Properties[0].Name, "Location") == 0);
+	CHECK(strcmp(Properties[0].DisplayName, "Translation") == 0);
+	CHECK(strcmp(Properties[1].DisplayName, "Rotation") == 0);
+
+	UCubeComp Cube;
+	CHECK(&Properties[0].GetValue<FVector>(&Cube) == &Cube.RelativeLocation);
+	CHECK(&Properties[2].GetValue<FVector>(&Cube) == &Cube.RelativeScale3D);
+}
+
+ENGINE_TEST(UPROPERTY_RoundTripsSceneComponentThroughBinary)
+{
+	UCubeComp Source({ 1, 2, 3 }, { 10, 20, 30 }, { 2, 2, 2 });
+	TArray<uint8> Bytes;
+	Source.SerializeBinary(Bytes);
+
+	UCubeComp Target;
+	const uint8* Cursor = Bytes.data();
+	CHECK(Target.DeserializeBinary(Cursor, Bytes.data() + Bytes.size()));
+	CHECK(Cursor == Bytes.data() + Bytes.size());
+	CHECK(NearlyEqual(Target.RelativeLocation, Source.RelativeLocation));
+	CHECK(NearlyEqual(Target.RelativeScale3D, Source.RelativeScale3D));
+	CHECK(NearlyEqual(Target.RelativeQuaternion.GetEulerXYZDeg(), FVector(10, 20, 30)));
+
+	// 잘린 이미지는 실패
+	for (size_t Length : { size_t(0), size_t(6), Bytes.size() - 1 })
+	{
+		UCubeComp Truncated;
+		Cursor = Bytes.data();
+		CHECK(!Truncated.DeserializeBinary(Cursor, Bytes.data() + Length));
+	}
+
+	// 다른 속성 레이아웃의 이미지는 읽지 않고 통째로 건너뜀
+	UTestScene Scene;
+	TArray<uint8> SceneImage;
+	FPropertySerializer::ToBinary(&Scene, SceneImage);
+	SceneImage.insert(SceneImage.end(), Bytes.begin(), Bytes.end());
+	UCubeComp Skipped;
+	Cursor = SceneImage.data();
+	CHECK(!FPropertySerializer::FromBinary(&Skipped, Cursor, SceneImage.data() + SceneImage.size()));
+	CHECK(Skipped.RelativeLocation.X == 0);
+	CHECK(Skipped.DeserializeBinary(Cursor, SceneImage.data() + SceneImage.size()));
+	CHECK(NearlyEqual(Skipped.RelativeLocation, Source.RelativeLocation));
+}
+
+ENGINE_TEST(UScene_RoundTripsThroughJsonAndBinary)
+{
+	UTestScene Source;
+	FillScene(Source);
+	CHECK(MatchesFilledScene(Source));
+	const uint32 NextUUID = UEngineStatics::GetNextUUID();
+
+	const json::JSON Json = Source.Serialize();
+	CHECK(Json.hasKey("Version") && Json.at("Version").ToInt() == 7);
+	{
+		UTestScene Loaded;
+		CHECK(Loaded.Deserialize(Json));
+		CHECK(MatchesFilledScene(Loaded));
+		CHECK(UEngineStatics::GetNextUUID() == NextUUID);
+
+		// 읽은 씬을 다시 쓰면 같은 JSON
+		CHECK(Loaded.Serialize().dump() == Json.dump());
+	}
+
+	TArray<uint8> Bytes;
+	Source.SerializeBinary(Bytes);
+	{
+		UTestScene Loaded;
+		const uint8* Cursor = Bytes.data();
+		CHECK(Loaded.DeserializeBinary(Cursor, Bytes.data() + Bytes.size()));
+		CHECK(Cursor == Bytes.data() + Bytes.size());
+		CHECK(MatchesFilledScene(Loaded));
+		CHECK(UEngineStatics::GetNextUUID() == NextUUID);
+
+		TArray<uint8> Rewritten;
+		Loaded.SerializeBinary(Rewritten);
+		CHECK(Rewritten == Bytes);
+	}
+
+	// 매직 넘버가 없으면 JSON 씬으로 보고 읽지 않음
+	{
+		UTestScene Loaded;
+		const uint8* Cursor = Bytes.data() + 1;
+		CHECK(!Loaded.DeserializeBinary(Cursor, Bytes.data() + Bytes.size()));
+		CHECK(Loaded.GetObjects().empty());
+	}
+}
@@ -0,0 +1,123 @@
+﻿#include "stdafx.h"
+#include "TestFramework.h"
+#include "FRecordingCommandContext.h"
+
+// URenderer와 UBatchRenderer는 생성 시 D3D11 디바이스가 필요해서 여기서는 띄우지 않음.
+// 대신 프레임과 같은 순서의 호출을 null 백엔드(FRecordingCommandContext)에 직접 보내고,
+// 리소스는 디바이스 없이 만들 수 없으므로 nullptr로 바인딩함 (리소스 동일성 비교는 다루지 않음)
+
+namespace
+{
+	struct FTestConstants
+	{
+		float World[16];
+		float Tint[4];
+	};
+
+	/** @brief Frame-shaped call sequence: pass setup, then a constant write and an instanced draw per primitive. */
+	void SubmitFrame(FRHICommandContext& RHI, uint32 NumDraws, float Tint)
+	{
+		D3D11_VIEWPORT Viewport = {};
+		Viewport.Width = 1280.0f;
+		Viewport.Height = 720.0f;
+		Viewport.MaxDepth = 1.0f;
+		const float ClearColor[4] = { 0.025f, 0.025f, 0.025f, 1.0f };
+
+		RHI.SetViewport(Viewport);
+		RHI.ClearRenderTarget(nullptr, ClearColor);
+		RHI.ClearDepthStencil(nullptr, D3D11_CLEAR_DEPTH, 1.0f, 0);
+		RHI.SetDepthStencilState(nullptr, 1);
+		RHI.SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+		ID3D11Buffer* VertexBuffer = nullptr;
+		const UINT Stride = 32;
+		const UINT Offset = 0;
+		RHI.SetVertexBuffers(0, 1, &VertexBuffer, &Stride, &Offset);
+		RHI.SetIndexBuffer(nullptr, DXGI_FORMAT_R32_UINT, 0);
+
+		FTestConstants Constants = {};
+		for (uint32 i = 0; i < NumDraws; ++i)
+		{
+			Constants.World[12] = static_cast<float>(i);
+			Constants.Tint[0] = Tint;
+			RHI.WriteDynamicBuffer(nullptr, &Constants, sizeof(Constants));
+			RHI.DrawIndexedInstanced(36, 1 + i % 4, 0, 0, 0);
+		}
+	}
+}
+
+ENGINE_TEST(FRecordingCommandContext_RecordsCountsAndReplays)
+{
+	constexpr uint32 NumDraws = 100;
+	constexpr uint32 NumSetupCommands = 7;
+
+	FRecordingCommandContext Recorded;
+	SubmitFrame(Recorded, NumDraws, 1.0f);
+	CHECK(Recorded.GetNumCommands() == NumSetupCommands + 2 * NumDraws);
+	CHECK(Recorded.GetNumDrawCalls() == NumDraws);
+	CHECK(Recorded.GetCommandCount(ERHICommandType::DrawIndexedInstanced) == NumDraws);
+	CHECK(Recorded.GetCommandCount(ERHICommandType::WriteDynamicBuffer) == NumDraws);
+	CHECK(Recorded.GetNumBytesWritten() == NumDraws * sizeof(FTestConstants));
+
+	// 타깃 없이도 마지막으로 기록된 깊이-스텐실 상태로 답함
+	ID3D11DepthStencilState* State = nullptr;
+	UINT StencilRef = 0;
+	Recorded.GetDepthStencilState(&State, &StencilRef);
+	CHECK(State == nullptr && StencilRef == 1);
+	CHECK(Recorded.GetNumCommands() == NumSetupCommands + 2 * NumDraws);
+
+	// 다른 기록기로 재생하면 호출 단위로 같은 스트림이 나와야 함
+	FRecordingCommandContext Replayed;
+	Recorded.Replay(Replayed);
+	CHECK(!Recorded.FindFirstDifference(Replayed).has_value());
+	CHECK(Replayed.GetNumDrawCalls() == NumDraws);
+	CHECK(Replayed.GetNumBytesWritten() == Recorded.GetNumBytesWritten());
+
+	// 타깃을 주면 기록과 동시에 전달됨
+	FRecordingCommandContext Forwarded;
+	FRecordingCommandContext Forwarding(&Forwarded);
+	SubmitFrame(Forwarding, NumDraws, 1.0f);
+	CHECK(!Forwarding.FindFirstDifference(Forwarded).has_value());
+	CHECK(!Recorded.FindFirstDifference(Forwarded).has_value());
+
+	// 상수 내용만 다른 프레임은 첫 WriteDynamicBuffer에서 갈라짐
+	FRecordingCommandContext Tinted;
+	SubmitFrame(Tinted, NumDraws, 0.5f);
+	const TOptional<uint32> Difference = Recorded.FindFirstDifference(Tinted);
+	CHECK(Difference.has_value() && *Difference == NumSetupCommands);
+	CHECK(Difference.has_value() && Recorded.DescribeCommand(*Difference).find("WriteDynamicBuffer") != FString::npos);
+
+	// 드로우가 빠진 프레임은 짧은 쪽의 끝에서 갈라짐
+	FRecordingCommandContext Shorter;
+	SubmitFrame(Shorter, NumDraws - 1, 1.0f);
+	const TOptional<uint32> MissingTail = Recorded.FindFirstDifference(Shorter);
+	CHECK(MissingTail.has_value() && *MissingTail == Shorter.GetNumCommands());
+
+	Recorded.Reset();
+	CHECK(Recorded.GetNumCommands() == 0);
+	CHECK(Recorded.GetNumDrawCalls() == 0);
+	CHECK(Recorded.GetNumBytesWritten() == 0);
+}
+
+ENGINE_BENCHMARK(FRecordingCommandContext_SubmitFrame)
+{
+	// 프레임 제출 CPU 비용을 GPU 없이 측정: 기록만, 그리고 기록된 스트림을 다른 기록기로 재생
+	for (uint32 NumDraws : { 1000u, 10000u })
+	{
+		const FString Suffix = " (" + std::to_string(NumDraws) + " draws)";
+
+		FRecordingCommandContext Recorded;
+		ReportTime(("record frame" + Suffix).c_str(), MeasureMs(10, [&Recorded, NumDraws] {
+			Recorded.Reset();
+			SubmitFrame(Recorded, NumDraws, 1.0f);
+			KeepResult(Recorded.GetNumCommands());
+		}));
+
+		FRecordingCommandContext Replayed;
+		ReportTime(("replay frame" + Suffix).c_str(), MeasureMs(10, [&Recorded, &Replayed] {
+			Replayed.Reset();
+			Recorded.Replay(Replayed);
+			KeepResult(Replayed.GetNumCommands());
+		}));
+	}
+}
@@ -0,0 +1,134 @@
+﻿#include "stdafx.h"
+#include "TestFramework.h"
+#include "FRenderKeySorter.h"
+#include <random>
+
+namespace
+{
+	using FKeyedItem = FRenderKeySorter::FKeyedItem;
+
+	// UBatchRenderer::RenderKeyManager와 같은 배치: 메시 10, 픽셀 셰이더 8, 버텍스 셰이더 8, 레이어 8비트 (하위부터)
+	constexpr uint32 RenderKeyBits = 34;
+
+	uint64 MakeRenderKey(uint32 Mesh, uint32 PixelShader, uint32 VertexShader, uint32 Layer)
+	{
+		return static_cast<uint64>(Mesh) | (static_cast<uint64>(PixelShader) << 10) | (static_cast<uint64>(VertexShader) << 18) | (static_cast<uint64>(Layer) << 26);
+	}
+
+	/** @brief A submission like a spawned scene: 12 meshes, 3 vertex and 3 pixel shaders, 3 layers; item i is packet i. */
+	TArray<FKeyedItem> MakeSubmission(uint32 Num, std::mt19937& Random)
+	{
+		TArray<FKeyedItem> Items(Num);
+		for (uint32 i = 0; i < Num; ++i)
+		{
+			Items[i] = { MakeRenderKey(Random() % 12, Random() % 3, Random() % 3, Random() % 3), i };
+		}
+		return Items;
+	}
+
+	/** @brief Gives Fraction of the items a new random key, as if those primitives changed mesh or layer. */
+	void ChangeKeys(TArray<FKeyedItem>& Items, float Fraction, std::mt19937& Random)
+	{
+		const uint32 NumChanged = static_cast<uint32>(Items.size() * Fraction);
+		for (uint32 i = 0; i < NumChanged; ++i)
+		{
+			Items[Random() % Items.size()].first = MakeRenderKey(Random() % 12, Random() % 3, Random() % 3, Random() % 3);
+		}
+	}
+
+	/** @brief Sorted by descending key and holding exactly the submitted items with their keys. */
+	bool IsSortedPermutationOf(const TArray<FKeyedItem>& Sorted, const TArray<FKeyedItem>& Submitted)
+	{
+		if (Sorted.size() != Submitted.size())
+			return false;
+
+		TArray<bool> bSeen(Submitted.size(), false);
+		for (size_t i = 0; i < Sorted.size(); ++i)
+		{
+			if (i > 0 && Sorted[i - 1].first < Sorted[i].first)
+				return false;
+			const uint32 Item = Sorted[i].second;
+			if (Item >= Submitted.size() || bSeen[Item] || Submitted[Item].first != Sorted[i].first)
+				return false;
+			bSeen[Item] = true;
+		}
+		return true;
+	}
+}
+
+ENGINE_TEST(FRenderKeySorter_AllModesSortDescending)
+{
+	std::mt19937 Random(5);
+	// std::sort 경로(1536 미만), 8비트 자릿수, 11비트 자릿수를 모두 지나감
+	for (uint32 Num : { 1000u, 4000u, 20000u })
+	{
+		for (ERenderSortMode Mode : { ERenderSortMode::Std, ERenderSortMode::Radix, ERenderSortMode::Coherent })
+		{
+			FRenderKeySorter Sorter;
+			TArray<FKeyedItem> Submitted = MakeSubmission(Num, Random);
+
+			// 매 프레임 같은 패킷을 같은 순서로 제출하고 일부 키만 바뀜 (Coherent는 두 번째 프레임부터 재사용,
+			// 10% 이상 바뀐 프레임은 전체 정렬로 돌아가고 그다음 프레임은 다시 재사용)
+			for (float Fraction : { 0.0f, 0.0f, 0.01f, 0.1f, 0.01f, 1.0f, 0.0f })
+			{
+				ChangeKeys(Submitted, Fraction, Random);
+				TArray<FKeyedItem> Items = Submitted;
+				Sorter.SortDescending(Items, RenderKeyBits, Mode);
+				CHECK(IsSortedPermutationOf(Items, Submitted));
+			}
+
+			// 제출이 바뀌면 Coherent도 처음부터 정렬해야 함
+			Submitted.pop_back();
+			TArray<FKeyedItem> Items = Submitted;
+			Sorter.SortDescending(Items, RenderKeyBits, Mode);
+			CHECK(IsSortedPermutationOf(Items, Submitted));
+		}
+	}
+}
+
+ENGINE_BENCHMARK(FRenderKeySorter_StdVsRadixVsCoherent)
+{
+	constexpr int32 Repeats = 20;
+	for (uint32 Num : { 1000u, 10000u, 100000u })
+	{
+		const FString Suffix = " (" + std::to_string(Num) + " primitives)";
+		std::mt19937 Random(9);
+		const TArray<FKeyedItem> Submitted = MakeSubmission(Num, Random);
+		TArray<FKeyedItem> Items;
+
+		FRenderKeySorter StdSorter;
+		ReportTime(("std::sort" + Suffix).c_str(), MeasureMs(Repeats, [&] {
+			Items = Submitted;
+			StdSorter.SortDescending(Items, RenderKeyBits, ERenderSortMode::Std);
+			KeepResult(Items[0].second);
+		}));
+
+		FRenderKeySorter RadixSorter;
+		ReportTime(("radix" + Suffix).c_str(), MeasureMs(Repeats, [&] {
+			Items = Submitted;
+			RadixSorter.SortDescending(Items, RenderKeyBits, ERenderSortMode::Radix);
+			KeepResult(Items[0].second);
+		}));
+
+		// 첫 프레임으로 이전 순서를 만든 뒤, 매 반복이 "다음 프레임" 하나를 정렬 (키 변경과 복사 비용은 두 모드 모두 포함)
+		for (float Fraction : { 0.0f, 0.01f, 0.05f, 0.1f })
+		{
+			for (ERenderSortMode Mode : { ERenderSortMode::Radix, ERenderSortMode::Coherent })
+			{
+				FRenderKeySorter Sorter;
+				TArray<FKeyedItem> Frame = Submitted;
+				Items = Frame;
+				Sorter.SortDescending(Items, RenderKeyBits, Mode);
+
+				char Label[64];
+				snprintf(Label, sizeof(Label), "%s, %g%% keys changed", Mode == ERenderSortMode::Radix ? "radix" : "coherent", Fraction * 100.0f);
+				ReportTime((Label + Suffix).c_str(), MeasureMs(Repeats, [&] {
+					ChangeKeys(Frame, Fraction, Random);
+					Items = Frame;
+					Sorter.SortDescending(Items, RenderKeyBits, Mode);
+					KeepResult(Items[0].second);
+				}));
+			}
+		}
+	}
+}
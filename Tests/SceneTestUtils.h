@@ -0,0 +1,83 @@
+﻿#pragma once
+#include "stdafx.h"
+#include "UScene.h"
+#include "USceneComponent.h"
+#include "UPrimitiveComponent.h"
+#include "UInputManager.h"
+#include "AActor.h"
+
+/** @brief Primitive with unit bounds around its world location, so it enters the spatial index without a mesh. */
+class UTestPrimitive : public UPrimitiveComponent
+{
+public:
+	explicit UTestPrimitive(const FVector& location = FVector(0, 0, 0))
+		: UPrimitiveComponent(location)
+	{
+	}
+
+	bool GetWorldBounds(FAABB& outBounds) const override
+	{
+		const FVector Center = GetWorldLocation();
+		outBounds = FAABB(Center - FVector(0.5f, 0.5f, 0.5f), Center + FVector(0.5f, 0.5f, 0.5f));
+		return true;
+	}
+};
+
+/**
+ * @brief Headless UScene for EngineTests
+ *
+ * Initialize runs without an application, renderer or mesh manager, so objects are added through
+ * AddTestObject (AddObject needs the mesh manager and calls Initialize on primitives). Owns the
+ * UInputManager that component OnShutdown unregisters its callbacks from.
+ */
+class UTestScene : public UScene
+{
+public:
+	UTestScene()
+	{
+		Initialize(nullptr, nullptr, nullptr, nullptr);
+	}
+
+	using UScene::FlushPendingDestroy;
+	using UScene::ApplyCommandBuffers;
+
+	/** @brief What TickActorsParallel does before its ParallelFor: one command buffer per job thread. */
+	void PrepareCommandBuffers(uint32 NumThreads)
+	{
+		commandBuffers.resize((std::max)(NumThreads, static_cast<uint32>(commandBuffers.size())));
+	}
+
+	/** @brief AddObject without the mesh manager / primitive Initialize step. */
+	void AddTestObject(USceneComponent* component)
+	{
+		objects.push_back(component);
+		component->SetGarbageCollectable(true);
+		RegisterComponent(component);
+	}
+
+	/** @brief What Update does for an object whose markedAsDestroyed was set this frame. */
+	void QueueDestroy(USceneComponent* component)
+	{
+		component->markedAsDestroyed = true;
+		pendingDestroyObjects.push_back(component);
+	}
+
+	/** @brief AddActor without Initialize (components would look up the mesh manager). */
+	void AddTestActor(AActor* actor)
+	{
+		actors.push_back(actor);
+		actor->SetGarbageCollectable(true);
+		RegisterActorComponents(actor);
+	}
+
+	const TArray<USceneComponent*>& GetObjects() const { return objects; }
+
+	/** @brief Drops component from the object list without deleting it (the test deletes it itself). */
+	void ForgetObject(USceneComponent* component)
+	{
+		objects.erase(std::find(objects.begin(), objects.end(), component));
+	}
+
+private:
+	UInputManager testInputManager;
+};
@@ -0,0 +1,452 @@
+﻿#include "stdafx.h"
+#include "TestFramework.h"
+#include "SceneTestUtils.h"
+#include "AActor.h"
+#include "UJobSystem.h"
+#include "USceneManager.h"
+#include "FSceneStreamer.h"
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+ENGINE_TEST(UScene_FlushPendingDestroyRemovesQueuedObjects)
+{
+	UTestScene Scene;
+	const uint32 LiveBefore = UObject::GUObjectArray.GetObjectCount();
+
+	TArray<USceneComponent*> Components;
+	for (int32 i = 0; i < 100; ++i)
+	{
+		Components.push_back(new USceneComponent());
+		Scene.AddTestObject(Components.back());
+	}
+	CHECK(UObject::GUObjectArray.GetObjectCount() == LiveBefore + 100);
+
+	// 짝수 번째만 삭제하고, 같은 객체를 두 번 넣어도 한 번만 삭제되어야 함
+	for (int32 i = 0; i < 100; i += 2)
+	{
+		Scene.QueueDestroy(Components[i]);
+	}
+	Scene.QueueDestroy(Components[0]);
+	Scene.FlushPendingDestroy();
+
+	CHECK(Scene.GetObjects().size() == 50);
+	CHECK(UObject::GUObjectArray.GetObjectCount() == LiveBefore + 50);
+	for (USceneComponent* Component : Scene.GetObjects())
+	{
+		CHECK(!Component->markedAsDestroyed);
+	}
+
+	// 비어 있는 큐는 아무것도 하지 않음
+	Scene.FlushPendingDestroy();
+	CHECK(Scene.GetObjects().size() == 50);
+}
+
+ENGINE_TEST(FSceneCommandBuffer_SpawnConstructsOnGameThreadAtApply)
+{
+	UTestScene Scene;
+	UJobSystem JobSystem;
+	JobSystem.StartWorkers(2);
+	Scene.PrepareCommandBuffers(JobSystem.GetNumThreads());
+
+	// 워커에서는 클래스만 기록하고, 객체는 적용 시점에 게임 스레드에서 만들어져야 함
+	const uint32 LiveBefore = UObject::GUObjectArray.GetObjectCount();
+	JobSystem.ParallelFor(100, 1, [&Scene](uint32 Start, uint32 End) {
+		for (uint32 i = Start; i < End; ++i)
+		{
+			Scene.GetCommandBuffer().SpawnActor(AActor::StaticClass());
+		}
+	});
+	CHECK(UObject::GUObjectArray.GetObjectCount() == LiveBefore);
+	CHECK(Scene.GetActors().empty());
+
+	Scene.ApplyCommandBuffers();
+	CHECK(Scene.GetActors().size() == 100);
+	CHECK(UObject::GUObjectArray.GetObjectCount() == LiveBefore + 100);
+
+	// 버퍼는 적용 후 비워짐
+	Scene.ApplyCommandBuffers();
+	CHECK(Scene.GetActors().size() == 100);
+}
+
+ENGINE_TEST(UScene_DeletingPrimitiveLeavesSpatialIndex)
+{
+	UTestScene Scene;
+
+	// 원점 주변 200 단위 정육면체를 평면 6개로 표현 (QueryPrimitivesLinear용)
+	FFrustum Bounds;
+	Bounds.Planes[FFrustum::Left] = FVector4(1, 0, 0, 100);
+	Bounds.Planes[FFrustum::Right] = FVector4(-1, 0, 0, 100);
+	Bounds.Planes[FFrustum::Bottom] = FVector4(0, 1, 0, 100);
+	Bounds.Planes[FFrustum::Top] = FVector4(0, -1, 0, 100);
+	Bounds.Planes[FFrustum::Near] = FVector4(0, 0, 1, 100);
+	Bounds.Planes[FFrustum::Far] = FVector4(0, 0, -1, 100);
+
+	// 직접 delete: 소멸자 안에서 BVH 리프와 목록에서 빠져야 함
+	UTestPrimitive* Direct = new UTestPrimitive(FVector(1, 0, 0));
+	Scene.AddTestObject(Direct);
+	Scene.UpdateSpatialIndex();
+	CHECK(Scene.GetPrimitiveTree().GetNumProxies() == 1);
+	CHECK(Scene.GetPrimitives().size() == 1);
+	CHECK(Scene.GetEntityStore().Num() == 1);
+	TArray<UPrimitiveComponent*> Found;
+	Scene.QueryPrimitivesLinear(Bounds, Found);
+	CHECK(Found.size() == 1 && Found[0] == Direct);
+	// objects 목록에는 남아 있으므로 씬 소멸자에서 다시 지우지 않도록 먼저 뺌
+	Scene.ForgetObject(Direct);
+	delete Direct;
+	CHECK(Scene.GetPrimitiveTree().GetNumProxies() == 0);
+	CHECK(Scene.GetPrimitives().empty());
+	CHECK(Scene.GetEntityStore().Num() == 0);
+
+	// 삭제 큐: FlushPendingDestroy가 OnShutdown 후 delete
+	UTestPrimitive* Queued = new UTestPrimitive(FVector(2, 0, 0));
+	Scene.AddTestObject(Queued);
+	Scene.UpdateSpatialIndex();
+	CHECK(Scene.GetPrimitiveTree().GetNumProxies() == 1);
+	Scene.QueueDestroy(Queued);
+	Scene.FlushPendingDestroy();
+	CHECK(Scene.GetPrimitiveTree().GetNumProxies() == 0);
+	CHECK(Scene.GetPrimitives().empty());
+	CHECK(Scene.GetEntityStore().Num() == 0);
+
+	// 부착된 자식 프리미티브는 부모의 OnShutdown이 delete
+	USceneComponent* Parent = new USceneComponent();
+	UTestPrimitive* Child = new UTestPrimitive(FVector(0, 3, 0));
+	Child->AttachToComponent(Parent);
+	Scene.AddTestObject(Parent);
+	Scene.UpdateSpatialIndex();
+	CHECK(Scene.GetPrimitiveTree().GetNumProxies() == 1);
+	Scene.QueueDestroy(Parent);
+	Scene.FlushPendingDestroy();
+	CHECK(Scene.GetPrimitiveTree().GetNumProxies() == 0);
+	CHECK(Scene.GetPrimitives().empty());
+	CHECK(Scene.GetEntityStore().Num() == 0);
+
+	// 삭제된 프리미티브가 질의 결과로 돌아오면 안 됨
+	Found.clear();
+	Scene.QueryPrimitives(FAABB({ -100, -100, -100 }, { 100, 100, 100 }), Found);
+	CHECK(Found.empty());
+
+	// entityStore 청크를 그대로 훑는 경로도 해제된 FPrimitiveRef를 보면 안 됨
+	Found.clear();
+	Scene.QueryPrimitivesLinear(Bounds, Found);
+	CHECK(Found.empty());
+}
+
+namespace
+{
+	/** @brief Holds each of Expected exactly once and nothing else. */
+	bool HoldsEachOnce(const TArray<UPrimitiveComponent*>& Primitives, const TArray<UPrimitiveComponent*>& Expected)
+	{
+		if (Primitives.size() != Expected.size())
+			return false;
+		for (UPrimitiveComponent* Primitive : Expected)
+		{
+			if (std::count(Primitives.begin(), Primitives.end(), Primitive) != 1)
+				return false;
+		}
+		return true;
+	}
+
+	/** @brief Axis-aligned box [-Half, Half]^3 as six inward planes. */
+	FFrustum MakeBoxFrustum(float Half)
+	{
+		FFrustum Box;
+		Box.Planes[FFrustum::Left] = FVector4(1, 0, 0, Half);
+		Box.Planes[FFrustum::Right] = FVector4(-1, 0, 0, Half);
+		Box.Planes[FFrustum::Bottom] = FVector4(0, 1, 0, Half);
+		Box.Planes[FFrustum::Top] = FVector4(0, -1, 0, Half);
+		Box.Planes[FFrustum::Near] = FVector4(0, 0, 1, Half);
+		Box.Planes[FFrustum::Far] = FVector4(0, 0, -1, Half);
+		return Box;
+	}
+}
+
+ENGINE_TEST(UScene_RegisterUnregisterSwapPopsRegistry)
+{
+	UTestScene Scene;
+	TArray<UPrimitiveComponent*> Expected;
+	for (int32 i = 0; i < 8; ++i)
+	{
+		Expected.push_back(new UTestPrimitive(FVector(float(i), 0, 0)));
+		Scene.AddTestObject(Expected.back());
+	}
+	CHECK(HoldsEachOnce(Scene.GetPrimitives(), Expected));
+
+	// 가운데를 빼면 마지막 원소가 그 자리로 옮겨짐
+	UPrimitiveComponent* Middle = Expected[3];
+	UPrimitiveComponent* Last = Scene.GetPrimitives().back();
+	Scene.UnregisterComponent(Middle);
+	Expected.erase(Expected.begin() + 3);
+	CHECK(Scene.GetPrimitives()[3] == Last);
+	CHECK(Middle->GetRegisteredScene() == nullptr);
+	CHECK(HoldsEachOnce(Scene.GetPrimitives(), Expected));
+
+	// 마지막 원소와 첫 원소를 빼도 나머지 인덱스가 맞아야 (이후 해제가 올바른 슬롯을 지움)
+	Scene.UnregisterComponent(Scene.GetPrimitives().back());
+	Scene.UnregisterComponent(Scene.GetPrimitives().front());
+	Expected.erase(std::remove_if(Expected.begin(), Expected.end(),
+		[](UPrimitiveComponent* Primitive) { return Primitive->GetRegisteredScene() == nullptr; }), Expected.end());
+	CHECK(Expected.size() == 5);
+	CHECK(HoldsEachOnce(Scene.GetPrimitives(), Expected));
+	for (UPrimitiveComponent* Primitive : Expected)
+	{
+		Scene.UnregisterComponent(Primitive);
+		CHECK(std::count(Scene.GetPrimitives().begin(), Scene.GetPrimitives().end(), Primitive) == 0);
+	}
+	CHECK(Scene.GetPrimitives().empty());
+	CHECK(Scene.GetEntityStore().Num() == 0);
+	CHECK(Scene.GetPrimitiveTree().GetNumProxies() == 0);
+
+	// 해제 후 다시 등록하면 한 번만 들어감 (두 번 등록해도 마찬가지)
+	Scene.RegisterComponent(Middle);
+	Scene.RegisterComponent(Middle);
+	CHECK(HoldsEachOnce(Scene.GetPrimitives(), { Middle }));
+}
+
+ENGINE_TEST(UScene_AttachedChildrenRegisteredAndDrawnOnce)
+{
+	UTestScene Scene;
+	const FFrustum Everything = MakeBoxFrustum(1000.0f);
+
+	// 씬에 넣기 전에 붙은 자식, 넣은 뒤에 붙은 자식, 바운드가 없는 자식
+	UTestPrimitive* Parent = new UTestPrimitive(FVector(0, 0, 0));
+	UTestPrimitive* EarlyChild = new UTestPrimitive(FVector(1, 0, 0));
+	EarlyChild->AttachToComponent(Parent);
+	Scene.AddTestObject(Parent);
+	UTestPrimitive* LateChild = new UTestPrimitive(FVector(0, 1, 0));
+	LateChild->AttachToComponent(Parent);
+	UPrimitiveComponent* Unbounded = new UPrimitiveComponent();
+	Unbounded->AttachToComponent(EarlyChild);
+
+	const TArray<UPrimitiveComponent*> All = { Parent, EarlyChild, LateChild, Unbounded };
+	CHECK(HoldsEachOnce(Scene.GetPrimitives(), All));
+	CHECK(!EarlyChild->IsSceneRoot() && !LateChild->IsSceneRoot());
+
+	// 같은 컴포넌트를 직접 다시 등록해도 중복되지 않음 (루트 표시만 바뀜)
+	Scene.RegisterComponent(EarlyChild);
+	Scene.RegisterComponent(Parent);
+	CHECK(EarlyChild->IsSceneRoot());
+	CHECK(HoldsEachOnce(Scene.GetPrimitives(), All));
+
+	// 그리기 목록: 컬링 켜고 끔 둘 다 각 프리미티브가 한 번씩 (바운드 없는 것은 트리 밖에서 추가)
+	for (bool bCulling : { true, false })
+	{
+		Scene.SetFrustumCulling(bCulling);
+		TArray<UPrimitiveComponent*> Drawn;
+		Scene.CollectDrawPrimitives(Everything, Drawn);
+		CHECK(HoldsEachOnce(Drawn, All));
+	}
+	CHECK(Scene.GetPrimitiveTree().GetNumProxies() == 3);
+
+	// 절두체 밖 프리미티브는 빠지고 바운드 없는 것만 남음
+	Scene.SetFrustumCulling(true);
+	Parent->SetPosition({ 5000, 0, 0 });
+	TArray<UPrimitiveComponent*> Drawn;
+	Scene.CollectDrawPrimitives(Everything, Drawn);
+	CHECK(HoldsEachOnce(Drawn, { Unbounded }));
+
+	// 떼어낸 비루트 자식은 씬에서도 빠지고 (자기 자식과 함께) 다시 그려지지 않음
+	Parent->SetPosition({ 0, 0, 0 });
+	LateChild->DetachFromComponent();
+	CHECK(LateChild->GetRegisteredScene() == nullptr);
+	CHECK(HoldsEachOnce(Scene.GetPrimitives(), { Parent, EarlyChild, Unbounded }));
+	Drawn.clear();
+	Scene.CollectDrawPrimitives(Everything, Drawn);
+	CHECK(HoldsEachOnce(Drawn, { Parent, EarlyChild, Unbounded }));
+	delete LateChild;
+}
+
+namespace
+{
+	json::JSON LoadJsonFile(const std::filesystem::path& Path)
+	{
+		std::ifstream File(Path);
+		return json::JSON::Load(FString(std::istreambuf_iterator<char>(File), std::istreambuf_iterator<char>()));
+	}
+}
+
+ENGINE_TEST(USceneManager_SavePartitionedSceneLoadsBack)
+{
+	const std::filesystem::path Directory = std::filesystem::temp_directory_path() / "EngineTests_PartitionedScene";
+	std::filesystem::remove_all(Directory);
+	const std::filesystem::path CellDirectory = Directory / "World.cells";
+	std::filesystem::create_directories(CellDirectory);
+	const FString Path = (Directory / "World.json").string();
+
+	// 이전 저장에서 남은 셀은 새 메인 파일이 쓰인 뒤 지워져야 함
+	const std::filesystem::path StaleCell = CellDirectory / FSceneStreamer::GetCellFileName(99, 99);
+	std::ofstream(StaleCell) << "{}";
+
+	// 셀 크기 10: (0,0)에 둘, (1,0), (-1,-3)에 하나씩
+	constexpr float CellSize = 10.0f;
+	const TArray<FVector> Locations = { { 1, 1, 0 }, { 2, 3, 5 }, { 15, 1, 0 }, { -5, -25, 0 } };
+	{
+		UTestScene Scene;
+		for (const FVector& Location : Locations)
+		{
+			Scene.AddTestObject(new USceneComponent(Location, { 0, 0, 0 }));
+		}
+
+		// 메인 파일 자리에 폴더가 있으면 교체가 실패하고, 이전 셀은 그대로 남아야 함
+		std::filesystem::create_directories(Directory / "World.json" / "Blocker");
+		CHECK(!USceneManager::SavePartitionedScene(Scene, Path, CellSize));
+		CHECK(std::filesystem::exists(StaleCell));
+		CHECK(!std::filesystem::exists(Path + ".tmp"));
+		std::filesystem::remove_all(Path);
+
+		CHECK(USceneManager::SavePartitionedScene(Scene, Path, CellSize));
+	}
+	CHECK(std::filesystem::exists(Path));
+	CHECK(!std::filesystem::exists(Path + ".tmp"));
+	CHECK(!std::filesystem::exists(StaleCell));
+
+	// 메인 파일은 프리미티브 없이 읽히고, Partition 블록이 셀 파일을 모두 가리킴
+	const json::JSON MainData = LoadJsonFile(Path);
+	CHECK(MainData.hasKey("Partition"));
+	CHECK(MainData.at("Primitives").size() == 0);
+	{
+		UTestScene Loaded;
+		CHECK(Loaded.Deserialize(MainData));
+		CHECK(Loaded.GetObjects().empty());
+	}
+
+	const json::JSON& Partition = MainData.at("Partition");
+	CHECK(Partition.at("CellSize").ToFloat() == CellSize);
+	CHECK(Partition.at("Directory").ToString() == "World.cells");
+	CHECK(Partition.at("Cells").length() == 3);
+	CHECK(std::distance(std::filesystem::directory_iterator(CellDirectory), std::filesystem::directory_iterator()) == 3);
+
+	// 스트리머가 셀을 커밋할 때와 같은 경로로 객체를 만들어 위치와 셀을 확인
+	TArray<FVector> LoadedLocations;
+	for (const json::JSON& Cell : Partition.at("Cells").ArrayRange())
+	{
+		const int32 X = Cell.at(0u).ToInt();
+		const int32 Y = Cell.at(1u).ToInt();
+		const json::JSON CellData = LoadJsonFile(CellDirectory / FSceneStreamer::GetCellFileName(X, Y));
+		for (const auto& Primitive : CellData.at("Primitives").ObjectRange())
+		{
+			USceneComponent* Component = UScene::CreateObjectFromJson(Primitive.second);
+			CHECK(Component != nullptr);
+			if (!Component)
+				continue;
+
+			const FVector Location = Component->GetWorldLocation();
+			CHECK(FSceneStreamer::ToCellCoord(Location.X, CellSize) == X);
+			CHECK(FSceneStreamer::ToCellCoord(Location.Y, CellSize) == Y);
+			LoadedLocations.push_back(Location);
+			delete Component;
+		}
+	}
+
+	CHECK(LoadedLocations.size() == Locations.size());
+	for (const FVector& Location : Locations)
+	{
+		CHECK(std::count_if(LoadedLocations.begin(), LoadedLocations.end(), [&Location](const FVector& Loaded) {
+			return Loaded.X == Location.X && Loaded.Y == Location.Y && Loaded.Z == Location.Z;
+		}) == 1);
+	}
+
+	std::filesystem::remove_all(Directory);
+}
+
+ENGINE_BENCHMARK(UScene_PrimitiveTreeVsBruteForce)
+{
+	// 2000 단위 정육면체 안에 흩어진 프리미티브에 대해 씬 질의와 전체 순회를 비교
+	constexpr int32 NumQueries = 200;
+	for (int32 NumPrimitives : { 2000, 20000 })
+	{
+		UTestScene Scene;
+		std::mt19937 Random(42);
+		std::uniform_real_distribution<float> Coord(-1000.0f, 1000.0f);
+		for (int32 i = 0; i < NumPrimitives; ++i)
+		{
+			Scene.AddTestObject(new UTestPrimitive(FVector(Coord(Random), Coord(Random), Coord(Random))));
+		}
+		Scene.UpdateSpatialIndex();
+
+		TArray<FAABB> Boxes;
+		for (int32 i = 0; i < NumQueries; ++i)
+		{
+			const FVector Center(Coord(Random), Coord(Random), Coord(Random));
+			Boxes.push_back(FAABB(Center - FVector(50, 50, 50), Center + FVector(50, 50, 50)));
+		}
+
+		const FString Suffix = ", " + std::to_string(NumPrimitives) + " primitives";
+		TArray<UPrimitiveComponent*> Found;
+		ReportTime(("200 box queries, brute force" + Suffix).c_str(), MeasureMs(3, [&] {
+			uint64 Count = 0;
+			for (const FAABB& Box : Boxes)
+			{
+				Found.clear();
+				for (UPrimitiveComponent* Primitive : Scene.GetPrimitives())
+				{
+					FAABB Bounds;
+					if (Primitive->GetWorldBounds(Bounds) && Bounds.Intersects(Box))
+						Found.push_back(Primitive);
+				}
+				Count += Found.size();
+			}
+			KeepResult(Count);
+		}));
+		ReportTime(("200 box queries, QueryPrimitives" + Suffix).c_str(), MeasureMs(3, [&] {
+			uint64 Count = 0;
+			for (const FAABB& Box : Boxes)
+			{
+				Found.clear();
+				Scene.QueryPrimitives(Box, Found);
+				Count += Found.size();
+			}
+			KeepResult(Count);
+		}));
+	}
+}
+
+ENGINE_BENCHMARK(UScene_DestroyManyObjectsInOneFrame)
+{
+	// 객체당 시간이 개수와 무관하게 일정하면 선형 (이전 find/erase 방식은 개수에 비례해 늘어남)
+	for (int32 NumObjects : { 10000, 20000, 40000 })
+	{
+		double Best = DBL_MAX;
+		for (int32 Repeat = 0; Repeat < 3; ++Repeat)
+		{
+			UTestScene Scene;
+			// 절반을 남겨 두어 목록 정리 비용도 포함
+			TArray<USceneComponent*> Components;
+			for (int32 i = 0; i < NumObjects * 2; ++i)
+			{
+				Components.push_back(new USceneComponent());
+				Scene.AddTestObject(Components.back());
+			}
+			Best = (std::min)(Best, MeasureMs(1, [&Scene, &Components] {
+				for (size_t i = 0; i < Components.size(); i += 2)
+				{
+					Scene.QueueDestroy(Components[i]);
+				}
+				Scene.FlushPendingDestroy();
+			}));
+			KeepResult(Scene.GetObjects().size());
+		}
+
+		// 이전 경로: 삭제마다 전역 배열에서 find + erase
+		TArray<UObject*> OldObjectArray(NumObjects * 2);
+		for (int32 i = 0; i < NumObjects * 2; ++i)
+		{
+			OldObjectArray[i] = reinterpret_cast<UObject*>(static_cast<uintptr_t>(i + 1) * 64);
+		}
+		const double OldMs = MeasureMs(1, [&OldObjectArray, NumObjects] {
+			for (int32 i = 0; i < NumObjects * 2; i += 2)
+			{
+				UObject* Object = reinterpret_cast<UObject*>(static_cast<uintptr_t>(i + 1) * 64);
+				OldObjectArray.erase(std::find(OldObjectArray.begin(), OldObjectArray.end(), Object));
+			}
+		});
+		KeepResult(OldObjectArray.size());
+
+		const FString Count = std::to_string(NumObjects);
+		ReportTime(("deferred queue, destroy " + Count + " of " + std::to_string(NumObjects * 2)).c_str(), Best);
+		printf("    %-48s %10.1f ns\n", "  per destroyed object", Best * 1.0e6 / NumObjects);
+		ReportTime(("find+erase (old), destroy " + Count).c_str(), OldMs);
+	}
+}
@@ -0,0 +1,189 @@
+﻿#include "stdafx.h"
+#include "TestFramework.h"
+#include "FSpatialHashGrid.h"
+#include <random>
+
+namespace
+{
+	// 그리드는 액터 포인터를 역참조하지 않으므로 인덱스를 가짜 포인터로 넣고 다시 꺼내 비교함
+	AActor* ToFakeActor(uint32 Index)
+	{
+		return reinterpret_cast<AActor*>(static_cast<uintptr_t>(Index + 1) * 16);
+	}
+
+	uint32 FromFakeActor(AActor* Actor)
+	{
+		return static_cast<uint32>(reinterpret_cast<uintptr_t>(Actor) / 16) - 1;
+	}
+
+	TArray<uint32> SortedIndices(AActor* const* Begin, AActor* const* End)
+	{
+		TArray<uint32> Indices;
+		for (auto It = Begin; It != End; ++It)
+		{
+			Indices.push_back(FromFakeActor(*It));
+		}
+		std::sort(Indices.begin(), Indices.end());
+		return Indices;
+	}
+
+	bool IsInside(const FAABB& Box, const FVector& P)
+	{
+		return P.X >= Box.Min.X && P.X <= Box.Max.X && P.Y >= Box.Min.Y && P.Y <= Box.Max.Y && P.Z >= Box.Min.Z && P.Z <= Box.Max.Z;
+	}
+}
+
+ENGINE_TEST(FSpatialHashGrid_QueriesMatchBruteForceAfterMovesAndRemoves)
+{
+	constexpr uint32 NumActors = 5000;
+	std::mt19937 Random(3);
+	std::uniform_real_distribution<float> Coord(-300.0f, 300.0f), Radius(0.0f, 60.0f), Jitter(-8.0f, 8.0f);
+
+	FSpatialHashGrid Grid(10.0f);
+	TArray<FVector> Positions(NumActors);
+	TArray<uint32> Handles(NumActors);
+	TArray<bool> bAlive(NumActors, true);
+	for (uint32 i = 0; i < NumActors; ++i)
+	{
+		Positions[i] = FVector(Coord(Random), Coord(Random), Coord(Random));
+		Handles[i] = Grid.Add(ToFakeActor(i), Positions[i]);
+	}
+
+	// 같은 셀 안 이동, 셀 간 이동, 제거, 핸들 재사용을 한 번씩 섞음
+	for (uint32 i = 0; i < NumActors; ++i)
+	{
+		Positions[i] = Positions[i] + FVector(Jitter(Random), Jitter(Random), Jitter(Random));
+		Grid.Move(Handles[i], Positions[i]);
+	}
+	for (uint32 i = 0; i < NumActors; i += 7)
+	{
+		Grid.Remove(Handles[i]);
+		bAlive[i] = false;
+	}
+	for (uint32 i = 0; i < NumActors; i += 14)
+	{
+		Handles[i] = Grid.Add(ToFakeActor(i), Positions[i]);
+		bAlive[i] = true;
+	}
+
+	uint32 NumAlive = 0;
+	for (bool b : bAlive)
+		NumAlive += b ? 1 : 0;
+	CHECK(Grid.Num() == NumAlive);
+
+	for (float CellSize : { 10.0f, 35.0f })
+	{
+		Grid.SetCellSize(CellSize);
+
+		constexpr uint32 NumQueries = 32;
+		TArray<FVector> Centers(NumQueries);
+		TArray<float> Radii(NumQueries);
+		TArray<FAABB> Boxes(NumQueries);
+		for (uint32 q = 0; q < NumQueries; ++q)
+		{
+			Centers[q] = FVector(Coord(Random), Coord(Random), Coord(Random));
+			Radii[q] = Radius(Random);
+			Boxes[q] = FAABB(Centers[q] - FVector(Radii[q], Radii[q] * 0.5f, Radii[q] * 2.0f), Centers[q] + FVector(Radii[q], Radii[q] * 0.5f, Radii[q] * 2.0f));
+		}
+
+		TArray<AActor*> Found;
+		TArray<uint32> Offsets;
+		Grid.QuerySpheres(Centers.data(), Radii.data(), NumQueries, Found, Offsets);
+		CHECK(Offsets.size() == NumQueries + 1);
+		for (uint32 q = 0; q < NumQueries; ++q)
+		{
+			TArray<uint32> Expected;
+			for (uint32 i = 0; i < NumActors; ++i)
+			{
+				if (bAlive[i] && (Positions[i] - Centers[q]).LengthSquared() <= Radii[q] * Radii[q])
+					Expected.push_back(i);
+			}
+			CHECK(SortedIndices(Found.data() + Offsets[q], Found.data() + Offsets[q + 1]) == Expected);
+		}
+
+		Grid.QueryBoxes(Boxes.data(), NumQueries, Found, Offsets);
+		for (uint32 q = 0; q < NumQueries; ++q)
+		{
+			TArray<uint32> Expected;
+			for (uint32 i = 0; i < NumActors; ++i)
+			{
+				if (bAlive[i] && IsInside(Boxes[q], Positions[i]))
+					Expected.push_back(i);
+			}
+			CHECK(SortedIndices(Found.data() + Offsets[q], Found.data() + Offsets[q + 1]) == Expected);
+		}
+	}
+}
+
+ENGINE_BENCHMARK(FSpatialHashGrid_RangeQueriesVsLinearScan)
+{
+	constexpr uint32 NumQueries = 256;
+	constexpr float QueryRadius = 50.0f;
+
+	for (uint32 NumActors : { 10000u, 100000u, 1000000u })
+	{
+		const FString Suffix = " (" + std::to_string(NumActors / 1000) + "k actors)";
+
+		// 밀도를 일정하게 유지하도록 월드 크기를 액터 수의 세제곱근에 맞춤 (1만 개에 1000 단위)
+		const float HalfExtent = 500.0f * cbrtf(NumActors / 10000.0f);
+		std::mt19937 Random(11);
+		std::uniform_real_distribution<float> Coord(-HalfExtent, HalfExtent), Jitter(-2.0f, 2.0f);
+
+		TArray<FVector> Positions(NumActors);
+		for (FVector& Position : Positions)
+		{
+			Position = FVector(Coord(Random), Coord(Random), Coord(Random));
+		}
+		TArray<FVector> Centers(NumQueries);
+		TArray<float> Radii(NumQueries, QueryRadius);
+		TArray<FAABB> Boxes(NumQueries);
+		for (uint32 q = 0; q < NumQueries; ++q)
+		{
+			Centers[q] = FVector(Coord(Random), Coord(Random), Coord(Random));
+			Boxes[q] = FAABB(Centers[q] - FVector(QueryRadius, QueryRadius, QueryRadius), Centers[q] + FVector(QueryRadius, QueryRadius, QueryRadius));
+		}
+
+		FSpatialHashGrid Grid(QueryRadius);
+		TArray<uint32> Handles(NumActors);
+		ReportTime(("add all" + Suffix).c_str(), MeasureMs(1, [&] {
+			for (uint32 i = 0; i < NumActors; ++i)
+				Handles[i] = Grid.Add(ToFakeActor(i), Positions[i]);
+		}));
+
+		// 동적 액터처럼 매 프레임 조금씩 움직이므로 대부분 같은 셀 안 이동이고 일부만 셀을 넘어감
+		ReportTime(("move all" + Suffix).c_str(), MeasureMs(3, [&] {
+			for (uint32 i = 0; i < NumActors; ++i)
+			{
+				Positions[i] = Positions[i] + FVector(Jitter(Random), Jitter(Random), Jitter(Random));
+				Grid.Move(Handles[i], Positions[i]);
+			}
+		}));
+
+		TArray<AActor*> Found;
+		TArray<uint32> Offsets;
+		ReportTime(("256 sphere queries, batched" + Suffix).c_str(), MeasureMs(3, [&] {
+			Grid.QuerySpheres(Centers.data(), Radii.data(), NumQueries, Found, Offsets);
+			KeepResult(Found.size());
+		}));
+		ReportTime(("256 box queries, batched" + Suffix).c_str(), MeasureMs(3, [&] {
+			Grid.QueryBoxes(Boxes.data(), NumQueries, Found, Offsets);
+			KeepResult(Found.size());
+		}));
+
+		const uint32 NumGridHits = static_cast<uint32>(Found.size());
+		TArray<AActor*> Linear;
+		ReportTime(("256 sphere queries, linear scan" + Suffix).c_str(), MeasureMs(1, [&] {
+			Linear.clear();
+			for (uint32 q = 0; q < NumQueries; ++q)
+			{
+				for (uint32 i = 0; i < NumActors; ++i)
+				{
+					if ((Positions[i] - Centers[q]).LengthSquared() <= QueryRadius * QueryRadius)
+						Linear.push_back(ToFakeActor(i));
+				}
+			}
+			KeepResult(Linear.size());
+		}));
+		printf("    %-48s %10u\n", "  hits per query (box)", NumGridHits / NumQueries);
+	}
+}
@@ -0,0 +1,98 @@
+﻿#include "stdafx.h"
+#include "TestFramework.h"
+#include "UEngineSubsystem.h"
+#include "UInputManager.h"
+#include "UTimeManager.h"
+#include "UTextureManager.h"
+#include "URaycastManager.h"
+#include <thread>
+
+ENGINE_TEST(GetSubsystem_TracksRegisterAndUnregister)
+{
+	CHECK(UEngineStatics::GetSubsystem<UInputManager>() == nullptr);
+	{
+		UInputManager First;
+		CHECK(UEngineStatics::GetSubsystem<UInputManager>() == &First);
+		// 캐시가 채워진 뒤에도 같은 값
+		CHECK(UEngineStatics::GetSubsystem<UInputManager>() == &First);
+		CHECK(UEngineStatics::GetSubsystem<UTimeManager>() == nullptr);
+	}
+	// 해제된 서브시스템을 캐시에서 돌려주면 안 됨
+	CHECK(UEngineStatics::GetSubsystem<UInputManager>() == nullptr);
+
+	UInputManager Second;
+	CHECK(UEngineStatics::GetSubsystem<UInputManager>() == &Second);
+	CHECK(UEngineStatics::GetSubsystem<UEngineSubsystem>() == &Second);
+}
+
+ENGINE_TEST(GetSubsystem_ConcurrentLookupsAndGenerationWrap)
+{
+	UInputManager InputManager;
+	UTimeManager TimeManager;
+
+	// 캐시가 빈 상태에서 여러 스레드가 동시에 채우고 읽음
+	UEngineStatics::InvalidateSubsystemCache();
+	TArray<uint32> Mismatches(4, 0);
+	TArray<std::thread> Threads;
+	for (uint32 t = 0; t < Mismatches.size(); ++t)
+	{
+		Threads.emplace_back([&Mismatches, &InputManager, &TimeManager, t] {
+			for (int32 i = 0; i < 100000; ++i)
+			{
+				Mismatches[t] += UEngineStatics::GetSubsystem<UInputManager>() != &InputManager ? 1 : 0;
+				Mismatches[t] += UEngineStatics::GetSubsystem<UTimeManager>() != &TimeManager ? 1 : 0;
+			}
+		});
+	}
+	for (std::thread& Thread : Threads)
+	{
+		Thread.join();
+	}
+	for (uint32 Count : Mismatches)
+	{
+		CHECK(Count == 0);
+	}
+
+	// 16비트 세대가 한 바퀴 돌아도 빈 슬롯(세대 0)으로 오인하지 않음
+	for (uint32 i = 0; i <= FSubsystemCacheSlot::GenerationMask; ++i)
+	{
+		UEngineStatics::InvalidateSubsystemCache();
+		CHECK(UEngineStatics::GetSubsystem<UInputManager>() == &InputManager);
+	}
+	CHECK(UEngineStatics::GetSubsystem<UTimeManager>() == &TimeManager);
+}
+
+ENGINE_BENCHMARK(GetSubsystem_CachedVsLinearScan)
+{
+	// 엔진이 띄우는 서브시스템 수와 비슷하게 등록하고, 가장 뒤에 등록된 타입을 조회
+	UTimeManager TimeManager;
+	UTextureManager TextureManager;
+	URaycastManager RaycastManager;
+	UInputManager InputManager;
+
+	// 이전 FindSubsystemByClass와 같은 스캔
+	TArray<UEngineSubsystem*> Registered;
+	UEngineStatics::ForEachSubsystem([&Registered](UEngineSubsystem* Subsystem) { Registered.push_back(Subsystem); });
+	auto FindByScan = [&Registered](UClass* TargetClass) -> UEngineSubsystem* {
+		for (UEngineSubsystem* Subsystem : Registered)
+		{
+			if (Subsystem && Subsystem->GetClass()->IsChildOrSelfOf(TargetClass))
+				return Subsystem;
+		}
+		return nullptr;
+	};
+
+	constexpr int32 NumLookups = 10000000;
+	ReportTime("10M x linear scan (old)", MeasureMs(3, [&FindByScan] {
+		uint64 Sum = 0;
+		for (int32 i = 0; i < NumLookups; ++i)
+			Sum += reinterpret_cast<uintptr_t>(FindByScan(UInputManager::StaticClass()));
+		KeepResult(Sum);
+	}));
+	ReportTime("10M x GetSubsystem<UInputManager>()", MeasureMs(3, [] {
+		uint64 Sum = 0;
+		for (int32 i = 0; i < NumLookups; ++i)
+			Sum += reinterpret_cast<uintptr_t>(UEngineStatics::GetSubsystem<UInputManager>());
+		KeepResult(Sum);
+	}));
+}
@@ -0,0 +1,72 @@
+﻿#pragma once
+#include "stdafx.h"
+#include <chrono>
+#include "UEngineStatics.h"
+#include "TArray.h"
+
+/**
+ * @brief Minimal self-registering runner for EngineTests
+ *
+ * ENGINE_TEST bodies run by default and report failed CHECKs; ENGINE_BENCHMARK bodies only run
+ * with --bench and print their own timings through ReportTime. Both are registered during static
+ * initialization, so adding a case is just adding a function to one of the *Tests.cpp files.
+ */
+struct FTestCase
+{
+	const char* Name;
+	void (*Function)();
+};
+
+class FTestRegistry
+{
+public:
+	static TArray<FTestCase>& GetTests();
+	static TArray<FTestCase>& GetBenchmarks();
+
+	static void ReportFailure(const char* Expression, const char* File, int32 Line);
+	static int32 GetNumFailures() { return NumFailures; }
+
+private:
+	static inline int32 NumFailures = 0;
+};
+
+struct FTestRegistrar
+{
+	FTestRegistrar(const char* Name, void (*Function)(), bool bBenchmark)
+	{
+		(bBenchmark ? FTestRegistry::GetBenchmarks() : FTestRegistry::GetTests()).push_back(FTestCase{ Name, Function });
+	}
+};
+
+#define ENGINE_TEST(Name) \
+	static void Name(); \
+	static FTestRegistrar Name##Registrar(#Name, &Name, false); \
+	static void Name()
+
+#define ENGINE_BENCHMARK(Name) \
+	static void Name(); \
+	static FTestRegistrar Name##Registrar(#Name, &Name, true); \
+	static void Name()
+
+#define CHECK(Expression) \
+	do { if (!(Expression)) FTestRegistry::ReportFailure(#Expression, __FILE__, __LINE__); } while (0)
+
+/** @brief Best of Repeats wall-clock runs of Function, in milliseconds. */
+template<typename TFunction>
+double MeasureMs(int32 Repeats, TFunction&& Function)
+{
+	double Best = DBL_MAX;
+	for (int32 i = 0; i < Repeats; ++i)
+	{
+		const auto Start = std::chrono::steady_clock::now();
+		Function();
+		const auto End = std::chrono::steady_clock::now();
+		Best = (std::min)(Best, std::chrono::duration<double, std::milli>(End - Start).count());
+	}
+	return Best;
+}
+
+void ReportTime(const char* Label, double Milliseconds);
+
+/** @brief Folds a benchmark result into a global so the optimizer cannot drop the work that produced it. */
+void KeepResult(uint64 Value);
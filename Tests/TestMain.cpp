@@ -0,0 +1,82 @@
+﻿#include "stdafx.h"
+#include "TestFramework.h"
+#include "UClass.h"
+
+// EngineTests entry point
+//
+//   EngineTests             runs every ENGINE_TEST
+//   EngineTests --bench     runs every ENGINE_BENCHMARK instead
+//   EngineTests [--bench] <filter>   only cases whose name contains <filter>
+//
+// Run from the Engine folder (the debugger working directory is set to it): component
+// constructors read editor.ini, which is created from editor.default.ini there.
+
+namespace
+{
+	volatile uint64 GResultSink = 0;
+}
+
+TArray<FTestCase>& FTestRegistry::GetTests()
+{
+	static TArray<FTestCase> Tests;
+	return Tests;
+}
+
+TArray<FTestCase>& FTestRegistry::GetBenchmarks()
+{
+	static TArray<FTestCase> Benchmarks;
+	return Benchmarks;
+}
+
+void FTestRegistry::ReportFailure(const char* Expression, const char* File, int32 Line)
+{
+	++NumFailures;
+	printf("    FAILED: %s (%s:%d)\n", Expression, File, Line);
+}
+
+void ReportTime(const char* Label, double Milliseconds)
+{
+	printf("    %-48s %10.3f ms\n", Label, Milliseconds);
+}
+
+void KeepResult(uint64 Value)
+{
+	GResultSink = GResultSink + Value;
+}
+
+int main(int argc, char** argv)
+{
+	bool bBenchmarks = false;
+	FString Filter;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "--bench") == 0)
+			bBenchmarks = true;
+		else
+			Filter = argv[i];
+	}
+
+	UClass::ResolveTypeIntervals();
+
+	int32 NumRun = 0;
+	int32 NumFailedCases = 0;
+	for (const FTestCase& Case : bBenchmarks ? FTestRegistry::GetBenchmarks() : FTestRegistry::GetTests())
+	{
+		if (!Filter.empty() && FString(Case.Name).find(Filter) == FString::npos)
+			continue;
+
+		printf("[ RUN  ] %s\n", Case.Name);
+		fflush(stdout);
+
+		const int32 FailuresBefore = FTestRegistry::GetNumFailures();
+		Case.Function();
+		const bool bPassed = FTestRegistry::GetNumFailures() == FailuresBefore;
+
+		printf("[ %s ] %s\n", bPassed ? " OK " : "FAIL", Case.Name);
+		++NumRun;
+		NumFailedCases += bPassed ? 0 : 1;
+	}
+
+	printf("%d case(s) run, %d failed\n", NumRun, NumFailedCases);
+	return NumFailedCases == 0 ? 0 : 1;
+}
@@ -0,0 +1,413 @@
+﻿#include "stdafx.h"
+#include "TestFramework.h"
+#include "USceneComponent.h"
+#include "FTransformStore.h"
+#include "UJobSystem.h"
+#include <random>
+#include <thread>
+
+namespace
+{
+	/** @brief What GetWorldTransform did before caching: rebuild the whole parent chain. */
+	FMatrix ComputeWorldTransformUncached(const USceneComponent* Component)
+	{
+		const FMatrix Local = Component->GetRelativeTransform();
+		return Component->GetAttachParent() ? Local * ComputeWorldTransformUncached(Component->GetAttachParent()) : Local;
+	}
+
+	bool NearlyEqual(const FMatrix& A, const FMatrix& B)
+	{
+		for (int32 Row = 0; Row < 4; ++Row)
+			for (int32 Col = 0; Col < 4; ++Col)
+				if (fabsf(A.M[Row][Col] - B.M[Row][Col]) > 1e-3f) return false;
+		return true;
+	}
+
+	/** @brief NumChains chains of Depth components each, parent before child. */
+	TArray<USceneComponent*> BuildChains(int32 NumChains, int32 Depth)
+	{
+		TArray<USceneComponent*> Components;
+		for (int32 Chain = 0; Chain < NumChains; ++Chain)
+		{
+			USceneComponent* Parent = nullptr;
+			for (int32 Level = 0; Level < Depth; ++Level)
+			{
+				USceneComponent* Component = new USceneComponent({ 1, 0, 0.5f }, { 0, 0, 10 }, { 1, 1, 1 });
+				if (Parent)
+					Component->AttachToComponent(Parent);
+				Components.push_back(Component);
+				Parent = Component;
+			}
+		}
+		return Components;
+	}
+
+	void DeleteChains(TArray<USceneComponent*>& Components)
+	{
+		// 자식부터 지움
+		for (auto It = Components.rbegin(); It != Components.rend(); ++It)
+		{
+			(*It)->DetachFromComponent();
+			delete *It;
+		}
+		Components.clear();
+	}
+}
+
+ENGINE_TEST(USceneComponent_CachedWorldTransformFollowsEdits)
+{
+	std::mt19937 Random(5);
+	TArray<USceneComponent*> Components;
+	for (int32 i = 0; i < 200; ++i)
+	{
+		Components.push_back(new USceneComponent({ float(Random() % 10), 0, 0 }, { float(Random() % 90), 0, 0 }, { 1, 1, 1 }));
+		if (i > 0 && Random() % 4 != 0)
+			Components.back()->AttachToComponent(Components[Random() % i]);
+	}
+
+	// 위치/회전/크기 변경, 부착/분리 뒤에도 캐시가 전체 재계산과 같아야 함
+	for (int32 Step = 0; Step < 500; ++Step)
+	{
+		USceneComponent* Component = Components[Random() % Components.size()];
+		switch (Random() % 5)
+		{
+		case 0: Component->SetPosition({ float(Random() % 10), 1, 2 }); break;
+		case 1: Component->SetRotation({ 0, 0, float(Random() % 90) }); break;
+		case 2: Component->SetScale({ 1, float(Random() % 3 + 1), 1 }); break;
+		case 3:
+		{
+			USceneComponent* Parent = Components[Random() % Components.size()];
+			if (Parent != Component && !Parent->IsAttachedTo(Component))
+				Component->AttachToComponent(Parent);
+			break;
+		}
+		default: Component->DetachFromComponent(); break;
+		}
+
+		USceneComponent* Probe = Components[Random() % Components.size()];
+		CHECK(NearlyEqual(Probe->GetWorldTransform(), ComputeWorldTransformUncached(Probe)));
+	}
+	for (USceneComponent* Component : Components)
+	{
+		CHECK(NearlyEqual(Component->GetWorldTransform(), ComputeWorldTransformUncached(Component)));
+	}
+
+	for (USceneComponent* Component : Components)
+	{
+		Component->DetachFromComponent();
+	}
+	for (USceneComponent* Component : Components)
+	{
+		delete Component;
+	}
+}
+
+ENGINE_TEST(FTransformStore_WorldMatricesAfterAttachDetachReparent)
+{
+	constexpr int32 NumChains = 20;
+	constexpr int32 Depth = 5;
+	TArray<USceneComponent*> Components = BuildChains(NumChains, Depth);
+	FTransformStore Store;
+	for (USceneComponent* Component : Components)
+	{
+		Store.Register(Component);
+	}
+	auto MatchesReference = [&Components]() {
+		for (USceneComponent* Component : Components)
+		{
+			if (!NearlyEqual(Component->GetWorldTransform(), ComputeWorldTransformUncached(Component)))
+				return false;
+		}
+		return true;
+	};
+	Store.UpdateWorldTransforms();
+	CHECK(Store.NumDirty() == 0);
+	CHECK(MatchesReference());
+
+	USceneComponent* Root3 = Components[3 * Depth];
+	USceneComponent* Leaf7 = Components[7 * Depth + Depth - 1];
+	USceneComponent* Root9 = Components[9 * Depth];
+
+	// 재구성은 다른 엔트리 조회로 일으키고, 더티는 옮겨진 서브트리에만 남아야 함
+	Root3->AttachToComponent(Leaf7);
+	Components[0]->GetWorldTransform();
+	CHECK(Store.NumDirty() == Depth);
+	CHECK(MatchesReference());
+
+	// 다시 붙이기: 이전 부모에서 떨어진 쪽만 다시 계산
+	Store.UpdateWorldTransforms();
+	Root3->AttachToComponent(Root9);
+	Components[0]->GetWorldTransform();
+	CHECK(Store.NumDirty() == Depth);
+	CHECK(MatchesReference());
+
+	// 분리: 떨어진 서브트리 (자기 + 자손 4개)만 다시 계산
+	Store.UpdateWorldTransforms();
+	Root3->DetachFromComponent();
+	Components[0]->GetWorldTransform();
+	CHECK(Store.NumDirty() == Depth);
+	CHECK(MatchesReference());
+
+	// 움직인 부모 아래로 옮긴 뒤에도 부모의 새 위치가 자손까지 반영되어야 함
+	Store.UpdateWorldTransforms();
+	Root9->SetPosition({ 5, -2, 1 });
+	Components[3 * Depth + 2]->AttachToComponent(Components[9 * Depth + 1]);
+	TArray<USceneComponent*> Moved;
+	Store.UpdateWorldTransforms(&Moved);
+	CHECK(Store.NumDirty() == 0);
+	CHECK(Moved.size() == Depth + 3);
+	CHECK(MatchesReference());
+
+	// 자식 없는 컴포넌트 해제는 구멍만 남기고, 부모가 해제되면 자식은 루트가 됨
+	USceneComponent* Leaf0 = Components[Depth - 1];
+	Leaf0->DetachFromComponent();
+	Store.Unregister(Leaf0);
+	Store.Unregister(Components[11 * Depth]);
+	Components[11 * Depth + 1]->DetachFromComponent();
+	Store.UpdateWorldTransforms();
+	CHECK(Store.Num() == NumChains * Depth - 2);
+	for (USceneComponent* Component : Components)
+	{
+		if (Component != Leaf0 && Component != Components[11 * Depth])
+		{
+			CHECK(NearlyEqual(Store.GetWorldTransform(Component), ComputeWorldTransformUncached(Component)));
+		}
+	}
+
+	Store.Clear();
+	for (USceneComponent* Component : Components)
+	{
+		Component->DetachFromComponent();
+	}
+	for (USceneComponent* Component : Components)
+	{
+		delete Component;
+	}
+}
+
+ENGINE_TEST(FTransformStore_RegistersSubtreesInAnyOrder)
+{
+	// 부모 다음에 자식을 깊이 우선으로 등록하면 제자리에 추가되고, 그 밖의 순서는 재구성으로 맞춤
+	TArray<USceneComponent*> Components = BuildChains(4, 3);
+	FTransformStore Store;
+	for (int32 i = 0; i < 6; ++i)
+	{
+		Store.Register(Components[i]);
+	}
+	Store.UpdateWorldTransforms();
+
+	USceneComponent* Extra = new USceneComponent({ 2, 0, 0 }, { 0, 0, 0 });
+	Extra->AttachToComponent(Components[5]);
+	Store.Register(Extra);
+	for (int32 i = 6; i < 12; ++i)
+	{
+		Store.Register(Components[i]);
+	}
+	CHECK(Store.NumDirty() == 7);
+	CHECK(NearlyEqual(Extra->GetWorldTransform(), ComputeWorldTransformUncached(Extra)));
+	CHECK(Store.NumDirty() == 6);
+
+	// 앞쪽 서브트리 중간에 붙는 컴포넌트, 자식보다 늦게 등록되는 부모
+	USceneComponent* Late = new USceneComponent({ 0, 3, 0 }, { 0, 0, 0 });
+	Late->AttachToComponent(Components[0]);
+	Store.Register(Late);
+	USceneComponent* LateParent = new USceneComponent({ 0, 0, 4 }, { 0, 90, 0 });
+	Components[9]->AttachToComponent(LateParent);
+	Store.Register(LateParent);
+	Store.UpdateWorldTransforms();
+	CHECK(Store.Num() == 15);
+	CHECK(NearlyEqual(Late->GetWorldTransform(), ComputeWorldTransformUncached(Late)));
+	for (USceneComponent* Component : Components)
+	{
+		CHECK(NearlyEqual(Component->GetWorldTransform(), ComputeWorldTransformUncached(Component)));
+	}
+
+	Store.Clear();
+	Late->DetachFromComponent();
+	Extra->DetachFromComponent();
+	Components[9]->DetachFromComponent();
+	delete Late;
+	delete Extra;
+	delete LateParent;
+	DeleteChains(Components);
+}
+
+ENGINE_TEST(USceneComponent_ParallelQueriesDoNotWriteParentCache)
+{
+	// 병렬 틱처럼 저장소가 더티를 미루는 동안 형제들이 여러 스레드에서 같은 부모를 거쳐 조회
+	constexpr int32 NumChildren = 64;
+	USceneComponent Root({ 1, 2, 3 }, { 0, 30, 0 }, { 2, 2, 2 });
+	USceneComponent Middle({ 0, 1, 0 }, { 0, 0, 45 });
+	Middle.AttachToComponent(&Root);
+	TArray<USceneComponent*> Children;
+	FTransformStore Store;
+	Store.Register(&Root);
+	Store.Register(&Middle);
+	for (int32 i = 0; i < NumChildren; ++i)
+	{
+		Children.push_back(new USceneComponent({ float(i), 0, 0 }, { 0, 0, 0 }));
+		Children.back()->AttachToComponent(&Middle);
+		Store.Register(Children.back());
+	}
+	Store.UpdateWorldTransforms();
+
+	UJobSystem JobSystem;
+	JobSystem.StartWorkers(2);
+	Store.BeginDeferredDirty(JobSystem.GetNumThreads());
+	Root.SetPosition({ -4, 0, 1 });
+	TArray<uint8> bMatches(NumChildren, 0);
+	JobSystem.ParallelFor(NumChildren, 1, [&](uint32 Start, uint32 End) {
+		for (uint32 i = Start; i < End; ++i)
+		{
+			bMatches[i] = NearlyEqual(Children[i]->GetWorldTransform(), ComputeWorldTransformUncached(Children[i]));
+		}
+	});
+	Store.EndDeferredDirty();
+	for (uint8 bMatch : bMatches)
+	{
+		CHECK(bMatch);
+	}
+
+	// 미뤄진 이동이 반영된 뒤 저장소 값도 같아야 함
+	Store.UpdateWorldTransforms();
+	CHECK(NearlyEqual(Middle.GetWorldTransform(), ComputeWorldTransformUncached(&Middle)));
+	for (USceneComponent* Child : Children)
+	{
+		CHECK(NearlyEqual(Child->GetWorldTransform(), ComputeWorldTransformUncached(Child)));
+	}
+
+	Store.Clear();
+	for (USceneComponent* Child : Children)
+	{
+		Child->DetachFromComponent();
+		delete Child;
+	}
+	Middle.DetachFromComponent();
+}
+
+ENGINE_TEST(FTransformStore_DeferredDirtyFromForeignThread)
+{
+	// 잡 시스템 밖의 스레드는 스레드별 목록이 없으므로 잠긴 공용 목록으로 기록
+	TArray<USceneComponent*> Components = BuildChains(2, 3);
+	FTransformStore Store;
+	for (USceneComponent* Component : Components)
+	{
+		Store.Register(Component);
+	}
+	Store.UpdateWorldTransforms();
+
+	Store.BeginDeferredDirty(1);
+	std::thread Foreign([&Components] { Components[3]->SetPosition({ 7, 0, 0 }); });
+	Components[0]->SetPosition({ -7, 0, 0 });
+	Foreign.join();
+	CHECK(Store.NumDirty() == 0);
+	Store.EndDeferredDirty();
+	CHECK(Store.NumDirty() == 6);
+
+	Store.UpdateWorldTransforms();
+	for (USceneComponent* Component : Components)
+	{
+		CHECK(NearlyEqual(Component->GetWorldTransform(), ComputeWorldTransformUncached(Component)));
+	}
+
+	Store.Clear();
+	DeleteChains(Components);
+}
+
+ENGINE_BENCHMARK(USceneComponent_WorldTransform10LevelHierarchy)
+{
+	// 1000개의 10단계 체인 = 10k 컴포넌트. 프레임마다 루트 1%를 움직이고 모든 월드 행렬을 4번씩 조회
+	// (렌더러, 레이캐스트, AABB 표시, 텍스트홀더가 각각 조회하던 것과 같은 모양)
+	constexpr int32 NumChains = 1000;
+	constexpr int32 Depth = 10;
+	constexpr int32 NumFrames = 20;
+	constexpr int32 QueriesPerFrame = 4;
+	TArray<USceneComponent*> Components = BuildChains(NumChains, Depth);
+
+	auto MoveRoots = [&Components](int32 Frame) {
+		for (int32 Chain = Frame % 100; Chain < NumChains; Chain += 100)
+			Components[Chain * Depth]->SetPosition({ float(Frame), 0, 0 });
+	};
+
+	ReportTime("uncached parent chain (old), 20 frames", MeasureMs(3, [&] {
+		float Sum = 0;
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			MoveRoots(Frame);
+			for (int32 Query = 0; Query < QueriesPerFrame; ++Query)
+				for (USceneComponent* Component : Components)
+					Sum += ComputeWorldTransformUncached(Component).M[3][0];
+		}
+		KeepResult(static_cast<uint64>(Sum));
+	}));
+	ReportTime("cached GetWorldTransform, 20 frames", MeasureMs(3, [&] {
+		float Sum = 0;
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			MoveRoots(Frame);
+			for (int32 Query = 0; Query < QueriesPerFrame; ++Query)
+				for (USceneComponent* Component : Components)
+					Sum += Component->GetWorldTransform().M[3][0];
+		}
+		KeepResult(static_cast<uint64>(Sum));
+	}));
+
+	// 씬에 등록된 경우: FTransformStore가 프레임당 한 번 더티 구간만 갱신
+	FTransformStore Store;
+	for (USceneComponent* Component : Components)
+	{
+		Store.Register(Component);
+	}
+	ReportTime("FTransformStore update + lookups, 20 frames", MeasureMs(3, [&] {
+		float Sum = 0;
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			MoveRoots(Frame);
+			Store.UpdateWorldTransforms();
+			for (int32 Query = 0; Query < QueriesPerFrame; ++Query)
+				for (USceneComponent* Component : Components)
+					Sum += Component->GetWorldTransform().M[3][0];
+		}
+		KeepResult(static_cast<uint64>(Sum));
+	}));
+	// 모든 루트가 움직인 프레임: 갱신 패스만 (10k 월드 행렬 전부)
+	ReportTime("FTransformStore update, all moved, 20 frames", MeasureMs(3, [&] {
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			for (int32 Chain = 0; Chain < NumChains; ++Chain)
+				Components[Chain * Depth]->SetPosition({ float(Frame), 0, 0 });
+			Store.UpdateWorldTransforms();
+		}
+		KeepResult(static_cast<uint64>(Components.back()->GetWorldTransform().M[3][0]));
+	}));
+	for (USceneComponent* Component : Components)
+	{
+		Store.Unregister(Component);
+	}
+
+	DeleteChains(Components);
+}
+
+ENGINE_BENCHMARK(FTransformStore_RegisterWhileQuerying)
+{
+	// 로딩/스폰처럼 체인 하나를 등록할 때마다 그 잎의 월드 행렬을 조회 (2000개의 5단계 체인 = 10k 컴포넌트)
+	constexpr int32 NumChains = 2000;
+	constexpr int32 Depth = 5;
+	TArray<USceneComponent*> Components = BuildChains(NumChains, Depth);
+	FTransformStore Store;
+	ReportTime("register chain + query leaf, 10k components", MeasureMs(3, [&] {
+		Store.Clear();
+		float Sum = 0;
+		for (int32 Chain = 0; Chain < NumChains; ++Chain)
+		{
+			for (int32 Level = 0; Level < Depth; ++Level)
+				Store.Register(Components[Chain * Depth + Level]);
+			Sum += Components[Chain * Depth + Depth - 1]->GetWorldTransform().M[3][0];
+		}
+		Store.UpdateWorldTransforms();
+		KeepResult(static_cast<uint64>(Sum));
+	}));
+	Store.Clear();
+
+	DeleteChains(Components);
+}